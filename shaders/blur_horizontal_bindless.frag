@@ -0,0 +1,32 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+#include "include/precision.glsl"
+#include "include/bindless.glsl"
+#include "include/render_area.glsl"
+
+layout(location = 0) in vec2 fragTexCoord;
+layout(location = 0) out vec4 outColor;
+
+const float weights[5] = float[](0.227027, 0.1945946, 0.1216216, 0.054054, 0.016216);
+
+void main()
+{
+    vec2 uv = fragTexCoord * params.uvScale;
+    hvec3 result = hvec3(SampleLinear(params.inputTexture, uv).rgb) * hfloat(weights[0]);
+    hfloat weightSum = hfloat(weights[0]);
+    int radius = clamp(params.kernelRadius, 0, 4);
+
+    // Horizontal blur (along X axis)
+    for (int i = 1; i <= radius; i++)
+    {
+        vec2 offset = vec2(params.texelSize.x * float(i) * params.blurStrength, 0.0);
+        vec2 uvPositive = ClampToRenderArea(uv + offset, params.uvScale, params.texelSize);
+        vec2 uvNegative = ClampToRenderArea(uv - offset, params.uvScale, params.texelSize);
+        result += hvec3(SampleLinear(params.inputTexture, uvPositive).rgb) * hfloat(weights[i]);
+        result += hvec3(SampleLinear(params.inputTexture, uvNegative).rgb) * hfloat(weights[i]);
+        weightSum += hfloat(2.0 * weights[i]);
+    }
+
+    outColor = vec4(result / weightSum, 1.0);
+}
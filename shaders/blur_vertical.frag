@@ -1,4 +1,8 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
+
+#include "include/precision.glsl"
+#include "include/render_area.glsl"
 
 layout(location = 0) in vec2 fragTexCoord;
 layout(location = 0) out vec4 outColor;
@@ -7,11 +11,13 @@ layout(set = 0, binding = 0) uniform sampler2D inputTexture;
 layout(set = 0, binding = 1) uniform sampler2D velocityTexture;
 layout(set = 0, binding = 2) uniform sampler2D depthTexture;
 
-layout(set = 0, binding = 3) uniform PostProcessParams
+layout(push_constant) uniform PostProcessParams
 {
     float blurStrength;
     float motionScale;
     vec2 texelSize;
+    vec2 uvScale;
+    int kernelRadius;
 }
 params;
 
@@ -19,15 +25,21 @@ const float weights[5] = float[](0.227027, 0.1945946, 0.1216216, 0.054054, 0.016
 
 void main()
 {
-    vec3 result = texture(inputTexture, fragTexCoord).rgb * weights[0];
+    vec2 uv = fragTexCoord * params.uvScale;
+    hvec3 result = hvec3(texture(inputTexture, uv).rgb) * hfloat(weights[0]);
+    hfloat weightSum = hfloat(weights[0]);
+    int radius = clamp(params.kernelRadius, 0, 4);
 
     // Vertical blur (along Y axis)
-    for (int i = 1; i < 5; i++)
+    for (int i = 1; i <= radius; i++)
     {
         vec2 offset = vec2(0.0, params.texelSize.y * float(i) * params.blurStrength);
-        result += texture(inputTexture, fragTexCoord + offset).rgb * weights[i];
-        result += texture(inputTexture, fragTexCoord - offset).rgb * weights[i];
+        vec2 uvPositive = ClampToRenderArea(uv + offset, params.uvScale, params.texelSize);
+        vec2 uvNegative = ClampToRenderArea(uv - offset, params.uvScale, params.texelSize);
+        result += hvec3(texture(inputTexture, uvPositive).rgb) * hfloat(weights[i]);
+        result += hvec3(texture(inputTexture, uvNegative).rgb) * hfloat(weights[i]);
+        weightSum += hfloat(2.0 * weights[i]);
     }
 
-    outColor = vec4(result, 1.0);
+    outColor = vec4(result / weightSum, 1.0);
 }
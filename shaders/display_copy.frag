@@ -0,0 +1,14 @@
+#version 450
+
+// Frame interpolation: copies a displayed frame, rendered or interpolated, to the swapchain image. The
+// render targets are rendered in their top-left sub-rect, so framebuffer and source texels coincide.
+
+layout(location = 0) in vec2 fragTexCoord;
+layout(location = 0) out vec4 outColor;
+
+layout(set = 0, binding = 0) uniform sampler2D sourceTexture;
+
+void main()
+{
+    outColor = vec4(texelFetch(sourceTexture, ivec2(gl_FragCoord.xy), 0).rgb, 1.0);
+}
@@ -1,4 +1,9 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
+
+#include "include/precision.glsl"
+#include "include/render_area.glsl"
+#include "include/kawase.glsl"
 
 layout(location = 0) in vec2 fragTexCoord;
 layout(location = 0) out vec4 outColor;
@@ -6,17 +11,41 @@ layout(location = 0) out vec4 outColor;
 layout(set = 0, binding = 0) uniform sampler2D motionTexture;
 layout(set = 0, binding = 1) uniform sampler2D blurTexture;
 
+layout(push_constant) uniform PostProcessParams
+{
+    float blurStrength;
+    float motionScale;
+    vec2 texelSize;
+    vec2 uvScale;
+    int kernelRadius;
+}
+params;
+
+// Pyramid blur mode binds mip 0 of the blur pyramid as the blur input and runs its last Kawase
+// upsample here rather than in a separate full-resolution pass
+layout(constant_id = 0) const bool PYRAMID_BLUR = false;
+
 void main()
 {
-    vec3 motionResult = texture(motionTexture, fragTexCoord).rgb;
-    vec3 blurResult = texture(blurTexture, fragTexCoord).rgb;
+    vec2 uv = ClampToRenderArea(fragTexCoord * params.uvScale, params.uvScale, params.texelSize);
+    hvec3 motionResult = hvec3(texture(motionTexture, uv).rgb);
+    hvec3 blurResult;
+    if (PYRAMID_BLUR)
+    {
+        // Mip 0 has half the resolution of the render targets
+        blurResult = KawaseUpsample(blurTexture, uv, params.uvScale, 2.0 * params.texelSize, 1.0).rgb;
+    }
+    else
+    {
+        blurResult = hvec3(texture(blurTexture, uv).rgb);
+    }
 
-    float dofAmount = 0.3;
-    vec3 finalColor = mix(motionResult, blurResult, dofAmount);
+    hfloat dofAmount = hfloat(0.3);
+    hvec3 finalColor = mix(motionResult, blurResult, dofAmount);
 
     // Simple tone mapping and Gamma correction
-    finalColor = finalColor / (finalColor + vec3(1.0));
-    finalColor = pow(finalColor, vec3(1.0 / 2.2));
+    finalColor = finalColor / (finalColor + hvec3(1.0));
+    finalColor = pow(finalColor, hvec3(1.0 / 2.2));
 
     outColor = vec4(finalColor, 1.0);
 }
@@ -0,0 +1,42 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+#include "include/precision.glsl"
+#include "include/bindless.glsl"
+#include "include/render_area.glsl"
+#include "include/kawase.glsl"
+
+layout(location = 0) in vec2 fragTexCoord;
+layout(location = 0) out vec4 outColor;
+
+// Pyramid blur mode binds mip 0 of the blur pyramid as the blur input and runs its last Kawase
+// upsample here rather than in a separate full-resolution pass
+layout(constant_id = 0) const bool PYRAMID_BLUR = false;
+
+void main()
+{
+    vec2 uv = ClampToRenderArea(fragTexCoord * params.uvScale, params.uvScale, params.texelSize);
+    hvec3 motionResult = hvec3(SampleLinear(params.inputTexture, uv).rgb);
+    hvec3 blurResult;
+    if (PYRAMID_BLUR)
+    {
+        // Mip 0 has half the resolution of the render targets
+        blurResult = KawaseUpsample(sampler2D(bindlessTextures[params.blurTexture],
+                                              bindlessSamplers[params.linearSampler]),
+                                    uv, params.uvScale, 2.0 * params.texelSize, 1.0)
+                         .rgb;
+    }
+    else
+    {
+        blurResult = hvec3(SampleLinear(params.blurTexture, uv).rgb);
+    }
+
+    hfloat dofAmount = hfloat(0.3);
+    hvec3 finalColor = mix(motionResult, blurResult, dofAmount);
+
+    // Simple tone mapping and Gamma correction
+    finalColor = finalColor / (finalColor + hvec3(1.0));
+    finalColor = pow(finalColor, hvec3(1.0 / 2.2));
+
+    outColor = vec4(finalColor, 1.0);
+}
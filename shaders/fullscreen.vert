@@ -0,0 +1,12 @@
+#version 450
+
+// Vertex shader of every full-screen pass: one triangle with corners (-1,-1), (3,-1) and (-1,3), drawn
+// without vertex or index buffers (utils::DrawFullscreenTriangle). Clipping reduces it to the viewport,
+// where texture coordinates run from 0 at NDC -1 to 1 at NDC +1.
+layout(location = 0) out vec2 fragTexCoord;
+
+void main()
+{
+    fragTexCoord = vec2((gl_VertexIndex << 1) & 2, gl_VertexIndex & 2);
+    gl_Position = vec4(fragTexCoord * 2.0 - 1.0, 0.0, 1.0);
+}
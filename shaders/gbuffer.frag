@@ -1,4 +1,7 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
+
+#include "include/gbuffer.glsl"
 
 layout(location = 0) in vec3 fragColor;
 layout(location = 1) in vec4 currClipPos;
@@ -7,9 +10,16 @@ layout(location = 2) in vec4 prevClipPos;
 layout(location = 0) out vec4 outColor;
 layout(location = 1) out vec2 outVelocity;
 
+// Static instances in camera velocity mode: the pipeline masks out the velocity target
+layout(constant_id = 0) const bool STATIC_GEOMETRY = false;
+
 void main()
 {
-    outColor = vec4(fragColor, 1.0);
+    if (STATIC_GEOMETRY)
+    {
+        outColor = EncodeGBufferStatic(fragColor);
+        return;
+    }
 
     vec2 currNDC = currClipPos.xy / currClipPos.w;
     vec2 prevNDC = prevClipPos.xy / prevClipPos.w;
@@ -17,5 +27,6 @@ void main()
     vec2 currScreen = currNDC * 0.5 + 0.5;
     vec2 prevScreen = prevNDC * 0.5 + 0.5;
 
-    outVelocity = currScreen - prevScreen;
+    // Every layout marks the pixel as dynamic geometry, whose velocity the motion pass reads from here
+    EncodeGBuffer(fragColor, currScreen - prevScreen, outColor, outVelocity);
 }
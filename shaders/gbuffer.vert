@@ -1,14 +1,61 @@
 #version 450
+// Vertex pulling needs buffer device addresses, so it reads the instances by address as well
+#ifdef VERTEX_PULLING
+#define INSTANCE_ADDRESS
+#endif
 
-layout(set = 0, binding = 0) uniform UniformBufferObject
+#ifdef INSTANCE_ADDRESS
+#extension GL_EXT_buffer_reference : require
+#endif
+#ifdef VERTEX_PULLING
+#extension GL_GOOGLE_include_directive : require
+
+#include "include/packed_vertex.glsl"
+#endif
+
+// Current and previous model-view-projection of every instance (cpu::InstanceMvp), computed on the
+// CPU by the SIMD transform kernels
+struct InstanceMvp
 {
     mat4 currMVP;
     mat4 prevMVP;
-}
-ubo;
+    vec4 boundingSphere;
+};
 
+#ifdef INSTANCE_ADDRESS
+// Instances by address (gbuffer_address.vert, gbuffer_pulling.vert): one frame's slice, which may be
+// larger than maxStorageBufferRange
+layout(buffer_reference, std430, buffer_reference_align = 16) readonly buffer InstanceBuffer
+{
+    InstanceMvp instances[];
+};
+
+// Vertex pulling (gbuffer_pulling.vert): no vertex input, gl_VertexIndex (which includes the draw's
+// vertexOffset) indexes the packed vertices of shaders/vertex_pack.comp
+layout(buffer_reference, std430, buffer_reference_align = 8) readonly buffer PackedVertices
+{
+    uvec2 vertices[];
+};
+
+layout(push_constant) uniform GBufferParams
+{
+    PackedVertices packedVertices;
+    InstanceBuffer instanceBuffer;
+    // Dequantization of the drawn mesh
+    vec4 positionCenter;
+    vec4 positionExtent;
+} params;
+#else
+layout(std430, set = 0, binding = 0) readonly buffer InstanceBuffer
+{
+    InstanceMvp instances[];
+};
+#endif
+
+#ifndef VERTEX_PULLING
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inColor;
+#endif
 
 layout(location = 0) out vec3 fragColor;
 layout(location = 1) out vec4 currClipPos;
@@ -16,8 +63,19 @@ layout(location = 2) out vec4 prevClipPos;
 
 void main()
 {
-    currClipPos = ubo.currMVP * vec4(inPosition, 1.0);
-    prevClipPos = ubo.prevMVP * vec4(inPosition, 1.0);
+#ifdef VERTEX_PULLING
+    uvec2 packedVertex = params.packedVertices.vertices[gl_VertexIndex];
+    vec3 inPosition = UnpackPosition(packedVertex, params.positionCenter.xyz, params.positionExtent.xyz);
+    vec3 inColor = UnpackColor(packedVertex);
+#endif
+
+#ifdef INSTANCE_ADDRESS
+    InstanceMvp instance = params.instanceBuffer.instances[gl_InstanceIndex];
+#else
+    InstanceMvp instance = instances[gl_InstanceIndex];
+#endif
+    currClipPos = instance.currMVP * vec4(inPosition, 1.0);
+    prevClipPos = instance.prevMVP * vec4(inPosition, 1.0);
 
     gl_Position = currClipPos;
     fragColor = inColor;
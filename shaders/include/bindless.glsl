@@ -0,0 +1,35 @@
+// Bindless resource table (see BindlessTable) and the push constants shared by
+// every bindless post-process pass. Resources are addressed by handle.
+
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(set = 0, binding = 0) uniform texture2D bindlessTextures[];
+layout(set = 0, binding = 2) uniform sampler bindlessSamplers[];
+
+layout(push_constant) uniform BindlessPostProcessParams
+{
+    float blurStrength;
+    float motionScale;
+    vec2 texelSize;
+    vec2 uvScale;
+    int kernelRadius;
+    layout(offset = 32) uint inputTexture;
+    uint velocityTexture;
+    uint depthTexture;
+    uint blurTexture;
+    uint linearSampler;
+    uint nearestSampler;
+    // Previous view-projection times inverse current view-projection (motion apply, camera velocity mode)
+    layout(offset = 64) mat4 reprojection;
+}
+params;
+
+vec4 SampleLinear(uint textureHandle, vec2 uv)
+{
+    return texture(sampler2D(bindlessTextures[textureHandle], bindlessSamplers[params.linearSampler]), uv);
+}
+
+vec4 SampleNearest(uint textureHandle, vec2 uv)
+{
+    return texture(sampler2D(bindlessTextures[textureHandle], bindlessSamplers[params.nearestSampler]), uv);
+}
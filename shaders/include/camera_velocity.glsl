@@ -0,0 +1,10 @@
+// Velocity of static geometry from its depth and the camera alone. reprojection maps current NDC
+// (with depth) to the previous frame's clip space; the result uses the screen UV convention of
+// gbuffer.frag (current minus previous position).
+
+vec2 CameraVelocity(vec2 screenUv, float depth, mat4 reprojection)
+{
+    vec4 prevClip = reprojection * vec4(screenUv * 2.0 - 1.0, depth, 1.0);
+    vec2 prevScreen = prevClip.xy / prevClip.w * 0.5 + 0.5;
+    return screenUv - prevScreen;
+}
@@ -0,0 +1,34 @@
+// Motion-compensated frame interpolation (FrameLoopConfig::frameInterpolation), shared by its compute
+// passes. interpolation_motion.comp keeps the velocity and depth of every rendered frame;
+// interpolation_warp.comp builds the frame halfway between the last two rendered ones from their displayed
+// colors and motion, marking texels neither explains as holes; interpolation_fill.comp fills the holes.
+
+layout(local_size_x = 8, local_size_y = 8) in;
+
+layout(set = 0, binding = 0) uniform sampler2D sceneColorTexture;
+layout(set = 0, binding = 1) uniform sampler2D velocityTexture;
+layout(set = 0, binding = 2) uniform sampler2D depthTexture;
+// Displayed (tone-mapped) colors of the previous and the current rendered frame
+layout(set = 0, binding = 3) uniform sampler2D prevColorTexture;
+layout(set = 0, binding = 4) uniform sampler2D currColorTexture;
+// Velocity (xy, screen UV units) and nearness (z, 1 - depth) of the same two frames
+layout(set = 0, binding = 5) uniform sampler2D prevMotionTexture;
+layout(set = 0, binding = 6) uniform sampler2D currMotionTexture;
+layout(set = 0, binding = 7, rgba16f) uniform writeonly image2D motionOutput;
+// Warped frame: color, and nearness in alpha (negative for holes)
+layout(set = 0, binding = 8) uniform sampler2D warpTexture;
+layout(set = 0, binding = 9, rgba16f) uniform writeonly image2D warpOutput;
+layout(set = 0, binding = 10, rgba16f) uniform writeonly image2D interpolatedOutput;
+
+layout(push_constant) uniform FrameInterpolationParams
+{
+    // Previous view-projection times inverse current view-projection
+    mat4 reprojection;
+    vec2 texelSize;
+    vec2 uvScale;
+    // Displayed sub-rect of the display and interpolation targets
+    ivec2 extent;
+    // Rendered sub-rect of the G-buffer, smaller than extent with dynamic resolution
+    ivec2 renderExtent;
+}
+params;
@@ -0,0 +1,112 @@
+// G-buffer layouts (GBufferLayout in motion_blur_example.h), chosen by specialization constant 1 of
+// every shader that includes this. Velocity is in screen UV units (current minus previous position).
+//   SEPARATE: RGBA16F color, alpha 1 on dynamic geometry; RG16F velocity
+//   PACKED:   B10G11R11 color; RG16 snorm velocity scaled by 1 / VELOCITY_RANGE, cleared to
+//             VELOCITY_CLEAR where no dynamic geometry was drawn
+//   FOLDED:   RGBA16 unorm color with a 16-bit log-polar velocity code in alpha, no velocity target;
+//             code 0 (the clear value) marks pixels without dynamic geometry
+// Velocity is decoded from unfiltered texels: neither the scaled nor the folded encoding can be
+// interpolated. Static geometry in camera velocity mode is drawn with the velocity target masked and
+// marked like the background (EncodeGBufferStatic).
+
+#define GBUFFER_SEPARATE 0
+#define GBUFFER_PACKED 1
+#define GBUFFER_FOLDED 2
+
+layout(constant_id = 1) const int GBUFFER_LAYOUT = GBUFFER_SEPARATE;
+
+// Larger velocities are clamped; half the screen per frame is far beyond what the blur resolves
+const float VELOCITY_RANGE = 0.5;
+const float VELOCITY_CLEAR = -1.0;
+const float VELOCITY_LIMIT = 0.999;
+
+// Log-polar code: high byte log2 magnitude (1 = zero, 2..255 spanning VELOCITY_MIN..VELOCITY_RANGE),
+// low byte angle
+const float VELOCITY_MIN = 1.0 / 16384.0;
+const float TWO_PI = 6.28318530718;
+
+float EncodeFoldedVelocity(vec2 velocity)
+{
+    float magnitude = length(velocity);
+    uint magnitudeCode = 1u;
+    if (magnitude >= VELOCITY_MIN)
+    {
+        float t = log2(min(magnitude, VELOCITY_RANGE) / VELOCITY_MIN) / log2(VELOCITY_RANGE / VELOCITY_MIN);
+        magnitudeCode = 2u + uint(round(t * 253.0));
+    }
+    uint angleCode = uint(round((atan(velocity.y, velocity.x) / TWO_PI + 0.5) * 256.0)) & 255u;
+    return float((magnitudeCode << 8) | angleCode) / 65535.0;
+}
+
+vec2 DecodeFoldedVelocity(uint code)
+{
+    uint magnitudeCode = code >> 8;
+    if (magnitudeCode < 2u)
+        return vec2(0.0);
+
+    float magnitude = VELOCITY_MIN * exp2(float(magnitudeCode - 2u) / 253.0 * log2(VELOCITY_RANGE / VELOCITY_MIN));
+    float angle = (float(code & 255u) / 256.0 - 0.5) * TWO_PI;
+    return magnitude * vec2(cos(angle), sin(angle));
+}
+
+// G-buffer pass outputs; velocityOut is discarded by the folded layout, which has no velocity target
+void EncodeGBuffer(vec3 color, vec2 velocity, out vec4 colorOut, out vec2 velocityOut)
+{
+    colorOut = vec4(color, 1.0);
+    velocityOut = velocity;
+    if (GBUFFER_LAYOUT == GBUFFER_PACKED)
+    {
+        velocityOut = clamp(velocity / VELOCITY_RANGE, -VELOCITY_LIMIT, VELOCITY_LIMIT);
+    }
+    else if (GBUFFER_LAYOUT == GBUFFER_FOLDED)
+    {
+        colorOut.a = EncodeFoldedVelocity(velocity);
+    }
+}
+
+// Static geometry: alpha 0 (separate) or code 0 (folded) marks it; the packed layout keeps the cleared
+// velocity under it
+vec4 EncodeGBufferStatic(vec3 color)
+{
+    return vec4(color, 0.0);
+}
+
+// Whether the color texel leaves room for dynamic geometry. The packed layout has no alpha, so its
+// mark is the velocity texel itself.
+bool GBufferMayBeDynamic(vec4 colorTexel)
+{
+    if (GBUFFER_LAYOUT == GBUFFER_PACKED)
+        return true;
+    return colorTexel.a > (GBUFFER_LAYOUT == GBUFFER_FOLDED ? 0.5 / 65535.0 : 0.5);
+}
+
+// Velocity of one pixel from its unfiltered color and velocity texels (the folded layout binds the
+// color target as velocity texture too). Returns whether dynamic geometry wrote it.
+bool DecodeGBufferVelocity(vec4 colorTexel, vec4 velocityTexel, out vec2 velocity)
+{
+    if (GBUFFER_LAYOUT == GBUFFER_PACKED)
+    {
+        bool dynamic = velocityTexel.r > 0.5 * (VELOCITY_CLEAR - VELOCITY_LIMIT);
+        velocity = dynamic ? velocityTexel.rg * VELOCITY_RANGE : vec2(0.0);
+        return dynamic;
+    }
+    if (GBUFFER_LAYOUT == GBUFFER_FOLDED)
+    {
+        uint code = uint(round(colorTexel.a * 65535.0));
+        velocity = DecodeFoldedVelocity(code);
+        return code != 0u;
+    }
+    velocity = velocityTexel.rg;
+    return colorTexel.a > 0.5;
+}
+
+// DecodeGBufferVelocity that fetches the velocity texel only where GBufferMayBeDynamic; the folded
+// layout decodes from the color texel it already has
+bool FetchGBufferVelocity(vec4 colorTexel, sampler2D velocityTexture, ivec2 texel, out vec2 velocity)
+{
+    velocity = vec2(0.0);
+    if (!GBufferMayBeDynamic(colorTexel))
+        return false;
+    vec4 velocityTexel = GBUFFER_LAYOUT == GBUFFER_FOLDED ? colorTexel : texelFetch(velocityTexture, texel, 0);
+    return DecodeGBufferVelocity(colorTexel, velocityTexel, velocity);
+}
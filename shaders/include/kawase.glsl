@@ -0,0 +1,29 @@
+// Dual Kawase filters (Bjorge, "Bandwidth-Efficient Rendering", SIGGRAPH 2015). Each bilinear tap
+// averages a 2x2 texel quad, so a handful of taps per level covers a wide footprint. Tap offsets
+// are in half texels of the lower-resolution level of each pair; uvScale and texelSize describe
+// the source level and taps are clamped to its rendered sub-rect. Needs precision.glsl.
+
+hvec4 KawaseDownsample(sampler2D source, vec2 uv, vec2 uvScale, vec2 texelSize, float offset)
+{
+    vec2 d = texelSize * offset;
+    hvec4 sum = hvec4(texture(source, ClampToRenderArea(uv, uvScale, texelSize))) * hfloat(4.0);
+    sum += hvec4(texture(source, ClampToRenderArea(uv + vec2(-d.x, -d.y), uvScale, texelSize)));
+    sum += hvec4(texture(source, ClampToRenderArea(uv + vec2(d.x, -d.y), uvScale, texelSize)));
+    sum += hvec4(texture(source, ClampToRenderArea(uv + vec2(-d.x, d.y), uvScale, texelSize)));
+    sum += hvec4(texture(source, ClampToRenderArea(uv + vec2(d.x, d.y), uvScale, texelSize)));
+    return sum * hfloat(0.125);
+}
+
+hvec4 KawaseUpsample(sampler2D source, vec2 uv, vec2 uvScale, vec2 texelSize, float offset)
+{
+    vec2 d = 0.5 * texelSize * offset;
+    hvec4 sum = hvec4(texture(source, ClampToRenderArea(uv + vec2(-2.0 * d.x, 0.0), uvScale, texelSize)));
+    sum += hvec4(texture(source, ClampToRenderArea(uv + vec2(2.0 * d.x, 0.0), uvScale, texelSize)));
+    sum += hvec4(texture(source, ClampToRenderArea(uv + vec2(0.0, -2.0 * d.y), uvScale, texelSize)));
+    sum += hvec4(texture(source, ClampToRenderArea(uv + vec2(0.0, 2.0 * d.y), uvScale, texelSize)));
+    sum += hvec4(texture(source, ClampToRenderArea(uv + vec2(-d.x, -d.y), uvScale, texelSize))) * hfloat(2.0);
+    sum += hvec4(texture(source, ClampToRenderArea(uv + vec2(d.x, -d.y), uvScale, texelSize))) * hfloat(2.0);
+    sum += hvec4(texture(source, ClampToRenderArea(uv + vec2(-d.x, d.y), uvScale, texelSize))) * hfloat(2.0);
+    sum += hvec4(texture(source, ClampToRenderArea(uv + vec2(d.x, d.y), uvScale, texelSize))) * hfloat(2.0);
+    return sum / hfloat(12.0);
+}
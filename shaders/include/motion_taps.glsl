@@ -0,0 +1,17 @@
+// Velocity-adaptive tap count of motion apply (MotionBlurSettings::motionTapCap). With a cap, each
+// pixel takes as many taps as its velocity is long in texels, so taps stay at most one texel apart
+// and still pixels cost a single fetch. 0 keeps the fixed 4 taps.
+layout(constant_id = 2) const int MAX_MOTION_TAPS = 0;
+
+// Per-pixel jitter in [0, 1) (Jimenez, "Next Generation Post Processing in Call of Duty: Advanced
+// Warfare"); offsets every tap of a pixel by the same fraction of the tap spacing, which turns the
+// banding of low tap counts into high-frequency noise
+float InterleavedGradientNoise(vec2 pixel)
+{
+    return fract(52.9829189 * fract(dot(pixel, vec2(0.06711056, 0.00583715))));
+}
+
+int MotionTapCount(vec2 velocity, vec2 texelSize)
+{
+    return clamp(int(ceil(length(velocity / texelSize))), 1, MAX_MOTION_TAPS);
+}
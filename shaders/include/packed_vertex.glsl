@@ -0,0 +1,25 @@
+// Quantized vertex of the vertex-pulling path, 8 bytes instead of the 24 of MeshFileVertex:
+//   x: position xy as snorm16 pair
+//   y: position z as snorm16 in the low half, color as RGB565 in the high half
+// Positions are relative to the bounds of their mesh: position = center + snorm * extent, where extent
+// is the half size of the bounds (0 on flat axes).
+
+uvec2 PackVertex(vec3 normalizedPosition, vec3 color)
+{
+    uvec3 rgb = uvec3(round(clamp(color, 0.0, 1.0) * vec3(31.0, 63.0, 31.0)));
+    uint rgb565 = rgb.r | (rgb.g << 5) | (rgb.b << 11);
+    return uvec2(packSnorm2x16(normalizedPosition.xy),
+                 (packSnorm2x16(vec2(normalizedPosition.z, 0.0)) & 0xFFFFu) | (rgb565 << 16));
+}
+
+vec3 UnpackPosition(uvec2 packedVertex, vec3 center, vec3 extent)
+{
+    vec3 normalizedPosition = vec3(unpackSnorm2x16(packedVertex.x), unpackSnorm2x16(packedVertex.y).x);
+    return center + normalizedPosition * extent;
+}
+
+vec3 UnpackColor(uvec2 packedVertex)
+{
+    uvec3 rgb = uvec3(packedVertex.y >> 16, packedVertex.y >> 21, packedVertex.y >> 27) & uvec3(31u, 63u, 31u);
+    return vec3(rgb) / vec3(31.0, 63.0, 31.0);
+}
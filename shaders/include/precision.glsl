@@ -0,0 +1,15 @@
+// Arithmetic precision of the post-process passes. The *_fp16 variants are built with POST_FP16
+// defined and do their color math in half precision (shaderFloat16); texture fetches are converted
+// where they enter that math, and texture coordinates stay fp32. Include before anything else so
+// that the extension directive precedes every declaration.
+
+#ifdef POST_FP16
+#extension GL_EXT_shader_explicit_arithmetic_types_float16 : require
+#define hfloat float16_t
+#define hvec3 f16vec3
+#define hvec4 f16vec4
+#else
+#define hfloat float
+#define hvec3 vec3
+#define hvec4 vec4
+#endif
@@ -0,0 +1,7 @@
+// Render targets are over-allocated and every pass renders into their top-left sub-rect.
+// uvScale maps screen UVs into that sub-rect; taps are clamped so they never read outside it.
+
+vec2 ClampToRenderArea(vec2 uv, vec2 uvScale, vec2 texelSize)
+{
+    return clamp(uv, 0.5 * texelSize, uvScale - 0.5 * texelSize);
+}
@@ -0,0 +1,52 @@
+// Temporal reuse of the blur result (MotionBlurSettings::temporalBlur), shared by its two passes.
+// temporal_reproject.comp reprojects last frame's blur into rtBlurFinal and lists the tiles it could
+// not reuse; temporal_blur.comp runs the separable fragment blur kernel over exactly those tiles.
+
+// Tiles are 16x16 texels, covered by a 16x8 workgroup in two rows of invocations
+#define TEMPORAL_TILE_SIZE 16
+// Columns on each side of a tile that temporal_blur.comp blurs vertically for the horizontal taps;
+// bounds the blur reach (TEMPORAL_MAX_APRON in motion_blur_example.cpp)
+#define TEMPORAL_MAX_APRON 16
+
+layout(local_size_x = 16, local_size_y = 8) in;
+
+layout(set = 0, binding = 0) uniform sampler2D sceneColorTexture;
+layout(set = 0, binding = 1) uniform sampler2D velocityTexture;
+layout(set = 0, binding = 2) uniform sampler2D depthTexture;
+layout(set = 0, binding = 3) uniform sampler2D motionTexture;
+layout(set = 0, binding = 4) uniform sampler2D blurHistoryTexture;
+layout(set = 0, binding = 5) uniform sampler2D depthHistoryTexture;
+// The _packed variants write B10G11R11 targets (see the render target format policy)
+#ifdef TEMPORAL_PACKED_OUTPUT
+layout(set = 0, binding = 6, r11f_g11f_b10f) uniform writeonly image2D blurOutput;
+#else
+layout(set = 0, binding = 6, rgba16f) uniform writeonly image2D blurOutput;
+#endif
+layout(set = 0, binding = 7, r32f) uniform writeonly image2D depthOutput;
+
+// Indirect dispatch of temporal_blur.comp, one workgroup per listed tile (x | y << 16, in tiles)
+layout(set = 0, binding = 8) buffer TileList
+{
+    uint tileCount;
+    uint dispatchY;
+    uint dispatchZ;
+    uint padding;
+    uint tiles[];
+}
+tileList;
+
+layout(push_constant) uniform TemporalBlurParams
+{
+    // Previous view-projection times inverse current view-projection
+    mat4 reprojection;
+    vec2 texelSize;
+    vec2 uvScale;
+    // Rendered sub-rect of the render targets
+    ivec2 extent;
+    float blurStrength;
+    int kernelRadius;
+    int apron;
+    // 0 when the history targets hold nothing usable (first frame, resize)
+    int historyValid;
+}
+params;
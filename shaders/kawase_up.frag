@@ -0,0 +1,28 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+// Upsamples one level of the pyramid blur back into the next larger mip. The last level
+// (mip 0 to full resolution) is fused into final_apply instead.
+
+#include "include/precision.glsl"
+#include "include/render_area.glsl"
+#include "include/kawase.glsl"
+
+layout(location = 0) in vec2 fragTexCoord;
+layout(location = 0) out vec4 outColor;
+
+layout(set = 0, binding = 0) uniform sampler2D sourceTexture;
+
+layout(push_constant) uniform KawaseBlurParams
+{
+    vec2 sourceTexelSize;
+    vec2 sourceUvScale;
+    float offset;
+}
+params;
+
+void main()
+{
+    vec2 uv = fragTexCoord * params.sourceUvScale;
+    outColor = vec4(KawaseUpsample(sourceTexture, uv, params.sourceUvScale, params.sourceTexelSize, params.offset));
+}
@@ -1,4 +1,11 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
+
+#include "include/precision.glsl"
+#include "include/render_area.glsl"
+#include "include/camera_velocity.glsl"
+#include "include/gbuffer.glsl"
+#include "include/motion_taps.glsl"
 
 layout(location = 0) in vec2 fragTexCoord;
 layout(location = 0) out vec4 outColor;
@@ -7,25 +14,61 @@ layout(set = 0, binding = 0) uniform sampler2D inputTexture;
 layout(set = 0, binding = 1) uniform sampler2D velocityTexture;
 layout(set = 0, binding = 2) uniform sampler2D depthTexture;
 
-layout(set = 0, binding = 3) uniform PostProcessParams
+layout(push_constant) uniform PostProcessParams
 {
     float blurStrength;
     float motionScale;
     vec2 texelSize;
+    vec2 uvScale;
+    int kernelRadius;
+    // Previous view-projection times inverse current view-projection (camera velocity mode)
+    layout(offset = 64) mat4 reprojection;
 }
 params;
 
+// Camera velocity mode: only dynamic geometry writes velocity, and the G-buffer layout marks where it
+// did (FetchGBufferVelocity). Every other pixel reconstructs its velocity from depth.
+layout(constant_id = 0) const bool CAMERA_VELOCITY = false;
+
 void main()
 {
-    vec2 velocity = texture(velocityTexture, fragTexCoord).rg * params.motionScale;
+    vec2 uv = fragTexCoord * params.uvScale;
+    ivec2 texel = ivec2(gl_FragCoord.xy);
+    vec2 velocity;
+    bool dynamic = FetchGBufferVelocity(texelFetch(inputTexture, texel, 0), velocityTexture, texel, velocity);
+    if (CAMERA_VELOCITY && !dynamic)
+    {
+        velocity = CameraVelocity(fragTexCoord, texture(depthTexture, uv).r, params.reprojection);
+    }
 
-    // Simple 4-tap motion blur reconstruction
-    vec3 color = vec3(0.0);
+    // Velocity is stored in screen UV units; scale it into the render target sub-rect
+    velocity *= params.motionScale * params.uvScale;
 
-    color += texture(inputTexture, fragTexCoord).rgb;
-    color += texture(inputTexture, fragTexCoord + velocity * 0.25).rgb;
-    color += texture(inputTexture, fragTexCoord + velocity * 0.50).rgb;
-    color += texture(inputTexture, fragTexCoord + velocity * 0.75).rgb;
+    hvec3 color;
+    if (MAX_MOTION_TAPS > 0)
+    {
+        int taps = MotionTapCount(velocity, params.texelSize);
+        float jitter = InterleavedGradientNoise(gl_FragCoord.xy);
+        color = hvec3(0.0);
+        for (int i = 0; i < taps; i++)
+        {
+            vec2 tapUV = ClampToRenderArea(uv + velocity * ((float(i) + jitter) / float(taps)), params.uvScale,
+                                           params.texelSize);
+            color += hvec3(texture(inputTexture, tapUV).rgb);
+        }
+        color *= hfloat(1.0 / float(taps));
+    }
+    else
+    {
+        // Simple 4-tap motion blur reconstruction
+        color = hvec3(texture(inputTexture, uv).rgb);
+        for (int i = 1; i < 4; i++)
+        {
+            vec2 tapUV = ClampToRenderArea(uv + velocity * (float(i) * 0.25), params.uvScale, params.texelSize);
+            color += hvec3(texture(inputTexture, tapUV).rgb);
+        }
+        color *= hfloat(0.25);
+    }
 
-    outColor = vec4(color / 4.0, 1.0);
+    outColor = vec4(color, 1.0);
 }
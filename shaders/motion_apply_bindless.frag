@@ -0,0 +1,64 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+#include "include/precision.glsl"
+#include "include/bindless.glsl"
+#include "include/render_area.glsl"
+#include "include/camera_velocity.glsl"
+#include "include/gbuffer.glsl"
+#include "include/motion_taps.glsl"
+
+layout(location = 0) in vec2 fragTexCoord;
+layout(location = 0) out vec4 outColor;
+
+// Camera velocity mode: only dynamic geometry writes velocity, and the G-buffer layout marks where it
+// did (GBufferMayBeDynamic). Every other pixel reconstructs its velocity from depth.
+layout(constant_id = 0) const bool CAMERA_VELOCITY = false;
+
+void main()
+{
+    vec2 uv = fragTexCoord * params.uvScale;
+    vec2 velocity = vec2(0.0);
+    bool dynamic = false;
+    vec4 sceneColor = SampleNearest(params.inputTexture, uv);
+    if (GBufferMayBeDynamic(sceneColor))
+    {
+        vec4 velocityTexel = GBUFFER_LAYOUT == GBUFFER_FOLDED ? sceneColor : SampleNearest(params.velocityTexture, uv);
+        dynamic = DecodeGBufferVelocity(sceneColor, velocityTexel, velocity);
+    }
+    if (CAMERA_VELOCITY && !dynamic)
+    {
+        velocity = CameraVelocity(fragTexCoord, SampleNearest(params.depthTexture, uv).r, params.reprojection);
+    }
+
+    // Velocity is stored in screen UV units; scale it into the render target sub-rect
+    velocity *= params.motionScale * params.uvScale;
+
+    hvec3 color;
+    if (MAX_MOTION_TAPS > 0)
+    {
+        int taps = MotionTapCount(velocity, params.texelSize);
+        float jitter = InterleavedGradientNoise(gl_FragCoord.xy);
+        color = hvec3(0.0);
+        for (int i = 0; i < taps; i++)
+        {
+            vec2 tapUV = ClampToRenderArea(uv + velocity * ((float(i) + jitter) / float(taps)), params.uvScale,
+                                           params.texelSize);
+            color += hvec3(SampleLinear(params.inputTexture, tapUV).rgb);
+        }
+        color *= hfloat(1.0 / float(taps));
+    }
+    else
+    {
+        // Simple 4-tap motion blur reconstruction
+        color = hvec3(SampleLinear(params.inputTexture, uv).rgb);
+        for (int i = 1; i < 4; i++)
+        {
+            vec2 tapUV = ClampToRenderArea(uv + velocity * (float(i) * 0.25), params.uvScale, params.texelSize);
+            color += hvec3(SampleLinear(params.inputTexture, tapUV).rgb);
+        }
+        color *= hfloat(0.25);
+    }
+
+    outColor = vec4(color, 1.0);
+}
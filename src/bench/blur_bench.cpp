@@ -0,0 +1,554 @@
+// Microbenchmark of separable 9-tap blur strategies on RGBA32F images, the CPU counterpart of the
+// blur_vertical / blur_horizontal pass split:
+//
+//   naive         scalar horizontal pass then scalar vertical pass over the whole image
+//   transpose     row blur, cache-blocked transpose, row blur, transpose back (both passes stream rows)
+//   fused-tileN   vertical and horizontal blur fused per NxN tile while its source rows are cache resident
+//
+// The last two run with every compiled SIMD tier. Reported per strategy and size: ns/pixel, effective
+// bandwidth (one image read plus one written) and speedup versus naive, plus L1D/LLC misses per pixel
+// and IPC from hardware counters when perf_event_open is permitted.
+//
+// --crossover additionally sweeps the blur radius (taps stretched by blurStrength) and times the best
+// fused FIR against the recursive (IIR) Gaussian of the same sigma, reporting where the IIR starts to win.
+//
+// Usage: bench [--sizes 256,512,1024,1080p,1440p,4k,8k] [--min-time S] [--json FILE] [--crossover]
+
+#include "cpu/cpu_post_process.h"
+#include "cpu/iir_blur.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace vkdemo;
+
+namespace
+{
+
+//=============================================================================
+// Options
+//=============================================================================
+
+struct ImageSize
+{
+    std::string name;
+    uint32_t width;
+    uint32_t height;
+};
+
+struct BenchOptions
+{
+    std::vector<ImageSize> sizes;
+    double minTime = 0.25;
+    std::string jsonPath;
+    bool crossover = false;
+};
+
+bool ParseSize(const std::string& token, ImageSize& size)
+{
+    static const ImageSize NAMED_SIZES[] = {
+        {"1080p", 1920, 1080}, {"1440p", 2560, 1440}, {"4k", 3840, 2160}, {"8k", 7680, 4320}};
+    for (const ImageSize& named : NAMED_SIZES)
+    {
+        if (token == named.name)
+        {
+            size = named;
+            return true;
+        }
+    }
+
+    uint32_t width = 0, height = 0;
+    int fields = std::sscanf(token.c_str(), "%ux%u", &width, &height);
+    if (fields < 1 || width == 0)
+        return false;
+    if (fields == 1)
+    {
+        height = width;
+    }
+    size = {token, width, height};
+    return true;
+}
+
+BenchOptions ParseOptions(int argc, char** argv)
+{
+    BenchOptions options;
+    std::string sizeList = "256,512,1024,1080p,1440p,4k,8k";
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--sizes" && hasValue)
+        {
+            sizeList = argv[++i];
+        }
+        else if (arg == "--min-time" && hasValue)
+        {
+            options.minTime = std::atof(argv[++i]);
+        }
+        else if (arg == "--json" && hasValue)
+        {
+            options.jsonPath = argv[++i];
+        }
+        else if (arg == "--crossover")
+        {
+            options.crossover = true;
+        }
+        else
+        {
+            std::fprintf(stderr, "Ignoring unknown option: %s\n", arg.c_str());
+        }
+    }
+
+    std::stringstream stream(sizeList);
+    std::string token;
+    while (std::getline(stream, token, ','))
+    {
+        ImageSize size;
+        if (ParseSize(token, size))
+        {
+            options.sizes.push_back(size);
+        }
+        else
+        {
+            std::fprintf(stderr, "Ignoring invalid size: %s\n", token.c_str());
+        }
+    }
+    return options;
+}
+
+//=============================================================================
+// Blur Strategies
+//=============================================================================
+
+struct BlurBuffers
+{
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<float> source;
+    std::vector<float> destination;
+    std::vector<float> temp0;
+    std::vector<float> temp1;
+};
+
+int32_t Clamp(int32_t value, int32_t last)
+{
+    return std::min(std::max(value, 0), last);
+}
+
+void NaiveBlur(const cpu::BlurKernel& kernel, BlurBuffers& buffers)
+{
+    const int32_t width = static_cast<int32_t>(buffers.width);
+    const int32_t height = static_cast<int32_t>(buffers.height);
+    const float* src = buffers.source.data();
+    float* temp = buffers.temp0.data();
+    float* dst = buffers.destination.data();
+
+    for (int32_t y = 0; y < height; y++)
+    {
+        for (int32_t x = 0; x < width; x++)
+        {
+            for (int32_t c = 0; c < 4; c++)
+            {
+                float sum = 0.0f;
+                for (int32_t t = -kernel.radius; t <= kernel.radius; t++)
+                {
+                    int32_t sx = Clamp(x + t, width - 1);
+                    sum += kernel.weights[t + kernel.radius] * src[(static_cast<size_t>(y) * width + sx) * 4 + c];
+                }
+                temp[(static_cast<size_t>(y) * width + x) * 4 + c] = sum;
+            }
+        }
+    }
+
+    for (int32_t y = 0; y < height; y++)
+    {
+        for (int32_t x = 0; x < width; x++)
+        {
+            for (int32_t c = 0; c < 4; c++)
+            {
+                float sum = 0.0f;
+                for (int32_t t = -kernel.radius; t <= kernel.radius; t++)
+                {
+                    int32_t sy = Clamp(y + t, height - 1);
+                    sum += kernel.weights[t + kernel.radius] * temp[(static_cast<size_t>(sy) * width + x) * 4 + c];
+                }
+                dst[(static_cast<size_t>(y) * width + x) * 4 + c] = sum;
+            }
+        }
+    }
+}
+
+// Horizontal blur of every row through an edge-clamped padded copy
+void BlurRows(const cpu::PostProcessKernels& kernels, const cpu::BlurKernel& kernel, const float* src, float* dst,
+              uint32_t width, uint32_t height, std::vector<float>& padded)
+{
+    const uint32_t radius = static_cast<uint32_t>(kernel.radius);
+    padded.resize(static_cast<size_t>(width + 2 * radius) * 4);
+    for (uint32_t y = 0; y < height; y++)
+    {
+        const float* row = src + static_cast<size_t>(y) * width * 4;
+        for (uint32_t i = 0; i < radius; i++)
+        {
+            std::copy(row, row + 4, padded.data() + i * 4);
+            std::copy(row + (width - 1) * 4, row + width * 4, padded.data() + (radius + width + i) * 4);
+        }
+        std::copy(row, row + static_cast<size_t>(width) * 4, padded.data() + radius * 4);
+        kernels.blurRow(padded.data(), kernel.weights.data(), kernel.GetTapCount(),
+                        dst + static_cast<size_t>(y) * width * 4, width);
+    }
+}
+
+// RGBA pixel transpose in square blocks so both the read and the write side stay within a few cache lines
+void TransposeBlocked(const float* src, float* dst, uint32_t width, uint32_t height)
+{
+    constexpr uint32_t BLOCK = 16;
+    for (uint32_t by = 0; by < height; by += BLOCK)
+    {
+        uint32_t yEnd = std::min(by + BLOCK, height);
+        for (uint32_t bx = 0; bx < width; bx += BLOCK)
+        {
+            uint32_t xEnd = std::min(bx + BLOCK, width);
+            for (uint32_t y = by; y < yEnd; y++)
+            {
+                for (uint32_t x = bx; x < xEnd; x++)
+                {
+                    const float* in = src + (static_cast<size_t>(y) * width + x) * 4;
+                    std::copy(in, in + 4, dst + (static_cast<size_t>(x) * height + y) * 4);
+                }
+            }
+        }
+    }
+}
+
+void TransposeBlur(const cpu::PostProcessKernels& kernels, const cpu::BlurKernel& kernel, BlurBuffers& buffers,
+                   std::vector<float>& padded)
+{
+    const uint32_t width = buffers.width;
+    const uint32_t height = buffers.height;
+    BlurRows(kernels, kernel, buffers.source.data(), buffers.temp0.data(), width, height, padded);
+    TransposeBlocked(buffers.temp0.data(), buffers.temp1.data(), width, height);
+    BlurRows(kernels, kernel, buffers.temp1.data(), buffers.temp0.data(), height, width, padded);
+    TransposeBlocked(buffers.temp0.data(), buffers.destination.data(), height, width);
+}
+
+void FusedTileBlur(const cpu::PostProcessKernels& kernels, const cpu::BlurKernel& kernel, BlurBuffers& buffers,
+                   uint32_t tileSize, std::vector<float>& padded)
+{
+    const uint32_t width = buffers.width;
+    const uint32_t height = buffers.height;
+    const uint32_t radius = static_cast<uint32_t>(kernel.radius);
+    const uint32_t taps = kernel.GetTapCount();
+    const float* src = buffers.source.data();
+    float* dst = buffers.destination.data();
+
+    padded.resize(static_cast<size_t>(tileSize + 2 * radius) * 4);
+    std::vector<const float*> rows(taps);
+
+    for (uint32_t y0 = 0; y0 < height; y0 += tileSize)
+    {
+        uint32_t tileHeight = std::min(tileSize, height - y0);
+        for (uint32_t x0 = 0; x0 < width; x0 += tileSize)
+        {
+            uint32_t tileWidth = std::min(tileSize, width - x0);
+
+            // Halo columns inside the image; the rest is replicated from the edge after the vertical pass
+            uint32_t spanBegin = x0 >= radius ? x0 - radius : 0;
+            uint32_t spanEnd = std::min(x0 + tileWidth + radius, width);
+            uint32_t leftPad = radius - (x0 - spanBegin);
+            uint32_t rightPad = radius - (spanEnd - x0 - tileWidth);
+
+            for (uint32_t row = 0; row < tileHeight; row++)
+            {
+                uint32_t y = y0 + row;
+                for (uint32_t t = 0; t < taps; t++)
+                {
+                    int32_t sy = Clamp(static_cast<int32_t>(y + t) - kernel.radius, static_cast<int32_t>(height) - 1);
+                    rows[t] = src + (static_cast<size_t>(sy) * width + spanBegin) * 4;
+                }
+
+                float* span = padded.data() + leftPad * 4;
+                kernels.blurColumns(rows.data(), kernel.weights.data(), taps, span, (spanEnd - spanBegin) * 4);
+                for (uint32_t i = 0; i < leftPad; i++)
+                {
+                    std::copy(span, span + 4, padded.data() + i * 4);
+                }
+                float* last = span + (spanEnd - spanBegin - 1) * 4;
+                for (uint32_t i = 0; i < rightPad; i++)
+                {
+                    std::copy(last, last + 4, last + (i + 1) * 4);
+                }
+
+                float* out = dst + (static_cast<size_t>(y) * width + x0) * 4;
+                kernels.blurRow(padded.data(), kernel.weights.data(), taps, out, tileWidth);
+            }
+        }
+    }
+}
+
+// Recursive Gaussian: column strips top to bottom and back, then every row in place
+void IirBlur(const cpu::IirGaussianCoefficients& coefficients, BlurBuffers& buffers, std::vector<float>& history)
+{
+    constexpr uint32_t STRIP_WIDTH = 64;
+    for (uint32_t x0 = 0; x0 < buffers.width; x0 += STRIP_WIDTH)
+    {
+        cpu::IirBlurColumns(buffers.source.data(), buffers.destination.data(), buffers.width, buffers.height, x0,
+                            std::min(x0 + STRIP_WIDTH, buffers.width), coefficients, history);
+    }
+    cpu::IirBlurRows(buffers.destination.data(), buffers.destination.data(), buffers.width, 0, buffers.height,
+                     coefficients);
+}
+
+//=============================================================================
+// Measurement
+//=============================================================================
+
+struct BenchResult
+{
+    std::string size;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::string strategy;
+    std::string simd;
+    uint32_t tileSize = 0;
+    double nsPerPixel = 0.0;
+    double gigabytesPerSecond = 0.0;
+    double speedup = 1.0;
+    float maxError = 0.0f;
+    cpu::PerfCounterValues counters;
+};
+
+// Median time of repeated runs, repeating until minTime has elapsed (at least three runs)
+double MeasureSeconds(const std::function<void()>& run, double minTime)
+{
+    run();
+
+    std::vector<double> timings;
+    double total = 0.0;
+    while (timings.size() < 3 || total < minTime)
+    {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        auto end = std::chrono::steady_clock::now();
+        timings.push_back(std::chrono::duration<double>(end - start).count());
+        total += timings.back();
+    }
+
+    std::sort(timings.begin(), timings.end());
+    return timings[timings.size() / 2];
+}
+
+float MaxDifference(const std::vector<float>& a, const std::vector<float>& b)
+{
+    float maxError = 0.0f;
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        maxError = std::max(maxError, std::fabs(a[i] - b[i]));
+    }
+    return maxError;
+}
+
+// JSON number, or null for counters that were not available
+std::string JsonValue(double value, bool valid)
+{
+    if (!valid)
+        return "null";
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.4f", value);
+    return buffer;
+}
+
+void WriteJson(const std::string& path, const std::vector<BenchResult>& results)
+{
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file)
+    {
+        std::fprintf(stderr, "Failed to open %s for writing\n", path.c_str());
+        return;
+    }
+
+    std::fprintf(file, "{\n  \"benchmark\": \"separable_blur\",\n  \"taps\": 9,\n  \"format\": \"RGBA32F\",\n");
+    std::fprintf(file, "  \"cpu_simd\": \"%s\",\n  \"results\": [\n", cpu::GetSimdLevelName(cpu::DetectSimdLevel()));
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const BenchResult& r = results[i];
+        const double pixelCount = static_cast<double>(r.width) * r.height;
+        std::string l1dMisses = JsonValue(r.counters.GetPerPixel(cpu::PerfCounter::L1DMisses, pixelCount),
+                                          r.counters.IsValid(cpu::PerfCounter::L1DMisses));
+        std::string llcMisses = JsonValue(r.counters.GetPerPixel(cpu::PerfCounter::LLCMisses, pixelCount),
+                                          r.counters.IsValid(cpu::PerfCounter::LLCMisses));
+        std::string ipc = JsonValue(r.counters.GetIpc(), r.counters.GetIpc() > 0.0);
+        std::fprintf(file,
+                     "    {\"size\": \"%s\", \"width\": %u, \"height\": %u, \"strategy\": \"%s\", \"simd\": \"%s\", "
+                     "\"tile\": %u, \"ns_per_pixel\": %.4f, \"gb_per_s\": %.3f, \"speedup\": %.3f, "
+                     "\"l1d_misses_per_pixel\": %s, \"llc_misses_per_pixel\": %s, \"ipc\": %s, "
+                     "\"max_error\": %g}%s\n",
+                     r.size.c_str(), r.width, r.height, r.strategy.c_str(), r.simd.c_str(), r.tileSize, r.nsPerPixel,
+                     r.gigabytesPerSecond, r.speedup, l1dMisses.c_str(), llcMisses.c_str(), ipc.c_str(), r.maxError,
+                     i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+    std::fclose(file);
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    BenchOptions options = ParseOptions(argc, argv);
+
+    const cpu::BlurKernel kernel = cpu::BuildBlurKernel(cpu::CpuPostProcessParams{});
+    const uint32_t tileSizes[] = {16, 32, 64, 128, 256};
+
+    std::vector<const cpu::PostProcessKernels*> tiers;
+    for (cpu::SimdLevel level : {cpu::SimdLevel::Scalar, cpu::SimdLevel::SSE2, cpu::SimdLevel::AVX2})
+    {
+        if (level <= cpu::DetectSimdLevel() && cpu::GetPostProcessKernels(level).level == level)
+        {
+            tiers.push_back(&cpu::GetPostProcessKernels(level));
+        }
+    }
+    const cpu::PostProcessKernels& bestTier = *tiers.back();
+
+    std::printf("Separable %u-tap blur, RGBA32F, best SIMD tier %s\n", kernel.GetTapCount(),
+                cpu::GetSimdLevelName(bestTier.level));
+
+    cpu::PerfCounterGroup perfCounters;
+    if (!perfCounters.IsAvailable())
+    {
+        std::printf("Hardware counters disabled: %s\n", perfCounters.GetUnavailableReason().c_str());
+    }
+
+    std::vector<BenchResult> results;
+    std::vector<float> padded;
+    for (const ImageSize& size : options.sizes)
+    {
+        BlurBuffers buffers;
+        buffers.width = size.width;
+        buffers.height = size.height;
+        const size_t floatCount = static_cast<size_t>(size.width) * size.height * 4;
+        buffers.source.resize(floatCount);
+        buffers.destination.resize(floatCount);
+        buffers.temp0.resize(floatCount);
+        buffers.temp1.resize(floatCount);
+
+        uint32_t state = 0x9e3779b9u;
+        for (float& value : buffers.source)
+        {
+            state = state * 1664525u + 1013904223u;
+            value = static_cast<float>(state >> 8) / 16777216.0f;
+        }
+
+        const double pixelCount = static_cast<double>(size.width) * size.height;
+        const double bytesMoved = pixelCount * 16.0 * 2.0;
+        double naiveSeconds = 0.0;
+        std::vector<float> reference;
+
+        auto record = [&](const std::string& strategy, const cpu::PostProcessKernels* tier, uint32_t tileSize,
+                          const std::function<void()>& run)
+        {
+            double seconds = MeasureSeconds(run, options.minTime);
+            if (reference.empty())
+            {
+                naiveSeconds = seconds;
+                reference = buffers.destination;
+            }
+
+            BenchResult result;
+            result.size = size.name;
+            result.width = size.width;
+            result.height = size.height;
+            result.strategy = strategy;
+            result.simd = tier ? cpu::GetSimdLevelName(tier->level) : "Scalar";
+            result.tileSize = tileSize;
+            result.nsPerPixel = seconds * 1e9 / pixelCount;
+            result.gigabytesPerSecond = bytesMoved / seconds / 1e9;
+            result.speedup = naiveSeconds / seconds;
+            result.maxError = MaxDifference(reference, buffers.destination);
+
+            // Separate counted run so counter setup never lands in the timings
+            if (perfCounters.IsAvailable())
+            {
+                cpu::ScopedPerfCounters scope(&perfCounters, result.counters);
+                run();
+            }
+            results.push_back(result);
+
+            std::printf("  %-16s %-7s %10.3f ns/px %8.2f GB/s %7.2fx", strategy.c_str(), result.simd.c_str(),
+                        result.nsPerPixel, result.gigabytesPerSecond, result.speedup);
+            if (perfCounters.IsAvailable())
+            {
+                std::printf(" %7.3f L1D/px %7.3f LLC/px %5.2f IPC",
+                            result.counters.GetPerPixel(cpu::PerfCounter::L1DMisses, pixelCount),
+                            result.counters.GetPerPixel(cpu::PerfCounter::LLCMisses, pixelCount),
+                            result.counters.GetIpc());
+            }
+            std::printf("%s\n", result.maxError > 1e-4f ? "  MISMATCH" : "");
+        };
+
+        std::printf("%s (%ux%u)\n", size.name.c_str(), size.width, size.height);
+        record("naive", nullptr, 0, [&] { NaiveBlur(kernel, buffers); });
+        for (const cpu::PostProcessKernels* tier : tiers)
+        {
+            record("transpose", tier, 0, [&] { TransposeBlur(*tier, kernel, buffers, padded); });
+        }
+        for (uint32_t tileSize : tileSizes)
+        {
+            std::string name = "fused-tile" + std::to_string(tileSize);
+            record(name, &bestTier, tileSize, [&] { FusedTileBlur(bestTier, kernel, buffers, tileSize, padded); });
+        }
+        for (const cpu::PostProcessKernels* tier : tiers)
+        {
+            if (tier != &bestTier)
+            {
+                record("fused-tile64", tier, 64, [&] { FusedTileBlur(*tier, kernel, buffers, 64, padded); });
+            }
+        }
+
+        if (options.crossover)
+        {
+            std::printf("  %-8s %7s %14s %14s\n", "radius", "sigma", "fir ns/px", "iir ns/px");
+            float crossover = 0.0f;
+            std::vector<float> history;
+            for (float radius : {2.0f, 4.0f, 6.0f, 8.0f, 12.0f, 16.0f, 24.0f, 32.0f, 48.0f, 64.0f})
+            {
+                cpu::CpuPostProcessParams params;
+                params.blurStrength = radius / static_cast<float>(params.kernelRadius);
+                const cpu::BlurKernel stretched = cpu::BuildBlurKernel(params);
+                const float sigma = cpu::GetBlurKernelSigma(stretched);
+                const cpu::IirGaussianCoefficients coefficients = cpu::ComputeIirGaussianCoefficients(sigma);
+
+                double firSeconds = MeasureSeconds(
+                    [&] { FusedTileBlur(bestTier, stretched, buffers, 64, padded); }, options.minTime);
+                double iirSeconds = MeasureSeconds([&] { IirBlur(coefficients, buffers, history); }, options.minTime);
+                std::printf("  %-8.0f %7.2f %14.3f %14.3f%s\n", radius, sigma, firSeconds * 1e9 / pixelCount,
+                            iirSeconds * 1e9 / pixelCount, iirSeconds < firSeconds ? "  iir" : "");
+                if (iirSeconds >= firSeconds)
+                {
+                    crossover = 0.0f;
+                }
+                else if (crossover == 0.0f)
+                {
+                    crossover = radius;
+                }
+            }
+            if (crossover > 0.0f)
+                std::printf("  IIR faster from radius %.0f\n", crossover);
+            else
+                std::printf("  IIR not faster at any swept radius\n");
+        }
+    }
+
+    if (!options.jsonPath.empty())
+    {
+        WriteJson(options.jsonPath, results);
+        std::printf("Wrote %s\n", options.jsonPath.c_str());
+    }
+    return EXIT_SUCCESS;
+}
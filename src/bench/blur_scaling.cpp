@@ -0,0 +1,150 @@
+// Strong-scaling curve of the tiled CPU post-process chain on the job system: the same frame is
+// processed with 1..N workers and the median time, throughput, speedup and parallel efficiency
+// are printed per worker count.
+//
+// Usage: BlurScaling [--size WxH] [--tile N | --autotune] [--max-workers N] [--iterations N] [--pin]
+//
+// --autotune takes each worker count's tile size from the tile profile, tuning it on first use.
+
+#include "core/job_system.h"
+#include "cpu/cpu_post_process.h"
+#include "cpu/tile_tuner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace vkdemo;
+
+namespace
+{
+
+struct ScalingOptions
+{
+    uint32_t width = 1920;
+    uint32_t height = 1080;
+    uint32_t tileSize = cpu::CpuPostProcessor::DEFAULT_TILE_SIZE;
+    uint32_t maxWorkers = 0;
+    uint32_t iterations = 15;
+    bool pinThreads = false;
+    bool autotune = false;
+};
+
+ScalingOptions ParseOptions(int argc, char** argv)
+{
+    ScalingOptions options;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--size" && hasValue)
+        {
+            std::sscanf(argv[++i], "%ux%u", &options.width, &options.height);
+        }
+        else if (arg == "--tile" && hasValue)
+        {
+            options.tileSize = static_cast<uint32_t>(std::atoi(argv[++i]));
+        }
+        else if (arg == "--max-workers" && hasValue)
+        {
+            options.maxWorkers = static_cast<uint32_t>(std::atoi(argv[++i]));
+        }
+        else if (arg == "--iterations" && hasValue)
+        {
+            options.iterations = static_cast<uint32_t>(std::atoi(argv[++i]));
+        }
+        else if (arg == "--pin")
+        {
+            options.pinThreads = true;
+        }
+        else if (arg == "--autotune")
+        {
+            options.autotune = true;
+        }
+        else
+        {
+            std::fprintf(stderr, "Ignoring unknown option: %s\n", arg.c_str());
+        }
+    }
+
+    if (options.maxWorkers == 0)
+    {
+        options.maxWorkers = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    options.width = std::max(options.width, 1u);
+    options.height = std::max(options.height, 1u);
+    options.iterations = std::max(options.iterations, 1u);
+    return options;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    ScalingOptions options = ParseOptions(argc, argv);
+
+    cpu::Image sceneColor = cpu::Image::Create(options.width, options.height, cpu::PixelFormat::RGBA16F);
+    cpu::Image velocity = cpu::Image::Create(options.width, options.height, cpu::PixelFormat::RG16F);
+    cpu::Image output = cpu::Image::Create(options.width, options.height, cpu::PixelFormat::RGBA16F);
+    cpu::FillSyntheticFrame(sceneColor, velocity);
+
+    cpu::CpuPostProcessParams params;
+    cpu::CpuPostProcessor processor;
+    processor.SetTileSize(options.tileSize, options.tileSize);
+
+    const double pixelCount = static_cast<double>(options.width) * options.height;
+    std::printf("Tiled post-process scaling: %ux%u, %s kernels, %u hardware threads%s\n", options.width,
+                options.height, cpu::GetSimdLevelName(processor.GetSimdLevel()), std::thread::hardware_concurrency(),
+                options.pinThreads ? ", pinned" : "");
+    std::printf("%8s %9s %12s %12s %10s %11s\n", "workers", "tile", "median ms", "Mpixel/s", "speedup",
+                "efficiency");
+
+    double baselineMs = 0.0;
+    for (uint32_t workerCount = 1; workerCount <= options.maxWorkers; workerCount++)
+    {
+        JobSystemConfig config;
+        config.workerCount = workerCount;
+        config.pinThreads = options.pinThreads;
+
+        JobSystem jobs;
+        jobs.Initialize(config);
+
+        if (options.autotune)
+        {
+            cpu::LoadOrTuneCpuTileSize(cpu::TileProfile::DEFAULT_PATH, processor, &jobs, options.width,
+                                       options.height);
+        }
+
+        // Warm-up run sizes the per-worker scratch buffers
+        processor.Run(jobs, sceneColor, velocity, params, output);
+
+        std::vector<double> timings;
+        for (uint32_t i = 0; i < options.iterations; i++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            processor.Run(jobs, sceneColor, velocity, params, output);
+            auto end = std::chrono::steady_clock::now();
+            timings.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        jobs.Cleanup();
+
+        std::sort(timings.begin(), timings.end());
+        double medianMs = timings[timings.size() / 2];
+        if (workerCount == 1)
+        {
+            baselineMs = medianMs;
+        }
+
+        double speedup = baselineMs / medianMs;
+        std::string tile = std::to_string(processor.GetTileWidth()) + "x" + std::to_string(processor.GetTileHeight());
+        std::printf("%8u %9s %12.3f %12.1f %9.2fx %10.0f%%\n", workerCount, tile.c_str(), medianMs,
+                    pixelCount / (medianMs * 1000.0), speedup, 100.0 * speedup / workerCount);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,911 @@
+// Offline trace-driven cache model of the GPU post-process passes. For a given resolution, workgroup
+// size and dispatch order it generates the texel address stream each pass issues and replays it
+// through per-SM set-associative L1 caches backed by a shared L2, then reports hit rates and DRAM
+// traffic per pass. Software Vulkan exposes no GPU cache counters, so this is how blocking strategies
+// are compared before they are written in GLSL:
+//
+//   separate      motion_apply, blur_vertical, blur_horizontal, final_apply (the current chain)
+//   fused-blur    motion_apply, both blur directions in one pass with the halo in shared memory, final_apply
+//   fused-chain   every pass in one dispatch; only scene color and velocity are read from memory
+//
+// Usage: GpuCacheSim [--size WxH] [--workgroup WxH] [--order row|column|morton|supertile] [--supertile N]
+//                    [--sm-count N] [--line BYTES] [--l1 KB,WAYS] [--l2 KB,WAYS] [--texture-tile WxH]
+//                    [--radius N] [--blur-strength F] [--motion-scale F]
+//
+// Model: textures are block-linear (texture-tile texels per block, 0x0 = linear rows). Workgroups are
+// dealt round-robin to SMs in dispatch order and the threads of a workgroup issue each tap in lockstep.
+// Reads allocate in L1 and L2 with LRU replacement; render target writes bypass L1 and allocate in L2
+// without a fill. Each pass ends with a barrier that invalidates L1 and writes dirty L2 lines back.
+
+#include "cpu/image.h"
+#include "cpu/tile_tuner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace vkdemo;
+
+namespace
+{
+
+//=============================================================================
+// Options
+//=============================================================================
+
+enum class DispatchOrder
+{
+    RowMajor,
+    ColumnMajor,
+    Morton,
+    Supertile
+};
+
+struct SimOptions
+{
+    uint32_t width = 1920;
+    uint32_t height = 1080;
+    uint32_t groupWidth = 8;
+    uint32_t groupHeight = 8;
+    DispatchOrder order = DispatchOrder::RowMajor;
+    uint32_t supertile = 8;
+    uint32_t smCount = 8;
+    uint32_t lineSize = 64;
+    uint32_t l1SizeKb = 16;
+    uint32_t l1Ways = 4;
+    uint32_t l2SizeKb = 2048;
+    uint32_t l2Ways = 16;
+    uint32_t textureTileWidth = 8;
+    uint32_t textureTileHeight = 8;
+    uint32_t radius = 4;
+    float blurStrength = 1.0f;
+    float motionScale = 1.0f;
+};
+
+const char* GetDispatchOrderName(DispatchOrder order)
+{
+    switch (order)
+    {
+    case DispatchOrder::RowMajor: return "row";
+    case DispatchOrder::ColumnMajor: return "column";
+    case DispatchOrder::Morton: return "morton";
+    case DispatchOrder::Supertile: return "supertile";
+    }
+    return "unknown";
+}
+
+SimOptions ParseOptions(int argc, char** argv)
+{
+    SimOptions options;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--size" && hasValue)
+        {
+            std::sscanf(argv[++i], "%ux%u", &options.width, &options.height);
+        }
+        else if (arg == "--workgroup" && hasValue)
+        {
+            std::sscanf(argv[++i], "%ux%u", &options.groupWidth, &options.groupHeight);
+        }
+        else if (arg == "--order" && hasValue)
+        {
+            std::string order = argv[++i];
+            if (order == "row")
+                options.order = DispatchOrder::RowMajor;
+            else if (order == "column")
+                options.order = DispatchOrder::ColumnMajor;
+            else if (order == "morton")
+                options.order = DispatchOrder::Morton;
+            else if (order == "supertile")
+                options.order = DispatchOrder::Supertile;
+            else
+                std::fprintf(stderr, "Ignoring unknown dispatch order: %s\n", order.c_str());
+        }
+        else if (arg == "--supertile" && hasValue)
+        {
+            options.supertile = static_cast<uint32_t>(std::atoi(argv[++i]));
+        }
+        else if (arg == "--sm-count" && hasValue)
+        {
+            options.smCount = static_cast<uint32_t>(std::atoi(argv[++i]));
+        }
+        else if (arg == "--line" && hasValue)
+        {
+            options.lineSize = static_cast<uint32_t>(std::atoi(argv[++i]));
+        }
+        else if (arg == "--l1" && hasValue)
+        {
+            std::sscanf(argv[++i], "%u,%u", &options.l1SizeKb, &options.l1Ways);
+        }
+        else if (arg == "--l2" && hasValue)
+        {
+            std::sscanf(argv[++i], "%u,%u", &options.l2SizeKb, &options.l2Ways);
+        }
+        else if (arg == "--texture-tile" && hasValue)
+        {
+            std::sscanf(argv[++i], "%ux%u", &options.textureTileWidth, &options.textureTileHeight);
+        }
+        else if (arg == "--radius" && hasValue)
+        {
+            options.radius = static_cast<uint32_t>(std::atoi(argv[++i]));
+        }
+        else if (arg == "--blur-strength" && hasValue)
+        {
+            options.blurStrength = static_cast<float>(std::atof(argv[++i]));
+        }
+        else if (arg == "--motion-scale" && hasValue)
+        {
+            options.motionScale = static_cast<float>(std::atof(argv[++i]));
+        }
+        else
+        {
+            std::fprintf(stderr, "Ignoring unknown option: %s\n", arg.c_str());
+        }
+    }
+
+    options.width = std::max(options.width, 1u);
+    options.height = std::max(options.height, 1u);
+    options.groupWidth = std::max(options.groupWidth, 1u);
+    options.groupHeight = std::max(options.groupHeight, 1u);
+    options.supertile = std::max(options.supertile, 1u);
+    options.smCount = std::max(options.smCount, 1u);
+    options.lineSize = std::max(options.lineSize, 4u);
+    options.l1Ways = std::max(options.l1Ways, 1u);
+    options.l2Ways = std::max(options.l2Ways, 1u);
+    if (options.textureTileWidth == 0 || options.textureTileHeight == 0)
+    {
+        options.textureTileWidth = 0;
+        options.textureTileHeight = 0;
+    }
+    return options;
+}
+
+//=============================================================================
+// Cache Model
+//=============================================================================
+
+// Set-associative cache of line addresses with LRU replacement
+class SetAssociativeCache
+{
+public:
+    void Initialize(uint32_t sizeBytes, uint32_t ways, uint32_t lineSize)
+    {
+        this->ways = ways;
+        setCount = std::max(sizeBytes / (ways * lineSize), 1u);
+        lines.assign(static_cast<size_t>(setCount) * ways, Line{});
+        clock = 0;
+    }
+
+    // Returns true on a hit. A miss allocates the line, evicting the least recently used way;
+    // evictedDirty reports whether that way held modified data.
+    bool Access(uint64_t lineAddress, bool write, bool& evictedDirty)
+    {
+        evictedDirty = false;
+        Line* set = &lines[(lineAddress % setCount) * ways];
+        Line* victim = set;
+        for (uint32_t way = 0; way < ways; way++)
+        {
+            Line& line = set[way];
+            if (line.address == lineAddress)
+            {
+                line.lastUse = ++clock;
+                line.dirty = line.dirty || write;
+                return true;
+            }
+            if (line.lastUse < victim->lastUse)
+            {
+                victim = &line;
+            }
+        }
+
+        evictedDirty = victim->dirty;
+        victim->address = lineAddress;
+        victim->lastUse = ++clock;
+        victim->dirty = write;
+        return false;
+    }
+
+    // Cleans every dirty line and returns how many there were
+    uint64_t WriteBack()
+    {
+        uint64_t count = 0;
+        for (Line& line : lines)
+        {
+            count += line.dirty ? 1 : 0;
+            line.dirty = false;
+        }
+        return count;
+    }
+
+    void Invalidate() { std::fill(lines.begin(), lines.end(), Line{}); }
+
+private:
+    struct Line
+    {
+        uint64_t address = ~0ull;
+        uint64_t lastUse = 0;
+        bool dirty = false;
+    };
+
+    std::vector<Line> lines;
+    uint32_t setCount = 1;
+    uint32_t ways = 1;
+    uint64_t clock = 0;
+};
+
+struct TrafficStats
+{
+    uint64_t l1Accesses = 0;
+    uint64_t l1Hits = 0;
+    uint64_t l2Accesses = 0;
+    uint64_t l2Hits = 0;
+    uint64_t dramReadBytes = 0;
+    uint64_t dramWriteBytes = 0;
+};
+
+// Per-SM L1 caches in front of one shared L2 and DRAM
+class MemorySystem
+{
+public:
+    explicit MemorySystem(const SimOptions& options) : lineSize(options.lineSize)
+    {
+        l1.resize(options.smCount);
+        for (SetAssociativeCache& cache : l1)
+        {
+            cache.Initialize(options.l1SizeKb * 1024, options.l1Ways, lineSize);
+        }
+        l2.Initialize(options.l2SizeKb * 1024, options.l2Ways, lineSize);
+    }
+
+    uint32_t GetLineSize() const { return lineSize; }
+    const TrafficStats& GetStats() const { return stats; }
+
+    void Read(uint32_t sm, uint64_t lineAddress)
+    {
+        bool evictedDirty = false;
+        stats.l1Accesses++;
+        if (l1[sm].Access(lineAddress, false, evictedDirty))
+        {
+            stats.l1Hits++;
+            return;
+        }
+        AccessL2(lineAddress, false);
+    }
+
+    // Render target writes go straight to L2 and cover whole lines, so a miss needs no fill
+    void Write(uint64_t lineAddress) { AccessL2(lineAddress, true); }
+
+    // Pipeline barrier between passes: L1 is not coherent with L2 writes, and outputs reach memory
+    void EndPass()
+    {
+        for (SetAssociativeCache& cache : l1)
+        {
+            cache.Invalidate();
+        }
+        stats.dramWriteBytes += l2.WriteBack() * lineSize;
+    }
+
+private:
+    void AccessL2(uint64_t lineAddress, bool write)
+    {
+        bool evictedDirty = false;
+        stats.l2Accesses++;
+        if (l2.Access(lineAddress, write, evictedDirty))
+        {
+            stats.l2Hits++;
+        }
+        else if (!write)
+        {
+            stats.dramReadBytes += lineSize;
+        }
+        if (evictedDirty)
+        {
+            stats.dramWriteBytes += lineSize;
+        }
+    }
+
+    uint32_t lineSize;
+    std::vector<SetAssociativeCache> l1;
+    SetAssociativeCache l2;
+    TrafficStats stats;
+};
+
+//=============================================================================
+// Textures and Sampling
+//=============================================================================
+
+// A render target placed in the simulated address space
+struct SimTexture
+{
+    uint64_t baseAddress = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t texelSize = 0;
+    // Block-linear layout; 0 means linear rows
+    uint32_t tileWidth = 0;
+    uint32_t tileHeight = 0;
+
+    uint64_t GetSize() const { return static_cast<uint64_t>(GetPaddedWidth()) * GetPaddedHeight() * texelSize; }
+
+    uint32_t GetPaddedWidth() const { return tileWidth ? (width + tileWidth - 1) / tileWidth * tileWidth : width; }
+    uint32_t GetPaddedHeight() const
+    {
+        return tileHeight ? (height + tileHeight - 1) / tileHeight * tileHeight : height;
+    }
+
+    // Byte address of a texel; coordinates clamp to the edge like the render-area clamp in the shaders
+    uint64_t GetAddress(int32_t x, int32_t y) const
+    {
+        uint64_t cx = static_cast<uint64_t>(std::clamp(x, 0, static_cast<int32_t>(width) - 1));
+        uint64_t cy = static_cast<uint64_t>(std::clamp(y, 0, static_cast<int32_t>(height) - 1));
+        if (tileWidth == 0)
+        {
+            return baseAddress + (cy * width + cx) * texelSize;
+        }
+
+        uint64_t tilesPerRow = GetPaddedWidth() / tileWidth;
+        uint64_t tileIndex = (cy / tileHeight) * tilesPerRow + cx / tileWidth;
+        uint64_t texelInTile = (cy % tileHeight) * tileWidth + cx % tileWidth;
+        return baseAddress + (tileIndex * tileWidth * tileHeight + texelInTile) * texelSize;
+    }
+};
+
+// Texel accesses of one workgroup-wide instruction, deduplicated per line the way a texture unit
+// coalesces the requests of a wave
+class FetchBatch
+{
+public:
+    void Add(const SimTexture& texture, int32_t x, int32_t y, uint32_t lineSize)
+    {
+        lines.push_back(texture.GetAddress(x, y) / lineSize);
+    }
+
+    // Bilinear footprint of a UV coordinate: one to four texels
+    void AddSample(const SimTexture& texture, float u, float v, uint32_t lineSize)
+    {
+        float tx = u * texture.width - 0.5f;
+        float ty = v * texture.height - 0.5f;
+        float x0 = std::floor(tx);
+        float y0 = std::floor(ty);
+        int32_t ix = static_cast<int32_t>(x0);
+        int32_t iy = static_cast<int32_t>(y0);
+        bool blendX = tx - x0 > 1.0f / 256.0f;
+        bool blendY = ty - y0 > 1.0f / 256.0f;
+
+        Add(texture, ix, iy, lineSize);
+        if (blendX)
+            Add(texture, ix + 1, iy, lineSize);
+        if (blendY)
+            Add(texture, ix, iy + 1, lineSize);
+        if (blendX && blendY)
+            Add(texture, ix + 1, iy + 1, lineSize);
+    }
+
+    void Issue(MemorySystem& memory, uint32_t sm, bool write)
+    {
+        std::sort(lines.begin(), lines.end());
+        lines.erase(std::unique(lines.begin(), lines.end()), lines.end());
+        for (uint64_t line : lines)
+        {
+            if (write)
+                memory.Write(line);
+            else
+                memory.Read(sm, line);
+        }
+        lines.clear();
+    }
+
+private:
+    std::vector<uint64_t> lines;
+};
+
+//=============================================================================
+// Passes
+//=============================================================================
+
+struct SimFrame
+{
+    SimTexture sceneColor;
+    SimTexture velocity;
+    SimTexture motion;
+    SimTexture blurIntermediate;
+    SimTexture blurFinal;
+    SimTexture swapchain;
+    // Velocity values steer the motion taps, so the trace is data dependent
+    cpu::Image velocityData;
+};
+
+struct WorkgroupRect
+{
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+    uint32_t height;
+};
+
+// One dispatch (or full-screen draw). A pass issues the accesses of one workgroup at a time.
+class SimPass
+{
+public:
+    virtual ~SimPass() = default;
+    virtual const char* GetName() const = 0;
+    virtual void RunWorkgroup(MemorySystem& memory, uint32_t sm, const WorkgroupRect& rect) = 0;
+    // Shared memory a compute implementation needs per workgroup (0 for fragment passes)
+    virtual uint32_t GetSharedMemoryBytes(const WorkgroupRect& rect) const
+    {
+        (void)rect;
+        return 0;
+    }
+};
+
+// Per-pixel pass: every thread issues the same tap in lockstep, then writes its output texel
+class PixelPass : public SimPass
+{
+public:
+    PixelPass(const char* name, const SimTexture& output) : name(name), output(output) {}
+
+    const char* GetName() const override { return name; }
+
+    void RunWorkgroup(MemorySystem& memory, uint32_t sm, const WorkgroupRect& rect) override
+    {
+        const uint32_t lineSize = memory.GetLineSize();
+        for (uint32_t tap = 0; tap < GetTapCount(); tap++)
+        {
+            for (uint32_t y = rect.y; y < rect.y + rect.height; y++)
+            {
+                for (uint32_t x = rect.x; x < rect.x + rect.width; x++)
+                {
+                    AddTap(batch, x, y, tap, lineSize);
+                }
+            }
+            batch.Issue(memory, sm, false);
+        }
+
+        for (uint32_t y = rect.y; y < rect.y + rect.height; y++)
+        {
+            for (uint32_t x = rect.x; x < rect.x + rect.width; x++)
+            {
+                batch.Add(output, static_cast<int32_t>(x), static_cast<int32_t>(y), lineSize);
+            }
+        }
+        batch.Issue(memory, sm, true);
+    }
+
+protected:
+    virtual uint32_t GetTapCount() const = 0;
+    virtual void AddTap(FetchBatch& batch, uint32_t x, uint32_t y, uint32_t tap, uint32_t lineSize) const = 0;
+
+    static float ToU(const SimTexture& texture, float x) { return (x + 0.5f) / texture.width; }
+    static float ToV(const SimTexture& texture, float y) { return (y + 0.5f) / texture.height; }
+
+private:
+    const char* name;
+    const SimTexture& output;
+    FetchBatch batch;
+};
+
+constexpr uint32_t MOTION_TAP_COUNT = 4;
+
+// Motion tap offset along the velocity, in texels, matching motion_apply.frag
+void GetMotionOffset(const SimFrame& frame, float motionScale, uint32_t x, uint32_t y, float& dx, float& dy)
+{
+    const float* velocity =
+        reinterpret_cast<const float*>(frame.velocityData.GetRow(y)) + static_cast<size_t>(x) * 2;
+    dx = velocity[0] * motionScale * frame.sceneColor.width;
+    dy = velocity[1] * motionScale * frame.sceneColor.height;
+}
+
+// motion_apply: velocity, then the center and three taps along the velocity
+class MotionApplyPass : public PixelPass
+{
+public:
+    MotionApplyPass(const SimFrame& frame, float motionScale)
+        : PixelPass("motion_apply", frame.motion), frame(frame), motionScale(motionScale)
+    {
+    }
+
+protected:
+    uint32_t GetTapCount() const override { return 1 + MOTION_TAP_COUNT; }
+
+    void AddTap(FetchBatch& batch, uint32_t x, uint32_t y, uint32_t tap, uint32_t lineSize) const override
+    {
+        if (tap == 0)
+        {
+            batch.Add(frame.velocity, static_cast<int32_t>(x), static_cast<int32_t>(y), lineSize);
+            return;
+        }
+
+        float dx = 0.0f;
+        float dy = 0.0f;
+        GetMotionOffset(frame, motionScale, x, y, dx, dy);
+        float step = static_cast<float>(tap - 1) / MOTION_TAP_COUNT;
+        batch.AddSample(frame.sceneColor, ToU(frame.sceneColor, x + dx * step),
+                        ToV(frame.sceneColor, y + dy * step), lineSize);
+    }
+
+private:
+    const SimFrame& frame;
+    float motionScale;
+};
+
+// blur_vertical / blur_horizontal: center plus radius taps on either side
+class BlurPass : public PixelPass
+{
+public:
+    BlurPass(const char* name, const SimTexture& input, const SimTexture& output, bool vertical, uint32_t radius,
+             float blurStrength)
+        : PixelPass(name, output), input(input), vertical(vertical), radius(radius), blurStrength(blurStrength)
+    {
+    }
+
+protected:
+    uint32_t GetTapCount() const override { return 1 + 2 * radius; }
+
+    void AddTap(FetchBatch& batch, uint32_t x, uint32_t y, uint32_t tap, uint32_t lineSize) const override
+    {
+        float offset = 0.0f;
+        if (tap > 0)
+        {
+            float distance = static_cast<float>((tap + 1) / 2) * blurStrength;
+            offset = (tap & 1) ? distance : -distance;
+        }
+        float sx = vertical ? x : x + offset;
+        float sy = vertical ? y + offset : y;
+        batch.AddSample(input, ToU(input, sx), ToV(input, sy), lineSize);
+    }
+
+private:
+    const SimTexture& input;
+    bool vertical;
+    uint32_t radius;
+    float blurStrength;
+};
+
+// final_apply: motion and blur results at the pixel center
+class FinalApplyPass : public PixelPass
+{
+public:
+    explicit FinalApplyPass(const SimFrame& frame) : PixelPass("final_apply", frame.swapchain), frame(frame) {}
+
+protected:
+    uint32_t GetTapCount() const override { return 2; }
+
+    void AddTap(FetchBatch& batch, uint32_t x, uint32_t y, uint32_t tap, uint32_t lineSize) const override
+    {
+        const SimTexture& input = tap == 0 ? frame.motion : frame.blurFinal;
+        batch.Add(input, static_cast<int32_t>(x), static_cast<int32_t>(y), lineSize);
+    }
+
+private:
+    const SimFrame& frame;
+};
+
+// Texels of halo needed around a tile for the blur footprint (one more when taps fall between texels)
+uint32_t GetBlurHalo(uint32_t radius, float blurStrength)
+{
+    float reach = radius * blurStrength;
+    return static_cast<uint32_t>(std::ceil(reach)) + (reach != std::floor(reach) ? 1 : 0);
+}
+
+// Hypothetical compute pass: the workgroup loads its tile plus halo into shared memory once, blurs
+// vertically then horizontally in shared memory and writes only the final result
+class FusedBlurPass : public SimPass
+{
+public:
+    FusedBlurPass(const SimFrame& frame, uint32_t halo) : frame(frame), halo(halo) {}
+
+    const char* GetName() const override { return "fused_blur"; }
+
+    void RunWorkgroup(MemorySystem& memory, uint32_t sm, const WorkgroupRect& rect) override
+    {
+        const uint32_t lineSize = memory.GetLineSize();
+        const int32_t x0 = static_cast<int32_t>(rect.x - std::min(rect.x, halo));
+        const int32_t y0 = static_cast<int32_t>(rect.y - std::min(rect.y, halo));
+        const int32_t x1 = static_cast<int32_t>(std::min(rect.x + rect.width + halo, frame.motion.width));
+        const int32_t y1 = static_cast<int32_t>(std::min(rect.y + rect.height + halo, frame.motion.height));
+
+        // Cooperative load, one row of the footprint per instruction
+        for (int32_t y = y0; y < y1; y++)
+        {
+            for (int32_t x = x0; x < x1; x++)
+            {
+                batch.Add(frame.motion, x, y, lineSize);
+            }
+            batch.Issue(memory, sm, false);
+        }
+
+        for (uint32_t y = rect.y; y < rect.y + rect.height; y++)
+        {
+            for (uint32_t x = rect.x; x < rect.x + rect.width; x++)
+            {
+                batch.Add(frame.blurFinal, static_cast<int32_t>(x), static_cast<int32_t>(y), lineSize);
+            }
+        }
+        batch.Issue(memory, sm, true);
+    }
+
+    uint32_t GetSharedMemoryBytes(const WorkgroupRect& rect) const override
+    {
+        // Source footprint plus the vertically blurred rows still needed by the horizontal pass
+        uint32_t footprintWidth = rect.width + 2 * halo;
+        return (footprintWidth * (rect.height + 2 * halo) + footprintWidth * rect.height) * frame.motion.texelSize;
+    }
+
+private:
+    const SimFrame& frame;
+    uint32_t halo;
+    FetchBatch batch;
+};
+
+// Hypothetical single-dispatch chain: motion reconstruction for the tile plus blur halo, blur and the
+// final blend all happen in shared memory; only the swapchain texel is written
+class FusedChainPass : public SimPass
+{
+public:
+    FusedChainPass(const SimFrame& frame, float motionScale, uint32_t halo)
+        : frame(frame), motionScale(motionScale), halo(halo)
+    {
+    }
+
+    const char* GetName() const override { return "fused_chain"; }
+
+    void RunWorkgroup(MemorySystem& memory, uint32_t sm, const WorkgroupRect& rect) override
+    {
+        const uint32_t lineSize = memory.GetLineSize();
+        const uint32_t x0 = rect.x - std::min(rect.x, halo);
+        const uint32_t y0 = rect.y - std::min(rect.y, halo);
+        const uint32_t x1 = std::min(rect.x + rect.width + halo, frame.sceneColor.width);
+        const uint32_t y1 = std::min(rect.y + rect.height + halo, frame.sceneColor.height);
+
+        // Every footprint texel runs motion_apply; threads loop over the footprint row by row
+        for (uint32_t y = y0; y < y1; y++)
+        {
+            for (uint32_t tap = 0; tap <= MOTION_TAP_COUNT; tap++)
+            {
+                for (uint32_t x = x0; x < x1; x++)
+                {
+                    if (tap == 0)
+                    {
+                        batch.Add(frame.velocity, static_cast<int32_t>(x), static_cast<int32_t>(y), lineSize);
+                        continue;
+                    }
+                    float dx = 0.0f;
+                    float dy = 0.0f;
+                    GetMotionOffset(frame, motionScale, x, y, dx, dy);
+                    float step = static_cast<float>(tap - 1) / MOTION_TAP_COUNT;
+                    batch.AddSample(frame.sceneColor, (x + dx * step + 0.5f) / frame.sceneColor.width,
+                                    (y + dy * step + 0.5f) / frame.sceneColor.height, lineSize);
+                }
+                batch.Issue(memory, sm, false);
+            }
+        }
+
+        for (uint32_t y = rect.y; y < rect.y + rect.height; y++)
+        {
+            for (uint32_t x = rect.x; x < rect.x + rect.width; x++)
+            {
+                batch.Add(frame.swapchain, static_cast<int32_t>(x), static_cast<int32_t>(y), lineSize);
+            }
+        }
+        batch.Issue(memory, sm, true);
+    }
+
+    uint32_t GetSharedMemoryBytes(const WorkgroupRect& rect) const override
+    {
+        // Motion results over the footprint plus the vertically blurred rows
+        uint32_t footprintWidth = rect.width + 2 * halo;
+        return (footprintWidth * (rect.height + 2 * halo) + footprintWidth * rect.height) * frame.motion.texelSize;
+    }
+
+private:
+    const SimFrame& frame;
+    float motionScale;
+    uint32_t halo;
+    FetchBatch batch;
+};
+
+//=============================================================================
+// Dispatch
+//=============================================================================
+
+// Workgroup IDs in the order the hardware would launch them
+std::vector<std::pair<uint32_t, uint32_t>> GetDispatchOrder(uint32_t groupsX, uint32_t groupsY,
+                                                          const SimOptions& options)
+{
+    std::vector<std::pair<uint32_t, uint32_t>> groups;
+    groups.reserve(static_cast<size_t>(groupsX) * groupsY);
+
+    switch (options.order)
+    {
+    case DispatchOrder::RowMajor:
+        for (uint32_t y = 0; y < groupsY; y++)
+            for (uint32_t x = 0; x < groupsX; x++)
+                groups.emplace_back(x, y);
+        break;
+    case DispatchOrder::ColumnMajor:
+        for (uint32_t x = 0; x < groupsX; x++)
+            for (uint32_t y = 0; y < groupsY; y++)
+                groups.emplace_back(x, y);
+        break;
+    case DispatchOrder::Morton:
+    {
+        uint32_t extent = 1;
+        while (extent < std::max(groupsX, groupsY))
+            extent *= 2;
+        for (uint64_t code = 0; code < static_cast<uint64_t>(extent) * extent; code++)
+        {
+            uint32_t x = 0;
+            uint32_t y = 0;
+            for (uint32_t bit = 0; bit < 32; bit++)
+            {
+                x |= static_cast<uint32_t>((code >> (2 * bit)) & 1) << bit;
+                y |= static_cast<uint32_t>((code >> (2 * bit + 1)) & 1) << bit;
+            }
+            if (x < groupsX && y < groupsY)
+                groups.emplace_back(x, y);
+        }
+        break;
+    }
+    case DispatchOrder::Supertile:
+        // Row-major blocks of supertile x supertile workgroups, row-major inside each block
+        for (uint32_t blockY = 0; blockY < groupsY; blockY += options.supertile)
+            for (uint32_t blockX = 0; blockX < groupsX; blockX += options.supertile)
+                for (uint32_t y = blockY; y < std::min(blockY + options.supertile, groupsY); y++)
+                    for (uint32_t x = blockX; x < std::min(blockX + options.supertile, groupsX); x++)
+                        groups.emplace_back(x, y);
+        break;
+    }
+    return groups;
+}
+
+struct PassReport
+{
+    std::string name;
+    TrafficStats stats;
+    uint32_t sharedMemoryBytes = 0;
+};
+
+PassReport RunPass(MemorySystem& memory, SimPass& pass, const SimOptions& options)
+{
+    const uint32_t groupsX = (options.width + options.groupWidth - 1) / options.groupWidth;
+    const uint32_t groupsY = (options.height + options.groupHeight - 1) / options.groupHeight;
+    const TrafficStats before = memory.GetStats();
+
+    PassReport report;
+    report.name = pass.GetName();
+    report.sharedMemoryBytes = pass.GetSharedMemoryBytes({0, 0, options.groupWidth, options.groupHeight});
+
+    uint32_t sm = 0;
+    for (const auto& group : GetDispatchOrder(groupsX, groupsY, options))
+    {
+        WorkgroupRect rect;
+        rect.x = group.first * options.groupWidth;
+        rect.y = group.second * options.groupHeight;
+        rect.width = std::min(options.groupWidth, options.width - rect.x);
+        rect.height = std::min(options.groupHeight, options.height - rect.y);
+        pass.RunWorkgroup(memory, sm, rect);
+        sm = (sm + 1) % options.smCount;
+    }
+    memory.EndPass();
+
+    const TrafficStats& after = memory.GetStats();
+    report.stats.l1Accesses = after.l1Accesses - before.l1Accesses;
+    report.stats.l1Hits = after.l1Hits - before.l1Hits;
+    report.stats.l2Accesses = after.l2Accesses - before.l2Accesses;
+    report.stats.l2Hits = after.l2Hits - before.l2Hits;
+    report.stats.dramReadBytes = after.dramReadBytes - before.dramReadBytes;
+    report.stats.dramWriteBytes = after.dramWriteBytes - before.dramWriteBytes;
+    return report;
+}
+
+SimTexture PlaceTexture(uint64_t& nextAddress, const SimOptions& options, uint32_t texelSize)
+{
+    SimTexture texture;
+    texture.width = options.width;
+    texture.height = options.height;
+    texture.texelSize = texelSize;
+    texture.tileWidth = options.textureTileWidth;
+    texture.tileHeight = options.textureTileHeight;
+    texture.baseAddress = nextAddress;
+    // Page-align each allocation like the driver would
+    nextAddress = (nextAddress + texture.GetSize() + 65535) & ~65535ull;
+    return texture;
+}
+
+double GetHitRate(uint64_t hits, uint64_t accesses)
+{
+    return accesses ? 100.0 * static_cast<double>(hits) / static_cast<double>(accesses) : 0.0;
+}
+
+void PrintReport(const PassReport& report, double pixelCount)
+{
+    const TrafficStats& s = report.stats;
+    std::string shared = report.sharedMemoryBytes ? std::to_string(report.sharedMemoryBytes) : "-";
+    std::printf("  %-16s %12llu %7.1f%% %7.1f%% %10.2f %10.2f %9.2f %8s\n", report.name.c_str(),
+                static_cast<unsigned long long>(s.l1Accesses), GetHitRate(s.l1Hits, s.l1Accesses),
+                GetHitRate(s.l2Hits, s.l2Accesses), s.dramReadBytes / (1024.0 * 1024.0),
+                s.dramWriteBytes / (1024.0 * 1024.0), (s.dramReadBytes + s.dramWriteBytes) / pixelCount,
+                shared.c_str());
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    SimOptions options = ParseOptions(argc, argv);
+
+    // Same render target formats as the motion blur example; the swapchain is 8-bit BGRA
+    SimFrame frame;
+    uint64_t nextAddress = 0;
+    frame.sceneColor = PlaceTexture(nextAddress, options, 8);
+    frame.velocity = PlaceTexture(nextAddress, options, 4);
+    frame.motion = PlaceTexture(nextAddress, options, 8);
+    frame.blurIntermediate = PlaceTexture(nextAddress, options, 8);
+    frame.blurFinal = PlaceTexture(nextAddress, options, 8);
+    frame.swapchain = PlaceTexture(nextAddress, options, 4);
+
+    cpu::Image sceneColor = cpu::Image::Create(options.width, options.height, cpu::PixelFormat::RGBA16F);
+    frame.velocityData = cpu::Image::Create(options.width, options.height, cpu::PixelFormat::RG32F);
+    cpu::FillSyntheticFrame(sceneColor, frame.velocityData);
+
+    const uint32_t halo = GetBlurHalo(options.radius, options.blurStrength);
+    MotionApplyPass motionApply(frame, options.motionScale);
+    BlurPass blurVertical("blur_vertical", frame.motion, frame.blurIntermediate, true, options.radius,
+                          options.blurStrength);
+    BlurPass blurHorizontal("blur_horizontal", frame.blurIntermediate, frame.blurFinal, false, options.radius,
+                            options.blurStrength);
+    FinalApplyPass finalApply(frame);
+    FusedBlurPass fusedBlur(frame, halo);
+    FusedChainPass fusedChain(frame, options.motionScale, halo);
+
+    struct Strategy
+    {
+        const char* name;
+        std::vector<SimPass*> passes;
+    };
+    const Strategy strategies[] = {
+        {"separate", {&motionApply, &blurVertical, &blurHorizontal, &finalApply}},
+        {"fused-blur", {&motionApply, &fusedBlur, &finalApply}},
+        {"fused-chain", {&fusedChain}},
+    };
+
+    std::string textureLayout = options.textureTileWidth ? std::to_string(options.textureTileWidth) + "x" +
+                                                               std::to_string(options.textureTileHeight) + " blocks"
+                                                         : "linear";
+    std::printf("GPU post-process cache model: %ux%u, workgroup %ux%u, %s order, textures %s\n", options.width,
+                options.height, options.groupWidth, options.groupHeight, GetDispatchOrderName(options.order),
+                textureLayout.c_str());
+    std::printf("%u SMs x L1 %u KB %u-way, L2 %u KB %u-way, %u-byte lines, blur radius %u (halo %u)\n",
+                options.smCount, options.l1SizeKb, options.l1Ways, options.l2SizeKb, options.l2Ways, options.lineSize,
+                options.radius, halo);
+
+    const double pixelCount = static_cast<double>(options.width) * options.height;
+    for (const Strategy& strategy : strategies)
+    {
+        // Cold caches per strategy so their totals compare directly
+        MemorySystem memory(options);
+        std::printf("\n%s\n", strategy.name);
+        std::printf("  %-16s %12s %8s %8s %10s %10s %9s %8s\n", "pass", "L1 requests", "L1 hit", "L2 hit",
+                    "DRAM rd MB", "DRAM wr MB", "B/pixel", "LDS B");
+
+        PassReport total;
+        total.name = "total";
+        for (SimPass* pass : strategy.passes)
+        {
+            PassReport report = RunPass(memory, *pass, options);
+            PrintReport(report, pixelCount);
+            total.sharedMemoryBytes = std::max(total.sharedMemoryBytes, report.sharedMemoryBytes);
+        }
+        total.stats = memory.GetStats();
+        PrintReport(total, pixelCount);
+    }
+
+    return EXIT_SUCCESS;
+}
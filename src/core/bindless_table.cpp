@@ -0,0 +1,210 @@
+#include "bindless_table.h"
+
+#include "vulkan_context.h"
+
+#include <array>
+#include <stdexcept>
+
+namespace vkdemo
+{
+
+uint32_t BindlessTable::SlotAllocator::Acquire()
+{
+    if (!freeList.empty())
+    {
+        uint32_t handle = freeList.back();
+        freeList.pop_back();
+        return handle;
+    }
+    if (next >= capacity)
+    {
+        throw std::runtime_error("Bindless table is full!");
+    }
+    return next++;
+}
+
+void BindlessTable::SlotAllocator::Release(uint32_t handle)
+{
+    if (handle != INVALID_HANDLE)
+    {
+        freeList.push_back(handle);
+    }
+}
+
+void BindlessTable::Initialize(VulkanContext& ctx, uint32_t maxSampledImages, uint32_t maxStorageImages,
+                               uint32_t maxSamplers)
+{
+    if (!ctx.IsBindlessSupported())
+    {
+        throw std::runtime_error("Bindless table requires descriptor indexing support!");
+    }
+
+    device = ctx.GetDevice();
+    sampledImages.capacity = maxSampledImages;
+    storageImages.capacity = maxStorageImages;
+    samplers.capacity = maxSamplers;
+
+    const VkShaderStageFlags stages = VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+
+    std::array<VkDescriptorSetLayoutBinding, 3> bindings{};
+    bindings[0].binding = SAMPLED_IMAGE_BINDING;
+    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+    bindings[0].descriptorCount = maxSampledImages;
+    bindings[0].stageFlags = stages;
+
+    bindings[1].binding = STORAGE_IMAGE_BINDING;
+    bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    bindings[1].descriptorCount = maxStorageImages;
+    bindings[1].stageFlags = stages;
+
+    bindings[2].binding = SAMPLER_BINDING;
+    bindings[2].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+    bindings[2].descriptorCount = maxSamplers;
+    bindings[2].stageFlags = stages;
+
+    // Every slot may be empty and may be rewritten while the set is bound
+    const VkDescriptorBindingFlags imageFlags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+                                                VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+                                                VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+    std::array<VkDescriptorBindingFlags, 3> bindingFlags = {imageFlags, imageFlags,
+                                                            VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT};
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{};
+    bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+    bindingFlagsInfo.bindingCount = static_cast<uint32_t>(bindingFlags.size());
+    bindingFlagsInfo.pBindingFlags = bindingFlags.data();
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.pNext = &bindingFlagsInfo;
+    layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    layoutInfo.pBindings = bindings.data();
+
+    if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &layout) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create bindless descriptor set layout!");
+    }
+
+    std::array<VkDescriptorPoolSize, 3> poolSizes{};
+    poolSizes[0].type = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+    poolSizes[0].descriptorCount = maxSampledImages;
+    poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    poolSizes[1].descriptorCount = maxStorageImages;
+    poolSizes[2].type = VK_DESCRIPTOR_TYPE_SAMPLER;
+    poolSizes[2].descriptorCount = maxSamplers;
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    poolInfo.pPoolSizes = poolSizes.data();
+    poolInfo.maxSets = 1;
+
+    if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &pool) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create bindless descriptor pool!");
+    }
+
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = pool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &layout;
+
+    if (vkAllocateDescriptorSets(device, &allocInfo, &set) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to allocate bindless descriptor set!");
+    }
+}
+
+void BindlessTable::Cleanup(VkDevice dev)
+{
+    if (pool == VK_NULL_HANDLE)
+        return;
+
+    vkDestroyDescriptorPool(dev, pool, nullptr);
+    vkDestroyDescriptorSetLayout(dev, layout, nullptr);
+
+    pool = VK_NULL_HANDLE;
+    layout = VK_NULL_HANDLE;
+    set = VK_NULL_HANDLE;
+    sampledImages = {};
+    storageImages = {};
+    samplers = {};
+}
+
+uint32_t BindlessTable::RegisterSampledImage(VkImageView view, VkImageLayout imageLayout)
+{
+    uint32_t handle = sampledImages.Acquire();
+    UpdateSampledImage(handle, view, imageLayout);
+    return handle;
+}
+
+void BindlessTable::UpdateSampledImage(uint32_t handle, VkImageView view, VkImageLayout imageLayout)
+{
+    WriteImage(SAMPLED_IMAGE_BINDING, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, handle, view, imageLayout);
+}
+
+void BindlessTable::ReleaseSampledImage(uint32_t handle)
+{
+    sampledImages.Release(handle);
+}
+
+uint32_t BindlessTable::RegisterStorageImage(VkImageView view)
+{
+    uint32_t handle = storageImages.Acquire();
+    UpdateStorageImage(handle, view);
+    return handle;
+}
+
+void BindlessTable::UpdateStorageImage(uint32_t handle, VkImageView view)
+{
+    WriteImage(STORAGE_IMAGE_BINDING, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, handle, view, VK_IMAGE_LAYOUT_GENERAL);
+}
+
+void BindlessTable::ReleaseStorageImage(uint32_t handle)
+{
+    storageImages.Release(handle);
+}
+
+uint32_t BindlessTable::RegisterSampler(VkSampler sampler)
+{
+    uint32_t handle = samplers.Acquire();
+
+    VkDescriptorImageInfo imageInfo{};
+    imageInfo.sampler = sampler;
+
+    VkWriteDescriptorSet descriptorWrite{};
+    descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrite.dstSet = set;
+    descriptorWrite.dstBinding = SAMPLER_BINDING;
+    descriptorWrite.dstArrayElement = handle;
+    descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+    descriptorWrite.descriptorCount = 1;
+    descriptorWrite.pImageInfo = &imageInfo;
+
+    vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
+    return handle;
+}
+
+void BindlessTable::WriteImage(uint32_t binding, VkDescriptorType type, uint32_t handle, VkImageView view,
+                               VkImageLayout imageLayout)
+{
+    VkDescriptorImageInfo imageInfo{};
+    imageInfo.imageView = view;
+    imageInfo.imageLayout = imageLayout;
+
+    VkWriteDescriptorSet descriptorWrite{};
+    descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrite.dstSet = set;
+    descriptorWrite.dstBinding = binding;
+    descriptorWrite.dstArrayElement = handle;
+    descriptorWrite.descriptorType = type;
+    descriptorWrite.descriptorCount = 1;
+    descriptorWrite.pImageInfo = &imageInfo;
+
+    vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
+}
+
+}  // namespace vkdemo
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "vulkan_utils.h"
+
+#include <vector>
+
+namespace vkdemo
+{
+
+//=============================================================================
+// Bindless Table
+//=============================================================================
+
+// One global update-after-bind descriptor set holding arrays of sampled images,
+// storage images and samplers. Resources are referenced from shaders by the
+// uint32_t handle returned at registration (passed in push constants), so
+// replacing a resource only rewrites its array slot.
+class BindlessTable
+{
+public:
+    static constexpr uint32_t SAMPLED_IMAGE_BINDING = 0;
+    static constexpr uint32_t STORAGE_IMAGE_BINDING = 1;
+    static constexpr uint32_t SAMPLER_BINDING = 2;
+    static constexpr uint32_t INVALID_HANDLE = ~0u;
+
+    void Initialize(VulkanContext& ctx, uint32_t maxSampledImages, uint32_t maxStorageImages, uint32_t maxSamplers);
+    void Cleanup(VkDevice device);
+
+    uint32_t RegisterSampledImage(VkImageView view,
+                                  VkImageLayout layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    void UpdateSampledImage(uint32_t handle, VkImageView view,
+                            VkImageLayout layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    void ReleaseSampledImage(uint32_t handle);
+
+    uint32_t RegisterStorageImage(VkImageView view);
+    void UpdateStorageImage(uint32_t handle, VkImageView view);
+    void ReleaseStorageImage(uint32_t handle);
+
+    uint32_t RegisterSampler(VkSampler sampler);
+
+    VkDescriptorSetLayout GetLayout() const { return layout; }
+    VkDescriptorSet GetSet() const { return set; }
+
+private:
+    struct SlotAllocator
+    {
+        uint32_t capacity = 0;
+        uint32_t next = 0;
+        std::vector<uint32_t> freeList;
+
+        uint32_t Acquire();
+        void Release(uint32_t handle);
+    };
+
+    void WriteImage(uint32_t binding, VkDescriptorType type, uint32_t handle, VkImageView view, VkImageLayout imageLayout);
+
+    VkDevice device = VK_NULL_HANDLE;
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+    VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+    VkDescriptorSet set = VK_NULL_HANDLE;
+
+    SlotAllocator sampledImages;
+    SlotAllocator storageImages;
+    SlotAllocator samplers;
+};
+
+}  // namespace vkdemo
@@ -0,0 +1,107 @@
+#include "compute_tuning.h"
+
+#include "cpu/tile_tuner.h"
+#include "vulkan_context.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+namespace vkdemo
+{
+
+static constexpr uint32_t PREFERRED_INVOCATIONS = 256;
+
+ComputeTileLimits QueryComputeTileLimits(const VulkanContext& ctx)
+{
+    const VkPhysicalDeviceLimits& deviceLimits = ctx.GetPhysicalDeviceProperties().limits;
+
+    ComputeTileLimits limits;
+    limits.maxSharedMemorySize = deviceLimits.maxComputeSharedMemorySize;
+    limits.maxInvocations = deviceLimits.maxComputeWorkGroupInvocations;
+    limits.maxWorkGroupSize[0] = deviceLimits.maxComputeWorkGroupSize[0];
+    limits.maxWorkGroupSize[1] = deviceLimits.maxComputeWorkGroupSize[1];
+    limits.subgroupSize = std::max(ctx.GetSubgroupProperties().subgroupSize, 1u);
+    return limits;
+}
+
+std::vector<cpu::TileSize> GetComputeWorkgroupCandidates(const ComputeTileLimits& limits, uint32_t blurRadius,
+                                                         uint32_t texelSize)
+{
+    std::vector<cpu::TileSize> candidates;
+    for (uint32_t width = 4; width <= 64; width *= 2)
+    {
+        for (uint32_t height = 1; height <= 64; height *= 2)
+        {
+            uint32_t invocations = width * height;
+            if (width > limits.maxWorkGroupSize[0] || height > limits.maxWorkGroupSize[1] ||
+                invocations > limits.maxInvocations || invocations % limits.subgroupSize != 0)
+                continue;
+
+            size_t sharedBytes = static_cast<size_t>(width + 2 * blurRadius) * (height + 2 * blurRadius) * texelSize;
+            if (sharedBytes > limits.maxSharedMemorySize)
+                continue;
+
+            candidates.push_back({width, height});
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+              [](const cpu::TileSize& a, const cpu::TileSize& b)
+              {
+                  int32_t distanceA = std::abs(static_cast<int32_t>(a.width * a.height - PREFERRED_INVOCATIONS));
+                  int32_t distanceB = std::abs(static_cast<int32_t>(b.width * b.height - PREFERRED_INVOCATIONS));
+                  if (distanceA != distanceB)
+                      return distanceA < distanceB;
+                  // Rows map to contiguous memory; prefer the wider shape of equal size
+                  return a.width > b.width;
+              });
+    return candidates;
+}
+
+std::string GetGpuProfileKey(const VulkanContext& ctx)
+{
+    const VkPhysicalDeviceProperties& properties = ctx.GetPhysicalDeviceProperties();
+    return std::string(properties.deviceName) + "/" + std::to_string(properties.vendorID) + ":" +
+           std::to_string(properties.deviceID) + "/" + std::to_string(properties.driverVersion);
+}
+
+cpu::TileSize LoadComputeWorkgroupSize(const std::string& profilePath, const VulkanContext& ctx,
+                                       const std::string& kernel, uint32_t width, uint32_t height,
+                                       uint32_t blurRadius, uint32_t texelSize)
+{
+    cpu::TileProfile profile;
+    profile.Load(profilePath);
+
+    cpu::TileSize workgroup;
+    if (profile.FindNearest(kernel, GetGpuProfileKey(ctx), width, height, workgroup))
+        return workgroup;
+
+    std::vector<cpu::TileSize> candidates =
+        GetComputeWorkgroupCandidates(QueryComputeTileLimits(ctx), blurRadius, texelSize);
+    return candidates.empty() ? cpu::TileSize{8, 8} : candidates.front();
+}
+
+cpu::TileSize TuneComputeWorkgroupSize(const std::string& profilePath, const VulkanContext& ctx,
+                                       const std::string& kernel, uint32_t width, uint32_t height,
+                                       uint32_t blurRadius, uint32_t texelSize,
+                                       const std::function<double(cpu::TileSize)>& measure)
+{
+    std::vector<cpu::TileSize> candidates =
+        GetComputeWorkgroupCandidates(QueryComputeTileLimits(ctx), blurRadius, texelSize);
+    if (candidates.empty())
+        return {8, 8};
+
+    cpu::TileTuneResult result = cpu::TuneTileSize(candidates, static_cast<double>(width) * height, measure);
+
+    cpu::TileProfile profile;
+    profile.Load(profilePath);
+    profile.Store(kernel, GetGpuProfileKey(ctx), width, height, result.tile, result.nsPerPixel);
+    if (!profile.Save(profilePath))
+    {
+        std::cerr << "Failed to save tile profile to " << profilePath << std::endl;
+    }
+    return result.tile;
+}
+
+}  // namespace vkdemo
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "cpu/tile_profile.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace vkdemo
+{
+
+class VulkanContext;
+
+//=============================================================================
+// Compute Workgroup Tuning
+//=============================================================================
+
+// Device limits that bound a shared-memory tiled blur. Vulkan exposes no GPU cache sizes, so the
+// shared memory budget and subgroup width stand in for them.
+struct ComputeTileLimits
+{
+    uint32_t maxSharedMemorySize = 0;
+    uint32_t maxInvocations = 0;
+    uint32_t maxWorkGroupSize[2] = {};
+    uint32_t subgroupSize = 1;
+};
+
+ComputeTileLimits QueryComputeTileLimits(const VulkanContext& ctx);
+
+// 2D workgroups whose invocation count is a whole number of subgroups and whose tile plus blur halo
+// (texelSize bytes per texel) fits in shared memory, most preferred first (closest to 256 invocations,
+// wider than tall)
+std::vector<cpu::TileSize> GetComputeWorkgroupCandidates(const ComputeTileLimits& limits, uint32_t blurRadius,
+                                                         uint32_t texelSize);
+
+// Profile key of the GPU: name, vendor/device IDs and driver version
+std::string GetGpuProfileKey(const VulkanContext& ctx);
+
+// Profiled workgroup size of a compute kernel at this resolution (nearest profiled resolution if not exact),
+// or the preferred candidate when the kernel has never been tuned on this device
+cpu::TileSize LoadComputeWorkgroupSize(const std::string& profilePath, const VulkanContext& ctx,
+                                       const std::string& kernel, uint32_t width, uint32_t height,
+                                       uint32_t blurRadius, uint32_t texelSize);
+
+// Sweeps every candidate with measure (GPU seconds per dispatch, e.g. from timestamp queries) and
+// persists the winner
+cpu::TileSize TuneComputeWorkgroupSize(const std::string& profilePath, const VulkanContext& ctx,
+                                       const std::string& kernel, uint32_t width, uint32_t height,
+                                       uint32_t blurRadius, uint32_t texelSize,
+                                       const std::function<double(cpu::TileSize)>& measure);
+
+}  // namespace vkdemo
@@ -0,0 +1,128 @@
+#include "deletion_queue.h"
+
+#include <stdexcept>
+
+namespace vkdemo
+{
+
+void DeletionQueue::Initialize(VkDevice dev)
+{
+    device = dev;
+}
+
+void DeletionQueue::PushImage(uint64_t timelineValue, VkImage image, VkDeviceMemory memory)
+{
+    Entry entry;
+    entry.timelineValue = timelineValue;
+    entry.type = ResourceType::Image;
+    entry.image = image;
+    entry.memory = memory;
+    Push(std::move(entry));
+}
+
+void DeletionQueue::PushBuffer(uint64_t timelineValue, VkBuffer buffer, VkDeviceMemory memory)
+{
+    Entry entry;
+    entry.timelineValue = timelineValue;
+    entry.type = ResourceType::Buffer;
+    entry.buffer = buffer;
+    entry.memory = memory;
+    Push(std::move(entry));
+}
+
+void DeletionQueue::PushImageView(uint64_t timelineValue, VkImageView view)
+{
+    Entry entry;
+    entry.timelineValue = timelineValue;
+    entry.type = ResourceType::ImageView;
+    entry.view = view;
+    Push(std::move(entry));
+}
+
+void DeletionQueue::PushFramebuffer(uint64_t timelineValue, VkFramebuffer framebuffer)
+{
+    Entry entry;
+    entry.timelineValue = timelineValue;
+    entry.type = ResourceType::Framebuffer;
+    entry.framebuffer = framebuffer;
+    Push(std::move(entry));
+}
+
+void DeletionQueue::PushPipeline(uint64_t timelineValue, VkPipeline pipeline)
+{
+    Entry entry;
+    entry.timelineValue = timelineValue;
+    entry.type = ResourceType::Pipeline;
+    entry.pipeline = pipeline;
+    Push(std::move(entry));
+}
+
+void DeletionQueue::PushDescriptorPool(uint64_t timelineValue, VkDescriptorPool pool)
+{
+    Entry entry;
+    entry.timelineValue = timelineValue;
+    entry.type = ResourceType::DescriptorPool;
+    entry.descriptorPool = pool;
+    Push(std::move(entry));
+}
+
+void DeletionQueue::PushCallback(uint64_t timelineValue, std::function<void()> callback)
+{
+    Entry entry;
+    entry.timelineValue = timelineValue;
+    entry.type = ResourceType::Callback;
+    entry.callback = std::move(callback);
+    Push(std::move(entry));
+}
+
+void DeletionQueue::Push(Entry&& entry)
+{
+    if (!entries.empty() && entry.timelineValue < entries.back().timelineValue)
+    {
+        throw std::runtime_error("Deletion queue entries must be pushed in timeline order!");
+    }
+    entries.push_back(std::move(entry));
+}
+
+void DeletionQueue::Flush(uint64_t completedValue)
+{
+    while (!entries.empty() && entries.front().timelineValue <= completedValue)
+    {
+        // Pop before destroying, since a callback may push new entries
+        Entry entry = std::move(entries.front());
+        entries.pop_front();
+        Destroy(entry);
+    }
+}
+
+void DeletionQueue::Destroy(Entry& entry)
+{
+    switch (entry.type)
+    {
+    case ResourceType::Image:
+        vkDestroyImage(device, entry.image, nullptr);
+        vkFreeMemory(device, entry.memory, nullptr);
+        break;
+    case ResourceType::Buffer:
+        vkDestroyBuffer(device, entry.buffer, nullptr);
+        vkFreeMemory(device, entry.memory, nullptr);
+        break;
+    case ResourceType::ImageView:
+        vkDestroyImageView(device, entry.view, nullptr);
+        break;
+    case ResourceType::Framebuffer:
+        vkDestroyFramebuffer(device, entry.framebuffer, nullptr);
+        break;
+    case ResourceType::Pipeline:
+        vkDestroyPipeline(device, entry.pipeline, nullptr);
+        break;
+    case ResourceType::DescriptorPool:
+        vkDestroyDescriptorPool(device, entry.descriptorPool, nullptr);
+        break;
+    case ResourceType::Callback:
+        entry.callback();
+        break;
+    }
+}
+
+}  // namespace vkdemo
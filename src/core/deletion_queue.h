@@ -0,0 +1,68 @@
+#pragma once
+
+#include "vulkan_utils.h"
+
+#include <deque>
+#include <functional>
+
+namespace vkdemo
+{
+
+//=============================================================================
+// Deletion Queue
+//=============================================================================
+
+// Defers destruction of Vulkan objects until the GPU has passed a given timeline
+// value. Entries must be pushed with non-decreasing values; Flush destroys every
+// entry whose value has been reached, in the order they were pushed.
+class DeletionQueue
+{
+public:
+    void Initialize(VkDevice device);
+
+    void PushImage(uint64_t timelineValue, VkImage image, VkDeviceMemory memory);
+    void PushBuffer(uint64_t timelineValue, VkBuffer buffer, VkDeviceMemory memory);
+    void PushImageView(uint64_t timelineValue, VkImageView view);
+    void PushFramebuffer(uint64_t timelineValue, VkFramebuffer framebuffer);
+    void PushPipeline(uint64_t timelineValue, VkPipeline pipeline);
+    void PushDescriptorPool(uint64_t timelineValue, VkDescriptorPool pool);
+    void PushCallback(uint64_t timelineValue, std::function<void()> callback);
+
+    void Flush(uint64_t completedValue);
+
+    bool IsEmpty() const { return entries.empty(); }
+
+private:
+    enum class ResourceType
+    {
+        Image,
+        Buffer,
+        ImageView,
+        Framebuffer,
+        Pipeline,
+        DescriptorPool,
+        Callback
+    };
+
+    struct Entry
+    {
+        uint64_t timelineValue = 0;
+        ResourceType type = ResourceType::Callback;
+        VkImage image = VK_NULL_HANDLE;
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkImageView view = VK_NULL_HANDLE;
+        VkFramebuffer framebuffer = VK_NULL_HANDLE;
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+        std::function<void()> callback;
+    };
+
+    void Push(Entry&& entry);
+    void Destroy(Entry& entry);
+
+    VkDevice device = VK_NULL_HANDLE;
+    std::deque<Entry> entries;
+};
+
+}  // namespace vkdemo
@@ -0,0 +1,102 @@
+#include "gpu_timer.h"
+
+#include "vulkan_context.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace vkdemo
+{
+
+bool GpuTimer::Initialize(VulkanContext& ctx, uint32_t maxTimestampsPerFrame)
+{
+    const VkPhysicalDeviceLimits& limits = ctx.GetPhysicalDeviceProperties().limits;
+    if (limits.timestampPeriod <= 0.0f)
+        return false;
+
+    // Timestamps wrap at the valid bits of the queue; every graphics family must count them
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(ctx.GetPhysicalDevice(), &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(ctx.GetPhysicalDevice(), &familyCount, families.data());
+    uint32_t validBits = 64;
+    for (const VkQueueFamilyProperties& family : families)
+    {
+        if (family.queueFlags & VK_QUEUE_GRAPHICS_BIT)
+        {
+            validBits = std::min(validBits, family.timestampValidBits);
+        }
+    }
+    if (validBits == 0)
+        return false;
+
+    poolDevice = ctx.GetDevice();
+    capacity = maxTimestampsPerFrame;
+    nanosecondsPerTick = limits.timestampPeriod;
+    validMask = validBits == 64 ? ~0ull : (1ull << validBits) - 1;
+    written.assign(VulkanContext::MAX_FRAMES_IN_FLIGHT, 0);
+    results.clear();
+
+    VkQueryPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    poolInfo.queryCount = capacity * VulkanContext::MAX_FRAMES_IN_FLIGHT;
+
+    if (vkCreateQueryPool(poolDevice, &poolInfo, nullptr, &queryPool) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create timestamp query pool!");
+    }
+    return true;
+}
+
+void GpuTimer::Cleanup(VkDevice device)
+{
+    vkDestroyQueryPool(device, queryPool, nullptr);
+    queryPool = VK_NULL_HANDLE;
+}
+
+void GpuTimer::BeginFrame(VkCommandBuffer cmd, uint32_t frameIndex)
+{
+    if (queryPool == VK_NULL_HANDLE)
+        return;
+
+    currentSlot = frameIndex;
+    uint32_t first = frameIndex * capacity;
+
+    // Slots that have never been written hold no results (nor reset queries to read)
+    results.clear();
+    if (written[frameIndex] > 0)
+    {
+        results.resize(written[frameIndex]);
+        VkResult result = vkGetQueryPoolResults(poolDevice, queryPool, first, written[frameIndex],
+                                                results.size() * sizeof(uint64_t), results.data(), sizeof(uint64_t),
+                                                VK_QUERY_RESULT_64_BIT);
+        if (result != VK_SUCCESS)
+        {
+            results.clear();
+        }
+    }
+
+    vkCmdResetQueryPool(cmd, queryPool, first, capacity);
+    written[frameIndex] = 0;
+}
+
+uint32_t GpuTimer::Timestamp(VkCommandBuffer cmd, VkPipelineStageFlagBits stage)
+{
+    if (queryPool == VK_NULL_HANDLE || written[currentSlot] == capacity)
+        return capacity;
+
+    vkCmdWriteTimestamp(cmd, stage, queryPool, currentSlot * capacity + written[currentSlot]);
+    return written[currentSlot]++;
+}
+
+double GpuTimer::GetMilliseconds(uint32_t first, uint32_t second) const
+{
+    if (first >= results.size() || second >= results.size())
+        return 0.0;
+
+    uint64_t ticks = (results[second] - results[first]) & validMask;
+    return static_cast<double>(ticks) * nanosecondsPerTick * 1e-6;
+}
+
+}  // namespace vkdemo
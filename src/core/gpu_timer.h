@@ -0,0 +1,53 @@
+#pragma once
+
+#include "vulkan_utils.h"
+
+#include <vector>
+
+namespace vkdemo
+{
+
+//=============================================================================
+// GPU Timer
+//=============================================================================
+
+// Timestamp queries over one pool, split into one slice per frame in flight. Each frame resets its slice
+// and writes timestamps into it; when the slice comes round again its fence has been waited on, and the
+// timestamps of that earlier frame are read back without stalling.
+class GpuTimer
+{
+public:
+    // Returns false (and times nothing) when the graphics queue has no timestamp support
+    bool Initialize(VulkanContext& ctx, uint32_t maxTimestampsPerFrame);
+    void Cleanup(VkDevice device);
+
+    bool IsSupported() const { return queryPool != VK_NULL_HANDLE; }
+
+    // Reads back the timestamps the given frame slot wrote last time and resets the slot. Must be called
+    // outside a render pass, once the slot's in-flight fence has been waited on.
+    void BeginFrame(VkCommandBuffer cmd, uint32_t frameIndex);
+
+    // Writes a timestamp once all earlier commands have reached stage; returns its index in the frame, or
+    // an index without a result when the slice is full
+    uint32_t Timestamp(VkCommandBuffer cmd, VkPipelineStageFlagBits stage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+
+    // Results of the frame read back by the last BeginFrame
+    bool HasResults() const { return !results.empty(); }
+    uint32_t GetResultCount() const { return static_cast<uint32_t>(results.size()); }
+    // Milliseconds between two timestamps of that frame
+    double GetMilliseconds(uint32_t first, uint32_t second) const;
+
+private:
+    VkDevice poolDevice = VK_NULL_HANDLE;
+    VkQueryPool queryPool = VK_NULL_HANDLE;
+    uint32_t capacity = 0;
+    double nanosecondsPerTick = 1.0;
+    uint64_t validMask = ~0ull;
+
+    // Timestamps written into each slot by its last frame, and the slot being recorded
+    std::vector<uint32_t> written;
+    uint32_t currentSlot = 0;
+    std::vector<uint64_t> results;
+};
+
+}  // namespace vkdemo
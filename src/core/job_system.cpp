@@ -0,0 +1,451 @@
+#include "job_system.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#elif defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+namespace vkdemo
+{
+
+struct Job
+{
+    JobSystem::JobFunction function;
+    JobCounter* counter = nullptr;
+};
+
+namespace
+{
+
+// Identifies the worker running on this thread; a thread belongs to at most one job system
+struct WorkerIdentity
+{
+    const JobSystem* system = nullptr;
+    uint32_t index = JobSystem::INVALID_WORKER;
+};
+
+thread_local WorkerIdentity currentWorker;
+
+}  // namespace
+
+//=============================================================================
+// Chase-Lev Deque
+//=============================================================================
+
+bool JobSystem::WorkStealingDeque::Push(Job* job)
+{
+    int64_t b = bottom.load(std::memory_order_relaxed);
+    int64_t t = top.load(std::memory_order_acquire);
+    if (b - t >= CAPACITY)
+        return false;
+
+    buffer[b & (CAPACITY - 1)].store(job, std::memory_order_relaxed);
+    // Publishes the slot to thieves that acquire bottom
+    bottom.store(b + 1, std::memory_order_release);
+    return true;
+}
+
+Job* JobSystem::WorkStealingDeque::Pop()
+{
+    int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_relaxed);
+
+    if (t > b)
+    {
+        // Empty
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    Job* job = buffer[b & (CAPACITY - 1)].load(std::memory_order_relaxed);
+    if (t == b)
+    {
+        // Last element: race thieves for it
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            job = nullptr;
+        }
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+Job* JobSystem::WorkStealingDeque::Steal()
+{
+    int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom.load(std::memory_order_acquire);
+    if (t >= b)
+        return nullptr;
+
+    Job* job = buffer[t & (CAPACITY - 1)].load(std::memory_order_relaxed);
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+    {
+        // Lost the race against the owner or another thief
+        return nullptr;
+    }
+    return job;
+}
+
+//=============================================================================
+// JobSystem
+//=============================================================================
+
+JobSystem::~JobSystem()
+{
+    Cleanup();
+}
+
+void JobSystem::Initialize(const JobSystemConfig& config)
+{
+    if (!workers.empty())
+    {
+        throw std::runtime_error("Job system is already initialized!");
+    }
+    if (currentWorker.system != nullptr)
+    {
+        throw std::runtime_error("Failed to initialize job system: thread already belongs to another one!");
+    }
+
+    uint32_t workerCount = config.workerCount;
+    if (workerCount == 0)
+    {
+        workerCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    pinThreads = config.pinThreads;
+    stopping = false;
+    queuedJobs = 0;
+
+    workers.resize(workerCount);
+    for (auto& worker : workers)
+    {
+        worker = std::make_unique<Worker>();
+    }
+
+    // The initializing thread is worker 0
+    currentWorker.system = this;
+    currentWorker.index = 0;
+    if (pinThreads)
+    {
+        PinCurrentThread(0);
+    }
+
+    for (uint32_t i = 1; i < workerCount; i++)
+    {
+        workers[i]->thread = std::thread(&JobSystem::WorkerLoop, this, i);
+    }
+}
+
+void JobSystem::Cleanup()
+{
+    if (workers.empty())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+
+    for (auto& worker : workers)
+    {
+        if (worker->thread.joinable())
+        {
+            worker->thread.join();
+        }
+    }
+
+    // Anything still queued was never waited on; drop it
+    for (auto& worker : workers)
+    {
+        while (Job* job = worker->deque.Pop())
+        {
+            delete job;
+        }
+    }
+    for (Job* job : injectionQueue)
+    {
+        delete job;
+    }
+    injectionQueue.clear();
+    workers.clear();
+
+    if (currentWorker.system == this)
+    {
+        currentWorker = {};
+    }
+}
+
+uint32_t JobSystem::GetCurrentWorkerIndex() const
+{
+    return currentWorker.system == this ? currentWorker.index : INVALID_WORKER;
+}
+
+void JobSystem::Run(JobFunction function, JobCounter* counter)
+{
+    if (counter)
+    {
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    Submit(new Job{std::move(function), counter});
+    WakeWorkers(false);
+}
+
+void JobSystem::RunAfter(JobCounter& dependency, JobFunction function, JobCounter* counter)
+{
+    if (counter)
+    {
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    Job* job = new Job{std::move(function), counter};
+
+    {
+        std::lock_guard<std::mutex> lock(dependency.mutex);
+        if (dependency.pending.load(std::memory_order_acquire) != 0)
+        {
+            dependency.continuations.push_back(job);
+            return;
+        }
+    }
+
+    Submit(job);
+    WakeWorkers(false);
+}
+
+void JobSystem::Wait(JobCounter& counter)
+{
+    uint32_t workerIndex = GetCurrentWorkerIndex();
+    if (workerIndex == INVALID_WORKER)
+    {
+        throw std::runtime_error("Job system Wait must be called from a worker thread!");
+    }
+
+    while (!counter.IsDone())
+    {
+        if (Job* job = FindJob(workerIndex))
+        {
+            Execute(job);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // The last Complete may still hold the mutex; the counter must outlive it
+    std::lock_guard<std::mutex> lock(counter.mutex);
+}
+
+void JobSystem::ParallelFor2D(uint32_t countX, uint32_t countY, const TileFunction& function, uint32_t batchSize)
+{
+    const uint32_t tileCount = countX * countY;
+    if (tileCount == 0)
+        return;
+
+    uint32_t workerIndex = GetCurrentWorkerIndex();
+    if (workerIndex == INVALID_WORKER)
+    {
+        throw std::runtime_error("Job system ParallelFor2D must be called from a worker thread!");
+    }
+
+    if (batchSize == 0)
+    {
+        batchSize = std::max(tileCount / (GetWorkerCount() * 4), 1u);
+    }
+
+    // Nothing to share: skip the queue entirely
+    if (GetWorkerCount() == 1 || tileCount <= batchSize)
+    {
+        for (uint32_t i = 0; i < tileCount; i++)
+        {
+            function(i % countX, i / countX, workerIndex);
+        }
+        return;
+    }
+
+    JobCounter counter;
+    for (uint32_t begin = 0; begin < tileCount; begin += batchSize)
+    {
+        uint32_t end = std::min(begin + batchSize, tileCount);
+        counter.pending.fetch_add(1, std::memory_order_relaxed);
+        Submit(new Job{[this, &function, countX, begin, end]
+                       {
+                           uint32_t executingWorker = GetCurrentWorkerIndex();
+                           for (uint32_t i = begin; i < end; i++)
+                           {
+                               function(i % countX, i / countX, executingWorker);
+                           }
+                       },
+                       &counter});
+    }
+    WakeWorkers(true);
+    Wait(counter);
+}
+
+void JobSystem::Submit(Job* job)
+{
+    uint32_t workerIndex = GetCurrentWorkerIndex();
+    if (workerIndex != INVALID_WORKER)
+    {
+        if (!workers[workerIndex]->deque.Push(job))
+        {
+            // Deque full: run it now rather than grow
+            Execute(job);
+            return;
+        }
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(injectionMutex);
+        injectionQueue.push_back(job);
+    }
+    queuedJobs.fetch_add(1, std::memory_order_release);
+}
+
+Job* JobSystem::FindJob(uint32_t workerIndex)
+{
+    Worker& self = *workers[workerIndex];
+
+    Job* job = self.deque.Pop();
+    if (!job && queuedJobs.load(std::memory_order_acquire) != 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(injectionMutex);
+            if (!injectionQueue.empty())
+            {
+                job = injectionQueue.back();
+                injectionQueue.pop_back();
+            }
+        }
+
+        // Steal round-robin, resuming after the last victim
+        const uint32_t workerCount = GetWorkerCount();
+        for (uint32_t i = 0; !job && i < workerCount; i++)
+        {
+            uint32_t victim = (self.stealCursor + i) % workerCount;
+            if (victim != workerIndex)
+            {
+                job = workers[victim]->deque.Steal();
+                if (job)
+                {
+                    self.stealCursor = victim;
+                }
+            }
+        }
+    }
+
+    if (job)
+    {
+        queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+void JobSystem::Execute(Job* job)
+{
+    job->function();
+    JobCounter* counter = job->counter;
+    delete job;
+
+    if (counter)
+    {
+        Complete(*counter);
+    }
+}
+
+void JobSystem::Complete(JobCounter& counter)
+{
+    std::vector<Job*> ready;
+    {
+        std::lock_guard<std::mutex> lock(counter.mutex);
+        if (counter.pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            ready.swap(counter.continuations);
+        }
+    }
+
+    // Counter may be destroyed by a waiter from here on
+    for (Job* job : ready)
+    {
+        Submit(job);
+    }
+    if (!ready.empty())
+    {
+        WakeWorkers(ready.size() > 1);
+    }
+}
+
+void JobSystem::WakeWorkers(bool all)
+{
+    // Taking the lock orders the queuedJobs increment before a sleeper re-checks its predicate
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    if (all)
+    {
+        wakeCondition.notify_all();
+    }
+    else
+    {
+        wakeCondition.notify_one();
+    }
+}
+
+void JobSystem::WorkerLoop(uint32_t workerIndex)
+{
+    currentWorker.system = this;
+    currentWorker.index = workerIndex;
+    if (pinThreads)
+    {
+        PinCurrentThread(workerIndex);
+    }
+
+    while (!stopping.load(std::memory_order_acquire))
+    {
+        if (Job* job = FindJob(workerIndex))
+        {
+            Execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeCondition.wait(lock, [this]
+                           { return stopping.load() || queuedJobs.load(std::memory_order_acquire) != 0; });
+    }
+
+    currentWorker = {};
+}
+
+void JobSystem::PinCurrentThread(uint32_t core)
+{
+    const uint32_t coreCount = std::max(std::thread::hardware_concurrency(), 1u);
+    core %= coreCount;
+
+#if defined(_WIN32)
+    if (core < 64)
+    {
+        SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << core);
+    }
+#elif defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(core, &cpuSet);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+#else
+    // Thread affinity is not exposed on this platform; pinning is a hint only
+    (void)core;
+#endif
+}
+
+}  // namespace vkdemo
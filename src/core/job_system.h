@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vkdemo
+{
+
+//=============================================================================
+// Job System
+//=============================================================================
+
+struct Job;
+
+// Counts unfinished jobs. Jobs submitted with a counter increment it and decrement it on
+// completion; jobs submitted with RunAfter are held until their dependency counter reaches zero,
+// which is how job graphs are expressed.
+class JobCounter
+{
+public:
+    JobCounter() = default;
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool IsDone() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<uint32_t> pending{0};
+    std::mutex mutex;
+    std::vector<Job*> continuations;
+};
+
+struct JobSystemConfig
+{
+    // Total number of threads executing jobs, including the thread that calls Initialize (0 = one per core)
+    uint32_t workerCount = 0;
+    // Pin worker i to logical core i (worker 0 being the initializing thread)
+    bool pinThreads = false;
+};
+
+// Work-stealing scheduler. Every worker owns a Chase-Lev deque: it pushes and pops at the bottom
+// (LIFO, cache warm) while idle workers steal from the top (FIFO, largest remaining work). The
+// thread that initialized the system is worker 0 and executes jobs while it waits; threads that are
+// not workers submit through a shared injection queue.
+class JobSystem
+{
+public:
+    using JobFunction = std::function<void()>;
+    // Called once per tile with the tile coordinates and the index of the executing worker, which
+    // selects per-worker scratch memory
+    using TileFunction = std::function<void(uint32_t tileX, uint32_t tileY, uint32_t workerIndex)>;
+
+    JobSystem() = default;
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void Initialize(const JobSystemConfig& config = {});
+    void Cleanup();
+
+    uint32_t GetWorkerCount() const { return static_cast<uint32_t>(workers.size()); }
+
+    void Run(JobFunction function, JobCounter* counter = nullptr);
+    void RunAfter(JobCounter& dependency, JobFunction function, JobCounter* counter = nullptr);
+
+    // Executes other jobs until the counter reaches zero; must be called from a worker thread
+    void Wait(JobCounter& counter);
+
+    // Runs function over every tile of a countX x countY grid and returns when all are done. Tiles are
+    // grouped into row-major batches of batchSize (0 = a few batches per worker) so stealing stays cheap.
+    void ParallelFor2D(uint32_t countX, uint32_t countY, const TileFunction& function, uint32_t batchSize = 0);
+
+    // Index of the calling thread, or INVALID_WORKER for threads outside this system
+    uint32_t GetCurrentWorkerIndex() const;
+
+    static constexpr uint32_t INVALID_WORKER = ~0u;
+
+private:
+    // Fixed-capacity Chase-Lev deque (Le et al., "Correct and Efficient Work-Stealing for Weak Memory
+    // Models"). Push and Pop are owner-only; Steal may be called from any thread.
+    class WorkStealingDeque
+    {
+    public:
+        static constexpr int64_t CAPACITY = 4096;
+
+        bool Push(Job* job);
+        Job* Pop();
+        Job* Steal();
+
+    private:
+        alignas(64) std::atomic<int64_t> top{0};
+        alignas(64) std::atomic<int64_t> bottom{0};
+        std::unique_ptr<std::atomic<Job*>[]> buffer{new std::atomic<Job*>[CAPACITY]};
+    };
+
+    struct Worker
+    {
+        WorkStealingDeque deque;
+        std::thread thread;
+        uint32_t stealCursor = 0;
+    };
+
+    void WorkerLoop(uint32_t workerIndex);
+    // Queues a job without waking anyone; callers follow up with WakeWorkers
+    void Submit(Job* job);
+    Job* FindJob(uint32_t workerIndex);
+    void Execute(Job* job);
+    void Complete(JobCounter& counter);
+    void WakeWorkers(bool all);
+
+    static void PinCurrentThread(uint32_t core);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    bool pinThreads = false;
+
+    std::mutex injectionMutex;
+    std::vector<Job*> injectionQueue;
+
+    // Jobs pushed but not yet taken; idle workers sleep while it is zero
+    std::atomic<uint32_t> queuedJobs{0};
+    std::mutex sleepMutex;
+    std::condition_variable wakeCondition;
+    std::atomic<bool> stopping{false};
+};
+
+}  // namespace vkdemo
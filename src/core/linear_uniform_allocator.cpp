@@ -0,0 +1,68 @@
+#include "linear_uniform_allocator.h"
+
+#include "vulkan_context.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace vkdemo
+{
+
+static VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+void LinearUniformAllocator::Initialize(VulkanContext& ctx, VkDeviceSize bytesPerFrame)
+{
+    alignment = std::max<VkDeviceSize>(ctx.GetPhysicalDeviceProperties().limits.minUniformBufferOffsetAlignment, 16);
+    frameCapacity = AlignUp(bytesPerFrame, alignment);
+
+    VkDeviceSize totalSize = frameCapacity * VulkanContext::MAX_FRAMES_IN_FLIGHT;
+    ctx.CreateBuffer(totalSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, buffer, memory);
+
+    void* data;
+    vkMapMemory(ctx.GetDevice(), memory, 0, totalSize, 0, &data);
+    mapped = static_cast<uint8_t*>(data);
+
+    frameBase = 0;
+    head = 0;
+}
+
+void LinearUniformAllocator::Cleanup(VkDevice device)
+{
+    if (buffer == VK_NULL_HANDLE)
+        return;
+
+    vkUnmapMemory(device, memory);
+    vkDestroyBuffer(device, buffer, nullptr);
+    vkFreeMemory(device, memory, nullptr);
+
+    buffer = VK_NULL_HANDLE;
+    memory = VK_NULL_HANDLE;
+    mapped = nullptr;
+}
+
+void LinearUniformAllocator::BeginFrame(uint32_t frameIndex)
+{
+    frameBase = frameCapacity * frameIndex;
+    head = 0;
+}
+
+LinearUniformAllocator::Allocation LinearUniformAllocator::Allocate(VkDeviceSize size)
+{
+    VkDeviceSize alignedSize = AlignUp(size, alignment);
+    if (head + alignedSize > frameCapacity)
+    {
+        throw std::runtime_error("Linear uniform allocator out of memory for this frame!");
+    }
+
+    Allocation allocation;
+    allocation.offset = static_cast<uint32_t>(frameBase + head);
+    allocation.mapped = mapped + frameBase + head;
+    head += alignedSize;
+    return allocation;
+}
+
+}  // namespace vkdemo
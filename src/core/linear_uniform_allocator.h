@@ -0,0 +1,59 @@
+#pragma once
+
+#include "vulkan_utils.h"
+
+#include <cstring>
+
+namespace vkdemo
+{
+
+//=============================================================================
+// Linear Uniform Allocator
+//=============================================================================
+
+// Per-frame bump allocator over a single persistently mapped uniform buffer.
+// The buffer is split into one arena per frame in flight; every allocation is
+// aligned to minUniformBufferOffsetAlignment and is bound through a
+// VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC descriptor using the returned offset.
+class LinearUniformAllocator
+{
+public:
+    struct Allocation
+    {
+        void* mapped = nullptr;
+        uint32_t offset = 0;
+    };
+
+    void Initialize(VulkanContext& ctx, VkDeviceSize bytesPerFrame);
+    void Cleanup(VkDevice device);
+
+    // Rewinds the arena of the given frame. Must only be called once the GPU has
+    // finished with that frame (i.e. after its in-flight fence has been waited on).
+    void BeginFrame(uint32_t frameIndex);
+
+    Allocation Allocate(VkDeviceSize size);
+
+    // Copies the value into the current frame arena and returns its dynamic offset
+    template <typename T>
+    uint32_t Push(const T& value)
+    {
+        Allocation allocation = Allocate(sizeof(T));
+        memcpy(allocation.mapped, &value, sizeof(T));
+        return allocation.offset;
+    }
+
+    VkBuffer GetBuffer() const { return buffer; }
+    VkDeviceSize GetFrameCapacity() const { return frameCapacity; }
+
+private:
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    uint8_t* mapped = nullptr;
+
+    VkDeviceSize alignment = 256;
+    VkDeviceSize frameCapacity = 0;
+    VkDeviceSize frameBase = 0;
+    VkDeviceSize head = 0;
+};
+
+}  // namespace vkdemo
@@ -0,0 +1,209 @@
+#include "mesh_file.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace vkdemo
+{
+
+static uint64_t AlignBlob(uint64_t value)
+{
+    return (value + MESH_FILE_BLOB_ALIGNMENT - 1) & ~(MESH_FILE_BLOB_ALIGNMENT - 1);
+}
+
+MeshFile::~MeshFile()
+{
+    Close();
+}
+
+void MeshFile::Open(const std::string& path)
+{
+    Close();
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error("Failed to open mesh file: " + path);
+    }
+    fileHandle = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < static_cast<LONGLONG>(sizeof(MeshFileHeader)))
+    {
+        Close();
+        throw std::runtime_error("Mesh file is too small: " + path);
+    }
+    mappingSize = static_cast<size_t>(size.QuadPart);
+
+    mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mappingHandle ? MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view)
+    {
+        Close();
+        throw std::runtime_error("Failed to map mesh file: " + path);
+    }
+    mapping = static_cast<const uint8_t*>(view);
+#else
+    fileDescriptor = open(path.c_str(), O_RDONLY);
+    if (fileDescriptor < 0)
+    {
+        throw std::runtime_error("Failed to open mesh file: " + path);
+    }
+
+    struct stat status;
+    if (fstat(fileDescriptor, &status) != 0 || status.st_size < static_cast<off_t>(sizeof(MeshFileHeader)))
+    {
+        Close();
+        throw std::runtime_error("Mesh file is too small: " + path);
+    }
+    mappingSize = static_cast<size_t>(status.st_size);
+
+    void* view = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    if (view == MAP_FAILED)
+    {
+        Close();
+        throw std::runtime_error("Failed to map mesh file: " + path);
+    }
+    mapping = static_cast<const uint8_t*>(view);
+
+    // The blobs are read front to back (the index blob by validation first)
+    madvise(view, mappingSize, MADV_SEQUENTIAL);
+#endif
+
+    // Validate the header, the mesh table and every index, so a truncated or foreign file can neither read past
+    // the mapping nor make a draw fetch outside its mesh's vertices (vertex pulling reads them through a raw
+    // device address, which robustBufferAccess does not cover)
+    const MeshFileHeader& header = GetHeader();
+    auto fits = [&](uint64_t offset, uint64_t size) { return offset <= mappingSize && size <= mappingSize - offset; };
+
+    bool valid = header.magic == MESH_FILE_MAGIC && header.version == MESH_FILE_VERSION &&
+                 header.vertexStride == sizeof(MeshFileVertex) &&
+                 header.vertexDataOffset % MESH_FILE_BLOB_ALIGNMENT == 0 &&
+                 header.indexDataOffset % MESH_FILE_BLOB_ALIGNMENT == 0 &&
+                 fits(sizeof(MeshFileHeader), static_cast<uint64_t>(header.meshCount) * sizeof(MeshFileMesh)) &&
+                 header.vertexCount <= UINT64_MAX / sizeof(MeshFileVertex) &&
+                 header.indexCount <= UINT64_MAX / sizeof(uint32_t) &&
+                 fits(header.vertexDataOffset, header.vertexCount * sizeof(MeshFileVertex)) &&
+                 fits(header.indexDataOffset, header.indexCount * sizeof(uint32_t));
+
+    for (uint32_t i = 0; valid && i < header.meshCount; i++)
+    {
+        const MeshFileMesh& mesh = GetMesh(i);
+        valid = static_cast<uint64_t>(mesh.firstIndex) + mesh.indexCount <= header.indexCount &&
+                mesh.vertexOffset >= 0 &&
+                static_cast<uint64_t>(mesh.vertexOffset) + mesh.vertexCount <= header.vertexCount;
+    }
+
+    // Indices are relative to the mesh's vertexOffset
+    for (uint32_t i = 0; valid && i < header.meshCount; i++)
+    {
+        const MeshFileMesh& mesh = GetMesh(i);
+        const uint32_t* indices = static_cast<const uint32_t*>(GetIndexData()) + mesh.firstIndex;
+        uint32_t maxIndex = 0;
+        for (uint32_t j = 0; j < mesh.indexCount; j++)
+        {
+            maxIndex = std::max(maxIndex, indices[j]);
+        }
+        valid = mesh.indexCount == 0 || maxIndex < mesh.vertexCount;
+    }
+
+    if (!valid)
+    {
+        Close();
+        throw std::runtime_error("Invalid mesh file: " + path);
+    }
+}
+
+void MeshFile::Close()
+{
+#if defined(_WIN32)
+    if (mapping)
+        UnmapViewOfFile(mapping);
+    if (mappingHandle)
+        CloseHandle(mappingHandle);
+    if (fileHandle)
+        CloseHandle(fileHandle);
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    if (mapping)
+        munmap(const_cast<uint8_t*>(mapping), mappingSize);
+    if (fileDescriptor >= 0)
+        close(fileDescriptor);
+    fileDescriptor = -1;
+#endif
+    mapping = nullptr;
+    mappingSize = 0;
+}
+
+const MeshFileMesh& MeshFile::GetMesh(uint32_t index) const
+{
+    return reinterpret_cast<const MeshFileMesh*>(mapping + sizeof(MeshFileHeader))[index];
+}
+
+void WriteMeshFile(const std::string& path, const std::vector<MeshFileMesh>& meshes,
+                   const std::vector<MeshFileVertex>& vertices, const std::vector<uint32_t>& indices)
+{
+    MeshFileHeader header{};
+    header.magic = MESH_FILE_MAGIC;
+    header.version = MESH_FILE_VERSION;
+    header.meshCount = static_cast<uint32_t>(meshes.size());
+    header.vertexStride = sizeof(MeshFileVertex);
+    header.vertexCount = vertices.size();
+    header.indexCount = indices.size();
+    header.vertexDataOffset = AlignBlob(sizeof(MeshFileHeader) + sizeof(MeshFileMesh) * meshes.size());
+    header.indexDataOffset = AlignBlob(header.vertexDataOffset + sizeof(MeshFileVertex) * vertices.size());
+    uint64_t fileSize = AlignBlob(header.indexDataOffset + sizeof(uint32_t) * indices.size());
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file)
+    {
+        throw std::runtime_error("Failed to create mesh file: " + path);
+    }
+
+    uint64_t written = 0;
+    auto write = [&](const void* data, uint64_t size)
+    {
+        if (size > 0 && std::fwrite(data, 1, static_cast<size_t>(size), file) != size)
+        {
+            std::fclose(file);
+            throw std::runtime_error("Failed to write mesh file: " + path);
+        }
+        written += size;
+    };
+    auto padTo = [&](uint64_t offset)
+    {
+        static const uint8_t zeros[MESH_FILE_BLOB_ALIGNMENT] = {};
+        write(zeros, offset - written);
+    };
+
+    write(&header, sizeof(header));
+    write(meshes.data(), sizeof(MeshFileMesh) * meshes.size());
+    padTo(header.vertexDataOffset);
+    write(vertices.data(), sizeof(MeshFileVertex) * vertices.size());
+    padTo(header.indexDataOffset);
+    write(indices.data(), sizeof(uint32_t) * indices.size());
+    padTo(fileSize);
+
+    if (std::fclose(file) != 0)
+    {
+        throw std::runtime_error("Failed to write mesh file: " + path);
+    }
+}
+
+}  // namespace vkdemo
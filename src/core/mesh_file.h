@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vkdemo
+{
+
+//=============================================================================
+// Binary Mesh File
+//=============================================================================
+
+// Layout of a .vkmesh file (little-endian):
+//   MeshFileHeader
+//   MeshFileMesh[meshCount]
+//   vertex blob: MeshFileVertex[vertexCount], at a MESH_FILE_BLOB_ALIGNMENT boundary
+//   index blob:  uint32_t[indexCount], at a MESH_FILE_BLOB_ALIGNMENT boundary
+// Each blob is padded to the alignment too, so page-granular views of a blob never leave the file.
+// The blobs are in GPU layout: a loader copies (or imports) them without touching individual vertices.
+constexpr uint32_t MESH_FILE_MAGIC = 0x464D4B56;  // "VKMF"
+constexpr uint32_t MESH_FILE_VERSION = 1;
+constexpr uint64_t MESH_FILE_BLOB_ALIGNMENT = 4096;
+
+struct MeshFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t meshCount;
+    uint32_t vertexStride;
+    uint64_t vertexCount;
+    uint64_t indexCount;
+    uint64_t vertexDataOffset;
+    uint64_t indexDataOffset;
+};
+
+// One drawable range of the shared blobs, with model-space bounds. boundingRadius is measured from
+// the model origin, the point instance transforms place.
+struct MeshFileMesh
+{
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    int32_t vertexOffset;
+    uint32_t vertexCount;
+    float boundsMin[3];
+    float boundsMax[3];
+    float boundingRadius;
+    uint32_t reserved;
+};
+
+// Matches TriangleVertex of the motion blur example
+struct MeshFileVertex
+{
+    float position[3];
+    float color[3];
+};
+
+static_assert(sizeof(MeshFileHeader) == 48, "Mesh file header layout changed");
+static_assert(sizeof(MeshFileMesh) == 48, "Mesh file mesh layout changed");
+static_assert(sizeof(MeshFileVertex) == 24, "Mesh file vertex layout changed");
+
+// Read-only view of a .vkmesh file through a memory mapping. The header, the mesh table and every
+// index are validated on Open, which pages in the index blob; the vertex blob is only paged in when
+// something reads it.
+class MeshFile
+{
+public:
+    MeshFile() = default;
+    ~MeshFile();
+
+    MeshFile(const MeshFile&) = delete;
+    MeshFile& operator=(const MeshFile&) = delete;
+
+    void Open(const std::string& path);
+    void Close();
+
+    const MeshFileHeader& GetHeader() const { return *reinterpret_cast<const MeshFileHeader*>(mapping); }
+    uint32_t GetMeshCount() const { return GetHeader().meshCount; }
+    const MeshFileMesh& GetMesh(uint32_t index) const;
+
+    // Blobs inside the mapping; the pointers stay valid until Close
+    const void* GetVertexData() const { return mapping + GetHeader().vertexDataOffset; }
+    size_t GetVertexDataSize() const { return static_cast<size_t>(GetHeader().vertexCount * sizeof(MeshFileVertex)); }
+    const void* GetIndexData() const { return mapping + GetHeader().indexDataOffset; }
+    size_t GetIndexDataSize() const { return static_cast<size_t>(GetHeader().indexCount * sizeof(uint32_t)); }
+
+    // Size of the whole file; blob offsets in the header are relative to GetData()
+    const uint8_t* GetData() const { return mapping; }
+    size_t GetSize() const { return mappingSize; }
+
+private:
+    const uint8_t* mapping = nullptr;
+    size_t mappingSize = 0;
+#if defined(_WIN32)
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int fileDescriptor = -1;
+#endif
+};
+
+// Writes a .vkmesh file; used by the offline converter
+void WriteMeshFile(const std::string& path, const std::vector<MeshFileMesh>& meshes,
+                   const std::vector<MeshFileVertex>& vertices, const std::vector<uint32_t>& indices);
+
+}  // namespace vkdemo
@@ -0,0 +1,48 @@
+#include "resolution_governor.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace vkdemo
+{
+
+ResolutionGovernor::ResolutionGovernor(const ResolutionGovernorConfig& config) : config(config)
+{
+    this->config.minScale = std::clamp(config.minScale, 0.1f, 1.0f);
+    this->config.maxScale = std::clamp(config.maxScale, this->config.minScale, 1.0f);
+    this->config.targetMilliseconds = std::max(config.targetMilliseconds, 0.1f);
+    Reset(this->config.maxScale);
+}
+
+void ResolutionGovernor::Reset(float newScale)
+{
+    scale = std::clamp(newScale, config.minScale, config.maxScale);
+    integral = config.integralGain > 0.0f ? scale * scale / config.integralGain : 0.0f;
+    previousError = 0.0f;
+    hasPreviousError = false;
+}
+
+float ResolutionGovernor::Update(float gpuMilliseconds)
+{
+    if (!(gpuMilliseconds > 0.0f))
+        return scale;
+
+    float error = (config.targetMilliseconds - gpuMilliseconds) / config.targetMilliseconds;
+    float derivative = hasPreviousError ? error - previousError : 0.0f;
+    previousError = error;
+    hasPreviousError = true;
+
+    // Anti-windup: the integral alone never asks for an area outside the scale range
+    float minArea = config.minScale * config.minScale;
+    float maxArea = config.maxScale * config.maxScale;
+    if (config.integralGain > 0.0f)
+    {
+        integral = std::clamp(integral + error, minArea / config.integralGain, maxArea / config.integralGain);
+    }
+
+    float area = config.proportionalGain * error + config.integralGain * integral + config.derivativeGain * derivative;
+    scale = std::sqrt(std::clamp(area, minArea, maxArea));
+    return scale;
+}
+
+}  // namespace vkdemo
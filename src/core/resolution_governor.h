@@ -0,0 +1,51 @@
+#pragma once
+
+namespace vkdemo
+{
+
+//=============================================================================
+// Resolution Governor
+//=============================================================================
+
+struct ResolutionGovernorConfig
+{
+    // Frame time the governor steers the measured GPU time towards
+    float targetMilliseconds = 16.0f;
+
+    // Render scale range, per axis, as a fraction of the output extent
+    float minScale = 0.5f;
+    float maxScale = 1.0f;
+
+    // Gains on the relative error (target - measured) / target, acting on the rendered area (scale
+    // squared), which frame cost is close to proportional to. The measurement trails the frame it steers
+    // by the frames in flight, so the integral gain is kept low enough not to overshoot through the delay.
+    float proportionalGain = 0.3f;
+    float integralGain = 0.1f;
+    float derivativeGain = 0.05f;
+};
+
+// PID controller from measured GPU frame time to render scale. The integral term holds the steady-state
+// area and is clamped to the scale range, so a long stretch over or under budget does not wind it up.
+class ResolutionGovernor
+{
+public:
+    explicit ResolutionGovernor(const ResolutionGovernorConfig& config = ResolutionGovernorConfig());
+
+    // Restarts from the given scale with no error history
+    void Reset(float scale);
+
+    // Feeds one measured frame and returns the scale for the next one
+    float Update(float gpuMilliseconds);
+
+    float GetScale() const { return scale; }
+    const ResolutionGovernorConfig& GetConfig() const { return config; }
+
+private:
+    ResolutionGovernorConfig config;
+    float scale = 1.0f;
+    float integral = 0.0f;
+    float previousError = 0.0f;
+    bool hasPreviousError = false;
+};
+
+}  // namespace vkdemo
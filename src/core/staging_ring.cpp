@@ -0,0 +1,135 @@
+#include "staging_ring.h"
+
+#include "vulkan_context.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace vkdemo
+{
+
+void StagingRing::Initialize(VulkanContext& ctx, VkDeviceSize size, uint32_t chunkCount)
+{
+    context = &ctx;
+    chunkSize = size;
+    VkDevice device = ctx.GetDevice();
+
+    ctx.CreateBuffer(chunkSize * chunkCount, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, buffer, memory);
+
+    void* data;
+    vkMapMemory(device, memory, 0, chunkSize * chunkCount, 0, &data);
+    mapped = static_cast<uint8_t*>(data);
+
+    chunks.resize(chunkCount);
+    std::vector<VkCommandBuffer> commandBuffers(chunkCount);
+
+    VkCommandBufferAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.commandPool = ctx.GetCommandPool();
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandBufferCount = chunkCount;
+    if (vkAllocateCommandBuffers(device, &allocInfo, commandBuffers.data()) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to allocate staging command buffers!");
+    }
+
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    for (uint32_t i = 0; i < chunkCount; i++)
+    {
+        chunks[i].commandBuffer = commandBuffers[i];
+        if (vkCreateFence(device, &fenceInfo, nullptr, &chunks[i].fence) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create staging fence!");
+        }
+    }
+    nextChunk = 0;
+}
+
+void StagingRing::Cleanup()
+{
+    if (buffer == VK_NULL_HANDLE)
+        return;
+
+    Flush();
+
+    VkDevice device = context->GetDevice();
+    for (Chunk& chunk : chunks)
+    {
+        vkFreeCommandBuffers(device, context->GetCommandPool(), 1, &chunk.commandBuffer);
+        vkDestroyFence(device, chunk.fence, nullptr);
+    }
+    chunks.clear();
+
+    vkUnmapMemory(device, memory);
+    vkDestroyBuffer(device, buffer, nullptr);
+    vkFreeMemory(device, memory, nullptr);
+
+    buffer = VK_NULL_HANDLE;
+    memory = VK_NULL_HANDLE;
+    mapped = nullptr;
+}
+
+void StagingRing::Upload(VkBuffer dstBuffer, VkDeviceSize dstOffset, const void* source, VkDeviceSize size)
+{
+    VkDevice device = context->GetDevice();
+    const uint8_t* bytes = static_cast<const uint8_t*>(source);
+
+    for (VkDeviceSize done = 0; done < size;)
+    {
+        Chunk& chunk = chunks[nextChunk];
+        if (chunk.pending)
+        {
+            vkWaitForFences(device, 1, &chunk.fence, VK_TRUE, UINT64_MAX);
+            vkResetFences(device, 1, &chunk.fence);
+            chunk.pending = false;
+        }
+
+        VkDeviceSize chunkOffset = chunkSize * nextChunk;
+        VkDeviceSize copySize = std::min(chunkSize, size - done);
+        memcpy(mapped + chunkOffset, bytes + done, static_cast<size_t>(copySize));
+
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        vkBeginCommandBuffer(chunk.commandBuffer, &beginInfo);
+
+        VkBufferCopy copyRegion{};
+        copyRegion.srcOffset = chunkOffset;
+        copyRegion.dstOffset = dstOffset + done;
+        copyRegion.size = copySize;
+        vkCmdCopyBuffer(chunk.commandBuffer, buffer, dstBuffer, 1, &copyRegion);
+        vkEndCommandBuffer(chunk.commandBuffer);
+
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &chunk.commandBuffer;
+        if (vkQueueSubmit(context->GetGraphicsQueue(), 1, &submitInfo, chunk.fence) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to submit staging copy!");
+        }
+
+        chunk.pending = true;
+        nextChunk = (nextChunk + 1) % static_cast<uint32_t>(chunks.size());
+        done += copySize;
+    }
+}
+
+void StagingRing::Flush()
+{
+    VkDevice device = context->GetDevice();
+    for (Chunk& chunk : chunks)
+    {
+        if (!chunk.pending)
+            continue;
+
+        vkWaitForFences(device, 1, &chunk.fence, VK_TRUE, UINT64_MAX);
+        vkResetFences(device, 1, &chunk.fence);
+        chunk.pending = false;
+    }
+}
+
+}  // namespace vkdemo
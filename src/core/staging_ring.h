@@ -0,0 +1,54 @@
+#pragma once
+
+#include "vulkan_utils.h"
+
+#include <vector>
+
+namespace vkdemo
+{
+
+class VulkanContext;
+
+//=============================================================================
+// Staging Ring
+//=============================================================================
+
+// Streams host data into device-local buffers through a ring of persistently mapped staging chunks.
+// An upload of any size needs only chunkSize * chunkCount bytes of staging memory, and filling one
+// chunk (typically page faults on a memory-mapped file) overlaps the GPU copy out of the previous
+// ones. Submits to the graphics queue; meant for load time, not for use between frames.
+class StagingRing
+{
+public:
+    static constexpr VkDeviceSize DEFAULT_CHUNK_SIZE = 8 * 1024 * 1024;
+    static constexpr uint32_t DEFAULT_CHUNK_COUNT = 3;
+
+    void Initialize(VulkanContext& ctx, VkDeviceSize chunkSize = DEFAULT_CHUNK_SIZE,
+                    uint32_t chunkCount = DEFAULT_CHUNK_COUNT);
+    void Cleanup();
+
+    // Copies size bytes from source to dstBuffer at dstOffset. source is no longer read once this
+    // returns; the copy itself completes by the next Flush.
+    void Upload(VkBuffer dstBuffer, VkDeviceSize dstOffset, const void* source, VkDeviceSize size);
+
+    // Waits for every copy submitted so far
+    void Flush();
+
+private:
+    struct Chunk
+    {
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        VkFence fence = VK_NULL_HANDLE;
+        bool pending = false;
+    };
+
+    VulkanContext* context = nullptr;
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    uint8_t* mapped = nullptr;
+    VkDeviceSize chunkSize = 0;
+    std::vector<Chunk> chunks;
+    uint32_t nextChunk = 0;
+};
+
+}  // namespace vkdemo
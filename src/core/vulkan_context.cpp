@@ -3,6 +3,7 @@
 #include "../examples/example_base.h"
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstring>
 #include <iostream>
@@ -13,9 +14,11 @@
 namespace vkdemo
 {
 
-VulkanContext::VulkanContext(uint32_t width, uint32_t height, const std::string& title)
-    : windowWidth(width), windowHeight(height), windowTitle(title)
+VulkanContext::VulkanContext(uint32_t width, uint32_t height, const std::string& title,
+                             const JobSystemConfig& jobConfig, const FrameLoopConfig& frameLoopConfig)
+    : windowWidth(width), windowHeight(height), windowTitle(title), frameLoopConfig(frameLoopConfig)
 {
+    jobSystem.Initialize(jobConfig);
     InitWindow();
     InitVulkan();
 }
@@ -60,6 +63,9 @@ void VulkanContext::InitVulkan()
     CreateCommandPool();
     CreateCommandBuffers();
     CreateSyncObjects();
+    CreateFrameTimeline();
+
+    deletionQueue.Initialize(device);
 }
 
 void VulkanContext::Run(ExampleBase* example)
@@ -72,6 +78,16 @@ void VulkanContext::Run(ExampleBase* example)
     {
         glfwPollEvents();
 
+        // Nothing to render into while minimized; sleep until the window is restored
+        int width = 0, height = 0;
+        glfwGetFramebufferSize(window, &width, &height);
+        if (width == 0 || height == 0)
+        {
+            glfwWaitEvents();
+            lastTime = std::chrono::high_resolution_clock::now();
+            continue;
+        }
+
         auto currentTime = std::chrono::high_resolution_clock::now();
         float deltaTime = std::chrono::duration<float>(currentTime - lastTime).count();
         lastTime = currentTime;
@@ -83,18 +99,33 @@ void VulkanContext::Run(ExampleBase* example)
 
     vkDeviceWaitIdle(device);
 
+    // Deferred callbacks may reference example resources, so run them before the example is torn down
+    deletionQueue.Flush(std::numeric_limits<uint64_t>::max());
+
     example->Cleanup();
 }
 
 void VulkanContext::Cleanup()
 {
+    // Jobs may still reference Vulkan objects; join the workers first
+    jobSystem.Cleanup();
+    deletionQueue.Flush(std::numeric_limits<uint64_t>::max());
     CleanupSwapChain();
 
+    if (frameTimeline != VK_NULL_HANDLE)
+    {
+        vkDestroySemaphore(device, frameTimeline, nullptr);
+    }
+
     for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
     {
         vkDestroySemaphore(device, imageAvailableSemaphores[i], nullptr);
         vkDestroyFence(device, inFlightFences[i], nullptr);
     }
+    for (VkSemaphore semaphore : interpolatedImageAvailableSemaphores)
+    {
+        vkDestroySemaphore(device, semaphore, nullptr);
+    }
     for (size_t i = 0; i < renderFinishedSemaphores.size(); i++)
     {
         vkDestroySemaphore(device, renderFinishedSemaphores[i], nullptr);
@@ -235,9 +266,22 @@ void VulkanContext::PickPhysicalDevice()
         throw std::runtime_error("Failed to find a suitable GPU!");
     }
 
-    VkPhysicalDeviceProperties props;
-    vkGetPhysicalDeviceProperties(physicalDevice, &props);
-    std::cout << "Selected GPU: " << props.deviceName << std::endl;
+    vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+    std::cout << "Selected GPU: " << physicalDeviceProperties.deviceName << std::endl;
+
+    subgroupProperties = {};
+    subgroupProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES;
+    if (physicalDeviceProperties.apiVersion >= VK_API_VERSION_1_1)
+    {
+        VkPhysicalDeviceProperties2 properties2{};
+        properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        properties2.pNext = &subgroupProperties;
+        vkGetPhysicalDeviceProperties2(physicalDevice, &properties2);
+    }
+    else
+    {
+        subgroupProperties.subgroupSize = 1;
+    }
 }
 
 void VulkanContext::CreateLogicalDevice()
@@ -259,14 +303,108 @@ void VulkanContext::CreateLogicalDevice()
     }
 
     VkPhysicalDeviceFeatures deviceFeatures{};
+    enabledVulkan12Features = {};
+    enabledVulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+    // Storage images in the extended formats (the B10G11R11 outputs of the *_packed compute shaders)
+    VkPhysicalDeviceFeatures supportedCoreFeatures{};
+    vkGetPhysicalDeviceFeatures(physicalDevice, &supportedCoreFeatures);
+    storageImageExtendedFormatsSupported = supportedCoreFeatures.shaderStorageImageExtendedFormats == VK_TRUE;
+    deviceFeatures.shaderStorageImageExtendedFormats = supportedCoreFeatures.shaderStorageImageExtendedFormats;
+
+    if (physicalDeviceProperties.apiVersion >= VK_API_VERSION_1_2)
+    {
+        VkPhysicalDeviceVulkan12Features supported12{};
+        supported12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+        VkPhysicalDeviceFeatures2 supportedFeatures{};
+        supportedFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        supportedFeatures.pNext = &supported12;
+        vkGetPhysicalDeviceFeatures2(physicalDevice, &supportedFeatures);
+
+        // Descriptor indexing (bindless resource tables)
+        bindlessSupported = supported12.descriptorIndexing && supported12.runtimeDescriptorArray &&
+                            supported12.descriptorBindingPartiallyBound &&
+                            supported12.descriptorBindingSampledImageUpdateAfterBind &&
+                            supported12.descriptorBindingStorageImageUpdateAfterBind &&
+                            supported12.descriptorBindingUpdateUnusedWhilePending &&
+                            supportedFeatures.features.shaderSampledImageArrayDynamicIndexing &&
+                            supportedFeatures.features.shaderStorageImageArrayDynamicIndexing;
+        if (bindlessSupported)
+        {
+            enabledVulkan12Features.descriptorIndexing = VK_TRUE;
+            enabledVulkan12Features.runtimeDescriptorArray = VK_TRUE;
+            enabledVulkan12Features.descriptorBindingPartiallyBound = VK_TRUE;
+            enabledVulkan12Features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+            enabledVulkan12Features.descriptorBindingStorageImageUpdateAfterBind = VK_TRUE;
+            enabledVulkan12Features.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+            deviceFeatures.shaderSampledImageArrayDynamicIndexing = VK_TRUE;
+            deviceFeatures.shaderStorageImageArrayDynamicIndexing = VK_TRUE;
+        }
+
+        // Half-precision shader arithmetic (the *_fp16 post-process shader variants)
+        enabledVulkan12Features.shaderFloat16 = supported12.shaderFloat16;
+
+        // Timeline semaphores (GPU progress tracking for deferred destruction)
+        timelineSemaphoreSupported = supported12.timelineSemaphore;
+        enabledVulkan12Features.timelineSemaphore = supported12.timelineSemaphore;
+
+        // Indirect draw counts (GPU-driven culling); the compacted draws address their instance through
+        // firstInstance
+        if (supported12.drawIndirectCount && supportedFeatures.features.drawIndirectFirstInstance)
+        {
+            enabledVulkan12Features.drawIndirectCount = VK_TRUE;
+            deviceFeatures.drawIndirectFirstInstance = VK_TRUE;
+        }
+
+        // Buffer device addresses (vertex pulling through GL_EXT_buffer_reference)
+        enabledVulkan12Features.bufferDeviceAddress = supported12.bufferDeviceAddress;
+    }
+
+    // Host pointer import (zero-copy uploads from memory-mapped files); not part of the trimmed volk
+    // tables, so its entry point is loaded below
+    std::vector<const char*> enabledExtensions = deviceExtensions;
+    bool externalMemoryHost = false;
+    if (physicalDeviceProperties.apiVersion >= VK_API_VERSION_1_1)
+    {
+        uint32_t extensionCount = 0;
+        vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, nullptr);
+        std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+        vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, availableExtensions.data());
+
+        for (const auto& extension : availableExtensions)
+        {
+            if (strcmp(extension.extensionName, VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME) == 0)
+            {
+                externalMemoryHost = true;
+                enabledExtensions.push_back(VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME);
+                break;
+            }
+        }
+    }
+    if (externalMemoryHost)
+    {
+        VkPhysicalDeviceExternalMemoryHostPropertiesEXT hostProperties{};
+        hostProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTERNAL_MEMORY_HOST_PROPERTIES_EXT;
+
+        VkPhysicalDeviceProperties2 properties2{};
+        properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        properties2.pNext = &hostProperties;
+        vkGetPhysicalDeviceProperties2(physicalDevice, &properties2);
+        minImportedHostPointerAlignment = hostProperties.minImportedHostPointerAlignment;
+    }
 
     VkDeviceCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    if (physicalDeviceProperties.apiVersion >= VK_API_VERSION_1_2)
+    {
+        createInfo.pNext = &enabledVulkan12Features;
+    }
     createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
     createInfo.pQueueCreateInfos = queueCreateInfos.data();
     createInfo.pEnabledFeatures = &deviceFeatures;
-    createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
-    createInfo.ppEnabledExtensionNames = deviceExtensions.data();
+    createInfo.enabledExtensionCount = static_cast<uint32_t>(enabledExtensions.size());
+    createInfo.ppEnabledExtensionNames = enabledExtensions.data();
 
     if (enableValidationLayers)
     {
@@ -285,11 +423,18 @@ void VulkanContext::CreateLogicalDevice()
 
     volkLoadDevice(device);
 
+    getMemoryHostPointerProperties = nullptr;
+    if (externalMemoryHost)
+    {
+        getMemoryHostPointerProperties = reinterpret_cast<PFN_vkGetMemoryHostPointerPropertiesEXT>(
+            vkGetDeviceProcAddr(device, "vkGetMemoryHostPointerPropertiesEXT"));
+    }
+
     vkGetDeviceQueue(device, indices.graphicsFamily.value(), 0, &graphicsQueue);
     vkGetDeviceQueue(device, indices.presentFamily.value(), 0, &presentQueue);
 }
 
-void VulkanContext::CreateSwapChain()
+void VulkanContext::CreateSwapChain(VkSwapchainKHR oldSwapChain)
 {
     SwapChainSupportDetails swapChainSupport = QuerySwapChainSupport(physicalDevice);
 
@@ -297,7 +442,8 @@ void VulkanContext::CreateSwapChain()
     VkPresentModeKHR presentMode = ChooseSwapPresentMode(swapChainSupport.presentModes);
     VkExtent2D extent = ChooseSwapExtent(swapChainSupport.capabilities);
 
-    uint32_t imageCount = swapChainSupport.capabilities.minImageCount + 1;
+    // Frame interpolation holds two acquired images at once
+    uint32_t imageCount = swapChainSupport.capabilities.minImageCount + (frameLoopConfig.frameInterpolation ? 2 : 1);
     if (swapChainSupport.capabilities.maxImageCount > 0 && imageCount > swapChainSupport.capabilities.maxImageCount)
     {
         imageCount = swapChainSupport.capabilities.maxImageCount;
@@ -331,7 +477,7 @@ void VulkanContext::CreateSwapChain()
     createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
     createInfo.presentMode = presentMode;
     createInfo.clipped = VK_TRUE;
-    createInfo.oldSwapchain = VK_NULL_HANDLE;
+    createInfo.oldSwapchain = oldSwapChain;
 
     if (vkCreateSwapchainKHR(device, &createInfo, nullptr, &swapChain) != VK_SUCCESS)
     {
@@ -384,12 +530,20 @@ void VulkanContext::CreateCommandBuffers()
     {
         throw std::runtime_error("Failed to allocate command buffers!");
     }
+
+    if (frameLoopConfig.frameInterpolation)
+    {
+        interpolatedCommandBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+        if (vkAllocateCommandBuffers(device, &allocInfo, interpolatedCommandBuffers.data()) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to allocate command buffers!");
+        }
+    }
 }
 
 void VulkanContext::CreateSyncObjects()
 {
     imageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
-    renderFinishedSemaphores.resize(swapChainImages.size());
     inFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
     imagesInFlight.resize(swapChainImages.size(), VK_NULL_HANDLE);
 
@@ -409,6 +563,50 @@ void VulkanContext::CreateSyncObjects()
         }
     }
 
+    if (frameLoopConfig.frameInterpolation)
+    {
+        interpolatedImageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
+        for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+        {
+            if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &interpolatedImageAvailableSemaphores[i]) !=
+                VK_SUCCESS)
+            {
+                throw std::runtime_error("Failed to create sync objects!");
+            }
+        }
+    }
+
+    CreateRenderFinishedSemaphores();
+}
+
+void VulkanContext::CreateFrameTimeline()
+{
+    if (!timelineSemaphoreSupported)
+        return;
+
+    VkSemaphoreTypeCreateInfo typeInfo{};
+    typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeInfo.initialValue = 0;
+
+    VkSemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreInfo.pNext = &typeInfo;
+
+    if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &frameTimeline) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create frame timeline semaphore!");
+    }
+}
+
+void VulkanContext::CreateRenderFinishedSemaphores()
+{
+    // One per swapchain image, since a present may still be waiting on it when the frame slot is reused
+    renderFinishedSemaphores.resize(swapChainImages.size());
+
+    VkSemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
     for (size_t i = 0; i < swapChainImages.size(); i++)
     {
         if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &renderFinishedSemaphores[i]) != VK_SUCCESS)
@@ -422,6 +620,14 @@ void VulkanContext::DrawFrame(ExampleBase* example)
 {
     vkWaitForFences(device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
 
+    // The fence just waited on belongs to frame (frameNumber - MAX_FRAMES_IN_FLIGHT), so it and every
+    // frame before it have completed
+    if (frameNumber >= MAX_FRAMES_IN_FLIGHT)
+    {
+        fenceCompletedValue = frameNumber - MAX_FRAMES_IN_FLIGHT + 1;
+    }
+    deletionQueue.Flush(GetCompletedTimelineValue());
+
     uint32_t imageIndex;
     VkResult result = vkAcquireNextImageKHR(device, swapChain, UINT64_MAX, imageAvailableSemaphores[currentFrame],
                                             VK_NULL_HANDLE, &imageIndex);
@@ -436,19 +642,48 @@ void VulkanContext::DrawFrame(ExampleBase* example)
         throw std::runtime_error("Failed to acquire swap chain image!");
     }
 
-    if (imagesInFlight[imageIndex] != VK_NULL_HANDLE)
+    // Frame interpolation presents a second image, synthesized by the example, ahead of the rendered one.
+    // If it cannot be acquired the rendered image is still presented and the swapchain recreated after it.
+    bool interpolate = frameLoopConfig.frameInterpolation && example->SupportsFrameInterpolation();
+    uint32_t interpolatedImageIndex = 0;
+    if (interpolate)
     {
-        vkWaitForFences(device, 1, &imagesInFlight[imageIndex], VK_TRUE, UINT64_MAX);
+        result = vkAcquireNextImageKHR(device, swapChain, UINT64_MAX,
+                                       interpolatedImageAvailableSemaphores[currentFrame], VK_NULL_HANDLE,
+                                       &interpolatedImageIndex);
+        if (result == VK_ERROR_OUT_OF_DATE_KHR)
+        {
+            interpolate = false;
+            framebufferResized = true;
+        }
+        else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR)
+        {
+            throw std::runtime_error("Failed to acquire swap chain image!");
+        }
+    }
+
+    // Wait for the frames still using either image before resetting the fence, which an image may be tied to
+    auto waitForImage = [&](uint32_t index)
+    {
+        if (imagesInFlight[index] != VK_NULL_HANDLE)
+        {
+            vkWaitForFences(device, 1, &imagesInFlight[index], VK_TRUE, UINT64_MAX);
+        }
+        imagesInFlight[index] = inFlightFences[currentFrame];
+    };
+    waitForImage(imageIndex);
+    if (interpolate)
+    {
+        waitForImage(interpolatedImageIndex);
     }
-    imagesInFlight[imageIndex] = inFlightFences[currentFrame];
 
     vkResetFences(device, 1, &inFlightFences[currentFrame]);
-    vkResetCommandBuffer(commandBuffers[currentFrame], 0);
 
-    VkCommandBuffer cmd = commandBuffers[currentFrame];
     VkCommandBufferBeginInfo beginInfo{};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 
+    VkCommandBuffer cmd = commandBuffers[currentFrame];
+    vkResetCommandBuffer(cmd, 0);
     if (vkBeginCommandBuffer(cmd, &beginInfo) != VK_SUCCESS)
     {
         throw std::runtime_error("Failed to begin recording command buffer!");
@@ -461,85 +696,147 @@ void VulkanContext::DrawFrame(ExampleBase* example)
         throw std::runtime_error("Failed to record command buffer!");
     }
 
-    VkSubmitInfo submitInfo{};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    // The interpolated frame reads the results of the rendered one, so it is recorded and submitted after it
+    VkCommandBuffer interpolatedCmd = VK_NULL_HANDLE;
+    if (interpolate)
+    {
+        interpolatedCmd = interpolatedCommandBuffers[currentFrame];
+        vkResetCommandBuffer(interpolatedCmd, 0);
+        if (vkBeginCommandBuffer(interpolatedCmd, &beginInfo) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to begin recording command buffer!");
+        }
 
-    VkSemaphore waitSemaphores[] = {imageAvailableSemaphores[currentFrame]};
-    VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-    submitInfo.waitSemaphoreCount = 1;
-    submitInfo.pWaitSemaphores = waitSemaphores;
-    submitInfo.pWaitDstStageMask = waitStages;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &commandBuffers[currentFrame];
+        example->RecordInterpolatedFrame(interpolatedCmd, interpolatedImageIndex);
 
-    VkSemaphore signalSemaphores[] = {renderFinishedSemaphores[imageIndex]};
-    submitInfo.signalSemaphoreCount = 1;
-    submitInfo.pSignalSemaphores = signalSemaphores;
+        if (vkEndCommandBuffer(interpolatedCmd) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to record command buffer!");
+        }
+    }
+
+    // Each batch waits for its image and signals its present; the last one also signals the frame timeline.
+    // The binary semaphore's entry in signalValues is ignored.
+    VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    VkSemaphore renderedSignals[] = {renderFinishedSemaphores[imageIndex], frameTimeline};
+    VkSemaphore interpolatedSignals[] = {renderFinishedSemaphores[interpolatedImageIndex], frameTimeline};
+    uint64_t signalValues[] = {0, GetCurrentTimelineValue()};
+
+    VkTimelineSemaphoreSubmitInfo timelineInfo{};
+    timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timelineInfo.signalSemaphoreValueCount = 2;
+    timelineInfo.pSignalSemaphoreValues = signalValues;
 
-    if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, inFlightFences[currentFrame]) != VK_SUCCESS)
+    auto fillSubmit = [&](VkSubmitInfo& submitInfo, const VkSemaphore& waitSemaphore,
+                          const VkCommandBuffer& commandBuffer, const VkSemaphore* signalSemaphores, bool last)
     {
-        throw std::runtime_error("Failed to submit draw command buffer!");
-    }
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.waitSemaphoreCount = 1;
+        submitInfo.pWaitSemaphores = &waitSemaphore;
+        submitInfo.pWaitDstStageMask = &waitStage;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &commandBuffer;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = signalSemaphores;
+        if (last && timelineSemaphoreSupported)
+        {
+            submitInfo.pNext = &timelineInfo;
+            submitInfo.signalSemaphoreCount = 2;
+        }
+    };
 
-    VkPresentInfoKHR presentInfo{};
-    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-    presentInfo.waitSemaphoreCount = 1;
-    presentInfo.pWaitSemaphores = signalSemaphores;
+    std::array<VkSubmitInfo, 2> submitInfos{};
+    fillSubmit(submitInfos[0], imageAvailableSemaphores[currentFrame], cmd, renderedSignals, !interpolate);
+    if (interpolate)
+    {
+        fillSubmit(submitInfos[1], interpolatedImageAvailableSemaphores[currentFrame], interpolatedCmd,
+                   interpolatedSignals, true);
+    }
 
-    VkSwapchainKHR swapChains[] = {swapChain};
-    presentInfo.swapchainCount = 1;
-    presentInfo.pSwapchains = swapChains;
-    presentInfo.pImageIndices = &imageIndex;
+    if (vkQueueSubmit(graphicsQueue, interpolate ? 2 : 1, submitInfos.data(), inFlightFences[currentFrame]) !=
+        VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to submit draw command buffer!");
+    }
+    frameNumber++;
 
-    result = vkQueuePresentKHR(presentQueue, &presentInfo);
+    // The interpolated image is presented first. A failed present still releases its image, so the
+    // rendered one is presented regardless.
+    bool outOfDate = false;
+    auto present = [&](uint32_t index)
+    {
+        VkPresentInfoKHR presentInfo{};
+        presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+        presentInfo.waitSemaphoreCount = 1;
+        presentInfo.pWaitSemaphores = &renderFinishedSemaphores[index];
+        presentInfo.swapchainCount = 1;
+        presentInfo.pSwapchains = &swapChain;
+        presentInfo.pImageIndices = &index;
+
+        VkResult presentResult = vkQueuePresentKHR(presentQueue, &presentInfo);
+        if (presentResult == VK_ERROR_OUT_OF_DATE_KHR || presentResult == VK_SUBOPTIMAL_KHR)
+        {
+            outOfDate = true;
+        }
+        else if (presentResult != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to present swap chain image!");
+        }
+    };
+    if (interpolate)
+    {
+        present(interpolatedImageIndex);
+    }
+    present(imageIndex);
 
-    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || framebufferResized)
+    if (outOfDate || framebufferResized)
     {
         framebufferResized = false;
         RecreateSwapChain(example);
     }
-    else if (result != VK_SUCCESS)
-    {
-        throw std::runtime_error("Failed to present swap chain image!");
-    }
 
     currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
 }
 
 void VulkanContext::RecreateSwapChain(ExampleBase* example)
 {
+    // A minimized window has no valid extent; keep the current swapchain and retry once it is restored
     int width = 0, height = 0;
     glfwGetFramebufferSize(window, &width, &height);
-    while (width == 0 || height == 0)
+    if (width == 0 || height == 0)
     {
-        glfwGetFramebufferSize(window, &width, &height);
-        glfwWaitEvents();
+        framebufferResized = true;
+        return;
     }
 
-    vkDeviceWaitIdle(device);
-
     example->OnSwapChainCleanup();
-    CleanupSwapChain();
 
-    CreateSwapChain();
+    // Hand the old swapchain to the new one and retire it through the deferred destruction queue,
+    // so frames still in flight finish presenting without a device-wide wait
+    VkSwapchainKHR oldSwapChain = swapChain;
+    std::vector<VkImageView> oldImageViews = swapChainImageViews;
+    std::vector<VkSemaphore> oldRenderFinishedSemaphores = renderFinishedSemaphores;
+
+    CreateSwapChain(oldSwapChain);
     CreateImageViews();
+    CreateRenderFinishedSemaphores();
+    imagesInFlight.assign(swapChainImages.size(), VK_NULL_HANDLE);
 
-    // Recreate sync objects for new swapchain size
-    for (size_t i = 0; i < renderFinishedSemaphores.size(); i++)
+    for (auto imageView : oldImageViews)
     {
-        vkDestroySemaphore(device, renderFinishedSemaphores[i], nullptr);
+        DestroyImageView(imageView);
     }
-    renderFinishedSemaphores.resize(swapChainImages.size());
-    VkSemaphoreCreateInfo semaphoreInfo{};
-    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-    for (size_t i = 0; i < swapChainImages.size(); i++)
-    {
-        if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &renderFinishedSemaphores[i]) != VK_SUCCESS)
+
+    VkDevice dev = device;
+    DeferDestroy(
+        [dev, oldSwapChain, oldRenderFinishedSemaphores]()
         {
-            throw std::runtime_error("Failed to create render finished semaphores!");
-        }
-    }
-    imagesInFlight.resize(swapChainImages.size(), VK_NULL_HANDLE);
+            for (auto semaphore : oldRenderFinishedSemaphores)
+            {
+                vkDestroySemaphore(dev, semaphore, nullptr);
+            }
+            vkDestroySwapchainKHR(dev, oldSwapChain, nullptr);
+        });
 
     example->OnSwapChainRecreated();
 }
@@ -553,6 +850,51 @@ void VulkanContext::CleanupSwapChain()
     vkDestroySwapchainKHR(device, swapChain, nullptr);
 }
 
+void VulkanContext::DestroyImage(VkImage image, VkDeviceMemory memory)
+{
+    deletionQueue.PushImage(GetCurrentTimelineValue(), image, memory);
+}
+
+void VulkanContext::DestroyBuffer(VkBuffer buffer, VkDeviceMemory memory)
+{
+    deletionQueue.PushBuffer(GetCurrentTimelineValue(), buffer, memory);
+}
+
+void VulkanContext::DestroyImageView(VkImageView view)
+{
+    deletionQueue.PushImageView(GetCurrentTimelineValue(), view);
+}
+
+void VulkanContext::DestroyFramebuffer(VkFramebuffer framebuffer)
+{
+    deletionQueue.PushFramebuffer(GetCurrentTimelineValue(), framebuffer);
+}
+
+void VulkanContext::DestroyPipeline(VkPipeline pipeline)
+{
+    deletionQueue.PushPipeline(GetCurrentTimelineValue(), pipeline);
+}
+
+void VulkanContext::DestroyDescriptorPool(VkDescriptorPool pool)
+{
+    deletionQueue.PushDescriptorPool(GetCurrentTimelineValue(), pool);
+}
+
+void VulkanContext::DeferDestroy(std::function<void()> destroy)
+{
+    deletionQueue.PushCallback(GetCurrentTimelineValue(), std::move(destroy));
+}
+
+uint64_t VulkanContext::GetCompletedTimelineValue()
+{
+    if (!timelineSemaphoreSupported)
+        return fenceCompletedValue;
+
+    uint64_t value = 0;
+    vkGetSemaphoreCounterValue(device, frameTimeline, &value);
+    return value;
+}
+
 QueueFamilyIndices VulkanContext::FindQueueFamilies(VkPhysicalDevice dev)
 {
     QueueFamilyIndices indices;
@@ -666,6 +1008,12 @@ VkSurfaceFormatKHR VulkanContext::ChooseSwapSurfaceFormat(const std::vector<VkSu
 
 VkPresentModeKHR VulkanContext::ChooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes)
 {
+    // Mailbox would replace each interpolated image with the rendered one presented right after it
+    if (frameLoopConfig.frameInterpolation)
+    {
+        return VK_PRESENT_MODE_FIFO_KHR;
+    }
+
     for (const auto& availablePresentMode : availablePresentModes)
     {
         if (availablePresentMode == VK_PRESENT_MODE_MAILBOX_KHR)
@@ -759,7 +1107,8 @@ VkFormat VulkanContext::FindDepthFormat()
 }
 
 void VulkanContext::CreateImage(uint32_t w, uint32_t h, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage,
-                                VkMemoryPropertyFlags properties, VkImage& image, VkDeviceMemory& imageMemory)
+                                VkMemoryPropertyFlags properties, VkImage& image, VkDeviceMemory& imageMemory,
+                                uint32_t mipLevels)
 {
     VkImageCreateInfo imageInfo{};
     imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
@@ -767,7 +1116,7 @@ void VulkanContext::CreateImage(uint32_t w, uint32_t h, VkFormat format, VkImage
     imageInfo.extent.width = w;
     imageInfo.extent.height = h;
     imageInfo.extent.depth = 1;
-    imageInfo.mipLevels = 1;
+    imageInfo.mipLevels = mipLevels;
     imageInfo.arrayLayers = 1;
     imageInfo.format = format;
     imageInfo.tiling = tiling;
@@ -797,7 +1146,8 @@ void VulkanContext::CreateImage(uint32_t w, uint32_t h, VkFormat format, VkImage
     vkBindImageMemory(device, image, imageMemory, 0);
 }
 
-VkImageView VulkanContext::CreateImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags)
+VkImageView VulkanContext::CreateImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags,
+                                           uint32_t mipLevel, uint32_t levelCount)
 {
     VkImageViewCreateInfo viewInfo{};
     viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -805,8 +1155,8 @@ VkImageView VulkanContext::CreateImageView(VkImage image, VkFormat format, VkIma
     viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
     viewInfo.format = format;
     viewInfo.subresourceRange.aspectMask = aspectFlags;
-    viewInfo.subresourceRange.baseMipLevel = 0;
-    viewInfo.subresourceRange.levelCount = 1;
+    viewInfo.subresourceRange.baseMipLevel = mipLevel;
+    viewInfo.subresourceRange.levelCount = levelCount;
     viewInfo.subresourceRange.baseArrayLayer = 0;
     viewInfo.subresourceRange.layerCount = 1;
 
@@ -841,6 +1191,15 @@ void VulkanContext::CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, Vk
     allocInfo.allocationSize = memRequirements.size;
     allocInfo.memoryTypeIndex = FindMemoryType(memRequirements.memoryTypeBits, properties);
 
+    // Buffers read through device addresses need memory allocated for it
+    VkMemoryAllocateFlagsInfo allocFlagsInfo{};
+    allocFlagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+    allocFlagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+    if (usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT)
+    {
+        allocInfo.pNext = &allocFlagsInfo;
+    }
+
     if (vkAllocateMemory(device, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS)
     {
         throw std::runtime_error("Failed to allocate buffer memory!");
@@ -849,6 +1208,14 @@ void VulkanContext::CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, Vk
     vkBindBufferMemory(device, buffer, bufferMemory, 0);
 }
 
+VkDeviceAddress VulkanContext::GetBufferDeviceAddress(VkBuffer buffer) const
+{
+    VkBufferDeviceAddressInfo addressInfo{};
+    addressInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+    addressInfo.buffer = buffer;
+    return vkGetBufferDeviceAddress(device, &addressInfo);
+}
+
 void VulkanContext::CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size)
 {
     VkCommandBuffer commandBuffer = BeginSingleTimeCommands();
@@ -860,6 +1227,72 @@ void VulkanContext::CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceS
     EndSingleTimeCommands(commandBuffer);
 }
 
+bool VulkanContext::ImportHostBuffer(const void* hostPointer, VkDeviceSize size, VkBufferUsageFlags usage,
+                                     VkBuffer& buffer, VkDeviceMemory& bufferMemory)
+{
+    const VkExternalMemoryHandleTypeFlagBits handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT;
+    VkDeviceSize alignment = minImportedHostPointerAlignment;
+    if (!getMemoryHostPointerProperties || alignment == 0 || size == 0 || size % alignment != 0 ||
+        reinterpret_cast<uintptr_t>(hostPointer) % alignment != 0)
+    {
+        return false;
+    }
+
+    VkMemoryHostPointerPropertiesEXT pointerProperties{};
+    pointerProperties.sType = VK_STRUCTURE_TYPE_MEMORY_HOST_POINTER_PROPERTIES_EXT;
+    if (getMemoryHostPointerProperties(device, handleType, hostPointer, &pointerProperties) != VK_SUCCESS)
+    {
+        return false;
+    }
+
+    VkExternalMemoryBufferCreateInfo externalInfo{};
+    externalInfo.sType = VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO;
+    externalInfo.handleTypes = handleType;
+
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.pNext = &externalInfo;
+    bufferInfo.size = size;
+    bufferInfo.usage = usage;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (vkCreateBuffer(device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS)
+    {
+        return false;
+    }
+
+    VkMemoryRequirements memRequirements;
+    vkGetBufferMemoryRequirements(device, buffer, &memRequirements);
+    uint32_t typeBits = memRequirements.memoryTypeBits & pointerProperties.memoryTypeBits;
+
+    VkImportMemoryHostPointerInfoEXT importInfo{};
+    importInfo.sType = VK_STRUCTURE_TYPE_IMPORT_MEMORY_HOST_POINTER_INFO_EXT;
+    importInfo.handleType = handleType;
+    importInfo.pHostPointer = const_cast<void*>(hostPointer);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.pNext = &importInfo;
+    allocInfo.allocationSize = size;
+
+    bool imported = false;
+    if (typeBits != 0 && memRequirements.size <= size)
+    {
+        // Any type the pointer allows; a copy source needs no particular properties
+        allocInfo.memoryTypeIndex = FindMemoryType(typeBits, 0);
+        imported = vkAllocateMemory(device, &allocInfo, nullptr, &bufferMemory) == VK_SUCCESS;
+    }
+    if (!imported)
+    {
+        vkDestroyBuffer(device, buffer, nullptr);
+        buffer = VK_NULL_HANDLE;
+        return false;
+    }
+
+    vkBindBufferMemory(device, buffer, bufferMemory, 0);
+    return true;
+}
+
 VkCommandBuffer VulkanContext::BeginSingleTimeCommands()
 {
     VkCommandBufferAllocateInfo allocInfo{};
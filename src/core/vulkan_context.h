@@ -1,5 +1,7 @@
 #pragma once
 
+#include "deletion_queue.h"
+#include "job_system.h"
 #include "vulkan_utils.h"
 #include <functional>
 #include <string>
@@ -10,10 +12,20 @@ namespace vkdemo
 
 class ExampleBase;
 
+// Frame loop options, fixed for the lifetime of the context
+struct FrameLoopConfig
+{
+    // Present a frame synthesized by the example between every two rendered ones
+    // (ExampleBase::RecordInterpolatedFrame), doubling the presented rate of a render-bound loop. Takes one
+    // more swapchain image and FIFO presentation, which shows every presented image for a refresh.
+    bool frameInterpolation = false;
+};
+
 class VulkanContext
 {
 public:
-    VulkanContext(uint32_t width, uint32_t height, const std::string& title);
+    VulkanContext(uint32_t width, uint32_t height, const std::string& title, const JobSystemConfig& jobConfig = {},
+                  const FrameLoopConfig& frameLoopConfig = {});
     ~VulkanContext();
 
     VulkanContext(const VulkanContext&) = delete;
@@ -23,25 +35,61 @@ public:
 
     VkInstance GetInstance() const { return instance; }
     VkPhysicalDevice GetPhysicalDevice() const { return physicalDevice; }
+    const VkPhysicalDeviceProperties& GetPhysicalDeviceProperties() const { return physicalDeviceProperties; }
+    const VkPhysicalDeviceSubgroupProperties& GetSubgroupProperties() const { return subgroupProperties; }
     VkDevice GetDevice() const { return device; }
     VkQueue GetGraphicsQueue() const { return graphicsQueue; }
     VkQueue GetPresentQueue() const { return presentQueue; }
     VkCommandPool GetCommandPool() const { return commandPool; }
 
+    // Shared CPU scheduler; the thread that created the context is worker 0
+    JobSystem& GetJobSystem() { return jobSystem; }
+
+    // Optional device features (enabled at device creation when supported)
+    const VkPhysicalDeviceVulkan12Features& GetEnabledVulkan12Features() const { return enabledVulkan12Features; }
+    bool IsBindlessSupported() const { return bindlessSupported; }
+    bool IsTimelineSemaphoreSupported() const { return timelineSemaphoreSupported; }
+    bool IsStorageImageExtendedFormatsSupported() const { return storageImageExtendedFormatsSupported; }
+    bool IsShaderFloat16Supported() const { return enabledVulkan12Features.shaderFloat16 == VK_TRUE; }
+    bool IsDrawIndirectCountSupported() const { return enabledVulkan12Features.drawIndirectCount == VK_TRUE; }
+    bool IsExternalMemoryHostSupported() const { return getMemoryHostPointerProperties != nullptr; }
+    bool IsBufferDeviceAddressSupported() const { return enabledVulkan12Features.bufferDeviceAddress == VK_TRUE; }
+
     VkSwapchainKHR GetSwapChain() const { return swapChain; }
     VkFormat GetSwapChainFormat() const { return swapChainImageFormat; }
     VkExtent2D GetSwapChainExtent() const { return swapChainExtent; }
     const std::vector<VkImageView>& GetSwapChainImageViews() const { return swapChainImageViews; }
     uint32_t GetSwapChainImageCount() const { return static_cast<uint32_t>(swapChainImages.size()); }
 
+    bool IsFrameInterpolationEnabled() const { return frameLoopConfig.frameInterpolation; }
+
     uint32_t GetCurrentFrame() const { return currentFrame; }
+    uint64_t GetFrameNumber() const { return frameNumber; }
     static constexpr int MAX_FRAMES_IN_FLIGHT = 2;
 
+    // Deferred destruction: the resource is released once the GPU timeline passes the current frame's value.
+    // Use these instead of vkDeviceWaitIdle when replacing resources at runtime.
+    void DestroyImage(VkImage image, VkDeviceMemory memory);
+    void DestroyBuffer(VkBuffer buffer, VkDeviceMemory memory);
+    void DestroyImageView(VkImageView view);
+    void DestroyFramebuffer(VkFramebuffer framebuffer);
+    void DestroyPipeline(VkPipeline pipeline);
+    void DestroyDescriptorPool(VkDescriptorPool pool);
+    void DeferDestroy(std::function<void()> destroy);
+
+    // Timeline value signalled by the frame currently being recorded, and the last value the GPU has reached
+    uint64_t GetCurrentTimelineValue() const { return frameNumber + 1; }
+    uint64_t GetCompletedTimelineValue();
+
     void CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer,
                       VkDeviceMemory& bufferMemory);
+    // Requires VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT, which CreateBuffer allocates device-addressable memory for
+    VkDeviceAddress GetBufferDeviceAddress(VkBuffer buffer) const;
     void CreateImage(uint32_t width, uint32_t height, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage,
-                     VkMemoryPropertyFlags properties, VkImage& image, VkDeviceMemory& imageMemory);
-    VkImageView CreateImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags);
+                     VkMemoryPropertyFlags properties, VkImage& image, VkDeviceMemory& imageMemory,
+                     uint32_t mipLevels = 1);
+    VkImageView CreateImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags,
+                                uint32_t mipLevel = 0, uint32_t levelCount = 1);
     VkShaderModule CreateShaderModule(const std::vector<char>& code);
     uint32_t FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
     VkFormat FindDepthFormat();
@@ -52,6 +100,13 @@ public:
     void EndSingleTimeCommands(VkCommandBuffer commandBuffer);
     void CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
 
+    // Wraps host memory in a buffer through VK_EXT_external_memory_host, without copying it. Returns false
+    // when the extension is missing, the range is not aligned to minImportedHostPointerAlignment or the
+    // driver rejects the pointer; the memory must stay mapped until the buffer and memory are destroyed.
+    bool ImportHostBuffer(const void* hostPointer, VkDeviceSize size, VkBufferUsageFlags usage, VkBuffer& buffer,
+                          VkDeviceMemory& bufferMemory);
+    VkDeviceSize GetMinImportedHostPointerAlignment() const { return minImportedHostPointerAlignment; }
+
     GLFWwindow* GetWindow() const { return window; }
     bool WasFramebufferResized() const { return framebufferResized; }
     void ResetFramebufferResized() { framebufferResized = false; }
@@ -66,15 +121,18 @@ private:
     void CreateSurface();
     void PickPhysicalDevice();
     void CreateLogicalDevice();
-    void CreateSwapChain();
+    void CreateSwapChain(VkSwapchainKHR oldSwapChain = VK_NULL_HANDLE);
     void CreateImageViews();
     void CreateCommandPool();
     void CreateSyncObjects();
+    void CreateRenderFinishedSemaphores();
     void CreateCommandBuffers();
 
     void RecreateSwapChain(ExampleBase* example);
     void CleanupSwapChain();
 
+    void CreateFrameTimeline();
+
     void DrawFrame(ExampleBase* example);
 
     QueueFamilyIndices FindQueueFamilies(VkPhysicalDevice device);
@@ -99,11 +157,20 @@ private:
     std::string windowTitle;
     bool framebufferResized = false;
 
+    FrameLoopConfig frameLoopConfig;
+
     // Core Vulkan objects
     VkInstance instance = VK_NULL_HANDLE;
     VkDebugUtilsMessengerEXT debugMessenger = VK_NULL_HANDLE;
     VkSurfaceKHR surface = VK_NULL_HANDLE;
     VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+    VkPhysicalDeviceProperties physicalDeviceProperties{};
+    VkPhysicalDeviceSubgroupProperties subgroupProperties{};
+    VkPhysicalDeviceVulkan12Features enabledVulkan12Features{};
+    bool bindlessSupported = false;
+    bool storageImageExtendedFormatsSupported = false;
+    VkDeviceSize minImportedHostPointerAlignment = 0;
+    PFN_vkGetMemoryHostPointerPropertiesEXT getMemoryHostPointerProperties = nullptr;
     VkDevice device = VK_NULL_HANDLE;
     VkQueue graphicsQueue = VK_NULL_HANDLE;
     VkQueue presentQueue = VK_NULL_HANDLE;
@@ -118,14 +185,28 @@ private:
     // Command pool and buffers
     VkCommandPool commandPool = VK_NULL_HANDLE;
     std::vector<VkCommandBuffer> commandBuffers;
+    // Frame interpolation: the interpolated frame of each frame in flight, recorded after the rendered one
+    std::vector<VkCommandBuffer> interpolatedCommandBuffers;
 
     // Sync objects
     std::vector<VkSemaphore> imageAvailableSemaphores;
+    std::vector<VkSemaphore> interpolatedImageAvailableSemaphores;
     std::vector<VkSemaphore> renderFinishedSemaphores;
     std::vector<VkFence> inFlightFences;
     std::vector<VkFence> imagesInFlight;
     uint32_t currentFrame = 0;
 
+    // Frame timeline: frame N signals value N + 1 on completion. Without timeline semaphore support the
+    // completed value is derived from the in-flight fences instead.
+    VkSemaphore frameTimeline = VK_NULL_HANDLE;
+    bool timelineSemaphoreSupported = false;
+    uint64_t fenceCompletedValue = 0;
+    uint64_t frameNumber = 0;
+
+    DeletionQueue deletionQueue;
+
+    JobSystem jobSystem;
+
     static constexpr bool enableValidationLayers =
 #ifdef NDEBUG
         false;
@@ -32,31 +32,19 @@ void RenderTarget::Cleanup(VkDevice device)
     }
 }
 
-//=============================================================================
-// FullscreenVertex
-//=============================================================================
-
-VkVertexInputBindingDescription FullscreenVertex::GetBindingDescription()
-{
-    VkVertexInputBindingDescription bindingDescription{};
-    bindingDescription.binding = 0;
-    bindingDescription.stride = sizeof(FullscreenVertex);
-    bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-    return bindingDescription;
-}
-
-std::array<VkVertexInputAttributeDescription, 2> FullscreenVertex::GetAttributeDescriptions()
+void RenderTarget::Retire(VulkanContext& ctx)
 {
-    std::array<VkVertexInputAttributeDescription, 2> attributeDescriptions{};
-    attributeDescriptions[0].binding = 0;
-    attributeDescriptions[0].location = 0;
-    attributeDescriptions[0].format = VK_FORMAT_R32G32_SFLOAT;
-    attributeDescriptions[0].offset = offsetof(FullscreenVertex, position);
-    attributeDescriptions[1].binding = 0;
-    attributeDescriptions[1].location = 1;
-    attributeDescriptions[1].format = VK_FORMAT_R32G32_SFLOAT;
-    attributeDescriptions[1].offset = offsetof(FullscreenVertex, texCoord);
-    return attributeDescriptions;
+    if (view != VK_NULL_HANDLE)
+    {
+        ctx.DestroyImageView(view);
+        view = VK_NULL_HANDLE;
+    }
+    if (image != VK_NULL_HANDLE)
+    {
+        ctx.DestroyImage(image, memory);
+        image = VK_NULL_HANDLE;
+        memory = VK_NULL_HANDLE;
+    }
 }
 
 //=============================================================================
@@ -100,46 +88,32 @@ VkPipeline CreatePipeline(VulkanContext& ctx, const PipelineConfig& config)
     fragShaderStageInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
     fragShaderStageInfo.module = fragShaderModule;
     fragShaderStageInfo.pName = "main";
+    fragShaderStageInfo.pSpecializationInfo = config.fragSpecialization;
 
     VkPipelineShaderStageCreateInfo shaderStages[] = {vertShaderStageInfo, fragShaderStageInfo};
 
-    // Vertex input
+    // No vertex input: the full-screen triangle comes from gl_VertexIndex
     VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
     vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
 
-    VkVertexInputBindingDescription bindingDescription = FullscreenVertex::GetBindingDescription();
-    auto attributeDescriptions = FullscreenVertex::GetAttributeDescriptions();
-
-    vertexInputInfo.vertexBindingDescriptionCount = 1;
-    vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
-    vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
-    vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
-
     VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
     inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
     inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
     inputAssembly.primitiveRestartEnable = VK_FALSE;
 
-    VkExtent2D extent = ctx.GetSwapChainExtent();
-
-    VkViewport viewport{};
-    viewport.x = 0.0f;
-    viewport.y = 0.0f;
-    viewport.width = static_cast<float>(extent.width);
-    viewport.height = static_cast<float>(extent.height);
-    viewport.minDepth = 0.0f;
-    viewport.maxDepth = 1.0f;
-
-    VkRect2D scissor{};
-    scissor.offset = {0, 0};
-    scissor.extent = extent;
-
+    // Viewport and scissor are dynamic so pipelines survive resizes and can target a sub-rect of a larger
+    // render target (see SetViewportAndScissor)
     VkPipelineViewportStateCreateInfo viewportState{};
     viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
     viewportState.viewportCount = 1;
-    viewportState.pViewports = &viewport;
     viewportState.scissorCount = 1;
-    viewportState.pScissors = &scissor;
+
+    std::array<VkDynamicState, 2> dynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+
+    VkPipelineDynamicStateCreateInfo dynamicState{};
+    dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+    dynamicState.pDynamicStates = dynamicStates.data();
 
     VkPipelineRasterizationStateCreateInfo rasterizer{};
     rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
@@ -189,6 +163,7 @@ VkPipeline CreatePipeline(VulkanContext& ctx, const PipelineConfig& config)
     pipelineInfo.pMultisampleState = &multisampling;
     pipelineInfo.pDepthStencilState = &depthStencil;
     pipelineInfo.pColorBlendState = &colorBlending;
+    pipelineInfo.pDynamicState = &dynamicState;
     pipelineInfo.layout = config.pipelineLayout;
     pipelineInfo.renderPass = config.renderPass;
     pipelineInfo.subpass = 0;
@@ -205,6 +180,79 @@ VkPipeline CreatePipeline(VulkanContext& ctx, const PipelineConfig& config)
     return pipeline;
 }
 
+VkPipeline CreateComputePipeline(VulkanContext& ctx, const std::string& shaderPath, VkPipelineLayout layout,
+                                 const VkSpecializationInfo* specialization)
+{
+    auto shaderCode = ReadFile(shaderPath);
+    VkShaderModule shaderModule = ctx.CreateShaderModule(shaderCode);
+
+    VkComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipelineInfo.stage.module = shaderModule;
+    pipelineInfo.stage.pName = "main";
+    pipelineInfo.stage.pSpecializationInfo = specialization;
+    pipelineInfo.layout = layout;
+
+    VkPipeline pipeline;
+    if (vkCreateComputePipelines(ctx.GetDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create compute pipeline!");
+    }
+
+    vkDestroyShaderModule(ctx.GetDevice(), shaderModule, nullptr);
+    return pipeline;
+}
+
+void ImageBarrier(VkCommandBuffer cmd, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout,
+                  VkPipelineStageFlags srcStage, VkAccessFlags srcAccess, VkPipelineStageFlags dstStage,
+                  VkAccessFlags dstAccess, VkImageAspectFlags aspect, uint32_t levelCount)
+{
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    barrier.srcAccessMask = srcAccess;
+    barrier.dstAccessMask = dstAccess;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange.aspectMask = aspect;
+    barrier.subresourceRange.levelCount = levelCount;
+    barrier.subresourceRange.layerCount = 1;
+
+    vkCmdPipelineBarrier(cmd, srcStage, dstStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
+
+void GlobalBarrier(VkCommandBuffer cmd, VkPipelineStageFlags srcStage, VkAccessFlags srcAccess,
+                   VkPipelineStageFlags dstStage, VkAccessFlags dstAccess)
+{
+    VkMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = srcAccess;
+    barrier.dstAccessMask = dstAccess;
+
+    vkCmdPipelineBarrier(cmd, srcStage, dstStage, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
+void SetViewportAndScissor(VkCommandBuffer cmd, VkExtent2D extent)
+{
+    VkViewport viewport{};
+    viewport.x = 0.0f;
+    viewport.y = 0.0f;
+    viewport.width = static_cast<float>(extent.width);
+    viewport.height = static_cast<float>(extent.height);
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+    vkCmdSetViewport(cmd, 0, 1, &viewport);
+
+    VkRect2D scissor{};
+    scissor.offset = {0, 0};
+    scissor.extent = extent;
+    vkCmdSetScissor(cmd, 0, 1, &scissor);
+}
+
 VkSampler CreateLinearSampler(VkDevice device)
 {
     VkSamplerCreateInfo samplerInfo{};
@@ -255,98 +303,11 @@ VkSampler CreateNearestSampler(VkDevice device)
     return sampler;
 }
 
-}  // namespace utils
-
-//=============================================================================
-// FullscreenQuad
-//=============================================================================
-
-void FullscreenQuad::Initialize(VulkanContext& ctx)
+void DrawFullscreenTriangle(VkCommandBuffer cmd)
 {
-    if (initialized)
-        return;
-
-    const std::vector<FullscreenVertex> vertices = {
-        {{-1.0f, -1.0f}, {0.0f, 0.0f}},  // bottom-left
-        {{1.0f, -1.0f}, {1.0f, 0.0f}},   // bottom-right
-        {{1.0f, 1.0f}, {1.0f, 1.0f}},    // top-right
-        {{-1.0f, 1.0f}, {0.0f, 1.0f}}    // top-left
-    };
-
-    const std::vector<uint16_t> indices = {0, 1, 2, 0, 2, 3};
-
-    // Create vertex buffer
-    VkDeviceSize vertexBufferSize = sizeof(vertices[0]) * vertices.size();
-    VkBuffer stagingBuffer;
-    VkDeviceMemory stagingBufferMemory;
-
-    ctx.CreateBuffer(vertexBufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer,
-                     stagingBufferMemory);
-
-    void* data;
-    vkMapMemory(ctx.GetDevice(), stagingBufferMemory, 0, vertexBufferSize, 0, &data);
-    memcpy(data, vertices.data(), static_cast<size_t>(vertexBufferSize));
-    vkUnmapMemory(ctx.GetDevice(), stagingBufferMemory);
-
-    ctx.CreateBuffer(vertexBufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vertexBuffer, vertexBufferMemory);
-
-    ctx.CopyBuffer(stagingBuffer, vertexBuffer, vertexBufferSize);
-
-    vkDestroyBuffer(ctx.GetDevice(), stagingBuffer, nullptr);
-    vkFreeMemory(ctx.GetDevice(), stagingBufferMemory, nullptr);
-
-    // Create index buffer
-    VkDeviceSize indexBufferSize = sizeof(indices[0]) * indices.size();
-
-    ctx.CreateBuffer(indexBufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer,
-                     stagingBufferMemory);
-
-    vkMapMemory(ctx.GetDevice(), stagingBufferMemory, 0, indexBufferSize, 0, &data);
-    memcpy(data, indices.data(), static_cast<size_t>(indexBufferSize));
-    vkUnmapMemory(ctx.GetDevice(), stagingBufferMemory);
-
-    ctx.CreateBuffer(indexBufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, indexBuffer, indexBufferMemory);
-
-    ctx.CopyBuffer(stagingBuffer, indexBuffer, indexBufferSize);
-
-    vkDestroyBuffer(ctx.GetDevice(), stagingBuffer, nullptr);
-    vkFreeMemory(ctx.GetDevice(), stagingBufferMemory, nullptr);
-
-    initialized = true;
-}
-
-void FullscreenQuad::Cleanup(VkDevice device)
-{
-    if (!initialized)
-        return;
-
-    vkDestroyBuffer(device, indexBuffer, nullptr);
-    vkFreeMemory(device, indexBufferMemory, nullptr);
-    vkDestroyBuffer(device, vertexBuffer, nullptr);
-    vkFreeMemory(device, vertexBufferMemory, nullptr);
-
-    indexBuffer = VK_NULL_HANDLE;
-    indexBufferMemory = VK_NULL_HANDLE;
-    vertexBuffer = VK_NULL_HANDLE;
-    vertexBufferMemory = VK_NULL_HANDLE;
-    initialized = false;
+    vkCmdDraw(cmd, 3, 1, 0, 0);
 }
 
-void FullscreenQuad::Bind(VkCommandBuffer cmd) const
-{
-    VkBuffer vertexBuffers[] = {vertexBuffer};
-    VkDeviceSize offsets[] = {0};
-    vkCmdBindVertexBuffers(cmd, 0, 1, vertexBuffers, offsets);
-    vkCmdBindIndexBuffer(cmd, indexBuffer, 0, VK_INDEX_TYPE_UINT16);
-}
-
-void FullscreenQuad::Draw(VkCommandBuffer cmd) const
-{
-    vkCmdDrawIndexed(cmd, 6, 1, 0, 0, 0);
-}
+}  // namespace utils
 
 }  // namespace vkdemo
@@ -47,6 +47,9 @@ struct RenderTarget
     uint32_t height = 0;
 
     void Cleanup(VkDevice device);
+
+    // Queues the target for deferred destruction once frames in flight no longer use it
+    void Retire(VulkanContext& ctx);
 };
 
 // Pipeline configuration (reusable)
@@ -58,20 +61,10 @@ struct PipelineConfig
     VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
     uint32_t colorAttachmentCount = 1;
     bool hasDepthAttachment = false;
-    bool isFullscreenQuad = false;
     VkCullModeFlags cullMode = VK_CULL_MODE_NONE;
     VkCompareOp depthCompareOp = VK_COMPARE_OP_LESS;
     bool enableBlending = false;
-};
-
-// Fullscreen quad vertex
-struct FullscreenVertex
-{
-    glm::vec2 position;
-    glm::vec2 texCoord;
-
-    static VkVertexInputBindingDescription GetBindingDescription();
-    static std::array<VkVertexInputAttributeDescription, 2> GetAttributeDescriptions();
+    const VkSpecializationInfo* fragSpecialization = nullptr;
 };
 
 //=============================================================================
@@ -84,36 +77,35 @@ namespace utils
 // File reading
 std::vector<char> ReadFile(const std::string& filename);
 
-// Pipeline creation helper
+// Full-screen pass pipeline (viewport and scissor are dynamic state). There is no vertex input: the vertex
+// shader generates the triangle drawn by DrawFullscreenTriangle (see shaders/fullscreen.vert).
 VkPipeline CreatePipeline(VulkanContext& ctx, const PipelineConfig& config);
 
-// Sampler creation helpers
-VkSampler CreateLinearSampler(VkDevice device);
-VkSampler CreateNearestSampler(VkDevice device);
+// One triangle covering the viewport, generated from gl_VertexIndex without any bound buffers. Unlike a
+// two-triangle quad it has no diagonal edge, so no 2x2 quads are shaded twice along it.
+void DrawFullscreenTriangle(VkCommandBuffer cmd);
 
-}  // namespace utils
+// Compute pipeline from one SPIR-V file, with optional specialization constants
+VkPipeline CreateComputePipeline(VulkanContext& ctx, const std::string& shaderPath, VkPipelineLayout layout,
+                                 const VkSpecializationInfo* specialization = nullptr);
 
-//=============================================================================
-// Fullscreen Quad Manager
-//=============================================================================
+// Image layout transition and execution/memory dependency over the first levelCount mips
+void ImageBarrier(VkCommandBuffer cmd, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout,
+                  VkPipelineStageFlags srcStage, VkAccessFlags srcAccess, VkPipelineStageFlags dstStage,
+                  VkAccessFlags dstAccess, VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT,
+                  uint32_t levelCount = 1);
 
-class FullscreenQuad
-{
-public:
-    void Initialize(VulkanContext& ctx);
-    void Cleanup(VkDevice device);
+// Global execution/memory dependency (buffers, and images that stay in one layout)
+void GlobalBarrier(VkCommandBuffer cmd, VkPipelineStageFlags srcStage, VkAccessFlags srcAccess,
+                   VkPipelineStageFlags dstStage, VkAccessFlags dstAccess);
 
-    void Bind(VkCommandBuffer cmd) const;
-    void Draw(VkCommandBuffer cmd) const;
+// Sets the viewport and scissor to the top-left extent of the current framebuffer
+void SetViewportAndScissor(VkCommandBuffer cmd, VkExtent2D extent);
 
-    bool IsInitialized() const { return initialized; }
+// Sampler creation helpers
+VkSampler CreateLinearSampler(VkDevice device);
+VkSampler CreateNearestSampler(VkDevice device);
 
-private:
-    VkBuffer vertexBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory vertexBufferMemory = VK_NULL_HANDLE;
-    VkBuffer indexBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory indexBufferMemory = VK_NULL_HANDLE;
-    bool initialized = false;
-};
+}  // namespace utils
 
 }  // namespace vkdemo
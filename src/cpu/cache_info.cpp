@@ -0,0 +1,80 @@
+#include "cache_info.h"
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace vkdemo
+{
+namespace cpu
+{
+
+#if defined(__linux__)
+static bool ReadSysfsValue(const std::string& path, std::string& value)
+{
+    std::ifstream file(path);
+    return static_cast<bool>(std::getline(file, value));
+}
+
+// Parses sysfs sizes such as "48K" or "2048K"
+static uint32_t ParseCacheSize(const std::string& text)
+{
+    uint32_t size = static_cast<uint32_t>(std::stoul(text));
+    char suffix = text.empty() ? '\0' : text.back();
+    if (suffix == 'K')
+        return size * 1024;
+    if (suffix == 'M')
+        return size * 1024 * 1024;
+    return size;
+}
+
+CpuCacheInfo QueryCpuCacheInfo()
+{
+    CpuCacheInfo info;
+    const std::string root = "/sys/devices/system/cpu/cpu0/cache/index";
+
+    for (uint32_t index = 0;; index++)
+    {
+        std::string directory = root + std::to_string(index) + "/";
+        std::string level, type, size, lineSize;
+        if (!ReadSysfsValue(directory + "level", level) || !ReadSysfsValue(directory + "type", type) ||
+            !ReadSysfsValue(directory + "size", size))
+            break;
+
+        try
+        {
+            uint32_t bytes = ParseCacheSize(size);
+            if (level == "1" && type == "Data")
+            {
+                info.l1DataSize = bytes;
+                if (ReadSysfsValue(directory + "coherency_line_size", lineSize))
+                {
+                    info.lineSize = static_cast<uint32_t>(std::stoul(lineSize));
+                }
+                info.queried = true;
+            }
+            else if (level == "2" && type != "Instruction")
+            {
+                info.l2Size = bytes;
+            }
+            else if (level == "3")
+            {
+                info.l3Size = bytes;
+            }
+        }
+        catch (const std::exception&)
+        {
+            // Malformed entry; keep the defaults for this level
+        }
+    }
+    return info;
+}
+#else
+CpuCacheInfo QueryCpuCacheInfo()
+{
+    return CpuCacheInfo();
+}
+#endif
+
+}  // namespace cpu
+}  // namespace vkdemo
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+namespace vkdemo
+{
+namespace cpu
+{
+
+//=============================================================================
+// CPU Cache Geometry
+//=============================================================================
+
+struct CpuCacheInfo
+{
+    uint32_t lineSize = 64;
+    uint32_t l1DataSize = 32 * 1024;
+    uint32_t l2Size = 256 * 1024;
+    uint32_t l3Size = 0;
+    // False when the values above are the built-in defaults
+    bool queried = false;
+};
+
+// Cache sizes of the first core, read from /sys/devices/system/cpu/cpu0/cache on Linux. Other
+// platforms, or a missing sysfs, get conservative defaults.
+CpuCacheInfo QueryCpuCacheInfo();
+
+}  // namespace cpu
+}  // namespace vkdemo
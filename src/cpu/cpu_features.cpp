@@ -0,0 +1,129 @@
+#include "cpu_features.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if VKDEMO_CPU_X86
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+        #include <immintrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#endif
+
+namespace vkdemo
+{
+namespace cpu
+{
+
+#if VKDEMO_CPU_X86
+static void QueryCpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4])
+{
+    #if defined(_MSC_VER)
+    int info[4];
+    __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; i++)
+    {
+        regs[i] = static_cast<uint32_t>(info[i]);
+    }
+    #else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+    #endif
+}
+
+static uint64_t ReadXcr0()
+{
+    #if defined(_MSC_VER)
+    return _xgetbv(0);
+    #else
+    uint32_t eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+    #endif
+}
+
+static CpuFeatures QueryCpuFeatures()
+{
+    CpuFeatures features;
+
+    uint32_t regs[4] = {};
+    QueryCpuid(0, 0, regs);
+    uint32_t maxLeaf = regs[0];
+    if (maxLeaf < 1)
+        return features;
+
+    QueryCpuid(1, 0, regs);
+    const uint32_t ecx1 = regs[2];
+    const uint32_t edx1 = regs[3];
+
+    features.sse2 = (edx1 & (1u << 26)) != 0;
+
+    // AVX needs both the CPU bit and the OS saving XMM/YMM state on context switches
+    bool osxsave = (ecx1 & (1u << 27)) != 0;
+    bool avxState = osxsave && (ReadXcr0() & 0x6) == 0x6;
+    features.avx = avxState && (ecx1 & (1u << 28)) != 0;
+    features.fma = features.avx && (ecx1 & (1u << 12)) != 0;
+    features.f16c = features.avx && (ecx1 & (1u << 29)) != 0;
+
+    if (maxLeaf >= 7)
+    {
+        QueryCpuid(7, 0, regs);
+        features.avx2 = features.avx && (regs[1] & (1u << 5)) != 0;
+    }
+
+    QueryCpuid(0x80000000u, 0, regs);
+    if (regs[0] >= 0x80000004u)
+    {
+        char brand[49] = {};
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            QueryCpuid(0x80000002u + i, 0, regs);
+            std::memcpy(brand + i * 16, regs, 16);
+        }
+        features.brand = brand;
+        features.brand.erase(0, features.brand.find_first_not_of(' '));
+        features.brand.erase(features.brand.find_last_not_of(' ') + 1);
+    }
+
+    return features;
+}
+#else
+static CpuFeatures QueryCpuFeatures()
+{
+    return CpuFeatures();
+}
+#endif
+
+const CpuFeatures& GetCpuFeatures()
+{
+    static const CpuFeatures features = QueryCpuFeatures();
+    return features;
+}
+
+SimdLevel DetectSimdLevel()
+{
+    const CpuFeatures& features = GetCpuFeatures();
+    if (features.avx2 && features.fma && features.f16c)
+        return SimdLevel::AVX2;
+    if (features.sse2)
+        return SimdLevel::SSE2;
+    return SimdLevel::Scalar;
+}
+
+const char* GetSimdLevelName(SimdLevel level)
+{
+    switch (level)
+    {
+    case SimdLevel::Scalar:
+        return "Scalar";
+    case SimdLevel::SSE2:
+        return "SSE2";
+    case SimdLevel::AVX2:
+        return "AVX2";
+    }
+    return "Unknown";
+}
+
+}  // namespace cpu
+}  // namespace vkdemo
@@ -0,0 +1,56 @@
+#pragma once
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define VKDEMO_CPU_X86 1
+#else
+    #define VKDEMO_CPU_X86 0
+#endif
+
+// Enables AVX2/FMA/F16C code generation for a single function. Used instead of per-file compiler flags so
+// that inline helpers shared with the baseline tiers are never emitted with AVX encodings.
+#if VKDEMO_CPU_X86 && (defined(__GNUC__) || defined(__clang__))
+    #define VKDEMO_TARGET_AVX2 __attribute__((target("avx2,fma,f16c")))
+#else
+    #define VKDEMO_TARGET_AVX2
+#endif
+
+#include <string>
+
+namespace vkdemo
+{
+namespace cpu
+{
+
+//=============================================================================
+// CPU Feature Detection
+//=============================================================================
+
+// Instruction set tiers the CPU kernels are built for, in increasing order
+enum class SimdLevel
+{
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+struct CpuFeatures
+{
+    bool sse2 = false;
+    bool avx = false;
+    bool avx2 = false;
+    bool fma = false;
+    bool f16c = false;
+    // Processor brand string (CPUID 0x80000002-4), empty when unavailable
+    std::string brand;
+};
+
+// Queries CPUID (and XGETBV for OS support of the AVX state) once and caches the result
+const CpuFeatures& GetCpuFeatures();
+
+// Highest level usable on this CPU; AVX2 also requires FMA and F16C
+SimdLevel DetectSimdLevel();
+
+const char* GetSimdLevelName(SimdLevel level);
+
+}  // namespace cpu
+}  // namespace vkdemo
@@ -0,0 +1,482 @@
+#include "cpu_post_process.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+
+namespace vkdemo
+{
+namespace cpu
+{
+
+// Gaussian weights shared by blur_vertical.frag and blur_horizontal.frag
+static const float BLUR_WEIGHTS[5] = {0.227027f, 0.1945946f, 0.1216216f, 0.054054f, 0.016216f};
+static constexpr int32_t MAX_KERNEL_RADIUS = 4;
+
+//=============================================================================
+// Helpers
+//=============================================================================
+
+// Texel indices start .. start + count - 1 clamped to [0, size - 1] (CLAMP_TO_EDGE / ClampToRenderArea)
+static void BuildClampedIndices(int32_t start, uint32_t count, uint32_t size, std::vector<uint32_t>& indices)
+{
+    indices.resize(count);
+    const int32_t last = static_cast<int32_t>(size) - 1;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        indices[i] = static_cast<uint32_t>(std::min(std::max(start + static_cast<int32_t>(i), 0), last));
+    }
+}
+
+static uint32_t ClampIndex(int32_t index, uint32_t size)
+{
+    return static_cast<uint32_t>(std::min(std::max(index, 0), static_cast<int32_t>(size) - 1));
+}
+
+static void PrepareOutput(uint32_t width, uint32_t height, Image& output)
+{
+    PixelFormat format = output.format == PixelFormat::RGBA16F ? PixelFormat::RGBA16F : PixelFormat::RGBA32F;
+    if (output.width != width || output.height != height || output.format != format || output.data.empty())
+    {
+        output = Image::Create(width, height, format);
+    }
+}
+
+//=============================================================================
+// Blur Kernel
+//=============================================================================
+
+BlurKernel BuildBlurKernel(const CpuPostProcessParams& params)
+{
+    const int32_t radius = std::min(std::max(params.kernelRadius, 0), MAX_KERNEL_RADIUS);
+    const float spacing = std::fabs(params.blurStrength);
+
+    BlurKernel kernel;
+    kernel.radius = static_cast<int32_t>(std::ceil(static_cast<float>(radius) * spacing));
+    kernel.weights.assign(static_cast<size_t>(kernel.radius) * 2 + 1, 0.0f);
+
+    // A linear fetch at a fractional texel offset blends the two neighbouring texels
+    auto addTap = [&kernel](float offset, float weight)
+    {
+        float base = std::floor(offset);
+        float fraction = offset - base;
+        int32_t index = static_cast<int32_t>(base) + kernel.radius;
+        kernel.weights[index] += weight * (1.0f - fraction);
+        if (fraction > 0.0f)
+        {
+            kernel.weights[index + 1] += weight * fraction;
+        }
+    };
+
+    float weightSum = BLUR_WEIGHTS[0];
+    addTap(0.0f, BLUR_WEIGHTS[0]);
+    for (int32_t i = 1; i <= radius; i++)
+    {
+        float offset = static_cast<float>(i) * spacing;
+        addTap(offset, BLUR_WEIGHTS[i]);
+        addTap(-offset, BLUR_WEIGHTS[i]);
+        weightSum += 2.0f * BLUR_WEIGHTS[i];
+    }
+
+    for (float& weight : kernel.weights)
+    {
+        weight /= weightSum;
+    }
+    return kernel;
+}
+
+float GetBlurKernelSigma(const BlurKernel& kernel)
+{
+    double variance = 0.0;
+    for (int32_t i = -kernel.radius; i <= kernel.radius; i++)
+    {
+        variance += kernel.weights[i + kernel.radius] * static_cast<double>(i) * i;
+    }
+    return static_cast<float>(std::sqrt(variance));
+}
+
+//=============================================================================
+// CpuPostProcessor
+//=============================================================================
+
+CpuPostProcessor::CpuPostProcessor(SimdLevel level) : kernels(&GetPostProcessKernels(level)) {}
+
+void CpuPostProcessor::SetTileSize(uint32_t width, uint32_t height)
+{
+    tileWidth = std::max(width, 1u);
+    tileHeight = std::max(height, 1u);
+}
+
+bool CpuPostProcessor::UsesIir(const CpuPostProcessParams& params) const
+{
+    if (params.blurMode != BlurMode::Auto)
+        return params.blurMode == BlurMode::Iir;
+
+    float radius = static_cast<float>(std::min(std::max(params.kernelRadius, 0), MAX_KERNEL_RADIUS));
+    return radius * std::fabs(params.blurStrength) >= iirCrossoverRadius;
+}
+
+const float* CpuPostProcessor::WidenColor(const Image& image, std::vector<float>& storage) const
+{
+    if (image.format == PixelFormat::RGBA32F)
+        return reinterpret_cast<const float*>(image.data.data());
+    if (image.format != PixelFormat::RGBA16F)
+    {
+        throw std::runtime_error("CPU post-process expects an RGBA color image!");
+    }
+
+    size_t count = static_cast<size_t>(image.width) * image.height * 4;
+    storage.resize(count);
+    kernels->halfToFloat(reinterpret_cast<const uint16_t*>(image.data.data()), storage.data(), count);
+    return storage.data();
+}
+
+const float* CpuPostProcessor::WidenVelocity(const Image& image, std::vector<float>& storage) const
+{
+    if (image.format == PixelFormat::RG32F)
+        return reinterpret_cast<const float*>(image.data.data());
+    if (image.format != PixelFormat::RG16F)
+    {
+        throw std::runtime_error("CPU post-process expects an RG velocity image!");
+    }
+
+    size_t count = static_cast<size_t>(image.width) * image.height * 2;
+    storage.resize(count);
+    kernels->halfToFloat(reinterpret_cast<const uint16_t*>(image.data.data()), storage.data(), count);
+    return storage.data();
+}
+
+void CpuPostProcessor::StoreRow(const float* src, Image& output, uint32_t x, uint32_t y, uint32_t pixelCount) const
+{
+    if (output.format == PixelFormat::RGBA16F)
+    {
+        uint16_t* dst = reinterpret_cast<uint16_t*>(output.GetRow(y)) + static_cast<size_t>(x) * 4;
+        kernels->floatToHalf(src, dst, static_cast<size_t>(pixelCount) * 4);
+    }
+    else
+    {
+        float* dst = reinterpret_cast<float*>(output.GetRow(y)) + static_cast<size_t>(x) * 4;
+        std::copy(src, src + static_cast<size_t>(pixelCount) * 4, dst);
+    }
+}
+
+void CpuPostProcessor::Run(const Image& sceneColor, const Image& velocity, const CpuPostProcessParams& params,
+                           Image& output)
+{
+    if (UsesIir(params))
+    {
+        RunIir(nullptr, sceneColor, velocity, params, output);
+        return;
+    }
+
+    BeginFrame(sceneColor, velocity, params, output);
+
+    frameCounters = {};
+    ScopedPerfCounters counters(perfCounters, frameCounters);
+
+    TileScratch scratch;
+    for (uint32_t tileY = 0; tileY < tileCountY; tileY++)
+    {
+        for (uint32_t tileX = 0; tileX < tileCountX; tileX++)
+        {
+            ProcessTile(tileX, tileY, scratch);
+        }
+    }
+}
+
+void CpuPostProcessor::Run(JobSystem& jobs, const Image& sceneColor, const Image& velocity,
+                           const CpuPostProcessParams& params, Image& output)
+{
+    if (UsesIir(params))
+    {
+        RunIir(&jobs, sceneColor, velocity, params, output);
+        return;
+    }
+
+    BeginFrame(sceneColor, velocity, params, output);
+
+    frameCounters = {};
+    ScopedPerfCounters counters(perfCounters, frameCounters);
+
+    workerScratch.resize(std::max<size_t>(workerScratch.size(), jobs.GetWorkerCount()));
+    jobs.ParallelFor2D(tileCountX, tileCountY, [this](uint32_t tileX, uint32_t tileY, uint32_t workerIndex)
+                       { ProcessTile(tileX, tileY, workerScratch[workerIndex]); });
+}
+
+void CpuPostProcessor::PrepareSource(const Image& sceneColor, const Image& velocity,
+                                     const CpuPostProcessParams& params)
+{
+    if (sceneColor.width != velocity.width || sceneColor.height != velocity.height)
+    {
+        throw std::runtime_error("CPU post-process color and velocity sizes differ!");
+    }
+
+    source.sceneColor = WidenColor(sceneColor, sceneStorage);
+    source.velocity = WidenVelocity(velocity, velocityStorage);
+    source.width = sceneColor.width;
+    source.height = sceneColor.height;
+    source.motionScale = params.motionScale;
+}
+
+void CpuPostProcessor::BeginFrame(const Image& sceneColor, const Image& velocity, const CpuPostProcessParams& params,
+                                  Image& output)
+{
+    PrepareSource(sceneColor, velocity, params);
+
+    kernel = BuildBlurKernel(params);
+    PrepareOutput(sceneColor.width, sceneColor.height, output);
+    target = &output;
+
+    tileCountX = (source.width + tileWidth - 1) / tileWidth;
+    tileCountY = (source.height + tileHeight - 1) / tileHeight;
+}
+
+void CpuPostProcessor::ProcessTile(uint32_t tileX, uint32_t tileY, TileScratch& scratch) const
+{
+    const uint32_t x0 = tileX * tileWidth;
+    const uint32_t y0 = tileY * tileHeight;
+    const uint32_t width = std::min(tileWidth, source.width - x0);
+    const uint32_t height = std::min(tileHeight, source.height - y0);
+    const uint32_t radius = static_cast<uint32_t>(kernel.radius);
+    const uint32_t taps = kernel.GetTapCount();
+
+    // The blur needs motion results for the tile plus `radius` texels on every side
+    const uint32_t haloWidth = width + 2 * radius;
+    const uint32_t haloHeight = height + 2 * radius;
+    const size_t haloPitch = static_cast<size_t>(haloWidth) * 4;
+
+    BuildClampedIndices(static_cast<int32_t>(x0) - kernel.radius, haloWidth, source.width, scratch.columns);
+    scratch.motion.resize(haloPitch * haloHeight);
+    for (uint32_t row = 0; row < haloHeight; row++)
+    {
+        uint32_t y = ClampIndex(static_cast<int32_t>(y0 + row) - kernel.radius, source.height);
+        kernels->motionApplyRow(source, y, scratch.columns.data(), scratch.motion.data() + row * haloPitch,
+                                haloWidth);
+    }
+
+    // Vertical pass over the full halo width so the horizontal pass has its neighbours
+    scratch.vertical.resize(haloPitch * height);
+    scratch.rows.resize(taps);
+    for (uint32_t row = 0; row < height; row++)
+    {
+        for (uint32_t t = 0; t < taps; t++)
+        {
+            scratch.rows[t] = scratch.motion.data() + (row + t) * haloPitch;
+        }
+        float* dst = scratch.vertical.data() + row * haloPitch;
+        kernels->blurColumns(scratch.rows.data(), kernel.weights.data(), taps, dst, haloWidth * 4);
+    }
+
+    scratch.horizontal.resize(static_cast<size_t>(width) * 4);
+    scratch.output.resize(static_cast<size_t>(width) * 4);
+    for (uint32_t row = 0; row < height; row++)
+    {
+        const float* motion = scratch.motion.data() + (row + radius) * haloPitch + radius * 4;
+        kernels->blurRow(scratch.vertical.data() + row * haloPitch, kernel.weights.data(), taps,
+                         scratch.horizontal.data(), width);
+        kernels->finalApplyRow(motion, scratch.horizontal.data(), scratch.output.data(), width);
+        StoreRow(scratch.output.data(), *target, x0, y0 + row, width);
+    }
+}
+
+void CpuPostProcessor::RunIir(JobSystem* jobs, const Image& sceneColor, const Image& velocity,
+                              const CpuPostProcessParams& params, Image& output)
+{
+    PrepareSource(sceneColor, velocity, params);
+    PrepareOutput(sceneColor.width, sceneColor.height, output);
+    target = &output;
+
+    frameCounters = {};
+    ScopedPerfCounters counters(perfCounters, frameCounters);
+
+    const uint32_t width = source.width;
+    const uint32_t height = source.height;
+    const size_t pitch = static_cast<size_t>(width) * 4;
+    const IirGaussianCoefficients coefficients =
+        ComputeIirGaussianCoefficients(GetBlurKernelSigma(BuildBlurKernel(params)));
+    iirMotion.resize(pitch * height);
+    iirBlur.resize(pitch * height);
+
+    // Each stage is split into independent work items that run on the job system when there is one
+    TileScratch serialScratch;
+    auto forEach = [&](uint32_t count, const std::function<void(uint32_t, TileScratch&)>& function)
+    {
+        if (!jobs)
+        {
+            for (uint32_t i = 0; i < count; i++)
+            {
+                function(i, serialScratch);
+            }
+            return;
+        }
+        workerScratch.resize(std::max<size_t>(workerScratch.size(), jobs->GetWorkerCount()));
+        jobs->ParallelFor2D(count, 1, [&](uint32_t index, uint32_t, uint32_t workerIndex)
+                            { function(index, workerScratch[workerIndex]); });
+    };
+
+    const uint32_t bandCount = (height + IIR_ROW_BAND - 1) / IIR_ROW_BAND;
+    const uint32_t stripCount = (width + IIR_STRIP_WIDTH - 1) / IIR_STRIP_WIDTH;
+
+    forEach(bandCount,
+            [&](uint32_t band, TileScratch& scratch)
+            {
+                BuildClampedIndices(0, width, width, scratch.columns);
+                for (uint32_t y = band * IIR_ROW_BAND; y < std::min((band + 1) * IIR_ROW_BAND, height); y++)
+                {
+                    kernels->motionApplyRow(source, y, scratch.columns.data(), iirMotion.data() + y * pitch, width);
+                }
+            });
+
+    forEach(stripCount,
+            [&](uint32_t strip, TileScratch& scratch)
+            {
+                uint32_t columnBegin = strip * IIR_STRIP_WIDTH;
+                uint32_t columnEnd = std::min(columnBegin + IIR_STRIP_WIDTH, width);
+                IirBlurColumns(iirMotion.data(), iirBlur.data(), width, height, columnBegin, columnEnd, coefficients,
+                               scratch.history);
+            });
+
+    forEach(bandCount,
+            [&](uint32_t band, TileScratch& scratch)
+            {
+                uint32_t rowBegin = band * IIR_ROW_BAND;
+                uint32_t rowEnd = std::min(rowBegin + IIR_ROW_BAND, height);
+                IirBlurRows(iirBlur.data(), iirBlur.data(), width, rowBegin, rowEnd, coefficients);
+
+                scratch.output.resize(pitch);
+                for (uint32_t y = rowBegin; y < rowEnd; y++)
+                {
+                    kernels->finalApplyRow(iirMotion.data() + y * pitch, iirBlur.data() + y * pitch,
+                                           scratch.output.data(), width);
+                    StoreRow(scratch.output.data(), *target, 0, y, width);
+                }
+            });
+}
+
+//=============================================================================
+// Individual Passes
+//=============================================================================
+
+void CpuPostProcessor::MotionApply(const Image& sceneColor, const Image& velocity, const CpuPostProcessParams& params,
+                                   Image& output)
+{
+    if (sceneColor.width != velocity.width || sceneColor.height != velocity.height)
+    {
+        throw std::runtime_error("CPU post-process color and velocity sizes differ!");
+    }
+
+    MotionApplySource motionSource;
+    motionSource.sceneColor = WidenColor(sceneColor, sceneStorage);
+    motionSource.velocity = WidenVelocity(velocity, velocityStorage);
+    motionSource.width = sceneColor.width;
+    motionSource.height = sceneColor.height;
+    motionSource.motionScale = params.motionScale;
+    PrepareOutput(sceneColor.width, sceneColor.height, output);
+
+    std::vector<uint32_t> columns;
+    BuildClampedIndices(0, motionSource.width, motionSource.width, columns);
+    std::vector<float> row(static_cast<size_t>(motionSource.width) * 4);
+    for (uint32_t y = 0; y < motionSource.height; y++)
+    {
+        kernels->motionApplyRow(motionSource, y, columns.data(), row.data(), motionSource.width);
+        StoreRow(row.data(), output, 0, y, motionSource.width);
+    }
+}
+
+void CpuPostProcessor::BlurVertical(const Image& input, const CpuPostProcessParams& params, Image& output)
+{
+    const float* pixels = WidenColor(input, sceneStorage);
+    const BlurKernel blurKernel = BuildBlurKernel(params);
+    const uint32_t taps = blurKernel.GetTapCount();
+    PrepareOutput(input.width, input.height, output);
+
+    // Walk narrow column strips top to bottom: consecutive rows reuse taps - 1 of the strip rows
+    // already in cache instead of streaming 2 * radius + 1 full image rows per output row
+    std::vector<const float*> rows(taps);
+    std::vector<float> result(static_cast<size_t>(VERTICAL_STRIP_WIDTH) * 4);
+    for (uint32_t x0 = 0; x0 < input.width; x0 += VERTICAL_STRIP_WIDTH)
+    {
+        uint32_t stripWidth = std::min(VERTICAL_STRIP_WIDTH, input.width - x0);
+        for (uint32_t y = 0; y < input.height; y++)
+        {
+            for (uint32_t t = 0; t < taps; t++)
+            {
+                uint32_t sourceY = ClampIndex(static_cast<int32_t>(y + t) - blurKernel.radius, input.height);
+                rows[t] = pixels + (static_cast<size_t>(sourceY) * input.width + x0) * 4;
+            }
+            kernels->blurColumns(rows.data(), blurKernel.weights.data(), taps, result.data(), stripWidth * 4);
+            StoreRow(result.data(), output, x0, y, stripWidth);
+        }
+    }
+}
+
+void CpuPostProcessor::BlurHorizontal(const Image& input, const CpuPostProcessParams& params, Image& output)
+{
+    const float* pixels = WidenColor(input, sceneStorage);
+    const BlurKernel blurKernel = BuildBlurKernel(params);
+    PrepareOutput(input.width, input.height, output);
+
+    // Each row is copied once into an edge-clamped padded buffer so the kernel needs no bounds checks
+    const uint32_t paddedWidth = input.width + 2 * static_cast<uint32_t>(blurKernel.radius);
+    std::vector<uint32_t> columns;
+    BuildClampedIndices(-blurKernel.radius, paddedWidth, input.width, columns);
+    std::vector<float> padded(static_cast<size_t>(paddedWidth) * 4);
+    std::vector<float> result(static_cast<size_t>(input.width) * 4);
+    for (uint32_t y = 0; y < input.height; y++)
+    {
+        const float* row = pixels + static_cast<size_t>(y) * input.width * 4;
+        for (uint32_t i = 0; i < paddedWidth; i++)
+        {
+            std::copy(row + columns[i] * 4, row + columns[i] * 4 + 4, padded.data() + i * 4);
+        }
+        kernels->blurRow(padded.data(), blurKernel.weights.data(), blurKernel.GetTapCount(), result.data(),
+                         input.width);
+        StoreRow(result.data(), output, 0, y, input.width);
+    }
+}
+
+void CpuPostProcessor::IirBlur(const Image& input, const CpuPostProcessParams& params, Image& output)
+{
+    const float* pixels = WidenColor(input, sceneStorage);
+    const IirGaussianCoefficients coefficients =
+        ComputeIirGaussianCoefficients(GetBlurKernelSigma(BuildBlurKernel(params)));
+    PrepareOutput(input.width, input.height, output);
+
+    std::vector<float> result(static_cast<size_t>(input.width) * input.height * 4);
+    std::vector<float> history;
+    for (uint32_t x0 = 0; x0 < input.width; x0 += IIR_STRIP_WIDTH)
+    {
+        IirBlurColumns(pixels, result.data(), input.width, input.height, x0,
+                       std::min(x0 + IIR_STRIP_WIDTH, input.width), coefficients, history);
+    }
+    IirBlurRows(result.data(), result.data(), input.width, 0, input.height, coefficients);
+
+    for (uint32_t y = 0; y < input.height; y++)
+    {
+        StoreRow(result.data() + static_cast<size_t>(y) * input.width * 4, output, 0, y, input.width);
+    }
+}
+
+void CpuPostProcessor::FinalApply(const Image& motion, const Image& blur, Image& output)
+{
+    if (motion.width != blur.width || motion.height != blur.height)
+    {
+        throw std::runtime_error("CPU post-process motion and blur sizes differ!");
+    }
+
+    const float* motionPixels = WidenColor(motion, sceneStorage);
+    const float* blurPixels = WidenColor(blur, velocityStorage);
+    PrepareOutput(motion.width, motion.height, output);
+
+    std::vector<float> result(static_cast<size_t>(motion.width) * 4);
+    for (uint32_t y = 0; y < motion.height; y++)
+    {
+        size_t offset = static_cast<size_t>(y) * motion.width * 4;
+        kernels->finalApplyRow(motionPixels + offset, blurPixels + offset, result.data(), motion.width);
+        StoreRow(result.data(), output, 0, y, motion.width);
+    }
+}
+
+}  // namespace cpu
+}  // namespace vkdemo
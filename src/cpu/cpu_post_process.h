@@ -0,0 +1,152 @@
+#pragma once
+
+#include "core/job_system.h"
+#include "iir_blur.h"
+#include "image.h"
+#include "perf_counters.h"
+#include "post_process_kernels.h"
+
+#include <vector>
+
+namespace vkdemo
+{
+namespace cpu
+{
+
+//=============================================================================
+// CPU Post-Process Chain
+//=============================================================================
+
+// Mirrors MotionBlurPostProcessParams minus the GPU-only texel size and uv scale
+struct CpuPostProcessParams
+{
+    float blurStrength = 1.0f;
+    float motionScale = 1.0f;
+    int32_t kernelRadius = 4;
+    BlurMode blurMode = BlurMode::Auto;
+};
+
+// The 9-tap Gaussian of blur_*.frag resolved to integer texel offsets [-radius, radius]. Fractional tap
+// offsets (blurStrength != 1) are split into the two texels a bilinear fetch would blend, and the
+// weights are pre-divided by the shader's weightSum.
+struct BlurKernel
+{
+    int32_t radius = 0;
+    std::vector<float> weights;
+
+    uint32_t GetTapCount() const { return static_cast<uint32_t>(weights.size()); }
+};
+
+BlurKernel BuildBlurKernel(const CpuPostProcessParams& params);
+
+// Standard deviation of the kernel in texels, which the recursive Gaussian reproduces
+float GetBlurKernelSigma(const BlurKernel& kernel);
+
+// Per-thread working memory for ProcessTile
+struct TileScratch
+{
+    std::vector<float> motion;
+    std::vector<float> vertical;
+    std::vector<float> horizontal;
+    std::vector<float> output;
+    std::vector<uint32_t> columns;
+    std::vector<const float*> rows;
+    std::vector<float> history;
+};
+
+// CPU reference of motion_apply -> blur_vertical -> blur_horizontal -> final_apply.
+// Images are RGBA16F/RGBA32F color and RG16F/RG32F velocity; half inputs are widened to FP32 once per frame.
+//
+// Run() executes the whole chain tile by tile: each tile computes motion over itself plus the blur halo,
+// blurs it vertically and horizontally and applies the final pass while everything is still in cache.
+// The standalone passes below produce the intermediate render targets for comparison with the GPU.
+class CpuPostProcessor
+{
+public:
+    static constexpr uint32_t DEFAULT_TILE_SIZE = 64;
+    // Blur radius in texels (kernelRadius * blurStrength) from which BlurMode::Auto uses the recursive
+    // Gaussian; TuneIirCrossoverRadius measures the actual value
+    static constexpr float DEFAULT_IIR_CROSSOVER_RADIUS = 16.0f;
+
+    explicit CpuPostProcessor(SimdLevel level = DetectSimdLevel());
+
+    SimdLevel GetSimdLevel() const { return kernels->level; }
+
+    void SetTileSize(uint32_t width, uint32_t height);
+    uint32_t GetTileWidth() const { return tileWidth; }
+    uint32_t GetTileHeight() const { return tileHeight; }
+
+    void SetIirCrossoverRadius(float radius) { iirCrossoverRadius = radius; }
+    float GetIirCrossoverRadius() const { return iirCrossoverRadius; }
+    bool UsesIir(const CpuPostProcessParams& params) const;
+
+    // Hardware counters sampled around each Run() (nullptr disables). With a job system only the
+    // calling thread's share of the tiles is counted.
+    void SetPerfCounters(PerfCounterGroup* group) { perfCounters = group; }
+    const PerfCounterValues& GetFrameCounters() const { return frameCounters; }
+
+    // Full chain; output is (re)created at the input size, keeping its format if already RGBA. The FIR chain
+    // is fused per tile; the IIR chain needs whole lines, so it runs as row and column-strip passes.
+    void Run(const Image& sceneColor, const Image& velocity, const CpuPostProcessParams& params, Image& output);
+    // Same, with tiles distributed over the job system's workers; must be called from a worker thread
+    void Run(JobSystem& jobs, const Image& sceneColor, const Image& velocity, const CpuPostProcessParams& params,
+             Image& output);
+
+    // Split form of the FIR chain for external schedulers: ProcessTile may be called concurrently for
+    // distinct tiles until the next non-const call, each caller with its own scratch
+    void BeginFrame(const Image& sceneColor, const Image& velocity, const CpuPostProcessParams& params,
+                    Image& output);
+    uint32_t GetTileCountX() const { return tileCountX; }
+    uint32_t GetTileCountY() const { return tileCountY; }
+    void ProcessTile(uint32_t tileX, uint32_t tileY, TileScratch& scratch) const;
+
+    // Individual passes, one full image at a time
+    void MotionApply(const Image& sceneColor, const Image& velocity, const CpuPostProcessParams& params,
+                     Image& output);
+    void BlurVertical(const Image& input, const CpuPostProcessParams& params, Image& output);
+    void BlurHorizontal(const Image& input, const CpuPostProcessParams& params, Image& output);
+    // Recursive Gaussian in both directions, the IIR counterpart of BlurVertical + BlurHorizontal
+    void IirBlur(const Image& input, const CpuPostProcessParams& params, Image& output);
+    void FinalApply(const Image& motion, const Image& blur, Image& output);
+
+private:
+    // Width in pixels of the column strips BlurVertical walks, sized so the strip rows under the
+    // kernel stay resident in L1/L2
+    static constexpr uint32_t VERTICAL_STRIP_WIDTH = 256;
+    // Parallel grain of the IIR chain: column strips for the vertical recursion, row bands for the rest
+    static constexpr uint32_t IIR_STRIP_WIDTH = 64;
+    static constexpr uint32_t IIR_ROW_BAND = 16;
+
+    void PrepareSource(const Image& sceneColor, const Image& velocity, const CpuPostProcessParams& params);
+    void RunIir(JobSystem* jobs, const Image& sceneColor, const Image& velocity, const CpuPostProcessParams& params,
+                Image& output);
+
+    const float* WidenColor(const Image& image, std::vector<float>& storage) const;
+    const float* WidenVelocity(const Image& image, std::vector<float>& storage) const;
+    void StoreRow(const float* src, Image& output, uint32_t x, uint32_t y, uint32_t pixelCount) const;
+
+    const PostProcessKernels* kernels = nullptr;
+    uint32_t tileWidth = DEFAULT_TILE_SIZE;
+    uint32_t tileHeight = DEFAULT_TILE_SIZE;
+    float iirCrossoverRadius = DEFAULT_IIR_CROSSOVER_RADIUS;
+
+    PerfCounterGroup* perfCounters = nullptr;
+    PerfCounterValues frameCounters;
+
+    // State of the frame started by BeginFrame
+    MotionApplySource source;
+    BlurKernel kernel;
+    Image* target = nullptr;
+    uint32_t tileCountX = 0;
+    uint32_t tileCountY = 0;
+    std::vector<float> sceneStorage;
+    std::vector<float> velocityStorage;
+    std::vector<float> iirMotion;
+    std::vector<float> iirBlur;
+
+    // One scratch per job system worker, reused across frames
+    std::vector<TileScratch> workerScratch;
+};
+
+}  // namespace cpu
+}  // namespace vkdemo
@@ -0,0 +1,161 @@
+#include "iir_blur.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace vkdemo
+{
+namespace cpu
+{
+
+// Coefficients of the 1995 paper for a given q
+static IirGaussianCoefficients CoefficientsFromQ(double q)
+{
+    const double q2 = q * q;
+    const double q3 = q2 * q;
+    const double b0 = 1.57825 + 2.44413 * q + 1.4281 * q2 + 0.422205 * q3;
+    const double b1 = 2.44413 * q + 2.85619 * q2 + 1.26661 * q3;
+    const double b2 = -(1.4281 * q2 + 1.26661 * q3);
+    const double b3 = 0.422205 * q3;
+
+    IirGaussianCoefficients coefficients;
+    coefficients.a1 = static_cast<float>(b1 / b0);
+    coefficients.a2 = static_cast<float>(b2 / b0);
+    coefficients.a3 = static_cast<float>(b3 / b0);
+    coefficients.b = static_cast<float>(1.0 - (b1 + b2 + b3) / b0);
+    return coefficients;
+}
+
+// Variance of the causal plus anti-causal impulse response, from the derivatives of the transfer
+// function b / (1 - a1 z^-1 - a2 z^-2 - a3 z^-3) at z = 1
+static double GetResponseVariance(const IirGaussianCoefficients& c)
+{
+    const double b = c.b;
+    const double first = c.a1 + 2.0 * c.a2 + 3.0 * c.a3;
+    const double second = 2.0 * c.a2 + 6.0 * c.a3;
+    return 2.0 * ((second + first) / b + (first * first) / (b * b));
+}
+
+IirGaussianCoefficients ComputeIirGaussianCoefficients(float sigma)
+{
+    const double s = std::max(static_cast<double>(sigma), 0.5);
+
+    // The paper's closed form for q overshoots sigma by 10-15%; bisect q until the response variance
+    // matches, starting from a bracket around it
+    double q = s >= 2.5 ? 0.98711 * s - 0.96330 : 3.97156 - 4.14554 * std::sqrt(1.0 - 0.26891 * s);
+    double low = q * 0.5;
+    double high = q * 1.5;
+    for (int i = 0; i < 40; i++)
+    {
+        q = 0.5 * (low + high);
+        if (GetResponseVariance(CoefficientsFromQ(q)) > s * s)
+            high = q;
+        else
+            low = q;
+    }
+    return CoefficientsFromQ(q);
+}
+
+void IirBlurRows(const float* src, float* dst, uint32_t width, uint32_t rowBegin, uint32_t rowEnd,
+                 const IirGaussianCoefficients& coefficients)
+{
+    const float b = coefficients.b;
+    const float a1 = coefficients.a1;
+    const float a2 = coefficients.a2;
+    const float a3 = coefficients.a3;
+    const size_t pitch = static_cast<size_t>(width) * 4;
+
+    for (uint32_t y = rowBegin; y < rowEnd; y++)
+    {
+        const float* in = src + y * pitch;
+        float* out = dst + y * pitch;
+
+        // Causal pass
+        float h1[4], h2[4], h3[4];
+        for (int c = 0; c < 4; c++)
+        {
+            h1[c] = h2[c] = h3[c] = in[c];
+        }
+        for (uint32_t x = 0; x < width; x++)
+        {
+            for (int c = 0; c < 4; c++)
+            {
+                float value = b * in[x * 4 + c] + a1 * h1[c] + a2 * h2[c] + a3 * h3[c];
+                h3[c] = h2[c];
+                h2[c] = h1[c];
+                h1[c] = value;
+                out[x * 4 + c] = value;
+            }
+        }
+
+        // Anti-causal pass over the causal result
+        for (int c = 0; c < 4; c++)
+        {
+            h2[c] = h3[c] = h1[c];
+        }
+        for (uint32_t x = width; x-- > 0;)
+        {
+            for (int c = 0; c < 4; c++)
+            {
+                float value = b * out[x * 4 + c] + a1 * h1[c] + a2 * h2[c] + a3 * h3[c];
+                h3[c] = h2[c];
+                h2[c] = h1[c];
+                h1[c] = value;
+                out[x * 4 + c] = value;
+            }
+        }
+    }
+}
+
+void IirBlurColumns(const float* src, float* dst, uint32_t width, uint32_t height, uint32_t columnBegin,
+                    uint32_t columnEnd, const IirGaussianCoefficients& coefficients, std::vector<float>& history)
+{
+    const float b = coefficients.b;
+    const float a1 = coefficients.a1;
+    const float a2 = coefficients.a2;
+    const float a3 = coefficients.a3;
+    const size_t pitch = static_cast<size_t>(width) * 4;
+    const size_t count = static_cast<size_t>(columnEnd - columnBegin) * 4;
+    const size_t offset = static_cast<size_t>(columnBegin) * 4;
+
+    history.resize(count * 3);
+    float* h1 = history.data();
+    float* h2 = h1 + count;
+    float* h3 = h2 + count;
+
+    // Causal pass, top to bottom
+    std::copy(src + offset, src + offset + count, h1);
+    std::copy(h1, h1 + count, h2);
+    std::copy(h1, h1 + count, h3);
+    for (uint32_t y = 0; y < height; y++)
+    {
+        const float* in = src + y * pitch + offset;
+        float* out = dst + y * pitch + offset;
+        for (size_t i = 0; i < count; i++)
+        {
+            out[i] = b * in[i] + a1 * h1[i] + a2 * h2[i] + a3 * h3[i];
+        }
+        // The oldest row of history becomes the newest
+        std::copy(out, out + count, h3);
+        std::swap(h3, h2);
+        std::swap(h2, h1);
+    }
+
+    // Anti-causal pass, bottom to top; history starts at the last causal row
+    std::copy(h1, h1 + count, h2);
+    std::copy(h1, h1 + count, h3);
+    for (uint32_t y = height; y-- > 0;)
+    {
+        float* out = dst + y * pitch + offset;
+        for (size_t i = 0; i < count; i++)
+        {
+            out[i] = b * out[i] + a1 * h1[i] + a2 * h2[i] + a3 * h3[i];
+        }
+        std::copy(out, out + count, h3);
+        std::swap(h3, h2);
+        std::swap(h2, h1);
+    }
+}
+
+}  // namespace cpu
+}  // namespace vkdemo
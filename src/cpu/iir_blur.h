@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace vkdemo
+{
+namespace cpu
+{
+
+//=============================================================================
+// Recursive Gaussian
+//=============================================================================
+
+// Fir runs the 9-tap kernel of blur_*.frag, whose cost grows with the stretched radius; Iir runs a
+// recursive Gaussian of the same sigma at constant cost; Auto picks Iir from a crossover radius on
+enum class BlurMode
+{
+    Fir,
+    Iir,
+    Auto
+};
+
+// Third-order recursive Gaussian of Young and van Vliet ("Recursive implementation of the Gaussian
+// filter", 1995): y[n] = b * x[n] + a1 * y[n-1] + a2 * y[n-2] + a3 * y[n-3], run causally and then
+// anti-causally along each line. Cost per pixel is constant whatever the sigma; b + a1 + a2 + a3 == 1.
+struct IirGaussianCoefficients
+{
+    float b = 1.0f;
+    float a1 = 0.0f;
+    float a2 = 0.0f;
+    float a3 = 0.0f;
+};
+
+// Valid from sigma 0.5 upwards (smaller values are clamped)
+IirGaussianCoefficients ComputeIirGaussianCoefficients(float sigma);
+
+// Filters rows [rowBegin, rowEnd) of an RGBA32F image along x. src and dst may be the same buffer.
+// Line ends start from the steady state of the edge texel, which matches CLAMP_TO_EDGE.
+void IirBlurRows(const float* src, float* dst, uint32_t width, uint32_t rowBegin, uint32_t rowEnd,
+                 const IirGaussianCoefficients& coefficients);
+
+// Filters columns [columnBegin, columnEnd) of an RGBA32F image along y. The strip advances one row
+// at a time with its recursion history held in history, so memory is walked row by row rather than
+// one column per pass. src and dst may be the same buffer.
+void IirBlurColumns(const float* src, float* dst, uint32_t width, uint32_t height, uint32_t columnBegin,
+                    uint32_t columnEnd, const IirGaussianCoefficients& coefficients, std::vector<float>& history);
+
+}  // namespace cpu
+}  // namespace vkdemo
@@ -0,0 +1,145 @@
+#include "image.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace vkdemo
+{
+namespace cpu
+{
+
+uint32_t GetChannelCount(PixelFormat format)
+{
+    switch (format)
+    {
+    case PixelFormat::RGBA32F:
+    case PixelFormat::RGBA16F:
+        return 4;
+    case PixelFormat::RG32F:
+    case PixelFormat::RG16F:
+        return 2;
+    }
+    return 0;
+}
+
+uint32_t GetPixelSize(PixelFormat format)
+{
+    return GetChannelCount(format) * (IsHalfFormat(format) ? 2 : 4);
+}
+
+bool IsHalfFormat(PixelFormat format)
+{
+    return format == PixelFormat::RGBA16F || format == PixelFormat::RG16F;
+}
+
+Image Image::Create(uint32_t width, uint32_t height, PixelFormat format)
+{
+    if (width == 0 || height == 0)
+    {
+        throw std::runtime_error("Failed to create CPU image: empty extent!");
+    }
+
+    Image image;
+    image.width = width;
+    image.height = height;
+    image.format = format;
+    image.data.resize(static_cast<size_t>(width) * height * GetPixelSize(format));
+    return image;
+}
+
+uint16_t FloatToHalf(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    uint32_t exponent = (bits >> 23) & 0xFFu;
+    uint32_t mantissa = bits & 0x7FFFFFu;
+
+    // Inf and NaN (keep NaN quiet)
+    if (exponent == 0xFFu)
+    {
+        return static_cast<uint16_t>(sign | 0x7C00u | (mantissa ? 0x200u | (mantissa >> 13) : 0u));
+    }
+
+    int32_t halfExponent = static_cast<int32_t>(exponent) - 127 + 15;
+
+    // Overflow to infinity
+    if (halfExponent >= 0x1F)
+    {
+        return static_cast<uint16_t>(sign | 0x7C00u);
+    }
+
+    // Denormal or zero
+    if (halfExponent <= 0)
+    {
+        if (halfExponent < -10)
+        {
+            return static_cast<uint16_t>(sign);
+        }
+
+        mantissa |= 0x800000u;
+        uint32_t shift = static_cast<uint32_t>(14 - halfExponent);
+        uint32_t halfMantissa = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1u);
+        uint32_t halfway = 1u << (shift - 1u);
+        if (remainder > halfway || (remainder == halfway && (halfMantissa & 1u)))
+        {
+            halfMantissa++;
+        }
+        return static_cast<uint16_t>(sign | halfMantissa);
+    }
+
+    uint32_t half = sign | (static_cast<uint32_t>(halfExponent) << 10) | (mantissa >> 13);
+    uint32_t remainder = mantissa & 0x1FFFu;
+
+    // Round to nearest even; a mantissa carry correctly bumps the exponent (up to infinity)
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u)))
+    {
+        half++;
+    }
+    return static_cast<uint16_t>(half);
+}
+
+float HalfToFloat(uint16_t value)
+{
+    uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+    uint32_t exponent = (value >> 10) & 0x1Fu;
+    uint32_t mantissa = value & 0x3FFu;
+
+    uint32_t bits;
+    if (exponent == 0)
+    {
+        if (mantissa == 0)
+        {
+            bits = sign;
+        }
+        else
+        {
+            // Normalize the denormal
+            exponent = 127 - 15 + 1;
+            while ((mantissa & 0x400u) == 0)
+            {
+                mantissa <<= 1;
+                exponent--;
+            }
+            mantissa &= 0x3FFu;
+            bits = sign | (exponent << 23) | (mantissa << 13);
+        }
+    }
+    else if (exponent == 0x1Fu)
+    {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    }
+    else
+    {
+        bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    }
+
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+}  // namespace cpu
+}  // namespace vkdemo
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vkdemo
+{
+namespace cpu
+{
+
+//=============================================================================
+// CPU Images
+//=============================================================================
+
+// Pixel formats matching the GPU render targets (R16G16B16A16_SFLOAT, R16G16_SFLOAT)
+// and their FP32 equivalents. Channels are interleaved.
+enum class PixelFormat
+{
+    RGBA32F,
+    RGBA16F,
+    RG32F,
+    RG16F
+};
+
+uint32_t GetChannelCount(PixelFormat format);
+uint32_t GetPixelSize(PixelFormat format);
+bool IsHalfFormat(PixelFormat format);
+
+// Tightly packed 2D image (row pitch == width * pixel size)
+struct Image
+{
+    uint32_t width = 0;
+    uint32_t height = 0;
+    PixelFormat format = PixelFormat::RGBA32F;
+    std::vector<uint8_t> data;
+
+    static Image Create(uint32_t width, uint32_t height, PixelFormat format);
+
+    size_t GetRowPitch() const { return static_cast<size_t>(width) * GetPixelSize(format); }
+    uint8_t* GetRow(uint32_t y) { return data.data() + y * GetRowPitch(); }
+    const uint8_t* GetRow(uint32_t y) const { return data.data() + y * GetRowPitch(); }
+};
+
+// IEEE 754 binary16 conversion (round to nearest even, denormals, inf and NaN preserved)
+uint16_t FloatToHalf(float value);
+float HalfToFloat(uint16_t value);
+
+}  // namespace cpu
+}  // namespace vkdemo
@@ -0,0 +1,229 @@
+#include "perf_counters.h"
+
+#if defined(__linux__)
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+
+    #include <cerrno>
+    #include <cstring>
+    #include <fstream>
+#endif
+
+namespace vkdemo
+{
+namespace cpu
+{
+
+const char* GetPerfCounterName(PerfCounter counter)
+{
+    switch (counter)
+    {
+    case PerfCounter::Cycles:
+        return "cycles";
+    case PerfCounter::Instructions:
+        return "instructions";
+    case PerfCounter::L1DMisses:
+        return "L1D misses";
+    case PerfCounter::LLCMisses:
+        return "LLC misses";
+    case PerfCounter::Count:
+        break;
+    }
+    return "unknown";
+}
+
+//=============================================================================
+// PerfCounterValues
+//=============================================================================
+
+double PerfCounterValues::GetIpc() const
+{
+    if (!IsValid(PerfCounter::Cycles) || !IsValid(PerfCounter::Instructions) || Get(PerfCounter::Cycles) == 0)
+        return 0.0;
+    return static_cast<double>(Get(PerfCounter::Instructions)) / static_cast<double>(Get(PerfCounter::Cycles));
+}
+
+double PerfCounterValues::GetPerPixel(PerfCounter counter, double pixelCount) const
+{
+    if (!IsValid(counter) || pixelCount <= 0.0)
+        return -1.0;
+    return static_cast<double>(Get(counter)) / pixelCount;
+}
+
+PerfCounterValues& PerfCounterValues::operator+=(const PerfCounterValues& other)
+{
+    for (size_t i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+        if (other.valid[i])
+        {
+            values[i] += other.values[i];
+            valid[i] = true;
+        }
+    }
+    return *this;
+}
+
+//=============================================================================
+// PerfCounterGroup
+//=============================================================================
+
+#if defined(__linux__)
+
+static int OpenCounter(uint32_t type, uint64_t config)
+{
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    // Calling thread, any CPU, no group: each counter is scheduled (and multiplexed) independently
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+static uint64_t CacheMissConfig(uint64_t cache)
+{
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+PerfCounterGroup::PerfCounterGroup()
+{
+    auto open = [this](PerfCounter counter, uint32_t type, uint64_t config)
+    {
+        int fd = OpenCounter(type, config);
+        fds[static_cast<size_t>(counter)] = fd;
+
+        // Report the first failure; later ones usually share its cause
+        if (fd >= 0 || !unavailableReason.empty())
+            return;
+
+        int error = errno;
+        if (error == EACCES || error == EPERM)
+        {
+            std::string paranoid = "unknown";
+            std::ifstream file("/proc/sys/kernel/perf_event_paranoid");
+            std::getline(file, paranoid);
+            unavailableReason = "perf_event_open denied (perf_event_paranoid = " + paranoid + ")";
+        }
+        else
+        {
+            unavailableReason = std::string(GetPerfCounterName(counter)) + " unavailable: " + std::strerror(error);
+        }
+    };
+
+    open(PerfCounter::Cycles, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    open(PerfCounter::Instructions, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    open(PerfCounter::L1DMisses, PERF_TYPE_HW_CACHE, CacheMissConfig(PERF_COUNT_HW_CACHE_L1D));
+    open(PerfCounter::LLCMisses, PERF_TYPE_HW_CACHE, CacheMissConfig(PERF_COUNT_HW_CACHE_LL));
+}
+
+PerfCounterGroup::~PerfCounterGroup()
+{
+    for (int fd : fds)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+    }
+}
+
+void PerfCounterGroup::Start()
+{
+    for (int fd : fds)
+    {
+        if (fd >= 0)
+        {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+PerfCounterValues PerfCounterGroup::Stop()
+{
+    for (int fd : fds)
+    {
+        if (fd >= 0)
+        {
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+
+    PerfCounterValues result;
+    for (size_t i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+        // value, time enabled, time running
+        uint64_t data[3] = {};
+        if (fds[i] < 0 || read(fds[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)))
+            continue;
+
+        // Scale up when the PMU multiplexed this counter with others
+        if (data[2] > 0 && data[2] < data[1])
+        {
+            data[0] = static_cast<uint64_t>(static_cast<double>(data[0]) * data[1] / data[2]);
+        }
+        result.values[i] = data[0];
+        result.valid[i] = data[2] > 0 || data[0] > 0;
+    }
+    return result;
+}
+
+#else
+
+PerfCounterGroup::PerfCounterGroup()
+{
+    fds.fill(-1);
+    unavailableReason = "perf_event_open is Linux only";
+}
+
+PerfCounterGroup::~PerfCounterGroup() = default;
+
+void PerfCounterGroup::Start() {}
+
+PerfCounterValues PerfCounterGroup::Stop()
+{
+    return PerfCounterValues();
+}
+
+#endif
+
+bool PerfCounterGroup::IsAvailable() const
+{
+    for (int fd : fds)
+    {
+        if (fd >= 0)
+            return true;
+    }
+    return false;
+}
+
+//=============================================================================
+// ScopedPerfCounters
+//=============================================================================
+
+ScopedPerfCounters::ScopedPerfCounters(PerfCounterGroup* group, PerfCounterValues& result)
+    : group(group), result(result)
+{
+    if (group)
+    {
+        group->Start();
+    }
+}
+
+ScopedPerfCounters::~ScopedPerfCounters()
+{
+    if (group)
+    {
+        result += group->Stop();
+    }
+}
+
+}  // namespace cpu
+}  // namespace vkdemo
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace vkdemo
+{
+namespace cpu
+{
+
+//=============================================================================
+// Hardware Performance Counters
+//=============================================================================
+
+enum class PerfCounter
+{
+    Cycles,
+    Instructions,
+    L1DMisses,
+    LLCMisses,
+    Count
+};
+
+constexpr size_t PERF_COUNTER_COUNT = static_cast<size_t>(PerfCounter::Count);
+
+const char* GetPerfCounterName(PerfCounter counter);
+
+// Counter totals of one or more measured regions; counters that could not be opened stay invalid
+struct PerfCounterValues
+{
+    std::array<uint64_t, PERF_COUNTER_COUNT> values{};
+    std::array<bool, PERF_COUNTER_COUNT> valid{};
+
+    bool IsValid(PerfCounter counter) const { return valid[static_cast<size_t>(counter)]; }
+    uint64_t Get(PerfCounter counter) const { return values[static_cast<size_t>(counter)]; }
+
+    // Instructions per cycle, or 0 when either counter is unavailable
+    double GetIpc() const;
+    // Events per pixel, or -1 when the counter is unavailable
+    double GetPerPixel(PerfCounter counter, double pixelCount) const;
+
+    PerfCounterValues& operator+=(const PerfCounterValues& other);
+};
+
+// Cycles, instructions, L1D read misses and LLC read misses of the calling thread, in user space,
+// through Linux perf_event_open. Counters the kernel refuses (perf_event_paranoid, missing PMU in a
+// VM, non-Linux builds) are reported as unavailable instead of failing. Counts cover the thread that
+// calls Start/Stop only, so measure single-threaded runs for per-kernel numbers.
+class PerfCounterGroup
+{
+public:
+    PerfCounterGroup();
+    ~PerfCounterGroup();
+
+    PerfCounterGroup(const PerfCounterGroup&) = delete;
+    PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+
+    bool IsAvailable() const;
+    bool IsAvailable(PerfCounter counter) const { return fds[static_cast<size_t>(counter)] >= 0; }
+    // Why counters are missing, empty when all opened
+    const std::string& GetUnavailableReason() const { return unavailableReason; }
+
+    void Start();
+    PerfCounterValues Stop();
+
+private:
+    std::array<int, PERF_COUNTER_COUNT> fds;
+    std::string unavailableReason;
+};
+
+// Counts the enclosing scope and adds the result to `result` on destruction
+class ScopedPerfCounters
+{
+public:
+    ScopedPerfCounters(PerfCounterGroup* group, PerfCounterValues& result);
+    ~ScopedPerfCounters();
+
+    ScopedPerfCounters(const ScopedPerfCounters&) = delete;
+    ScopedPerfCounters& operator=(const ScopedPerfCounters&) = delete;
+
+private:
+    PerfCounterGroup* group;
+    PerfCounterValues& result;
+};
+
+}  // namespace cpu
+}  // namespace vkdemo
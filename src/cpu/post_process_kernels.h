@@ -0,0 +1,68 @@
+#pragma once
+
+#include "cpu_features.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace vkdemo
+{
+namespace cpu
+{
+
+//=============================================================================
+// Post-Process Row Kernels
+//=============================================================================
+
+// Inputs of motion_apply.frag: full-resolution FP32 scene color (RGBA) and velocity (RG)
+struct MotionApplySource
+{
+    const float* sceneColor = nullptr;
+    const float* velocity = nullptr;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    float motionScale = 1.0f;
+};
+
+// Innermost loops of the CPU post-process chain. Every kernel works on FP32 RGBA
+// rows; one table exists per instruction set tier and is picked at runtime.
+struct PostProcessKernels
+{
+    SimdLevel level = SimdLevel::Scalar;
+
+    // motion_apply.frag for pixelCount pixels of row y; columns[i] is the image x of output pixel i
+    void (*motionApplyRow)(const MotionApplySource& source, uint32_t y, const uint32_t* columns, float* dst,
+                           uint32_t pixelCount) = nullptr;
+
+    // Vertical blur step: dst[i] = sum(weights[t] * rows[t][i]) over floatCount floats
+    void (*blurColumns)(const float* const* rows, const float* weights, uint32_t taps, float* dst,
+                        uint32_t floatCount) = nullptr;
+
+    // Horizontal blur of RGBA pixels: dst[x] = sum(weights[t] * src[x + t]); src holds pixelCount + taps - 1 pixels
+    void (*blurRow)(const float* src, const float* weights, uint32_t taps, float* dst, uint32_t pixelCount) = nullptr;
+
+    // final_apply.frag: blend motion and blur results, tone map and gamma correct
+    void (*finalApplyRow)(const float* motion, const float* blur, float* dst, uint32_t pixelCount) = nullptr;
+
+    void (*halfToFloat)(const uint16_t* src, float* dst, size_t count) = nullptr;
+    void (*floatToHalf)(const float* src, uint16_t* dst, size_t count) = nullptr;
+};
+
+// Returns the table for the requested level, or the best compiled-in level below it
+const PostProcessKernels& GetPostProcessKernels(SimdLevel level);
+
+// Constant blend factor hard-coded in final_apply.frag
+constexpr float FINAL_BLUR_AMOUNT = 0.3f;
+
+namespace detail
+{
+
+// Per-tier tables (nullptr when the tier is not compiled for this architecture)
+const PostProcessKernels* GetScalarKernels();
+const PostProcessKernels* GetSse2Kernels();
+const PostProcessKernels* GetAvx2Kernels();
+
+}  // namespace detail
+
+}  // namespace cpu
+}  // namespace vkdemo
@@ -0,0 +1,164 @@
+#include "post_process_kernels_common.h"
+
+#if VKDEMO_CPU_X86
+    #include <immintrin.h>
+#endif
+
+// Every kernel here is compiled for AVX2/FMA/F16C through VKDEMO_TARGET_AVX2 and must only be reached
+// after DetectSimdLevel() has confirmed support.
+
+namespace vkdemo
+{
+namespace cpu
+{
+namespace detail
+{
+
+#if VKDEMO_CPU_X86
+
+// Eight floats (two RGBA pixels) per register, two registers per iteration to hide FMA latency
+VKDEMO_TARGET_AVX2 static void BlurColumnsAvx2(const float* const* rows, const float* weights, uint32_t taps,
+                                                float* dst, uint32_t floatCount)
+{
+    uint32_t i = 0;
+    for (; i + 16 <= floatCount; i += 16)
+    {
+        __m256 sum0 = _mm256_setzero_ps();
+        __m256 sum1 = _mm256_setzero_ps();
+        for (uint32_t t = 0; t < taps; t++)
+        {
+            __m256 weight = _mm256_set1_ps(weights[t]);
+            sum0 = _mm256_fmadd_ps(weight, _mm256_loadu_ps(rows[t] + i), sum0);
+            sum1 = _mm256_fmadd_ps(weight, _mm256_loadu_ps(rows[t] + i + 8), sum1);
+        }
+        _mm256_storeu_ps(dst + i, sum0);
+        _mm256_storeu_ps(dst + i + 8, sum1);
+    }
+    for (; i + 8 <= floatCount; i += 8)
+    {
+        __m256 sum = _mm256_setzero_ps();
+        for (uint32_t t = 0; t < taps; t++)
+        {
+            sum = _mm256_fmadd_ps(_mm256_set1_ps(weights[t]), _mm256_loadu_ps(rows[t] + i), sum);
+        }
+        _mm256_storeu_ps(dst + i, sum);
+    }
+    for (; i < floatCount; i++)
+    {
+        float sum = 0.0f;
+        for (uint32_t t = 0; t < taps; t++)
+        {
+            sum += weights[t] * rows[t][i];
+        }
+        dst[i] = sum;
+    }
+}
+
+VKDEMO_TARGET_AVX2 static void BlurRowAvx2(const float* src, const float* weights, uint32_t taps, float* dst,
+                                            uint32_t pixelCount)
+{
+    uint32_t x = 0;
+    for (; x + 4 <= pixelCount; x += 4)
+    {
+        __m256 sum0 = _mm256_setzero_ps();
+        __m256 sum1 = _mm256_setzero_ps();
+        for (uint32_t t = 0; t < taps; t++)
+        {
+            __m256 weight = _mm256_set1_ps(weights[t]);
+            sum0 = _mm256_fmadd_ps(weight, _mm256_loadu_ps(src + (x + t) * 4), sum0);
+            sum1 = _mm256_fmadd_ps(weight, _mm256_loadu_ps(src + (x + t + 2) * 4), sum1);
+        }
+        _mm256_storeu_ps(dst + x * 4, sum0);
+        _mm256_storeu_ps(dst + x * 4 + 8, sum1);
+    }
+    for (; x < pixelCount; x++)
+    {
+        __m128 sum = _mm_setzero_ps();
+        for (uint32_t t = 0; t < taps; t++)
+        {
+            sum = _mm_fmadd_ps(_mm_set1_ps(weights[t]), _mm_loadu_ps(src + (x + t) * 4), sum);
+        }
+        _mm_storeu_ps(dst + x * 4, sum);
+    }
+}
+
+VKDEMO_TARGET_AVX2 static void FinalApplyRowAvx2(const float* motion, const float* blur, float* dst,
+                                                  uint32_t pixelCount)
+{
+    const __m256 motionWeight = _mm256_set1_ps(1.0f - FINAL_BLUR_AMOUNT);
+    const __m256 blurWeight = _mm256_set1_ps(FINAL_BLUR_AMOUNT);
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    uint32_t x = 0;
+    for (; x + 2 <= pixelCount; x += 2)
+    {
+        __m256 color = _mm256_fmadd_ps(_mm256_loadu_ps(motion + x * 4), motionWeight,
+                                       _mm256_mul_ps(_mm256_loadu_ps(blur + x * 4), blurWeight));
+        color = _mm256_div_ps(color, _mm256_add_ps(color, one));
+        _mm256_storeu_ps(dst + x * 4, color);
+        ApplyGamma(dst + x * 4);
+        ApplyGamma(dst + x * 4 + 4);
+    }
+    if (x < pixelCount)
+    {
+        GetSse2Kernels()->finalApplyRow(motion + x * 4, blur + x * 4, dst + x * 4, pixelCount - x);
+    }
+}
+
+VKDEMO_TARGET_AVX2 static void HalfToFloatAvx2(const uint16_t* src, float* dst, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i half = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(half));
+    }
+    for (; i < count; i++)
+    {
+        dst[i] = _cvtsh_ss(src[i]);
+    }
+}
+
+VKDEMO_TARGET_AVX2 static void FloatToHalfAvx2(const float* src, uint16_t* dst, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), half);
+    }
+    for (; i < count; i++)
+    {
+        dst[i] = _cvtss_sh(src[i], _MM_FROUND_TO_NEAREST_INT);
+    }
+}
+
+const PostProcessKernels* GetAvx2Kernels()
+{
+    static const PostProcessKernels kernels = []
+    {
+        // Motion apply is bound by its scattered bilinear fetches, so it keeps the SSE2 version
+        PostProcessKernels table = *GetSse2Kernels();
+        table.level = SimdLevel::AVX2;
+        table.blurColumns = BlurColumnsAvx2;
+        table.blurRow = BlurRowAvx2;
+        table.finalApplyRow = FinalApplyRowAvx2;
+        table.halfToFloat = HalfToFloatAvx2;
+        table.floatToHalf = FloatToHalfAvx2;
+        return table;
+    }();
+    return &kernels;
+}
+
+#else
+
+const PostProcessKernels* GetAvx2Kernels()
+{
+    return nullptr;
+}
+
+#endif
+
+}  // namespace detail
+}  // namespace cpu
+}  // namespace vkdemo
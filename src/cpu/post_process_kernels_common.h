@@ -0,0 +1,68 @@
+#pragma once
+
+#include "post_process_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Scalar building blocks shared by every kernel tier (internal to src/cpu)
+
+namespace vkdemo
+{
+namespace cpu
+{
+namespace detail
+{
+
+// Number of taps and their positions along the velocity vector in motion_apply.frag
+constexpr uint32_t MOTION_TAP_COUNT = 4;
+constexpr float MOTION_TAP_STEP = 0.25f;
+
+// Bilinear sample position of a motion tap, in texel coordinates clamped to the image (ClampToRenderArea)
+struct BilinearTap
+{
+    uint32_t x0, x1, y0, y1;
+    float fx, fy;
+};
+
+inline BilinearTap ComputeMotionTap(const MotionApplySource& source, uint32_t x, uint32_t y, float velocityX,
+                                    float velocityY, float t)
+{
+    // uv + velocity * t, converted from normalized to texel-center coordinates
+    float px = static_cast<float>(x) + velocityX * t * static_cast<float>(source.width);
+    float py = static_cast<float>(y) + velocityY * t * static_cast<float>(source.height);
+    px = std::min(std::max(px, 0.0f), static_cast<float>(source.width - 1));
+    py = std::min(std::max(py, 0.0f), static_cast<float>(source.height - 1));
+
+    BilinearTap tap;
+    tap.x0 = static_cast<uint32_t>(px);
+    tap.y0 = static_cast<uint32_t>(py);
+    tap.fx = px - static_cast<float>(tap.x0);
+    tap.fy = py - static_cast<float>(tap.y0);
+    tap.x1 = std::min(tap.x0 + 1, source.width - 1);
+    tap.y1 = std::min(tap.y0 + 1, source.height - 1);
+    return tap;
+}
+
+inline const float* ScenePixel(const MotionApplySource& source, uint32_t x, uint32_t y)
+{
+    return source.sceneColor + (static_cast<size_t>(y) * source.width + x) * 4;
+}
+
+inline const float* VelocityPixel(const MotionApplySource& source, uint32_t x, uint32_t y)
+{
+    return source.velocity + (static_cast<size_t>(y) * source.width + x) * 2;
+}
+
+// pow(c, 1/2.2) from final_apply.frag; kept scalar so every tier matches the reference exactly
+inline void ApplyGamma(float* rgba)
+{
+    rgba[0] = std::pow(rgba[0], 1.0f / 2.2f);
+    rgba[1] = std::pow(rgba[1], 1.0f / 2.2f);
+    rgba[2] = std::pow(rgba[2], 1.0f / 2.2f);
+    rgba[3] = 1.0f;
+}
+
+}  // namespace detail
+}  // namespace cpu
+}  // namespace vkdemo
@@ -0,0 +1,139 @@
+#include "image.h"
+#include "post_process_kernels_common.h"
+
+namespace vkdemo
+{
+namespace cpu
+{
+namespace detail
+{
+
+static void MotionApplyRowScalar(const MotionApplySource& source, uint32_t y, const uint32_t* columns, float* dst,
+                                 uint32_t pixelCount)
+{
+    for (uint32_t i = 0; i < pixelCount; i++)
+    {
+        uint32_t x = columns[i];
+        const float* velocity = VelocityPixel(source, x, y);
+        float velocityX = velocity[0] * source.motionScale;
+        float velocityY = velocity[1] * source.motionScale;
+
+        float color[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        for (uint32_t tapIndex = 0; tapIndex < MOTION_TAP_COUNT; tapIndex++)
+        {
+            BilinearTap tap =
+                ComputeMotionTap(source, x, y, velocityX, velocityY, static_cast<float>(tapIndex) * MOTION_TAP_STEP);
+            const float* p00 = ScenePixel(source, tap.x0, tap.y0);
+            const float* p10 = ScenePixel(source, tap.x1, tap.y0);
+            const float* p01 = ScenePixel(source, tap.x0, tap.y1);
+            const float* p11 = ScenePixel(source, tap.x1, tap.y1);
+            for (int c = 0; c < 3; c++)
+            {
+                float top = p00[c] + (p10[c] - p00[c]) * tap.fx;
+                float bottom = p01[c] + (p11[c] - p01[c]) * tap.fx;
+                color[c] += top + (bottom - top) * tap.fy;
+            }
+        }
+
+        float* out = dst + i * 4;
+        out[0] = color[0] / static_cast<float>(MOTION_TAP_COUNT);
+        out[1] = color[1] / static_cast<float>(MOTION_TAP_COUNT);
+        out[2] = color[2] / static_cast<float>(MOTION_TAP_COUNT);
+        out[3] = 1.0f;
+    }
+}
+
+static void BlurColumnsScalar(const float* const* rows, const float* weights, uint32_t taps, float* dst,
+                              uint32_t floatCount)
+{
+    for (uint32_t i = 0; i < floatCount; i++)
+    {
+        float sum = 0.0f;
+        for (uint32_t t = 0; t < taps; t++)
+        {
+            sum += weights[t] * rows[t][i];
+        }
+        dst[i] = sum;
+    }
+}
+
+static void BlurRowScalar(const float* src, const float* weights, uint32_t taps, float* dst, uint32_t pixelCount)
+{
+    for (uint32_t x = 0; x < pixelCount; x++)
+    {
+        float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        for (uint32_t t = 0; t < taps; t++)
+        {
+            const float* p = src + (x + t) * 4;
+            for (int c = 0; c < 4; c++)
+            {
+                sum[c] += weights[t] * p[c];
+            }
+        }
+        for (int c = 0; c < 4; c++)
+        {
+            dst[x * 4 + c] = sum[c];
+        }
+    }
+}
+
+static void FinalApplyRowScalar(const float* motion, const float* blur, float* dst, uint32_t pixelCount)
+{
+    for (uint32_t x = 0; x < pixelCount; x++)
+    {
+        float* out = dst + x * 4;
+        for (int c = 0; c < 3; c++)
+        {
+            float color = motion[x * 4 + c] * (1.0f - FINAL_BLUR_AMOUNT) + blur[x * 4 + c] * FINAL_BLUR_AMOUNT;
+            out[c] = color / (color + 1.0f);
+        }
+        ApplyGamma(out);
+    }
+}
+
+static void HalfToFloatScalar(const uint16_t* src, float* dst, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        dst[i] = HalfToFloat(src[i]);
+    }
+}
+
+static void FloatToHalfScalar(const float* src, uint16_t* dst, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        dst[i] = FloatToHalf(src[i]);
+    }
+}
+
+const PostProcessKernels* GetScalarKernels()
+{
+    static const PostProcessKernels kernels = []
+    {
+        PostProcessKernels table;
+        table.level = SimdLevel::Scalar;
+        table.motionApplyRow = MotionApplyRowScalar;
+        table.blurColumns = BlurColumnsScalar;
+        table.blurRow = BlurRowScalar;
+        table.finalApplyRow = FinalApplyRowScalar;
+        table.halfToFloat = HalfToFloatScalar;
+        table.floatToHalf = FloatToHalfScalar;
+        return table;
+    }();
+    return &kernels;
+}
+
+}  // namespace detail
+
+const PostProcessKernels& GetPostProcessKernels(SimdLevel level)
+{
+    if (level >= SimdLevel::AVX2 && detail::GetAvx2Kernels())
+        return *detail::GetAvx2Kernels();
+    if (level >= SimdLevel::SSE2 && detail::GetSse2Kernels())
+        return *detail::GetSse2Kernels();
+    return *detail::GetScalarKernels();
+}
+
+}  // namespace cpu
+}  // namespace vkdemo
@@ -0,0 +1,148 @@
+#include "post_process_kernels_common.h"
+
+#if VKDEMO_CPU_X86
+    #include <emmintrin.h>
+#endif
+
+namespace vkdemo
+{
+namespace cpu
+{
+namespace detail
+{
+
+#if VKDEMO_CPU_X86
+
+// One RGBA pixel per __m128; the tap address math stays scalar
+static void MotionApplyRowSse2(const MotionApplySource& source, uint32_t y, const uint32_t* columns, float* dst,
+                               uint32_t pixelCount)
+{
+    const __m128 tapScale = _mm_set1_ps(1.0f / static_cast<float>(MOTION_TAP_COUNT));
+
+    for (uint32_t i = 0; i < pixelCount; i++)
+    {
+        uint32_t x = columns[i];
+        const float* velocity = VelocityPixel(source, x, y);
+        float velocityX = velocity[0] * source.motionScale;
+        float velocityY = velocity[1] * source.motionScale;
+
+        __m128 color = _mm_setzero_ps();
+        for (uint32_t tapIndex = 0; tapIndex < MOTION_TAP_COUNT; tapIndex++)
+        {
+            BilinearTap tap =
+                ComputeMotionTap(source, x, y, velocityX, velocityY, static_cast<float>(tapIndex) * MOTION_TAP_STEP);
+            __m128 p00 = _mm_loadu_ps(ScenePixel(source, tap.x0, tap.y0));
+            __m128 p10 = _mm_loadu_ps(ScenePixel(source, tap.x1, tap.y0));
+            __m128 p01 = _mm_loadu_ps(ScenePixel(source, tap.x0, tap.y1));
+            __m128 p11 = _mm_loadu_ps(ScenePixel(source, tap.x1, tap.y1));
+
+            __m128 fx = _mm_set1_ps(tap.fx);
+            __m128 top = _mm_add_ps(p00, _mm_mul_ps(_mm_sub_ps(p10, p00), fx));
+            __m128 bottom = _mm_add_ps(p01, _mm_mul_ps(_mm_sub_ps(p11, p01), fx));
+            color = _mm_add_ps(color, _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), _mm_set1_ps(tap.fy))));
+        }
+
+        float* out = dst + i * 4;
+        _mm_storeu_ps(out, _mm_mul_ps(color, tapScale));
+        out[3] = 1.0f;
+    }
+}
+
+static void BlurColumnsSse2(const float* const* rows, const float* weights, uint32_t taps, float* dst,
+                            uint32_t floatCount)
+{
+    uint32_t i = 0;
+    for (; i + 8 <= floatCount; i += 8)
+    {
+        __m128 sum0 = _mm_setzero_ps();
+        __m128 sum1 = _mm_setzero_ps();
+        for (uint32_t t = 0; t < taps; t++)
+        {
+            __m128 weight = _mm_set1_ps(weights[t]);
+            sum0 = _mm_add_ps(sum0, _mm_mul_ps(weight, _mm_loadu_ps(rows[t] + i)));
+            sum1 = _mm_add_ps(sum1, _mm_mul_ps(weight, _mm_loadu_ps(rows[t] + i + 4)));
+        }
+        _mm_storeu_ps(dst + i, sum0);
+        _mm_storeu_ps(dst + i + 4, sum1);
+    }
+    for (; i < floatCount; i++)
+    {
+        float sum = 0.0f;
+        for (uint32_t t = 0; t < taps; t++)
+        {
+            sum += weights[t] * rows[t][i];
+        }
+        dst[i] = sum;
+    }
+}
+
+static void BlurRowSse2(const float* src, const float* weights, uint32_t taps, float* dst, uint32_t pixelCount)
+{
+    uint32_t x = 0;
+    for (; x + 2 <= pixelCount; x += 2)
+    {
+        __m128 sum0 = _mm_setzero_ps();
+        __m128 sum1 = _mm_setzero_ps();
+        for (uint32_t t = 0; t < taps; t++)
+        {
+            __m128 weight = _mm_set1_ps(weights[t]);
+            sum0 = _mm_add_ps(sum0, _mm_mul_ps(weight, _mm_loadu_ps(src + (x + t) * 4)));
+            sum1 = _mm_add_ps(sum1, _mm_mul_ps(weight, _mm_loadu_ps(src + (x + t + 1) * 4)));
+        }
+        _mm_storeu_ps(dst + x * 4, sum0);
+        _mm_storeu_ps(dst + x * 4 + 4, sum1);
+    }
+    for (; x < pixelCount; x++)
+    {
+        __m128 sum = _mm_setzero_ps();
+        for (uint32_t t = 0; t < taps; t++)
+        {
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[t]), _mm_loadu_ps(src + (x + t) * 4)));
+        }
+        _mm_storeu_ps(dst + x * 4, sum);
+    }
+}
+
+static void FinalApplyRowSse2(const float* motion, const float* blur, float* dst, uint32_t pixelCount)
+{
+    const __m128 motionWeight = _mm_set1_ps(1.0f - FINAL_BLUR_AMOUNT);
+    const __m128 blurWeight = _mm_set1_ps(FINAL_BLUR_AMOUNT);
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    for (uint32_t x = 0; x < pixelCount; x++)
+    {
+        __m128 color = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(motion + x * 4), motionWeight),
+                                  _mm_mul_ps(_mm_loadu_ps(blur + x * 4), blurWeight));
+        color = _mm_div_ps(color, _mm_add_ps(color, one));
+        _mm_storeu_ps(dst + x * 4, color);
+        ApplyGamma(dst + x * 4);
+    }
+}
+
+const PostProcessKernels* GetSse2Kernels()
+{
+    static const PostProcessKernels kernels = []
+    {
+        PostProcessKernels table = *GetScalarKernels();
+        table.level = SimdLevel::SSE2;
+        table.motionApplyRow = MotionApplyRowSse2;
+        table.blurColumns = BlurColumnsSse2;
+        table.blurRow = BlurRowSse2;
+        table.finalApplyRow = FinalApplyRowSse2;
+        return table;
+    }();
+    return &kernels;
+}
+
+#else
+
+const PostProcessKernels* GetSse2Kernels()
+{
+    return nullptr;
+}
+
+#endif
+
+}  // namespace detail
+}  // namespace cpu
+}  // namespace vkdemo
@@ -0,0 +1,145 @@
+#include "tile_profile.h"
+
+#include <cctype>
+#include <cstdio>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+namespace vkdemo
+{
+namespace cpu
+{
+
+bool TileProfile::Load(const std::string& path)
+{
+    entries.clear();
+
+    std::ifstream file(path);
+    if (!file.is_open())
+        return false;
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        Entry entry;
+        std::string resolution, tile;
+        std::istringstream stream(line);
+        if (!(stream >> entry.kernel >> entry.device >> resolution >> tile >> entry.nsPerPixel))
+            continue;
+        if (std::sscanf(resolution.c_str(), "%ux%u", &entry.width, &entry.height) != 2 ||
+            std::sscanf(tile.c_str(), "%ux%u", &entry.tile.width, &entry.tile.height) != 2)
+            continue;
+        if (entry.tile.width == 0 || entry.tile.height == 0)
+            continue;
+
+        entries.push_back(entry);
+    }
+    return true;
+}
+
+bool TileProfile::Save(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open())
+        return false;
+
+    file << "# Tuned tile sizes: <kernel> <device> <resolution> <tile> <ns/pixel>\n";
+    for (const Entry& entry : entries)
+    {
+        file << entry.kernel << ' ' << entry.device << ' ' << entry.width << 'x' << entry.height << ' '
+             << entry.tile.width << 'x' << entry.tile.height << ' ' << entry.nsPerPixel << '\n';
+    }
+    return static_cast<bool>(file);
+}
+
+bool TileProfile::Find(const std::string& kernel, const std::string& device, uint32_t width, uint32_t height,
+                       TileSize& tile) const
+{
+    const std::string deviceKey = SanitizeKey(device);
+    for (const Entry& entry : entries)
+    {
+        if (entry.kernel == kernel && entry.device == deviceKey && entry.width == width && entry.height == height)
+        {
+            tile = entry.tile;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TileProfile::FindNearest(const std::string& kernel, const std::string& device, uint32_t width, uint32_t height,
+                              TileSize& tile) const
+{
+    const std::string deviceKey = SanitizeKey(device);
+    const double pixelCount = static_cast<double>(width) * height;
+
+    const Entry* best = nullptr;
+    double bestDistance = std::numeric_limits<double>::max();
+    for (const Entry& entry : entries)
+    {
+        if (entry.kernel != kernel || entry.device != deviceKey)
+            continue;
+
+        double distance = std::abs(static_cast<double>(entry.width) * entry.height - pixelCount);
+        if (entry.width == width && entry.height == height)
+        {
+            distance = -1.0;
+        }
+
+        if (distance < bestDistance)
+        {
+            best = &entry;
+            bestDistance = distance;
+        }
+    }
+
+    if (!best)
+        return false;
+
+    tile = best->tile;
+    return true;
+}
+
+void TileProfile::Store(const std::string& kernel, const std::string& device, uint32_t width, uint32_t height,
+                        TileSize tile, double nsPerPixel)
+{
+    Entry entry;
+    entry.kernel = kernel;
+    entry.device = SanitizeKey(device);
+    entry.width = width;
+    entry.height = height;
+    entry.tile = tile;
+    entry.nsPerPixel = nsPerPixel;
+
+    for (Entry& existing : entries)
+    {
+        if (existing.kernel == entry.kernel && existing.device == entry.device && existing.width == width &&
+            existing.height == height)
+        {
+            existing = entry;
+            return;
+        }
+    }
+    entries.push_back(entry);
+}
+
+std::string TileProfile::SanitizeKey(const std::string& key)
+{
+    std::string sanitized = key.empty() ? "unknown" : key;
+    for (char& c : sanitized)
+    {
+        if (std::isspace(static_cast<unsigned char>(c)))
+        {
+            c = '_';
+        }
+    }
+    return sanitized;
+}
+
+}  // namespace cpu
+}  // namespace vkdemo
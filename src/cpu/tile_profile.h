@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vkdemo
+{
+namespace cpu
+{
+
+//=============================================================================
+// Tile Profile
+//=============================================================================
+
+struct TileSize
+{
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+// Tuned tile and workgroup sizes persisted between runs, one entry per (kernel, device, resolution).
+// The file is plain text, one entry per line:
+//
+//   <kernel> <device> <width>x<height> <tileWidth>x<tileHeight> <nsPerPixel>
+//
+// Device keys are sanitized to contain no whitespace.
+class TileProfile
+{
+public:
+    static constexpr const char* DEFAULT_PATH = "tile_profile.txt";
+
+    struct Entry
+    {
+        std::string kernel;
+        std::string device;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        TileSize tile;
+        double nsPerPixel = 0.0;
+    };
+
+    // Missing or unreadable files leave the profile empty; malformed lines are skipped
+    bool Load(const std::string& path);
+    bool Save(const std::string& path) const;
+
+    bool Find(const std::string& kernel, const std::string& device, uint32_t width, uint32_t height,
+              TileSize& tile) const;
+    // Exact resolution match if present, otherwise the entry closest in pixel count for the same kernel and device
+    bool FindNearest(const std::string& kernel, const std::string& device, uint32_t width, uint32_t height,
+                     TileSize& tile) const;
+    void Store(const std::string& kernel, const std::string& device, uint32_t width, uint32_t height, TileSize tile,
+               double nsPerPixel);
+
+    static std::string SanitizeKey(const std::string& key);
+
+private:
+    std::vector<Entry> entries;
+};
+
+}  // namespace cpu
+}  // namespace vkdemo
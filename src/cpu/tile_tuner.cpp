@@ -0,0 +1,240 @@
+#include "tile_tuner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+
+namespace vkdemo
+{
+namespace cpu
+{
+
+static constexpr const char* CPU_KERNEL_NAME = "cpu_post_process";
+
+TileTuneResult TuneTileSize(const std::vector<TileSize>& candidates, double pixelCount,
+                            const std::function<double(TileSize)>& measure)
+{
+    TileTuneResult best;
+    best.nsPerPixel = std::numeric_limits<double>::max();
+    for (const TileSize& candidate : candidates)
+    {
+        double nsPerPixel = measure(candidate) * 1e9 / pixelCount;
+        if (nsPerPixel < best.nsPerPixel)
+        {
+            best.tile = candidate;
+            best.nsPerPixel = nsPerPixel;
+        }
+    }
+    return best;
+}
+
+std::vector<TileSize> GetCpuTileCandidates(const CpuCacheInfo& cache, uint32_t blurRadius)
+{
+    struct Candidate
+    {
+        TileSize tile;
+        size_t workingSet;
+    };
+
+    std::vector<Candidate> fitting;
+    for (uint32_t height = 16; height <= 256; height *= 2)
+    {
+        // Square and 2:1 wide tiles; wider tiles favour the row-contiguous kernels
+        for (uint32_t width : {height, height * 2})
+        {
+            size_t haloWidth = width + 2 * blurRadius;
+            size_t haloHeight = height + 2 * blurRadius;
+            size_t workingSet = (haloWidth * haloHeight + haloWidth * height) * 4 * sizeof(float);
+            if (workingSet <= cache.l2Size)
+            {
+                fitting.push_back({{width, height}, workingSet});
+            }
+        }
+    }
+
+    std::sort(fitting.begin(), fitting.end(),
+              [](const Candidate& a, const Candidate& b) { return a.workingSet < b.workingSet; });
+
+    std::vector<TileSize> candidates;
+    for (const Candidate& candidate : fitting)
+    {
+        candidates.push_back(candidate.tile);
+    }
+    if (candidates.empty())
+    {
+        candidates.push_back({16, 16});
+    }
+    return candidates;
+}
+
+void FillSyntheticFrame(Image& sceneColor, Image& velocity)
+{
+    uint32_t state = 0x12345678u;
+    auto next = [&state]
+    {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<float>(state >> 8) / 16777216.0f;
+    };
+
+    for (uint32_t y = 0; y < sceneColor.height; y++)
+    {
+        for (uint32_t x = 0; x < sceneColor.width; x++)
+        {
+            float color[4] = {next() * 4.0f, next() * 4.0f, next() * 4.0f, 1.0f};
+            float motion[2] = {0.02f * (static_cast<float>(x) / sceneColor.width - 0.5f),
+                               0.02f * (static_cast<float>(y) / sceneColor.height - 0.5f)};
+
+            size_t pixel = static_cast<size_t>(y) * sceneColor.width + x;
+            if (IsHalfFormat(sceneColor.format))
+            {
+                uint16_t* dst = reinterpret_cast<uint16_t*>(sceneColor.data.data()) + pixel * 4;
+                std::transform(color, color + 4, dst, FloatToHalf);
+            }
+            else
+            {
+                std::copy(color, color + 4, reinterpret_cast<float*>(sceneColor.data.data()) + pixel * 4);
+            }
+
+            if (IsHalfFormat(velocity.format))
+            {
+                uint16_t* dst = reinterpret_cast<uint16_t*>(velocity.data.data()) + pixel * 2;
+                std::transform(motion, motion + 2, dst, FloatToHalf);
+            }
+            else
+            {
+                std::copy(motion, motion + 2, reinterpret_cast<float*>(velocity.data.data()) + pixel * 2);
+            }
+        }
+    }
+}
+
+// One warm-up run, then the best of two: short enough for a first-run sweep
+static double MeasureRunSeconds(CpuPostProcessor& processor, JobSystem* jobs, const Image& sceneColor,
+                                const Image& velocity, const CpuPostProcessParams& params, Image& output)
+{
+    double best = std::numeric_limits<double>::max();
+    for (int run = 0; run < 3; run++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        if (jobs)
+        {
+            processor.Run(*jobs, sceneColor, velocity, params, output);
+        }
+        else
+        {
+            processor.Run(sceneColor, velocity, params, output);
+        }
+        auto end = std::chrono::steady_clock::now();
+        if (run > 0)
+        {
+            best = std::min(best, std::chrono::duration<double>(end - start).count());
+        }
+    }
+    return best;
+}
+
+TileTuneResult TuneCpuTileSize(CpuPostProcessor& processor, JobSystem* jobs, uint32_t width, uint32_t height,
+                               const CpuCacheInfo& cache)
+{
+    Image sceneColor = Image::Create(width, height, PixelFormat::RGBA16F);
+    Image velocity = Image::Create(width, height, PixelFormat::RG16F);
+    Image output = Image::Create(width, height, PixelFormat::RGBA16F);
+    FillSyntheticFrame(sceneColor, velocity);
+
+    CpuPostProcessParams params;
+    params.blurMode = BlurMode::Fir;
+    const uint32_t radius = static_cast<uint32_t>(BuildBlurKernel(params).radius);
+    const TileSize previous = {processor.GetTileWidth(), processor.GetTileHeight()};
+
+    auto measure = [&](TileSize tile)
+    {
+        processor.SetTileSize(tile.width, tile.height);
+        return MeasureRunSeconds(processor, jobs, sceneColor, velocity, params, output);
+    };
+
+    TileTuneResult result =
+        TuneTileSize(GetCpuTileCandidates(cache, radius), static_cast<double>(width) * height, measure);
+    processor.SetTileSize(previous.width, previous.height);
+    return result;
+}
+
+IirCrossoverResult TuneIirCrossoverRadius(CpuPostProcessor& processor, JobSystem* jobs, uint32_t width,
+                                          uint32_t height)
+{
+    static const float RADII[] = {2.0f, 4.0f, 6.0f, 8.0f, 12.0f, 16.0f, 24.0f, 32.0f, 48.0f, 64.0f};
+
+    Image sceneColor = Image::Create(width, height, PixelFormat::RGBA16F);
+    Image velocity = Image::Create(width, height, PixelFormat::RG16F);
+    Image output = Image::Create(width, height, PixelFormat::RGBA16F);
+    FillSyntheticFrame(sceneColor, velocity);
+
+    const double pixelCount = static_cast<double>(width) * height;
+    IirCrossoverResult result;
+    for (float radius : RADII)
+    {
+        // Stretch the shader's taps to the radius, as the GPU path does with blurStrength
+        CpuPostProcessParams params;
+        params.blurStrength = radius / static_cast<float>(params.kernelRadius);
+
+        IirCrossoverSample sample;
+        sample.radius = radius;
+        params.blurMode = BlurMode::Fir;
+        sample.firNsPerPixel = MeasureRunSeconds(processor, jobs, sceneColor, velocity, params, output) * 1e9 /
+                               pixelCount;
+        params.blurMode = BlurMode::Iir;
+        sample.iirNsPerPixel = MeasureRunSeconds(processor, jobs, sceneColor, velocity, params, output) * 1e9 /
+                               pixelCount;
+        result.samples.push_back(sample);
+    }
+
+    // Smallest radius from which the IIR chain stays ahead, so timing noise near the crossover cannot
+    // make Auto flip back and forth
+    result.radius = std::numeric_limits<float>::infinity();
+    for (size_t i = result.samples.size(); i-- > 0;)
+    {
+        if (result.samples[i].iirNsPerPixel >= result.samples[i].firNsPerPixel)
+            break;
+        result.radius = result.samples[i].radius;
+    }
+    return result;
+}
+
+std::string GetCpuProfileKey(const CpuPostProcessor& processor, const JobSystem* jobs)
+{
+    const std::string& brand = GetCpuFeatures().brand;
+    uint32_t workers = jobs ? jobs->GetWorkerCount() : 1;
+    return (brand.empty() ? "unknown-cpu" : brand) + "/" + GetSimdLevelName(processor.GetSimdLevel()) + "/" +
+           std::to_string(workers) + "t";
+}
+
+TileSize LoadOrTuneCpuTileSize(const std::string& profilePath, CpuPostProcessor& processor, JobSystem* jobs,
+                               uint32_t width, uint32_t height)
+{
+    const std::string device = GetCpuProfileKey(processor, jobs);
+
+    TileProfile profile;
+    profile.Load(profilePath);
+
+    TileSize tile;
+    if (!profile.Find(CPU_KERNEL_NAME, device, width, height, tile))
+    {
+        CpuCacheInfo cache = QueryCpuCacheInfo();
+        std::cout << "Tuning CPU post-process tile size for " << width << "x" << height << " (L1D "
+                  << cache.l1DataSize / 1024 << " KiB, L2 " << cache.l2Size / 1024 << " KiB)..." << std::endl;
+
+        TileTuneResult result = TuneCpuTileSize(processor, jobs, width, height, cache);
+        tile = result.tile;
+        profile.Store(CPU_KERNEL_NAME, device, width, height, tile, result.nsPerPixel);
+        if (!profile.Save(profilePath))
+        {
+            std::cerr << "Failed to save tile profile to " << profilePath << std::endl;
+        }
+    }
+
+    processor.SetTileSize(tile.width, tile.height);
+    return tile;
+}
+
+}  // namespace cpu
+}  // namespace vkdemo
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "cache_info.h"
+#include "cpu_post_process.h"
+#include "tile_profile.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace vkdemo
+{
+namespace cpu
+{
+
+//=============================================================================
+// Tile Size Tuner
+//=============================================================================
+
+struct TileTuneResult
+{
+    TileSize tile;
+    double nsPerPixel = 0.0;
+};
+
+// Times every candidate with measure (seconds per run) and returns the fastest; shared by the CPU
+// sweep below and GPU workgroup sweeps that time with timestamp queries
+TileTuneResult TuneTileSize(const std::vector<TileSize>& candidates, double pixelCount,
+                            const std::function<double(TileSize)>& measure);
+
+// Power-of-two tiles whose fused working set (motion halo plus vertical blur rows, FP32 RGBA) fits in L2,
+// smallest working set first
+std::vector<TileSize> GetCpuTileCandidates(const CpuCacheInfo& cache, uint32_t blurRadius);
+
+// Deterministic noise scene color and a smooth radial velocity field, used for timing runs
+void FillSyntheticFrame(Image& sceneColor, Image& velocity);
+
+// Sweeps the candidates with short timed runs of the fused chain on synthetic input at the given resolution
+TileTuneResult TuneCpuTileSize(CpuPostProcessor& processor, JobSystem* jobs, uint32_t width, uint32_t height,
+                               const CpuCacheInfo& cache);
+
+struct IirCrossoverSample
+{
+    float radius = 0.0f;
+    double firNsPerPixel = 0.0;
+    double iirNsPerPixel = 0.0;
+};
+
+struct IirCrossoverResult
+{
+    // Smallest swept radius from which the IIR chain is faster (infinity if it never is)
+    float radius = 0.0f;
+    std::vector<IirCrossoverSample> samples;
+};
+
+// Times the FIR and IIR chains over a sweep of blur radii (kernelRadius * blurStrength texels) on synthetic
+// input; the result feeds CpuPostProcessor::SetIirCrossoverRadius
+IirCrossoverResult TuneIirCrossoverRadius(CpuPostProcessor& processor, JobSystem* jobs, uint32_t width,
+                                          uint32_t height);
+
+// Profile key of this CPU: brand, SIMD tier and worker count (the best tile shifts with threading)
+std::string GetCpuProfileKey(const CpuPostProcessor& processor, const JobSystem* jobs);
+
+// Applies the profiled tile size for this CPU and resolution, tuning and saving it on first use
+TileSize LoadOrTuneCpuTileSize(const std::string& profilePath, CpuPostProcessor& processor, JobSystem* jobs,
+                               uint32_t width, uint32_t height);
+
+}  // namespace cpu
+}  // namespace vkdemo
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "cpu_features.h"
+#include "transform_store.h"
+
+namespace vkdemo
+{
+namespace cpu
+{
+
+//=============================================================================
+// Instance Transform Kernels
+//=============================================================================
+
+// Instances per SIMD batch of the widest tier; TransformStore pads its arrays to a multiple of it
+constexpr uint32_t TRANSFORM_BATCH = 8;
+
+struct TransformKernels
+{
+    SimdLevel level = SimdLevel::Scalar;
+
+    // Instances [begin, end) of store into out[begin, end); begin is a multiple of TRANSFORM_BATCH.
+    // Full batches are written with streaming stores where the tier has them.
+    void (*updateInstances)(const TransformStore& store, const TransformUpdateParams& params, uint32_t begin,
+                            uint32_t end, InstanceMvp* out) = nullptr;
+};
+
+// Returns the table for the requested level, or the best compiled-in level below it
+const TransformKernels& GetTransformKernels(SimdLevel level);
+
+namespace detail
+{
+
+// Per-tier tables (nullptr when the tier is not compiled for this architecture)
+const TransformKernels* GetScalarTransformKernels();
+const TransformKernels* GetSse2TransformKernels();
+const TransformKernels* GetAvx2TransformKernels();
+
+}  // namespace detail
+
+}  // namespace cpu
+}  // namespace vkdemo
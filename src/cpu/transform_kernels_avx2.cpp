@@ -0,0 +1,178 @@
+#include "transform_kernels_common.h"
+
+#if VKDEMO_CPU_X86
+    #include <immintrin.h>
+#endif
+
+// Every kernel here is compiled for AVX2/FMA/F16C through VKDEMO_TARGET_AVX2 and must only be reached
+// after DetectSimdLevel() has confirmed support.
+
+namespace vkdemo
+{
+namespace cpu
+{
+namespace detail
+{
+
+#if VKDEMO_CPU_X86
+
+// Eight instances per batch, one per lane. FMA contraction makes the results differ from the scalar
+// tier in the last bits.
+
+VKDEMO_TARGET_AVX2 static inline __m256 SinAvx2(__m256 x)
+{
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+
+    __m256 turns = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(TRANSFORM_INV_TWO_PI)),
+                                   _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256 t = _mm256_fnmadd_ps(turns, _mm256_set1_ps(TRANSFORM_TWO_PI), x);
+
+    // Beyond +-pi/2, reflect: t = copysign(pi, t) - t
+    __m256 reflected = _mm256_sub_ps(_mm256_or_ps(_mm256_set1_ps(TRANSFORM_PI), _mm256_and_ps(t, signMask)), t);
+    __m256 outside =
+        _mm256_cmp_ps(_mm256_andnot_ps(signMask, t), _mm256_set1_ps(TRANSFORM_HALF_PI), _CMP_GT_OQ);
+    t = _mm256_blendv_ps(t, reflected, outside);
+
+    __m256 t2 = _mm256_mul_ps(t, t);
+    __m256 poly = _mm256_fmadd_ps(t2, _mm256_set1_ps(SIN_C9), _mm256_set1_ps(SIN_C7));
+    poly = _mm256_fmadd_ps(t2, poly, _mm256_set1_ps(SIN_C5));
+    poly = _mm256_fmadd_ps(t2, poly, _mm256_set1_ps(SIN_C3));
+    poly = _mm256_fmadd_ps(t2, poly, _mm256_set1_ps(1.0f));
+    return _mm256_mul_ps(t, poly);
+}
+
+VKDEMO_TARGET_AVX2 static inline void ComputeMvpAvx2(const float* viewProjection, const __m256 position[3],
+                                                     const __m256 axis[3], __m256 angle, __m256 scale,
+                                                     __m256 mvp[16])
+{
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 two = _mm256_set1_ps(2.0f);
+
+    __m256 halfAngle = _mm256_mul_ps(angle, _mm256_set1_ps(0.5f));
+    __m256 s = SinAvx2(halfAngle);
+    __m256 w = SinAvx2(_mm256_add_ps(halfAngle, _mm256_set1_ps(TRANSFORM_HALF_PI)));
+    __m256 x = _mm256_mul_ps(axis[0], s);
+    __m256 y = _mm256_mul_ps(axis[1], s);
+    __m256 z = _mm256_mul_ps(axis[2], s);
+
+    __m256 xx = _mm256_mul_ps(x, x), yy = _mm256_mul_ps(y, y), zz = _mm256_mul_ps(z, z);
+    __m256 xy = _mm256_mul_ps(x, y), xz = _mm256_mul_ps(x, z), yz = _mm256_mul_ps(y, z);
+    __m256 wx = _mm256_mul_ps(w, x), wy = _mm256_mul_ps(w, y), wz = _mm256_mul_ps(w, z);
+
+    __m256 rotation[3][3] = {
+        {_mm256_fnmadd_ps(two, _mm256_add_ps(yy, zz), one), _mm256_mul_ps(two, _mm256_add_ps(xy, wz)),
+         _mm256_mul_ps(two, _mm256_sub_ps(xz, wy))},
+        {_mm256_mul_ps(two, _mm256_sub_ps(xy, wz)), _mm256_fnmadd_ps(two, _mm256_add_ps(xx, zz), one),
+         _mm256_mul_ps(two, _mm256_add_ps(yz, wx))},
+        {_mm256_mul_ps(two, _mm256_add_ps(xz, wy)), _mm256_mul_ps(two, _mm256_sub_ps(yz, wx)),
+         _mm256_fnmadd_ps(two, _mm256_add_ps(xx, yy), one)}};
+
+    for (int column = 0; column < 3; column++)
+    {
+        for (int row = 0; row < 4; row++)
+        {
+            __m256 sum = _mm256_mul_ps(_mm256_set1_ps(viewProjection[row]), rotation[column][0]);
+            sum = _mm256_fmadd_ps(_mm256_set1_ps(viewProjection[4 + row]), rotation[column][1], sum);
+            sum = _mm256_fmadd_ps(_mm256_set1_ps(viewProjection[8 + row]), rotation[column][2], sum);
+            mvp[column * 4 + row] = _mm256_mul_ps(scale, sum);
+        }
+    }
+    for (int row = 0; row < 4; row++)
+    {
+        __m256 sum = _mm256_fmadd_ps(_mm256_set1_ps(viewProjection[row]), position[0],
+                                     _mm256_set1_ps(viewProjection[12 + row]));
+        sum = _mm256_fmadd_ps(_mm256_set1_ps(viewProjection[4 + row]), position[1], sum);
+        mvp[12 + row] = _mm256_fmadd_ps(_mm256_set1_ps(viewProjection[8 + row]), position[2], sum);
+    }
+}
+
+// Transposes four lane-per-instance registers into one float4 per instance and streams each to
+// floatOffset within its InstanceMvp; the low 128-bit halves hold instances 0-3, the high halves 4-7
+VKDEMO_TARGET_AVX2 static inline void StreamTransposedAvx2(__m256 r0, __m256 r1, __m256 r2, __m256 r3,
+                                                           InstanceMvp* out, uint32_t floatOffset)
+{
+    __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+    __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+    __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+    const __m256 columns[4] = {_mm256_shuffle_ps(t0, t2, 0x44), _mm256_shuffle_ps(t0, t2, 0xEE),
+                               _mm256_shuffle_ps(t1, t3, 0x44), _mm256_shuffle_ps(t1, t3, 0xEE)};
+
+    for (uint32_t k = 0; k < 4; k++)
+    {
+        _mm_stream_ps(reinterpret_cast<float*>(&out[k]) + floatOffset, _mm256_castps256_ps128(columns[k]));
+        _mm_stream_ps(reinterpret_cast<float*>(&out[k + 4]) + floatOffset, _mm256_extractf128_ps(columns[k], 1));
+    }
+}
+
+VKDEMO_TARGET_AVX2 static void UpdateInstancesAvx2(const TransformStore& store, const TransformUpdateParams& params,
+                                                   uint32_t begin, uint32_t end, InstanceMvp* out)
+{
+    const __m256 time = _mm256_set1_ps(params.time);
+    const __m256 previousTime = _mm256_set1_ps(params.previousTime);
+    const __m256 meshRadius = _mm256_set1_ps(params.meshRadius);
+
+    uint32_t i = begin;
+    for (; i + 8 <= end; i += 8)
+    {
+        const __m256 position[3] = {_mm256_load_ps(store.GetComponent(TransformStore::PositionX) + i),
+                                    _mm256_load_ps(store.GetComponent(TransformStore::PositionY) + i),
+                                    _mm256_load_ps(store.GetComponent(TransformStore::PositionZ) + i)};
+        const __m256 axis[3] = {_mm256_load_ps(store.GetComponent(TransformStore::AxisX) + i),
+                                _mm256_load_ps(store.GetComponent(TransformStore::AxisY) + i),
+                                _mm256_load_ps(store.GetComponent(TransformStore::AxisZ) + i)};
+        __m256 phase = _mm256_load_ps(store.GetComponent(TransformStore::Phase) + i);
+        __m256 rate = _mm256_load_ps(store.GetComponent(TransformStore::Rate) + i);
+        __m256 scale = _mm256_load_ps(store.GetComponent(TransformStore::Scale) + i);
+
+        __m256 mvp[16];
+        ComputeMvpAvx2(params.viewProjection, position, axis, _mm256_fmadd_ps(rate, time, phase), scale, mvp);
+        for (uint32_t column = 0; column < 4; column++)
+        {
+            StreamTransposedAvx2(mvp[column * 4], mvp[column * 4 + 1], mvp[column * 4 + 2], mvp[column * 4 + 3],
+                                 out + i, column * 4);
+        }
+
+        ComputeMvpAvx2(params.previousViewProjection, position, axis, _mm256_fmadd_ps(rate, previousTime, phase),
+                       scale, mvp);
+        for (uint32_t column = 0; column < 4; column++)
+        {
+            StreamTransposedAvx2(mvp[column * 4], mvp[column * 4 + 1], mvp[column * 4 + 2], mvp[column * 4 + 3],
+                                 out + i, 16 + column * 4);
+        }
+
+        StreamTransposedAvx2(position[0], position[1], position[2], _mm256_mul_ps(meshRadius, scale), out + i, 32);
+    }
+    for (; i < end; i++)
+    {
+        UpdateInstanceScalar(store, params, i, out[i]);
+    }
+
+    // Streaming stores are weakly ordered; fence them before the frame is submitted
+    _mm_sfence();
+}
+
+const TransformKernels* GetAvx2TransformKernels()
+{
+    static const TransformKernels kernels = []
+    {
+        TransformKernels table;
+        table.level = SimdLevel::AVX2;
+        table.updateInstances = UpdateInstancesAvx2;
+        return table;
+    }();
+    return &kernels;
+}
+
+#else
+
+const TransformKernels* GetAvx2TransformKernels()
+{
+    return nullptr;
+}
+
+#endif
+
+}  // namespace detail
+}  // namespace cpu
+}  // namespace vkdemo
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "transform_kernels.h"
+
+#include <cmath>
+
+// Scalar building blocks shared by every transform kernel tier (internal to src/cpu)
+
+namespace vkdemo
+{
+namespace cpu
+{
+namespace detail
+{
+
+constexpr float TRANSFORM_PI = 3.14159265f;
+constexpr float TRANSFORM_HALF_PI = 1.57079633f;
+constexpr float TRANSFORM_TWO_PI = 6.28318531f;
+constexpr float TRANSFORM_INV_TWO_PI = 0.159154943f;
+
+// Minimax odd polynomial for sin on [-pi/2, pi/2] (max error about 1e-7)
+constexpr float SIN_C3 = -0.166666672f;
+constexpr float SIN_C5 = 8.33332818e-3f;
+constexpr float SIN_C7 = -1.98408743e-4f;
+constexpr float SIN_C9 = 2.75255616e-6f;
+
+// sin(x): x is wrapped to [-pi, pi], reflected into [-pi/2, pi/2] and fed to the polynomial. The SIMD
+// tiers evaluate the same sequence; round to nearest matches their conversions.
+inline float SinApprox(float x)
+{
+    float t = x - std::nearbyint(x * TRANSFORM_INV_TWO_PI) * TRANSFORM_TWO_PI;
+    if (t > TRANSFORM_HALF_PI)
+        t = TRANSFORM_PI - t;
+    else if (t < -TRANSFORM_HALF_PI)
+        t = -TRANSFORM_PI - t;
+
+    float t2 = t * t;
+    return t * (1.0f + t2 * (SIN_C3 + t2 * (SIN_C5 + t2 * (SIN_C7 + t2 * SIN_C9))));
+}
+
+inline float CosApprox(float x)
+{
+    return SinApprox(x + TRANSFORM_HALF_PI);
+}
+
+// viewProjection * translate(position) * rotate(angle, axis) * scale, column-major. axis is unit length.
+inline void ComputeInstanceMvp(const float* viewProjection, const float position[3], const float axis[3],
+                               float angle, float scale, float* mvp)
+{
+    float s = SinApprox(angle * 0.5f);
+    float w = CosApprox(angle * 0.5f);
+    float x = axis[0] * s;
+    float y = axis[1] * s;
+    float z = axis[2] * s;
+
+    // Rotation columns from the quaternion (x, y, z, w), scaled
+    float rotation[3][3] = {
+        {1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y + w * z), 2.0f * (x * z - w * y)},
+        {2.0f * (x * y - w * z), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z + w * x)},
+        {2.0f * (x * z + w * y), 2.0f * (y * z - w * x), 1.0f - 2.0f * (x * x + y * y)}};
+
+    for (int column = 0; column < 3; column++)
+    {
+        for (int row = 0; row < 4; row++)
+        {
+            mvp[column * 4 + row] =
+                scale * (viewProjection[row] * rotation[column][0] + viewProjection[4 + row] * rotation[column][1] +
+                         viewProjection[8 + row] * rotation[column][2]);
+        }
+    }
+    for (int row = 0; row < 4; row++)
+    {
+        mvp[12 + row] = viewProjection[row] * position[0] + viewProjection[4 + row] * position[1] +
+                        viewProjection[8 + row] * position[2] + viewProjection[12 + row];
+    }
+}
+
+// Scalar path for one instance; used by the scalar tier and for partial batches
+inline void UpdateInstanceScalar(const TransformStore& store, const TransformUpdateParams& params, uint32_t index,
+                                 InstanceMvp& out)
+{
+    const float position[3] = {store.GetComponent(TransformStore::PositionX)[index],
+                               store.GetComponent(TransformStore::PositionY)[index],
+                               store.GetComponent(TransformStore::PositionZ)[index]};
+    const float axis[3] = {store.GetComponent(TransformStore::AxisX)[index],
+                           store.GetComponent(TransformStore::AxisY)[index],
+                           store.GetComponent(TransformStore::AxisZ)[index]};
+    float phase = store.GetComponent(TransformStore::Phase)[index];
+    float rate = store.GetComponent(TransformStore::Rate)[index];
+    float scale = store.GetComponent(TransformStore::Scale)[index];
+
+    ComputeInstanceMvp(params.viewProjection, position, axis, phase + rate * params.time, scale, out.currMvp);
+    ComputeInstanceMvp(params.previousViewProjection, position, axis, phase + rate * params.previousTime, scale,
+                       out.prevMvp);
+
+    out.boundingSphere[0] = position[0];
+    out.boundingSphere[1] = position[1];
+    out.boundingSphere[2] = position[2];
+    out.boundingSphere[3] = params.meshRadius * scale;
+}
+
+}  // namespace detail
+}  // namespace cpu
+}  // namespace vkdemo
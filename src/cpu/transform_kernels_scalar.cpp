@@ -0,0 +1,43 @@
+#include "transform_kernels_common.h"
+
+namespace vkdemo
+{
+namespace cpu
+{
+namespace detail
+{
+
+static void UpdateInstancesScalar(const TransformStore& store, const TransformUpdateParams& params, uint32_t begin,
+                                  uint32_t end, InstanceMvp* out)
+{
+    for (uint32_t i = begin; i < end; i++)
+    {
+        UpdateInstanceScalar(store, params, i, out[i]);
+    }
+}
+
+const TransformKernels* GetScalarTransformKernels()
+{
+    static const TransformKernels kernels = []
+    {
+        TransformKernels table;
+        table.level = SimdLevel::Scalar;
+        table.updateInstances = UpdateInstancesScalar;
+        return table;
+    }();
+    return &kernels;
+}
+
+}  // namespace detail
+
+const TransformKernels& GetTransformKernels(SimdLevel level)
+{
+    if (level >= SimdLevel::AVX2 && detail::GetAvx2TransformKernels())
+        return *detail::GetAvx2TransformKernels();
+    if (level >= SimdLevel::SSE2 && detail::GetSse2TransformKernels())
+        return *detail::GetSse2TransformKernels();
+    return *detail::GetScalarTransformKernels();
+}
+
+}  // namespace cpu
+}  // namespace vkdemo
@@ -0,0 +1,164 @@
+#include "transform_kernels_common.h"
+
+#if VKDEMO_CPU_X86
+    #include <emmintrin.h>
+#endif
+
+namespace vkdemo
+{
+namespace cpu
+{
+namespace detail
+{
+
+#if VKDEMO_CPU_X86
+
+// Four instances per batch, one per lane; the kernel mirrors ComputeInstanceMvp operation for operation
+
+static inline __m128 SinSse2(__m128 x)
+{
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+
+    __m128 turns = _mm_cvtepi32_ps(_mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(TRANSFORM_INV_TWO_PI))));
+    __m128 t = _mm_sub_ps(x, _mm_mul_ps(turns, _mm_set1_ps(TRANSFORM_TWO_PI)));
+
+    // Beyond +-pi/2, reflect: t = copysign(pi, t) - t
+    __m128 reflected = _mm_sub_ps(_mm_or_ps(_mm_set1_ps(TRANSFORM_PI), _mm_and_ps(t, signMask)), t);
+    __m128 outside = _mm_cmpgt_ps(_mm_andnot_ps(signMask, t), _mm_set1_ps(TRANSFORM_HALF_PI));
+    t = _mm_or_ps(_mm_and_ps(outside, reflected), _mm_andnot_ps(outside, t));
+
+    __m128 t2 = _mm_mul_ps(t, t);
+    __m128 poly = _mm_add_ps(_mm_set1_ps(SIN_C7), _mm_mul_ps(t2, _mm_set1_ps(SIN_C9)));
+    poly = _mm_add_ps(_mm_set1_ps(SIN_C5), _mm_mul_ps(t2, poly));
+    poly = _mm_add_ps(_mm_set1_ps(SIN_C3), _mm_mul_ps(t2, poly));
+    poly = _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(t2, poly));
+    return _mm_mul_ps(t, poly);
+}
+
+static inline void ComputeMvpSse2(const float* viewProjection, const __m128 position[3], const __m128 axis[3],
+                                  __m128 angle, __m128 scale, __m128 mvp[16])
+{
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+
+    __m128 halfAngle = _mm_mul_ps(angle, _mm_set1_ps(0.5f));
+    __m128 s = SinSse2(halfAngle);
+    __m128 w = SinSse2(_mm_add_ps(halfAngle, _mm_set1_ps(TRANSFORM_HALF_PI)));
+    __m128 x = _mm_mul_ps(axis[0], s);
+    __m128 y = _mm_mul_ps(axis[1], s);
+    __m128 z = _mm_mul_ps(axis[2], s);
+
+    __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+    __m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+    __m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y), wz = _mm_mul_ps(w, z);
+
+    __m128 rotation[3][3] = {
+        {_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), _mm_mul_ps(two, _mm_add_ps(xy, wz)),
+         _mm_mul_ps(two, _mm_sub_ps(xz, wy))},
+        {_mm_mul_ps(two, _mm_sub_ps(xy, wz)), _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))),
+         _mm_mul_ps(two, _mm_add_ps(yz, wx))},
+        {_mm_mul_ps(two, _mm_add_ps(xz, wy)), _mm_mul_ps(two, _mm_sub_ps(yz, wx)),
+         _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy)))}};
+
+    for (int column = 0; column < 3; column++)
+    {
+        for (int row = 0; row < 4; row++)
+        {
+            __m128 sum = _mm_mul_ps(_mm_set1_ps(viewProjection[row]), rotation[column][0]);
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(viewProjection[4 + row]), rotation[column][1]));
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(viewProjection[8 + row]), rotation[column][2]));
+            mvp[column * 4 + row] = _mm_mul_ps(scale, sum);
+        }
+    }
+    for (int row = 0; row < 4; row++)
+    {
+        __m128 sum = _mm_mul_ps(_mm_set1_ps(viewProjection[row]), position[0]);
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(viewProjection[4 + row]), position[1]));
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(viewProjection[8 + row]), position[2]));
+        mvp[12 + row] = _mm_add_ps(sum, _mm_set1_ps(viewProjection[12 + row]));
+    }
+}
+
+// Transposes four lane-per-instance registers into one float4 per instance and streams each to
+// floatOffset within its InstanceMvp
+static inline void StreamTransposedSse2(__m128 r0, __m128 r1, __m128 r2, __m128 r3, InstanceMvp* out,
+                                        uint32_t floatOffset)
+{
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_stream_ps(reinterpret_cast<float*>(&out[0]) + floatOffset, r0);
+    _mm_stream_ps(reinterpret_cast<float*>(&out[1]) + floatOffset, r1);
+    _mm_stream_ps(reinterpret_cast<float*>(&out[2]) + floatOffset, r2);
+    _mm_stream_ps(reinterpret_cast<float*>(&out[3]) + floatOffset, r3);
+}
+
+static void UpdateInstancesSse2(const TransformStore& store, const TransformUpdateParams& params, uint32_t begin,
+                                uint32_t end, InstanceMvp* out)
+{
+    const __m128 time = _mm_set1_ps(params.time);
+    const __m128 previousTime = _mm_set1_ps(params.previousTime);
+    const __m128 meshRadius = _mm_set1_ps(params.meshRadius);
+
+    uint32_t i = begin;
+    for (; i + 4 <= end; i += 4)
+    {
+        const __m128 position[3] = {_mm_load_ps(store.GetComponent(TransformStore::PositionX) + i),
+                                    _mm_load_ps(store.GetComponent(TransformStore::PositionY) + i),
+                                    _mm_load_ps(store.GetComponent(TransformStore::PositionZ) + i)};
+        const __m128 axis[3] = {_mm_load_ps(store.GetComponent(TransformStore::AxisX) + i),
+                                _mm_load_ps(store.GetComponent(TransformStore::AxisY) + i),
+                                _mm_load_ps(store.GetComponent(TransformStore::AxisZ) + i)};
+        __m128 phase = _mm_load_ps(store.GetComponent(TransformStore::Phase) + i);
+        __m128 rate = _mm_load_ps(store.GetComponent(TransformStore::Rate) + i);
+        __m128 scale = _mm_load_ps(store.GetComponent(TransformStore::Scale) + i);
+
+        __m128 mvp[16];
+        ComputeMvpSse2(params.viewProjection, position, axis, _mm_add_ps(phase, _mm_mul_ps(rate, time)), scale, mvp);
+        for (uint32_t column = 0; column < 4; column++)
+        {
+            StreamTransposedSse2(mvp[column * 4], mvp[column * 4 + 1], mvp[column * 4 + 2], mvp[column * 4 + 3],
+                                 out + i, column * 4);
+        }
+
+        ComputeMvpSse2(params.previousViewProjection, position, axis,
+                       _mm_add_ps(phase, _mm_mul_ps(rate, previousTime)), scale, mvp);
+        for (uint32_t column = 0; column < 4; column++)
+        {
+            StreamTransposedSse2(mvp[column * 4], mvp[column * 4 + 1], mvp[column * 4 + 2], mvp[column * 4 + 3],
+                                 out + i, 16 + column * 4);
+        }
+
+        StreamTransposedSse2(position[0], position[1], position[2], _mm_mul_ps(meshRadius, scale), out + i, 32);
+    }
+    for (; i < end; i++)
+    {
+        UpdateInstanceScalar(store, params, i, out[i]);
+    }
+
+    // Streaming stores are weakly ordered; fence them before the frame is submitted
+    _mm_sfence();
+}
+
+const TransformKernels* GetSse2TransformKernels()
+{
+    static const TransformKernels kernels = []
+    {
+        TransformKernels table;
+        table.level = SimdLevel::SSE2;
+        table.updateInstances = UpdateInstancesSse2;
+        return table;
+    }();
+    return &kernels;
+}
+
+#else
+
+const TransformKernels* GetSse2TransformKernels()
+{
+    return nullptr;
+}
+
+#endif
+
+}  // namespace detail
+}  // namespace cpu
+}  // namespace vkdemo
@@ -0,0 +1,78 @@
+#include "transform_store.h"
+
+#include "core/job_system.h"
+#include "transform_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace vkdemo
+{
+namespace cpu
+{
+
+// Instances per job; a multiple of TRANSFORM_BATCH so only the last chunk can end mid-batch
+constexpr uint32_t TRANSFORM_CHUNK_SIZE = 4096;
+static_assert(TRANSFORM_CHUNK_SIZE % TRANSFORM_BATCH == 0, "Chunks must hold whole batches");
+
+constexpr size_t TRANSFORM_STORE_ALIGNMENT = 64;
+
+void TransformStore::Resize(uint32_t newCount)
+{
+    count = newCount;
+    stride = (newCount + TRANSFORM_BATCH - 1) / TRANSFORM_BATCH * TRANSFORM_BATCH;
+    stride = (stride + 15) & ~15u;  // Keeps every component array on a 64-byte boundary
+
+    const size_t slack = TRANSFORM_STORE_ALIGNMENT / sizeof(float);
+    storage.assign(static_cast<size_t>(stride) * COMPONENT_COUNT + slack, 0.0f);
+
+    uintptr_t address = reinterpret_cast<uintptr_t>(storage.data());
+    uintptr_t aligned = (address + TRANSFORM_STORE_ALIGNMENT - 1) & ~(TRANSFORM_STORE_ALIGNMENT - 1);
+    base = storage.data() + (aligned - address) / sizeof(float);
+
+    std::fill_n(GetComponent(Scale), stride, 1.0f);
+}
+
+void TransformStore::Set(uint32_t index, const float position[3], const float axis[3], float phase, float rate,
+                         float scale)
+{
+    float length = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+    float inverseLength = length > 0.0f ? 1.0f / length : 0.0f;
+
+    GetComponent(PositionX)[index] = position[0];
+    GetComponent(PositionY)[index] = position[1];
+    GetComponent(PositionZ)[index] = position[2];
+    GetComponent(AxisX)[index] = axis[0] * inverseLength;
+    GetComponent(AxisY)[index] = axis[1] * inverseLength;
+    GetComponent(AxisZ)[index] = axis[2] * inverseLength;
+    GetComponent(Phase)[index] = phase;
+    GetComponent(Rate)[index] = rate;
+    GetComponent(Scale)[index] = scale;
+}
+
+void UpdateInstanceTransforms(JobSystem& jobs, const TransformKernels& kernels, const TransformStore& store,
+                              const TransformUpdateParams& params, InstanceMvp* out)
+{
+    const uint32_t count = store.GetCount();
+    const uint32_t chunkCount = (count + TRANSFORM_CHUNK_SIZE - 1) / TRANSFORM_CHUNK_SIZE;
+
+    auto updateChunk = [&](uint32_t chunk)
+    {
+        uint32_t begin = chunk * TRANSFORM_CHUNK_SIZE;
+        kernels.updateInstances(store, params, begin, std::min(begin + TRANSFORM_CHUNK_SIZE, count), out);
+    };
+
+    if (chunkCount <= 1)
+    {
+        if (chunkCount == 1)
+        {
+            updateChunk(0);
+        }
+        return;
+    }
+    jobs.ParallelFor2D(chunkCount, 1, [&](uint32_t chunk, uint32_t, uint32_t) { updateChunk(chunk); });
+}
+
+}  // namespace cpu
+}  // namespace vkdemo
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vkdemo
+{
+
+class JobSystem;
+
+namespace cpu
+{
+
+struct TransformKernels;
+
+//=============================================================================
+// Instance Transform Store
+//=============================================================================
+
+// Animated instance transforms in structure-of-arrays form: one 64-byte aligned array per component,
+// each padded with identity instances to a multiple of TRANSFORM_BATCH. At time t an instance is
+// scaled, rotated by phase + rate * t radians about its axis and translated to its position.
+class TransformStore
+{
+public:
+    enum Component : uint32_t
+    {
+        PositionX,
+        PositionY,
+        PositionZ,
+        AxisX,
+        AxisY,
+        AxisZ,
+        Phase,
+        Rate,
+        Scale,
+        COMPONENT_COUNT
+    };
+
+    TransformStore() = default;
+    TransformStore(const TransformStore&) = delete;
+    TransformStore& operator=(const TransformStore&) = delete;
+
+    // Resets every instance to the identity transform (origin, no spin, unit scale)
+    void Resize(uint32_t count);
+
+    // axis need not be normalised; a zero axis leaves the instance unrotated
+    void Set(uint32_t index, const float position[3], const float axis[3], float phase, float rate, float scale);
+
+    uint32_t GetCount() const { return count; }
+    const float* GetComponent(Component component) const { return base + static_cast<size_t>(component) * stride; }
+
+private:
+    float* GetComponent(Component component) { return base + static_cast<size_t>(component) * stride; }
+
+    std::vector<float> storage;
+    float* base = nullptr;
+    uint32_t count = 0;
+    uint32_t stride = 0;
+};
+
+// One instance as read by shaders/gbuffer.vert and shaders/cull.comp: current and previous
+// model-view-projection (column-major) and the world-space bounding sphere (center, radius)
+struct alignas(16) InstanceMvp
+{
+    float currMvp[16];
+    float prevMvp[16];
+    float boundingSphere[4];
+};
+
+struct TransformUpdateParams
+{
+    // Column-major view-projections of the current and the previous frame
+    const float* viewProjection = nullptr;
+    const float* previousViewProjection = nullptr;
+    float time = 0.0f;
+    float previousTime = 0.0f;
+    // Bounding sphere radius of the mesh at unit scale
+    float meshRadius = 0.0f;
+};
+
+// Writes every instance of store to out (16-byte aligned, typically mapped GPU memory that is only
+// written) with the kernel table, in parallel over chunks of instances
+void UpdateInstanceTransforms(JobSystem& jobs, const TransformKernels& kernels, const TransformStore& store,
+                              const TransformUpdateParams& params, InstanceMvp* out);
+
+}  // namespace cpu
+}  // namespace vkdemo
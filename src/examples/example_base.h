@@ -20,9 +20,16 @@ public:
 
     virtual void Initialize() = 0;
     virtual void Cleanup() = 0;
+    // Swapchain recreation does not idle the device: frames in flight may still use resources tied to the
+    // old swapchain, so OnSwapChainCleanup must retire them through VulkanContext's deferred Destroy* calls
     virtual void OnSwapChainRecreated() = 0;
     virtual void OnSwapChainCleanup() = 0;
     virtual void RecordCommands(VkCommandBuffer cmd, uint32_t imageIndex) = 0;
+    // Frame interpolation (FrameLoopConfig::frameInterpolation): after each RecordCommands, an example that
+    // supports it records a frame between the previous rendered frame and that one into a second swapchain
+    // image, presented ahead of the rendered image
+    virtual bool SupportsFrameInterpolation() const { return false; }
+    virtual void RecordInterpolatedFrame(VkCommandBuffer cmd, uint32_t imageIndex) {}
     virtual void Update(float deltaTime) = 0;
     virtual void ProcessInput(GLFWwindow* window, float deltaTime) {}
 
@@ -0,0 +1,106 @@
+#include "instance_scene.h"
+
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+namespace vkdemo
+{
+
+// Distance between neighbouring grid cells, in mesh units (the mesh spans [-0.5, 0.5])
+static constexpr float GRID_SPACING = 2.0f;
+
+// Spin rates in radians per second
+static constexpr float MIN_SPIN_RATE = 0.5f;
+static constexpr float MAX_SPIN_RATE = 4.0f;
+
+// The bottom 1 / STATIC_LAYER_DIVISOR of the grid layers is static
+static constexpr uint32_t STATIC_LAYER_DIVISOR = 4;
+
+// Integer hash (lowbias32) mapped to [0, 1)
+static float HashToUnit(uint32_t value)
+{
+    value ^= value >> 16;
+    value *= 0x7feb352du;
+    value ^= value >> 15;
+    value *= 0x846ca68bu;
+    value ^= value >> 16;
+    return static_cast<float>(value >> 8) * (1.0f / 16777216.0f);
+}
+
+void InstanceScene::Initialize(uint32_t count)
+{
+    uint32_t instanceCount = std::min(std::max(count, 1u), MAX_INSTANCES);
+    kernels = &cpu::GetTransformKernels(cpu::DetectSimdLevel());
+
+    gridSide = static_cast<uint32_t>(std::ceil(std::cbrt(static_cast<double>(instanceCount))));
+    while (static_cast<uint64_t>(gridSide) * gridSide * gridSide < instanceCount)
+    {
+        gridSide++;
+    }
+
+    uint32_t layerSize = gridSide * gridSide;
+    staticCount = std::min(instanceCount, gridSide / STATIC_LAYER_DIVISOR * layerSize);
+
+    transforms.Resize(instanceCount);
+    float center = 0.5f * static_cast<float>(gridSide - 1);
+    for (uint32_t index = 0; index < instanceCount; index++)
+    {
+        uint32_t x = index % gridSide;
+        uint32_t y = (index / gridSide) % gridSide;
+        uint32_t z = index / (gridSide * gridSide);
+        const float position[3] = {(static_cast<float>(x) - center) * GRID_SPACING,
+                                   (static_cast<float>(y) - center) * GRID_SPACING,
+                                   (static_cast<float>(z) - center) * GRID_SPACING};
+
+        // Axis from a uniform point on the sphere; rate and phase from further hashes of the index
+        float cosTheta = 2.0f * HashToUnit(index * 4 + 0) - 1.0f;
+        float phi = 2.0f * glm::pi<float>() * HashToUnit(index * 4 + 1);
+        float sinTheta = std::sqrt(std::max(0.0f, 1.0f - cosTheta * cosTheta));
+        const float axis[3] = {sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta};
+
+        float rate = MIN_SPIN_RATE + (MAX_SPIN_RATE - MIN_SPIN_RATE) * HashToUnit(index * 4 + 2);
+        if (index < staticCount)
+        {
+            rate = 0.0f;
+        }
+        float phase = 2.0f * glm::pi<float>() * HashToUnit(index * 4 + 3);
+
+        transforms.Set(index, position, axis, phase, rate, 1.0f);
+    }
+}
+
+void InstanceScene::InitializeSingle(float spinRate)
+{
+    kernels = &cpu::GetTransformKernels(cpu::DetectSimdLevel());
+    gridSide = 1;
+    staticCount = 0;
+
+    const float origin[3] = {0.0f, 0.0f, 0.0f};
+    const float axis[3] = {0.0f, 0.0f, 1.0f};
+    transforms.Resize(1);
+    transforms.Set(0, origin, axis, 0.0f, spinRate, 1.0f);
+}
+
+float InstanceScene::GetBoundingRadius() const
+{
+    // Half the grid diagonal plus the mesh's own extent
+    float halfSide = 0.5f * static_cast<float>(gridSide - 1) * GRID_SPACING;
+    return std::sqrt(3.0f) * (halfSide + 0.5f);
+}
+
+void InstanceScene::WriteTransforms(JobSystem& jobs, cpu::InstanceMvp* out, const glm::mat4& viewProjection,
+                                    const glm::mat4& previousViewProjection, float time, float previousTime,
+                                    float meshRadius) const
+{
+    cpu::TransformUpdateParams params;
+    params.viewProjection = glm::value_ptr(viewProjection);
+    params.previousViewProjection = glm::value_ptr(previousViewProjection);
+    params.time = time;
+    params.previousTime = previousTime;
+    params.meshRadius = meshRadius;
+    cpu::UpdateInstanceTransforms(jobs, *kernels, transforms, params, out);
+}
+
+}  // namespace vkdemo
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "../../cpu/transform_kernels.h"
+#include "../../cpu/transform_store.h"
+
+#include <cstdint>
+#include <glm/glm.hpp>
+
+namespace vkdemo
+{
+
+class JobSystem;
+
+//=============================================================================
+// Instanced Stress Scene
+//=============================================================================
+
+// Instances sit on a centred cubic grid, each spinning about its own axis at its own rate, except for
+// the bottom layers of the grid, which hold still (static geometry, first in index order). Axis and
+// rate are hashed from the instance index, so a frame depends only on the instance count and the animation
+// time and every run of the same settings renders the same images. Transforms are kept in a
+// cpu::TransformStore and expanded to per-instance MVPs by the best SIMD tier of this CPU.
+class InstanceScene
+{
+public:
+    static constexpr uint32_t MAX_INSTANCES = 1000000;
+
+    // Stress grid of instanceCount instances
+    void Initialize(uint32_t instanceCount);
+
+    // A single instance at the origin spinning about +z at spinRate radians per second
+    void InitializeSingle(float spinRate);
+
+    // Writes current and previous MVP and the bounding sphere of every instance to out, in parallel
+    void WriteTransforms(JobSystem& jobs, cpu::InstanceMvp* out, const glm::mat4& viewProjection,
+                         const glm::mat4& previousViewProjection, float time, float previousTime,
+                         float meshRadius) const;
+
+    uint32_t GetInstanceCount() const { return transforms.GetCount(); }
+    // Instances [0, GetStaticInstanceCount()) never move; only the camera moves them on screen
+    uint32_t GetStaticInstanceCount() const { return staticCount; }
+    cpu::SimdLevel GetSimdLevel() const { return kernels->level; }
+
+    // Radius of a sphere around the origin that contains every instance
+    float GetBoundingRadius() const;
+
+private:
+    cpu::TransformStore transforms;
+    const cpu::TransformKernels* kernels = nullptr;
+    uint32_t gridSide = 1;
+    uint32_t staticCount = 0;
+};
+
+}  // namespace vkdemo
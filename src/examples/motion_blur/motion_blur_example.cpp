@@ -1,15 +1,106 @@
 #include "motion_blur_example.h"
 
+#include "../../core/mesh_file.h"
+#include "../../core/staging_ring.h"
+#include "../../cpu/cpu_post_process.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <cstring>
 #include <glm/gtc/matrix_transform.hpp>
+#include <iostream>
+#include <limits>
 #include <stdexcept>
 
 namespace vkdemo
 {
 
+// The bindless handles are pushed at offset 32 (see shaders/include/bindless.glsl)
+static_assert(sizeof(MotionBlurPostProcessParams) == 32, "Post-process push constant layout mismatch");
+static_assert(sizeof(MotionBlurPostProcessParams) + sizeof(MotionBlurBindlessHandles) <= 64,
+              "Camera parameters overlap the bindless handles");
+static_assert(sizeof(IirBlurPushConstants) == 32, "Recursive blur push constant layout mismatch");
+static_assert(sizeof(CullUniforms) == 192, "Culling uniform layout mismatch");
+static_assert(sizeof(GBufferParams) == 48, "G-buffer push constant layout mismatch");
+static_assert(offsetof(VertexPackParams, vertexCount) == 52, "Vertex packing push constant layout mismatch");
+static_assert(offsetof(TemporalBlurPushConstants, historyValid) == 100, "Temporal blur push constant layout mismatch");
+static_assert(offsetof(FrameInterpolationPushConstants, renderExtent) == 88,
+              "Frame interpolation push constant layout mismatch");
+
+// Offset of the Kawase taps, in half texels of the lower-resolution level of each pass
+static constexpr float KAWASE_OFFSET = 1.0f;
+
+// Scene meshes, packed into one vertex and one index buffer: the triangle, then a unit cube whose
+// corners are colored by their position
 static const std::vector<TriangleVertex> triangleVertices = {{{0.0f, -0.5f, 0.0f}, {1.0f, 0.0f, 0.0f}},
                                                              {{0.5f, 0.5f, 0.0f}, {0.0f, 1.0f, 0.0f}},
                                                              {{-0.5f, 0.5f, 0.0f}, {0.0f, 0.0f, 1.0f}}};
+static const std::vector<uint32_t> triangleIndices = {0, 1, 2};
+
+static const std::vector<TriangleVertex> cubeVertices = {
+    {{-0.5f, -0.5f, -0.5f}, {0.0f, 0.0f, 0.0f}}, {{0.5f, -0.5f, -0.5f}, {1.0f, 0.0f, 0.0f}},
+    {{0.5f, 0.5f, -0.5f}, {1.0f, 1.0f, 0.0f}},   {{-0.5f, 0.5f, -0.5f}, {0.0f, 1.0f, 0.0f}},
+    {{-0.5f, -0.5f, 0.5f}, {0.0f, 0.0f, 1.0f}},  {{0.5f, -0.5f, 0.5f}, {1.0f, 0.0f, 1.0f}},
+    {{0.5f, 0.5f, 0.5f}, {1.0f, 1.0f, 1.0f}},    {{-0.5f, 0.5f, 0.5f}, {0.0f, 1.0f, 1.0f}}};
+static const std::vector<uint32_t> cubeIndices = {0, 2, 1, 0, 3, 2, 4, 5, 6, 4, 6, 7, 0, 1, 5, 0, 5, 4,
+                                                  3, 6, 2, 3, 7, 6, 0, 4, 7, 0, 7, 3, 1, 2, 6, 1, 6, 5};
+
+// Mesh files are uploaded as-is into the vertex buffer
+static_assert(sizeof(TriangleVertex) == sizeof(MeshFileVertex), "Mesh file vertex layout mismatch");
+
+// Degrees per second of the triangle's spin, and radians per second of the stress-scene camera orbit
+static constexpr float TRIANGLE_SPIN_RATE = 90.0f;
+static constexpr float CAMERA_ORBIT_RATE = 0.1f;
+
+// Bounding spheres of the triangle and the cube around their centres, and workgroup sizes of shaders/cull.comp and
+// shaders/hiz_build.comp
+static constexpr float TRIANGLE_BOUNDING_RADIUS = 0.7071068f;
+static constexpr float CUBE_BOUNDING_RADIUS = 0.8660254f;
+static constexpr uint32_t CULL_WORKGROUP_SIZE = 64;
+static constexpr uint32_t HIZ_WORKGROUP_SIZE = 8;
+static constexpr uint32_t VERTEX_PACK_WORKGROUP_SIZE = 64;
+
+// Upper bound of MotionBlurSettings::motionTapCap
+static constexpr uint32_t MAX_MOTION_TAP_CAP = 64;
+// Tile size and widest blur reach of temporal blur reuse (shaders/include/temporal_blur.glsl)
+static constexpr uint32_t TEMPORAL_TILE_SIZE = 16;
+static constexpr uint32_t TEMPORAL_MAX_APRON = 16;
+// Workgroup size of the frame interpolation passes (shaders/include/frame_interpolation.glsl)
+static constexpr uint32_t INTERPOLATION_WORKGROUP_SIZE = 8;
+// Segments each line of the recursive blur is split into, one invocation each (shaders/iir_blur.comp)
+static constexpr uint32_t IIR_SEGMENT_COUNT = 16;
+// Shared memory each of those invocations keeps its History (three vec4) in
+static constexpr uint32_t IIR_HISTORY_BYTES = 3 * 4 * sizeof(float);
+// Auto blur crossover measurement: the radii the fragment blur is timed at, the frames averaged after
+// the warm-up ones, and the crossover used until it is measured (or without timestamp queries)
+static constexpr std::array<float, 5> CROSSOVER_RADII = {2.0f, 4.0f, 8.0f, 16.0f, 32.0f};
+static constexpr uint32_t CROSSOVER_TIMESTAMP_COUNT = static_cast<uint32_t>(CROSSOVER_RADII.size()) + 2;
+static constexpr uint32_t CROSSOVER_WARMUP_FRAMES = 4;
+static constexpr uint32_t CROSSOVER_SAMPLE_FRAMES = 16;
+static constexpr float DEFAULT_IIR_CROSSOVER_RADIUS = 8.0f;
+
+// Timestamps written each frame with GPU profiling or dynamic resolution: the start, then the end of each
+// pass group
+static constexpr uint32_t TIMESTAMP_FRAME_START = 0;
+static constexpr uint32_t TIMESTAMP_CULLING = 1;
+static constexpr uint32_t TIMESTAMP_GBUFFER = 2;
+static constexpr uint32_t TIMESTAMP_HIZ = 3;
+static constexpr uint32_t TIMESTAMP_MOTION_APPLY = 4;
+static constexpr uint32_t TIMESTAMP_BLUR = 5;
+static constexpr uint32_t TIMESTAMP_FINAL = 6;
+static constexpr uint32_t TIMESTAMP_COUNT = 7;
+// The render extent is snapped to this many texels, so a settled governor does not keep resizing it (and
+// dropping the temporal history); the pass times are reported every GPU_TIMING_REPORT_FRAMES frames
+static constexpr uint32_t RENDER_EXTENT_GRANULARITY = 8;
+static constexpr uint64_t GPU_TIMING_REPORT_FRAMES = 300;
+
+// Tap cap as motion apply is specialized with (0 for the fixed 4 taps). An adaptive cap below 4 would
+// undersample fast pixels compared to the fixed taps.
+static uint32_t ClampMotionTapCap(uint32_t motionTapCap)
+{
+    return motionTapCap > 0 ? std::clamp(motionTapCap, 4u, MAX_MOTION_TAP_CAP) : 0;
+}
 
 VkVertexInputBindingDescription TriangleVertex::GetBindingDescription()
 {
@@ -34,28 +125,259 @@ std::array<VkVertexInputAttributeDescription, 2> TriangleVertex::GetAttributeDes
     return attributeDescriptions;
 }
 
-MotionBlurExample::MotionBlurExample(VulkanContext& context) : ExampleBase(context) {}
+MotionBlurExample::MotionBlurExample(VulkanContext& context, const MotionBlurSettings& settings)
+    : ExampleBase(context), settings(settings)
+{
+}
 
 void MotionBlurExample::Initialize()
 {
+    useBindless = settings.bindless && ctx.IsBindlessSupported();
+    if (settings.bindless && !useBindless)
+    {
+        std::cout << "Bindless mode requested but descriptor indexing is unsupported, using descriptor sets"
+                  << std::endl;
+    }
+
+    SelectPrecision();
+    SelectGBufferLayout();
+
+    useGpuCulling = settings.instanceCount > 0 && settings.gpuCulling && ctx.IsDrawIndirectCountSupported();
+    if (settings.instanceCount > 0 && settings.gpuCulling && !useGpuCulling)
+    {
+        std::cout << "GPU culling requested but indirect draw counts are unsupported, drawing every instance"
+                  << std::endl;
+    }
+
+    useVertexPulling = settings.vertexPulling && ctx.IsBufferDeviceAddressSupported();
+    if (settings.vertexPulling && !useVertexPulling)
+    {
+        std::cout << "Vertex pulling requested but buffer device addresses are unsupported, using vertex input"
+                  << std::endl;
+    }
+
+    // The G-buffer and culling passes read the instances by address, past maxStorageBufferRange
+    useInstanceAddress = ctx.IsBufferDeviceAddressSupported();
+
+    iirCrossoverRadius =
+        settings.iirCrossoverRadius > 0.0f ? settings.iirCrossoverRadius : DEFAULT_IIR_CROSSOVER_RADIUS;
+
+    // Tiles are blurred again with the fragment blur kernel, whose reach (BLUR_KERNEL_RADIUS taps spaced
+    // blurRadius / BLUR_KERNEL_RADIUS apart, plus a texel of linear filtering) must fit the tile strip;
+    // the recursive and pyramid blurs have no per-tile form
+    if (settings.temporalBlur)
+    {
+        temporalApron = static_cast<uint32_t>(std::ceil(settings.blurRadius)) + 1;
+        useTemporalBlur = ResolveBlurMode() == GpuBlurMode::Fir && temporalApron <= TEMPORAL_MAX_APRON;
+        if (!useTemporalBlur)
+        {
+            std::cout << "Temporal blur reuse needs the fragment blur with a radius below " << TEMPORAL_MAX_APRON
+                      << " texels, blurring every frame" << std::endl;
+        }
+    }
+
+    // Auto measures its crossover unless it is given, or temporal reuse holds it to the fragment blur
+    if (settings.blurMode == GpuBlurMode::Auto && settings.iirCrossoverRadius <= 0.0f && !useTemporalBlur)
+    {
+        measuringCrossover = crossoverTimer.Initialize(ctx, CROSSOVER_TIMESTAMP_COUNT);
+        firMilliseconds.assign(CROSSOVER_RADII.size(), 0.0);
+        if (!measuringCrossover)
+        {
+            std::cout << "Measuring the blur crossover needs timestamp queries, switching at radius "
+                      << iirCrossoverRadius << std::endl;
+        }
+    }
+
+    // Frame interpolation samples the displayed frames, which are kept in the swapchain format
+    if (ctx.IsFrameInterpolationEnabled())
+    {
+        VkFormatFeatureFlags displayFeatures = VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT |
+                                               VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT |
+                                               VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+        VkFormatProperties properties;
+        vkGetPhysicalDeviceFormatProperties(ctx.GetPhysicalDevice(), ctx.GetSwapChainFormat(), &properties);
+        useFrameInterpolation = (properties.optimalTilingFeatures & displayFeatures) == displayFeatures;
+        if (!useFrameInterpolation)
+        {
+            std::cout << "Frame interpolation needs a sampled swapchain format, presenting rendered frames only"
+                      << std::endl;
+        }
+    }
+
+    // The GPU profile and dynamic resolution read timestamps around the passes
+    if (settings.gpuProfile || settings.targetFrameMs > 0.0f)
+    {
+        bool timed = gpuTimer.Initialize(ctx, TIMESTAMP_COUNT);
+        if (settings.gpuProfile && !timed)
+        {
+            std::cout << "GPU profiling needs timestamp queries, skipping the pass timings" << std::endl;
+        }
+    }
+    if (settings.targetFrameMs > 0.0f)
+    {
+        useDynamicResolution = gpuTimer.IsSupported();
+        if (useDynamicResolution)
+        {
+            ResolutionGovernorConfig governorConfig;
+            governorConfig.targetMilliseconds = settings.targetFrameMs;
+            governorConfig.minScale = settings.minRenderScale;
+            resolutionGovernor = ResolutionGovernor(governorConfig);
+            renderScale = resolutionGovernor.GetScale();
+            std::cout << "Dynamic resolution: " << governorConfig.targetMilliseconds << " ms target, render scale "
+                      << resolutionGovernor.GetConfig().minScale << " to 1" << std::endl;
+        }
+        else
+        {
+            std::cout << "Dynamic resolution needs timestamp queries, rendering at full resolution" << std::endl;
+        }
+    }
+
+    VkExtent2D extent = ctx.GetSwapChainExtent();
+    blurWorkgroupSize = LoadComputeWorkgroupSize(cpu::TileProfile::DEFAULT_PATH, ctx, "blur", extent.width,
+                                                 extent.height, BLUR_KERNEL_RADIUS, 4 * sizeof(float));
+    std::cout << "Compute blur workgroup: " << blurWorkgroupSize.width << "x" << blurWorkgroupSize.height
+              << std::endl;
+
     CreateSamplers();
     CreateRenderTargets();
+    if (useBindless)
+    {
+        CreateBindlessTable();
+    }
     CreateRenderPasses();
     CreateDescriptorSetLayouts();
     CreatePipelineLayouts();
     CreatePipelines();
-    CreateFramebuffers();
-    CreateTriangleVertexBuffer();
-    fullscreenQuad.Initialize(ctx);
-    CreateUniformBuffers();
+    CreateRenderTargetFramebuffers();
+    CreateSwapChainFramebuffers();
+    CreateMeshBuffers();
+    CreateUniformAllocator();
+    CreateInstanceBuffer();
+    if (useGpuCulling)
+    {
+        CreateCullingBuffers();
+    }
     CreateDescriptorPool();
     CreateDescriptorSets();
 }
 
+void MotionBlurExample::SelectPrecision()
+{
+    // B10G11R11 halves the bytes per pixel of every post pass; it has no alpha and no sign, which
+    // none of the intermediates need
+    VkFormatFeatureFlags colorFeatures = VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT |
+                                         VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+    std::vector<VkFormat> candidates = {VK_FORMAT_R16G16B16A16_SFLOAT};
+    if (settings.packedFormats)
+    {
+        candidates.insert(candidates.begin(), VK_FORMAT_B10G11R11_UFLOAT_PACK32);
+    }
+    motionFormat = ctx.FindSupportedFormat(candidates, VK_IMAGE_TILING_OPTIMAL, colorFeatures);
+
+    // The blur targets are also written as storage images, which in B10G11R11 takes the
+    // shaderStorageImageExtendedFormats feature on top of the format support
+    if (!ctx.IsStorageImageExtendedFormatsSupported())
+    {
+        candidates.erase(std::remove(candidates.begin(), candidates.end(), VK_FORMAT_B10G11R11_UFLOAT_PACK32),
+                         candidates.end());
+    }
+    blurFormat = ctx.FindSupportedFormat(candidates, VK_IMAGE_TILING_OPTIMAL,
+                                         colorFeatures | VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT);
+
+    useFp16Shaders = settings.fp16Shaders && ctx.IsShaderFloat16Supported();
+
+    auto formatName = [](VkFormat format)
+    { return format == VK_FORMAT_B10G11R11_UFLOAT_PACK32 ? "B10G11R11" : "RGBA16F"; };
+    std::cout << "Post-process formats: motion " << formatName(motionFormat) << ", blur " << formatName(blurFormat)
+              << "; " << (useFp16Shaders ? "fp16" : "fp32") << " shader arithmetic" << std::endl;
+}
+
+GpuBlurMode MotionBlurExample::ResolveBlurMode() const
+{
+    if (settings.blurMode != GpuBlurMode::Auto)
+        return settings.blurMode;
+    return settings.blurRadius >= iirCrossoverRadius ? GpuBlurMode::Iir : GpuBlurMode::Fir;
+}
+
+std::string MotionBlurExample::GetPostShaderPath(const char* name) const
+{
+    return std::string("shaders/") + name + (useFp16Shaders ? "_fp16" : "") + ".frag.spv";
+}
+
+void MotionBlurExample::SelectGBufferLayout()
+{
+    // Rendering to B10G11R11, RG16 snorm and RGBA16 unorm is optional; color is also filtered by the taps
+    // of motion apply
+    auto supports = [&](VkFormat format, VkFormatFeatureFlags features)
+    {
+        VkFormatProperties properties;
+        vkGetPhysicalDeviceFormatProperties(ctx.GetPhysicalDevice(), format, &properties);
+        return (properties.optimalTilingFeatures & features) == features;
+    };
+    VkFormatFeatureFlags targetFeatures = VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
+
+    gbufferLayout = settings.gbufferLayout;
+    sceneColorFormat = VK_FORMAT_R16G16B16A16_SFLOAT;
+    velocityFormat = VK_FORMAT_R16G16_SFLOAT;
+    if (gbufferLayout == GBufferLayout::Packed)
+    {
+        sceneColorFormat = VK_FORMAT_B10G11R11_UFLOAT_PACK32;
+        velocityFormat = VK_FORMAT_R16G16_SNORM;
+    }
+    else if (gbufferLayout == GBufferLayout::Folded)
+    {
+        sceneColorFormat = VK_FORMAT_R16G16B16A16_UNORM;
+        velocityFormat = VK_FORMAT_UNDEFINED;
+    }
+
+    bool supported = supports(sceneColorFormat, targetFeatures | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT) &&
+                     (velocityFormat == VK_FORMAT_UNDEFINED || supports(velocityFormat, targetFeatures));
+    if (!supported)
+    {
+        std::cout << "G-buffer layout unsupported by the device, using separate targets" << std::endl;
+        gbufferLayout = GBufferLayout::Separate;
+        sceneColorFormat = VK_FORMAT_R16G16B16A16_SFLOAT;
+        velocityFormat = VK_FORMAT_R16G16_SFLOAT;
+    }
+
+    // Upper bounds of the bytes per pixel, as if no fetch hit a cache: the G-buffer pass writes color,
+    // velocity (skipped under static geometry in camera velocity mode) and depth once. Motion apply reads
+    // the color texel with the dynamic mark and every tap, then either the velocity texel or, in camera
+    // velocity mode, the depth (after the velocity texel in the packed layout, whose mark it holds).
+    VkFormat depthFormat = ctx.FindDepthFormat();
+    uint32_t colorBytes = gbufferLayout == GBufferLayout::Packed ? 4 : 8;
+    uint32_t velocityBytes = velocityFormat == VK_FORMAT_UNDEFINED ? 0 : 4;
+    uint32_t depthBytes = depthFormat == VK_FORMAT_D32_SFLOAT_S8_UINT ? 5 : 4;
+    uint32_t depthReadBytes = 4;  // The depth aspect alone
+    uint32_t motionTaps = std::max(ClampMotionTapCap(settings.motionTapCap), 4u);
+    uint32_t staticReadBytes = settings.cameraVelocity
+                                   ? (gbufferLayout == GBufferLayout::Packed ? velocityBytes : 0) + depthReadBytes
+                                   : velocityBytes;
+    gbufferWriteBytes = colorBytes + velocityBytes + depthBytes;
+    motionApplyReadBytes = (1 + motionTaps) * colorBytes + std::max(velocityBytes, staticReadBytes);
+
+    const char* layoutNames[] = {"separate (RGBA16F color, RG16F velocity)",
+                                 "packed (B10G11R11 color, RG16 snorm velocity)",
+                                 "folded (RGBA16 color, log-polar velocity in alpha)"};
+    std::cout << "G-buffer layout: " << layoutNames[static_cast<int>(gbufferLayout)] << "; up to "
+              << gbufferWriteBytes << " B/px written, up to " << motionApplyReadBytes << " B/px read by motion apply ("
+              << (settings.motionTapCap > 0 ? "at most " : "") << motionTaps << " taps"
+              << (settings.cameraVelocity ? ", camera velocity" : "") << ")" << std::endl;
+}
+
+VkImageView MotionBlurExample::GetVelocityView() const
+{
+    // The folded layout decodes velocity from the scene color texels
+    return gbufferLayout == GBufferLayout::Folded ? rtSceneColor.view : rtVelocity.view;
+}
+
 void MotionBlurExample::Cleanup()
 {
     VkDevice device = ctx.GetDevice();
 
+    gpuTimer.Cleanup(device);
+    crossoverTimer.Cleanup(device);
+
     // Cleanup samplers
     vkDestroySampler(device, samplerLinear, nullptr);
     vkDestroySampler(device, samplerNearest, nullptr);
@@ -64,70 +386,221 @@ void MotionBlurExample::Cleanup()
     rtSceneColor.Cleanup(device);
     rtVelocity.Cleanup(device);
     rtDepth.Cleanup(device);
+    for (VkImageView view : hizLevelViews)
+    {
+        vkDestroyImageView(device, view, nullptr);
+    }
+    rtHiZ.Cleanup(device);
     rtMotion.Cleanup(device);
     rtBlurIntermediate.Cleanup(device);
     rtBlurFinal.Cleanup(device);
+    rtIirCausal.Cleanup(device);
+    for (VkImageView view : pyramidViews)
+    {
+        vkDestroyImageView(device, view, nullptr);
+    }
+    pyramidViews.clear();
+    rtBlurPyramid.Cleanup(device);
+    rtBlurAlternate.Cleanup(device);
+    for (RenderTarget& target : rtTemporalDepth)
+    {
+        target.Cleanup(device);
+    }
+    for (RenderTarget& target : rtDisplay)
+    {
+        target.Cleanup(device);
+    }
+    for (RenderTarget& target : rtInterpolationMotion)
+    {
+        target.Cleanup(device);
+    }
+    rtInterpolationWarp.Cleanup(device);
+    rtInterpolated.Cleanup(device);
 
     // Cleanup framebuffers
     CleanupFramebuffers();
 
     // Cleanup pipelines
     vkDestroyPipeline(device, pipelineGBuffer, nullptr);
+    vkDestroyPipeline(device, pipelineGBufferStatic, nullptr);
     vkDestroyPipeline(device, pipelineMotionApply, nullptr);
     vkDestroyPipeline(device, pipelineBlurVertical, nullptr);
     vkDestroyPipeline(device, pipelineBlurHorizontal, nullptr);
     vkDestroyPipeline(device, pipelineFinal, nullptr);
+    vkDestroyPipeline(device, pipelineIirBlur, nullptr);
+    vkDestroyPipeline(device, pipelinePyramidDown, nullptr);
+    vkDestroyPipeline(device, pipelinePyramidUp, nullptr);
+    vkDestroyPipeline(device, pipelineFinalPyramid, nullptr);
+    vkDestroyPipeline(device, pipelineCull, nullptr);
+    vkDestroyPipeline(device, pipelineCullRetest, nullptr);
+    vkDestroyPipeline(device, pipelineHiZBuild, nullptr);
+    vkDestroyPipeline(device, pipelineTemporalReproject, nullptr);
+    vkDestroyPipeline(device, pipelineTemporalBlur, nullptr);
+    vkDestroyPipeline(device, pipelineInterpolationMotion, nullptr);
+    vkDestroyPipeline(device, pipelineInterpolationWarp, nullptr);
+    vkDestroyPipeline(device, pipelineInterpolationFill, nullptr);
+    vkDestroyPipeline(device, pipelineDisplayCopy, nullptr);
 
     // Cleanup pipeline layouts
     vkDestroyPipelineLayout(device, pipelineLayoutGBuffer, nullptr);
-    vkDestroyPipelineLayout(device, pipelineLayoutMotionApply, nullptr);
-    vkDestroyPipelineLayout(device, pipelineLayoutBlur, nullptr);
+    vkDestroyPipelineLayout(device, pipelineLayoutPostProcess, nullptr);
     vkDestroyPipelineLayout(device, pipelineLayoutFinal, nullptr);
+    vkDestroyPipelineLayout(device, pipelineLayoutIirBlur, nullptr);
+    vkDestroyPipelineLayout(device, pipelineLayoutPyramid, nullptr);
+    vkDestroyPipelineLayout(device, pipelineLayoutCull, nullptr);
+    vkDestroyPipelineLayout(device, pipelineLayoutHiZ, nullptr);
+    vkDestroyPipelineLayout(device, pipelineLayoutTemporal, nullptr);
+    vkDestroyPipelineLayout(device, pipelineLayoutInterpolation, nullptr);
 
     // Cleanup render passes
     vkDestroyRenderPass(device, renderPassGBuffer, nullptr);
+    vkDestroyRenderPass(device, renderPassGBufferRetest, nullptr);
     vkDestroyRenderPass(device, renderPassMotionApply, nullptr);
     vkDestroyRenderPass(device, renderPassBlurVertical, nullptr);
     vkDestroyRenderPass(device, renderPassBlurHorizontal, nullptr);
     vkDestroyRenderPass(device, renderPassFinal, nullptr);
+    vkDestroyRenderPass(device, renderPassPyramid, nullptr);
+    vkDestroyRenderPass(device, renderPassDisplay, nullptr);
 
     // Cleanup descriptor set layouts
     vkDestroyDescriptorSetLayout(device, descriptorSetLayoutGBuffer, nullptr);
     vkDestroyDescriptorSetLayout(device, descriptorSetLayoutPostProcess, nullptr);
     vkDestroyDescriptorSetLayout(device, descriptorSetLayoutFinal, nullptr);
+    vkDestroyDescriptorSetLayout(device, descriptorSetLayoutIirBlur, nullptr);
+    vkDestroyDescriptorSetLayout(device, descriptorSetLayoutPyramid, nullptr);
+    vkDestroyDescriptorSetLayout(device, descriptorSetLayoutCull, nullptr);
+    vkDestroyDescriptorSetLayout(device, descriptorSetLayoutTemporal, nullptr);
+    vkDestroyDescriptorSetLayout(device, descriptorSetLayoutInterpolation, nullptr);
 
     vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+    bindlessTable.Cleanup(device);
+
+    // Cleanup uniform allocator
+    uniformAllocator.Cleanup(device);
+
+    // Cleanup scene buffers
+    vkDestroyBuffer(device, meshVertexBuffer, nullptr);
+    vkFreeMemory(device, meshVertexBufferMemory, nullptr);
+    vkDestroyBuffer(device, meshIndexBuffer, nullptr);
+    vkFreeMemory(device, meshIndexBufferMemory, nullptr);
+    vkUnmapMemory(device, instanceBufferMemory);
+    vkDestroyBuffer(device, instanceBuffer, nullptr);
+    vkFreeMemory(device, instanceBufferMemory, nullptr);
+    vkDestroyBuffer(device, drawCommandBuffer, nullptr);
+    vkFreeMemory(device, drawCommandBufferMemory, nullptr);
+    vkDestroyBuffer(device, drawCountBuffer, nullptr);
+    vkFreeMemory(device, drawCountBufferMemory, nullptr);
+    vkDestroyBuffer(device, occlusionRetestBuffer, nullptr);
+    vkFreeMemory(device, occlusionRetestBufferMemory, nullptr);
+    vkDestroyBuffer(device, temporalTileBuffer, nullptr);
+    vkFreeMemory(device, temporalTileBufferMemory, nullptr);
+}
+
+void MotionBlurExample::OnSwapChainRecreated()
+{
+    CreateSwapChainFramebuffers();
+
+    // The history and the frames to interpolate between were rendered into the previous sub-rect
+    temporalHistoryValid = false;
+    interpolationFrames = 0;
+
+    // Most resizes stay within the current bucket and only change the rendered sub-rect
+    if (RenderTargetsFit(ctx.GetSwapChainExtent()))
+        return;
+
+    // Frames in flight may still read the old targets, so they are retired rather than destroyed
+    RetireRenderTargets();
+    CreateRenderTargets();
+    CreateRenderTargetFramebuffers();
 
-    // Cleanup uniform buffers
-    for (size_t i = 0; i < VulkanContext::MAX_FRAMES_IN_FLIGHT; i++)
+    if (useBindless)
     {
-        vkDestroyBuffer(device, mvpUniformBuffers[i], nullptr);
-        vkFreeMemory(device, mvpUniformBuffersMemory[i], nullptr);
-        vkDestroyBuffer(device, postProcessUniformBuffers[i], nullptr);
-        vkFreeMemory(device, postProcessUniformBuffersMemory[i], nullptr);
+        RegisterBindlessRenderTargets();
     }
 
-    // Cleanup vertex buffer
-    vkDestroyBuffer(device, triangleVertexBuffer, nullptr);
-    vkFreeMemory(device, triangleVertexBufferMemory, nullptr);
+    // The recursive and pyramid blur sets exist in both modes
+    RetireDescriptorPool();
+    CreateDescriptorPool();
+    CreateDescriptorSets();
+}
 
-    // Cleanup fullscreen quad
-    fullscreenQuad.Cleanup(device);
+void MotionBlurExample::OnSwapChainCleanup()
+{
+    RetireSwapChainFramebuffers();
 }
 
-void MotionBlurExample::OnSwapChainRecreated()
+bool MotionBlurExample::RenderTargetsFit(VkExtent2D extent) const
 {
-    CleanupRenderTargets();
-    CreateRenderTargets();
-    CreateFramebuffers();
+    if (extent.width > renderTargetExtent.width || extent.height > renderTargetExtent.height)
+        return false;
 
-    vkResetDescriptorPool(ctx.GetDevice(), descriptorPool, 0);
-    CreateDescriptorSets();
+    // Give memory back once the window shrinks well below the allocation
+    uint64_t requiredArea = static_cast<uint64_t>(extent.width) * extent.height;
+    uint64_t allocatedArea = static_cast<uint64_t>(renderTargetExtent.width) * renderTargetExtent.height;
+    return requiredArea * 4 > allocatedArea;
 }
 
-void MotionBlurExample::OnSwapChainCleanup()
+void MotionBlurExample::RetireRenderTargets()
 {
-    CleanupFramebuffers();
+    for (VkFramebuffer* framebuffer :
+         {&fbGBuffer, &fbMotionApply, &fbBlurVertical, &fbBlurHorizontal, &fbDisplay[0], &fbDisplay[1]})
+    {
+        ctx.DestroyFramebuffer(*framebuffer);
+        *framebuffer = VK_NULL_HANDLE;
+    }
+
+    for (VkFramebuffer framebuffer : fbPyramid)
+    {
+        ctx.DestroyFramebuffer(framebuffer);
+    }
+    fbPyramid.clear();
+
+    for (RenderTarget* target : {&rtSceneColor, &rtVelocity, &rtDepth, &rtMotion, &rtBlurIntermediate, &rtBlurFinal,
+                                 &rtIirCausal, &rtBlurAlternate, &rtTemporalDepth[0], &rtTemporalDepth[1],
+                                 &rtDisplay[0], &rtDisplay[1], &rtInterpolationMotion[0], &rtInterpolationMotion[1],
+                                 &rtInterpolationWarp, &rtInterpolated})
+    {
+        target->Retire(ctx);
+    }
+
+    // The tile list is sized by the render targets
+    if (temporalTileBuffer != VK_NULL_HANDLE)
+    {
+        ctx.DestroyBuffer(temporalTileBuffer, temporalTileBufferMemory);
+        temporalTileBuffer = VK_NULL_HANDLE;
+        temporalTileBufferMemory = VK_NULL_HANDLE;
+    }
+
+    for (VkImageView view : pyramidViews)
+    {
+        ctx.DestroyImageView(view);
+    }
+    pyramidViews.clear();
+    rtBlurPyramid.Retire(ctx);
+
+    for (VkImageView view : hizLevelViews)
+    {
+        ctx.DestroyImageView(view);
+    }
+    hizLevelViews.clear();
+    rtHiZ.Retire(ctx);
+}
+
+void MotionBlurExample::RetireSwapChainFramebuffers()
+{
+    for (auto framebuffer : swapChainFramebuffers)
+    {
+        ctx.DestroyFramebuffer(framebuffer);
+    }
+    swapChainFramebuffers.clear();
+}
+
+void MotionBlurExample::RetireDescriptorPool()
+{
+    // Sets allocated from the pool may still be bound by frames in flight; a fresh pool is cheaper
+    // than waiting for them
+    ctx.DestroyDescriptorPool(descriptorPool);
+    descriptorPool = VK_NULL_HANDLE;
 }
 
 void MotionBlurExample::CreateSamplers()
@@ -136,12 +609,97 @@ void MotionBlurExample::CreateSamplers()
     samplerNearest = utils::CreateNearestSampler(ctx.GetDevice());
 }
 
+void MotionBlurExample::CreateBindlessTable()
+{
+    bindlessTable.Initialize(ctx, 256, 64, 16);
+
+    bindlessSamplerLinear = bindlessTable.RegisterSampler(samplerLinear);
+    bindlessSamplerNearest = bindlessTable.RegisterSampler(samplerNearest);
+
+    RegisterBindlessRenderTargets();
+}
+
+void MotionBlurExample::RegisterBindlessRenderTargets()
+{
+    // Frames in flight may still sample the previous slots, so reallocated targets get fresh slots
+    // and the old ones are released once those frames have completed
+    if (bindlessSceneColor != BindlessTable::INVALID_HANDLE)
+    {
+        std::array<uint32_t, 8> oldHandles = {bindlessSceneColor, bindlessVelocity,         bindlessDepth,
+                                              bindlessMotion,     bindlessBlurIntermediate, bindlessBlurFinal,
+                                              bindlessBlurAlternate, bindlessBlurPyramid};
+        ctx.DeferDestroy(
+            [this, oldHandles]()
+            {
+                for (uint32_t handle : oldHandles)
+                {
+                    bindlessTable.ReleaseSampledImage(handle);
+                }
+            });
+    }
+
+    bindlessSceneColor = bindlessTable.RegisterSampledImage(rtSceneColor.view);
+    bindlessVelocity = bindlessTable.RegisterSampledImage(GetVelocityView());
+    bindlessDepth = bindlessTable.RegisterSampledImage(rtDepth.view);
+    bindlessMotion = bindlessTable.RegisterSampledImage(rtMotion.view);
+    bindlessBlurIntermediate = bindlessTable.RegisterSampledImage(rtBlurIntermediate.view);
+    bindlessBlurFinal = bindlessTable.RegisterSampledImage(rtBlurFinal.view);
+    if (useTemporalBlur)
+    {
+        bindlessBlurAlternate = bindlessTable.RegisterSampledImage(rtBlurAlternate.view);
+    }
+    bindlessBlurPyramid = bindlessTable.RegisterSampledImage(pyramidViews[0]);
+}
+
+MotionBlurBindlessHandles MotionBlurExample::MakeBindlessHandles(uint32_t inputTexture, uint32_t blurTexture) const
+{
+    MotionBlurBindlessHandles handles{};
+    handles.inputTexture = inputTexture;
+    handles.velocityTexture = bindlessVelocity;
+    handles.depthTexture = bindlessDepth;
+    handles.blurTexture = blurTexture;
+    handles.linearSampler = bindlessSamplerLinear;
+    handles.nearestSampler = bindlessSamplerNearest;
+    return handles;
+}
+
+void MotionBlurExample::BindPostProcessResources(VkCommandBuffer cmd, VkDescriptorSet descriptorSet,
+                                                 const MotionBlurBindlessHandles& handles)
+{
+    if (useBindless)
+    {
+        VkDescriptorSet bindlessSet = bindlessTable.GetSet();
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayoutPostProcess, 0, 1, &bindlessSet, 0,
+                                nullptr);
+        vkCmdPushConstants(cmd, pipelineLayoutPostProcess, VK_SHADER_STAGE_FRAGMENT_BIT,
+                           sizeof(MotionBlurPostProcessParams), sizeof(MotionBlurBindlessHandles), &handles);
+    }
+    else
+    {
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayoutPostProcess, 0, 1, &descriptorSet,
+                                0, nullptr);
+    }
+
+    vkCmdPushConstants(cmd, pipelineLayoutPostProcess, VK_SHADER_STAGE_FRAGMENT_BIT, 0,
+                       sizeof(MotionBlurPostProcessParams), &postProcessParams);
+}
+
 void MotionBlurExample::CreateRenderTargets()
 {
-    VkExtent2D extent = ctx.GetSwapChainExtent();
+    // Round up to the bucket size so that small resizes keep reusing the same allocation
+    VkExtent2D swapChainExtent = ctx.GetSwapChainExtent();
+    uint32_t maxDimension = ctx.GetPhysicalDeviceProperties().limits.maxImageDimension2D;
+    auto bucketed = [&](uint32_t size)
+    {
+        uint32_t rounded = (size + RENDER_TARGET_BUCKET - 1) / RENDER_TARGET_BUCKET * RENDER_TARGET_BUCKET;
+        return std::max(size, std::min(rounded, maxDimension));
+    };
+
+    VkExtent2D extent = {bucketed(swapChainExtent.width), bucketed(swapChainExtent.height)};
+    renderTargetExtent = extent;
 
     // Scene Color
-    rtSceneColor.format = VK_FORMAT_R16G16B16A16_SFLOAT;
+    rtSceneColor.format = sceneColorFormat;
     rtSceneColor.width = extent.width;
     rtSceneColor.height = extent.height;
     ctx.CreateImage(extent.width, extent.height, rtSceneColor.format, VK_IMAGE_TILING_OPTIMAL,
@@ -150,13 +708,16 @@ void MotionBlurExample::CreateRenderTargets()
     rtSceneColor.view = ctx.CreateImageView(rtSceneColor.image, rtSceneColor.format, VK_IMAGE_ASPECT_COLOR_BIT);
 
     // Velocity
-    rtVelocity.format = VK_FORMAT_R16G16_SFLOAT;
-    rtVelocity.width = extent.width;
-    rtVelocity.height = extent.height;
-    ctx.CreateImage(extent.width, extent.height, rtVelocity.format, VK_IMAGE_TILING_OPTIMAL,
-                    VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, rtVelocity.image, rtVelocity.memory);
-    rtVelocity.view = ctx.CreateImageView(rtVelocity.image, rtVelocity.format, VK_IMAGE_ASPECT_COLOR_BIT);
+    if (velocityFormat != VK_FORMAT_UNDEFINED)
+    {
+        rtVelocity.format = velocityFormat;
+        rtVelocity.width = extent.width;
+        rtVelocity.height = extent.height;
+        ctx.CreateImage(extent.width, extent.height, rtVelocity.format, VK_IMAGE_TILING_OPTIMAL,
+                        VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, rtVelocity.image, rtVelocity.memory);
+        rtVelocity.view = ctx.CreateImageView(rtVelocity.image, rtVelocity.format, VK_IMAGE_ASPECT_COLOR_BIT);
+    }
 
     // Depth
     rtDepth.format = ctx.FindDepthFormat();
@@ -168,7 +729,7 @@ void MotionBlurExample::CreateRenderTargets()
     rtDepth.view = ctx.CreateImageView(rtDepth.image, rtDepth.format, VK_IMAGE_ASPECT_DEPTH_BIT);
 
     // Motion output
-    rtMotion.format = VK_FORMAT_R16G16B16A16_SFLOAT;
+    rtMotion.format = motionFormat;
     rtMotion.width = extent.width;
     rtMotion.height = extent.height;
     ctx.CreateImage(extent.width, extent.height, rtMotion.format, VK_IMAGE_TILING_OPTIMAL,
@@ -177,81 +738,198 @@ void MotionBlurExample::CreateRenderTargets()
     rtMotion.view = ctx.CreateImageView(rtMotion.image, rtMotion.format, VK_IMAGE_ASPECT_COLOR_BIT);
 
     // Blur Intermediate
-    rtBlurIntermediate.format = VK_FORMAT_R16G16B16A16_SFLOAT;
+    rtBlurIntermediate.format = blurFormat;
     rtBlurIntermediate.width = extent.width;
     rtBlurIntermediate.height = extent.height;
     ctx.CreateImage(extent.width, extent.height, rtBlurIntermediate.format, VK_IMAGE_TILING_OPTIMAL,
-                    VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                    VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT,
                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, rtBlurIntermediate.image, rtBlurIntermediate.memory);
     rtBlurIntermediate.view =
         ctx.CreateImageView(rtBlurIntermediate.image, rtBlurIntermediate.format, VK_IMAGE_ASPECT_COLOR_BIT);
 
     // Blur Final
-    rtBlurFinal.format = VK_FORMAT_R16G16B16A16_SFLOAT;
+    rtBlurFinal.format = blurFormat;
     rtBlurFinal.width = extent.width;
     rtBlurFinal.height = extent.height;
     ctx.CreateImage(extent.width, extent.height, rtBlurFinal.format, VK_IMAGE_TILING_OPTIMAL,
-                    VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                    VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT,
                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, rtBlurFinal.image, rtBlurFinal.memory);
     rtBlurFinal.view = ctx.CreateImageView(rtBlurFinal.image, rtBlurFinal.format, VK_IMAGE_ASPECT_COLOR_BIT);
+
+    // Recursive blur scratch: the causal result stays at fp16 even when the blur targets are packed
+    if (settings.blurMode == GpuBlurMode::Iir || settings.blurMode == GpuBlurMode::Auto)
+    {
+        rtIirCausal.format = VK_FORMAT_R16G16B16A16_SFLOAT;
+        rtIirCausal.width = extent.width;
+        rtIirCausal.height = extent.height;
+        ctx.CreateImage(extent.width, extent.height, rtIirCausal.format, VK_IMAGE_TILING_OPTIMAL,
+                        VK_IMAGE_USAGE_STORAGE_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, rtIirCausal.image,
+                        rtIirCausal.memory);
+        rtIirCausal.view = ctx.CreateImageView(rtIirCausal.image, rtIirCausal.format, VK_IMAGE_ASPECT_COLOR_BIT);
+    }
+
+    // Temporal blur reuse: the second blur target, both depth targets and the tile list (an indirect
+    // dispatch header followed by one entry per tile)
+    temporalHistoryValid = false;
+    if (useTemporalBlur)
+    {
+        auto createTarget = [&](RenderTarget& target, VkFormat format, VkImageUsageFlags usage)
+        {
+            target.format = format;
+            target.width = extent.width;
+            target.height = extent.height;
+            ctx.CreateImage(extent.width, extent.height, format, VK_IMAGE_TILING_OPTIMAL, usage,
+                            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, target.image, target.memory);
+            target.view = ctx.CreateImageView(target.image, format, VK_IMAGE_ASPECT_COLOR_BIT);
+        };
+        VkImageUsageFlags temporalUsage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT;
+        createTarget(rtBlurAlternate, blurFormat, temporalUsage);
+        for (RenderTarget& target : rtTemporalDepth)
+        {
+            createTarget(target, VK_FORMAT_R32_SFLOAT, temporalUsage);
+        }
+
+        VkDeviceSize tilesX = (extent.width + TEMPORAL_TILE_SIZE - 1) / TEMPORAL_TILE_SIZE;
+        VkDeviceSize tilesY = (extent.height + TEMPORAL_TILE_SIZE - 1) / TEMPORAL_TILE_SIZE;
+        ctx.CreateBuffer(4 * sizeof(uint32_t) + tilesX * tilesY * sizeof(uint32_t),
+                         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                             VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, temporalTileBuffer, temporalTileBufferMemory);
+    }
+
+    // Frame interpolation: two display targets in the swapchain format, motion and nearness of the frame
+    // displayed from each, the warped frame and the interpolated one
+    interpolationFrames = 0;
+    if (useFrameInterpolation)
+    {
+        auto createTarget = [&](RenderTarget& target, VkFormat format, VkImageUsageFlags usage)
+        {
+            target.format = format;
+            target.width = extent.width;
+            target.height = extent.height;
+            ctx.CreateImage(extent.width, extent.height, format, VK_IMAGE_TILING_OPTIMAL, usage,
+                            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, target.image, target.memory);
+            target.view = ctx.CreateImageView(target.image, format, VK_IMAGE_ASPECT_COLOR_BIT);
+        };
+        VkImageUsageFlags storageUsage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        for (uint32_t i = 0; i < 2; i++)
+        {
+            createTarget(rtDisplay[i], ctx.GetSwapChainFormat(),
+                         VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT);
+            createTarget(rtInterpolationMotion[i], VK_FORMAT_R16G16B16A16_SFLOAT, storageUsage);
+        }
+        createTarget(rtInterpolationWarp, VK_FORMAT_R16G16B16A16_SFLOAT, storageUsage);
+        createTarget(rtInterpolated, VK_FORMAT_R16G16B16A16_SFLOAT, storageUsage);
+    }
+
+    // Blur pyramid, allocated with every level so that the level count can change per frame
+    uint32_t pyramidBase = std::min(extent.width, extent.height) / 2;
+    pyramidMipLevels = 1;
+    while (pyramidMipLevels < MAX_PYRAMID_LEVELS && (pyramidBase >> pyramidMipLevels) > 1)
+    {
+        pyramidMipLevels++;
+    }
+
+    rtBlurPyramid.format = motionFormat;
+    rtBlurPyramid.width = std::max(1u, extent.width / 2);
+    rtBlurPyramid.height = std::max(1u, extent.height / 2);
+    ctx.CreateImage(rtBlurPyramid.width, rtBlurPyramid.height, rtBlurPyramid.format, VK_IMAGE_TILING_OPTIMAL,
+                    VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, rtBlurPyramid.image, rtBlurPyramid.memory, pyramidMipLevels);
+    for (uint32_t level = 0; level < pyramidMipLevels; level++)
+    {
+        pyramidViews.push_back(
+            ctx.CreateImageView(rtBlurPyramid.image, rtBlurPyramid.format, VK_IMAGE_ASPECT_COLOR_BIT, level));
+    }
+
+    // Depth pyramid (GPU culling only). Power-of-two levels halve exactly, so the rendered area of every
+    // level, rounded up from the one below, always fits.
+    hizValid = false;
+    hizInitialized = false;
+    if (useGpuCulling)
+    {
+        auto nextPowerOfTwo = [](uint32_t value)
+        {
+            uint32_t result = 1;
+            while (result < value)
+                result <<= 1;
+            return result;
+        };
+        rtHiZ.format = VK_FORMAT_R32_SFLOAT;
+        rtHiZ.width = nextPowerOfTwo((extent.width + 1) / 2);
+        rtHiZ.height = nextPowerOfTwo((extent.height + 1) / 2);
+        hizMipLevels = 1;
+        while (hizMipLevels < MAX_HIZ_LEVELS && std::max(rtHiZ.width, rtHiZ.height) >> hizMipLevels > 0)
+        {
+            hizMipLevels++;
+        }
+
+        ctx.CreateImage(rtHiZ.width, rtHiZ.height, rtHiZ.format, VK_IMAGE_TILING_OPTIMAL,
+                        VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                        rtHiZ.image, rtHiZ.memory, hizMipLevels);
+        rtHiZ.view = ctx.CreateImageView(rtHiZ.image, rtHiZ.format, VK_IMAGE_ASPECT_COLOR_BIT, 0, hizMipLevels);
+        for (uint32_t level = 0; level < hizMipLevels; level++)
+        {
+            hizLevelViews.push_back(ctx.CreateImageView(rtHiZ.image, rtHiZ.format, VK_IMAGE_ASPECT_COLOR_BIT, level));
+        }
+    }
 }
 
-void MotionBlurExample::CleanupRenderTargets()
+VkExtent2D MotionBlurExample::GetPyramidLevelSize(uint32_t level) const
 {
-    VkDevice device = ctx.GetDevice();
-    rtSceneColor.Cleanup(device);
-    rtVelocity.Cleanup(device);
-    rtDepth.Cleanup(device);
-    rtMotion.Cleanup(device);
-    rtBlurIntermediate.Cleanup(device);
-    rtBlurFinal.Cleanup(device);
+    return {std::max(1u, rtBlurPyramid.width >> level), std::max(1u, rtBlurPyramid.height >> level)};
+}
+
+VkExtent2D MotionBlurExample::GetHiZLevelSize(VkExtent2D extent, uint32_t level) const
+{
+    // Rendered area of a level: each level rounds the one below up, so edge texels are never dropped
+    VkExtent2D size = extent;
+    for (uint32_t i = 0; i <= level; i++)
+    {
+        size = {(size.width + 1) / 2, (size.height + 1) / 2};
+    }
+    return size;
 }
 
 void MotionBlurExample::CreateRenderPasses()
 {
     VkDevice device = ctx.GetDevice();
 
-    // G-Buffer (SceneColor + Velocity + Depth)
-    {
-        std::array<VkAttachmentDescription, 3> attachments{};
-
-        // SceneColor
-        attachments[0].format = rtSceneColor.format;
-        attachments[0].samples = VK_SAMPLE_COUNT_1_BIT;
-        attachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-        attachments[0].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-        attachments[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        attachments[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        attachments[0].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        attachments[0].finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-        // Velocity
-        attachments[1].format = rtVelocity.format;
-        attachments[1].samples = VK_SAMPLE_COUNT_1_BIT;
-        attachments[1].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-        attachments[1].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-        attachments[1].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        attachments[1].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        attachments[1].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        attachments[1].finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-        // Depth
-        attachments[2].format = rtDepth.format;
-        attachments[2].samples = VK_SAMPLE_COUNT_1_BIT;
-        attachments[2].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-        attachments[2].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-        attachments[2].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        attachments[2].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        attachments[2].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        attachments[2].finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-        std::array<VkAttachmentReference, 2> colorRefs{};
-        colorRefs[0] = {0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
-        colorRefs[1] = {1, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+    // G-Buffer (SceneColor + Velocity + Depth, without Velocity when the layout folds it into SceneColor)
+    {
+        auto makeAttachment = [](VkFormat format, VkAttachmentLoadOp loadOp)
+        {
+            VkAttachmentDescription attachment{};
+            attachment.format = format;
+            attachment.samples = VK_SAMPLE_COUNT_1_BIT;
+            attachment.loadOp = loadOp;
+            attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+            attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            attachment.finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            return attachment;
+        };
+
+        std::vector<VkAttachmentDescription> attachments;
+        std::vector<VkAttachmentReference> colorRefs;
+        attachments.push_back(makeAttachment(rtSceneColor.format, VK_ATTACHMENT_LOAD_OP_CLEAR));
+        colorRefs.push_back({0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL});
+
+        // Velocity (camera velocity mode only reads it where dynamic geometry was drawn, unless the packed
+        // layout's clear value is what marks those pixels)
+        if (velocityFormat != VK_FORMAT_UNDEFINED)
+        {
+            bool clearVelocity = !settings.cameraVelocity || gbufferLayout == GBufferLayout::Packed;
+            attachments.push_back(makeAttachment(
+                rtVelocity.format, clearVelocity ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_DONT_CARE));
+            colorRefs.push_back({1, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL});
+        }
 
         VkAttachmentReference depthRef{};
-        depthRef.attachment = 2;
+        depthRef.attachment = static_cast<uint32_t>(attachments.size());
         depthRef.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        attachments.push_back(makeAttachment(rtDepth.format, VK_ATTACHMENT_LOAD_OP_CLEAR));
 
         VkSubpassDescription subpass{};
         subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
@@ -282,6 +960,31 @@ void MotionBlurExample::CreateRenderPasses()
         {
             throw std::runtime_error("Failed to create G-Buffer render pass!");
         }
+
+        // Draws of the second culling pass: keep what the first drew, after the depth pyramid has read it
+        if (useGpuCulling && settings.occlusionCulling)
+        {
+            for (VkAttachmentDescription& attachment : attachments)
+            {
+                attachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+                attachment.initialLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            }
+            dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+                                      VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+            dependency.srcAccessMask =
+                VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+                                      VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                                      VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+            dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                                       VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                                       VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+            if (vkCreateRenderPass(device, &renderPassInfo, nullptr, &renderPassGBufferRetest) != VK_SUCCESS)
+            {
+                throw std::runtime_error("Failed to create occlusion re-test G-Buffer render pass!");
+            }
+        }
     }
 
     // Post-process passes
@@ -332,6 +1035,13 @@ void MotionBlurExample::CreateRenderPasses()
     createPostProcessRenderPass(rtMotion.format, renderPassMotionApply);
     createPostProcessRenderPass(rtBlurIntermediate.format, renderPassBlurVertical);
     createPostProcessRenderPass(rtBlurFinal.format, renderPassBlurHorizontal);
+    createPostProcessRenderPass(rtBlurPyramid.format, renderPassPyramid);
+
+    // Display targets of frame interpolation, compatible with the final pass
+    if (useFrameInterpolation)
+    {
+        createPostProcessRenderPass(ctx.GetSwapChainFormat(), renderPassDisplay);
+    }
 
     // Final pass
     {
@@ -382,18 +1092,19 @@ void MotionBlurExample::CreateDescriptorSetLayouts()
 {
     VkDevice device = ctx.GetDevice();
 
-    // G-Buffer layout (UBO only)
+    // G-Buffer layout (per-instance MVPs), unless they are read by address
+    if (!useInstanceAddress)
     {
-        VkDescriptorSetLayoutBinding uboBinding{};
-        uboBinding.binding = 0;
-        uboBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        uboBinding.descriptorCount = 1;
-        uboBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+        VkDescriptorSetLayoutBinding binding{};
+        binding.binding = 0;
+        binding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+        binding.descriptorCount = 1;
+        binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
 
         VkDescriptorSetLayoutCreateInfo layoutInfo{};
         layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
         layoutInfo.bindingCount = 1;
-        layoutInfo.pBindings = &uboBinding;
+        layoutInfo.pBindings = &binding;
 
         if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &descriptorSetLayoutGBuffer) != VK_SUCCESS)
         {
@@ -401,63 +1112,196 @@ void MotionBlurExample::CreateDescriptorSetLayouts()
         }
     }
 
-    // Post-process layout (samplers for input texture, velocity, depth)
+    // Recursive blur layout (input sampler, output and causal scratch storage images)
     {
-        std::array<VkDescriptorSetLayoutBinding, 4> bindings{};
+        std::array<VkDescriptorSetLayoutBinding, 3> bindings{};
 
         bindings[0].binding = 0;
         bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
         bindings[0].descriptorCount = 1;
-        bindings[0].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+        bindings[0].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
 
         bindings[1].binding = 1;
-        bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
         bindings[1].descriptorCount = 1;
-        bindings[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+        bindings[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
 
         bindings[2].binding = 2;
-        bindings[2].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        bindings[2].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
         bindings[2].descriptorCount = 1;
-        bindings[2].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-
-        bindings[3].binding = 3;
-        bindings[3].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        bindings[3].descriptorCount = 1;
-        bindings[3].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+        bindings[2].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
 
         VkDescriptorSetLayoutCreateInfo layoutInfo{};
         layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
         layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
         layoutInfo.pBindings = bindings.data();
 
-        if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &descriptorSetLayoutPostProcess) != VK_SUCCESS)
+        if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &descriptorSetLayoutIirBlur) != VK_SUCCESS)
         {
-            throw std::runtime_error("Failed to create post-process descriptor set layout!");
+            throw std::runtime_error("Failed to create recursive blur descriptor set layout!");
         }
     }
 
-    // Final pass layout (two samplers: motion result and blur result)
+    // Pyramid blur layout (source level sampler)
     {
-        std::array<VkDescriptorSetLayoutBinding, 2> bindings{};
-
-        bindings[0].binding = 0;
-        bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        bindings[0].descriptorCount = 1;
-        bindings[0].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-
-        bindings[1].binding = 1;
-        bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        bindings[1].descriptorCount = 1;
-        bindings[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+        VkDescriptorSetLayoutBinding binding{};
+        binding.binding = 0;
+        binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        binding.descriptorCount = 1;
+        binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
 
         VkDescriptorSetLayoutCreateInfo layoutInfo{};
         layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
-        layoutInfo.pBindings = bindings.data();
+        layoutInfo.bindingCount = 1;
+        layoutInfo.pBindings = &binding;
 
-        if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &descriptorSetLayoutFinal) != VK_SUCCESS)
+        if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &descriptorSetLayoutPyramid) != VK_SUCCESS)
         {
-            throw std::runtime_error("Failed to create final descriptor set layout!");
+            throw std::runtime_error("Failed to create pyramid blur descriptor set layout!");
+        }
+    }
+
+    // Culling layout (uniforms, instance transforms, draw commands, draw counts, depth pyramid, occlusion
+    // re-test list); instances read by address leave binding 1 out
+    {
+        const std::array<VkDescriptorType, 6> types = {
+            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER};
+        std::vector<VkDescriptorSetLayoutBinding> bindings;
+        for (uint32_t i = 0; i < types.size(); i++)
+        {
+            if (i == 1 && useInstanceAddress)
+                continue;
+
+            VkDescriptorSetLayoutBinding binding{};
+            binding.binding = i;
+            binding.descriptorType = types[i];
+            binding.descriptorCount = 1;
+            binding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+            bindings.push_back(binding);
+        }
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings = bindings.data();
+
+        if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &descriptorSetLayoutCull) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create culling descriptor set layout!");
+        }
+    }
+
+    // Temporal blur reuse layout (scene color, velocity, depth, motion result, blur and depth history,
+    // blur and depth outputs, tile list)
+    {
+        std::array<VkDescriptorSetLayoutBinding, 9> bindings{};
+        for (uint32_t i = 0; i < bindings.size(); i++)
+        {
+            bindings[i].binding = i;
+            bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            bindings[i].descriptorCount = 1;
+            bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        }
+        bindings[6].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        bindings[7].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        bindings[8].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings = bindings.data();
+
+        if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &descriptorSetLayoutTemporal) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create temporal blur descriptor set layout!");
+        }
+    }
+
+    // Frame interpolation layout (scene color, velocity, depth, both displayed frames and their motion,
+    // motion output, warped frame, warp output, interpolated output)
+    {
+        std::array<VkDescriptorSetLayoutBinding, 11> bindings{};
+        for (uint32_t i = 0; i < bindings.size(); i++)
+        {
+            bindings[i].binding = i;
+            bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            bindings[i].descriptorCount = 1;
+            bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        }
+        bindings[7].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        bindings[9].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        bindings[10].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings = bindings.data();
+
+        if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &descriptorSetLayoutInterpolation) !=
+            VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create frame interpolation descriptor set layout!");
+        }
+    }
+
+    // Bindless mode takes every post-process resource from the bindless table
+    if (useBindless)
+        return;
+
+    // Post-process layout (samplers for input texture, velocity, depth)
+    {
+        std::array<VkDescriptorSetLayoutBinding, 3> bindings{};
+
+        bindings[0].binding = 0;
+        bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        bindings[0].descriptorCount = 1;
+        bindings[0].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+        bindings[1].binding = 1;
+        bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        bindings[1].descriptorCount = 1;
+        bindings[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+        bindings[2].binding = 2;
+        bindings[2].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        bindings[2].descriptorCount = 1;
+        bindings[2].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings = bindings.data();
+
+        if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &descriptorSetLayoutPostProcess) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create post-process descriptor set layout!");
+        }
+    }
+
+    // Final pass layout (two samplers: motion result and blur result)
+    {
+        std::array<VkDescriptorSetLayoutBinding, 2> bindings{};
+
+        bindings[0].binding = 0;
+        bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        bindings[0].descriptorCount = 1;
+        bindings[0].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+        bindings[1].binding = 1;
+        bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        bindings[1].descriptorCount = 1;
+        bindings[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings = bindings.data();
+
+        if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &descriptorSetLayoutFinal) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create final descriptor set layout!");
         }
     }
 }
@@ -468,10 +1312,24 @@ void MotionBlurExample::CreatePipelineLayouts()
 
     // G-Buffer pipeline layout
     {
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(GBufferParams);
+
+        // Instances read by address take the place of the descriptor set
         VkPipelineLayoutCreateInfo layoutInfo{};
         layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-        layoutInfo.setLayoutCount = 1;
-        layoutInfo.pSetLayouts = &descriptorSetLayoutGBuffer;
+        if (useInstanceAddress)
+        {
+            layoutInfo.pushConstantRangeCount = 1;
+            layoutInfo.pPushConstantRanges = &pushConstantRange;
+        }
+        else
+        {
+            layoutInfo.setLayoutCount = 1;
+            layoutInfo.pSetLayouts = &descriptorSetLayoutGBuffer;
+        }
 
         if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &pipelineLayoutGBuffer) != VK_SUCCESS)
         {
@@ -479,38 +1337,168 @@ void MotionBlurExample::CreatePipelineLayouts()
         }
     }
 
-    // Motion Apply pipeline layout
+    // Recursive blur pipeline layout
+    {
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(IirBlurPushConstants);
+
+        VkPipelineLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount = 1;
+        layoutInfo.pSetLayouts = &descriptorSetLayoutIirBlur;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges = &pushConstantRange;
+
+        if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &pipelineLayoutIirBlur) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create recursive blur pipeline layout!");
+        }
+    }
+
+    // Culling pipeline layout; instances read by address are pushed
+    {
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(VkDeviceAddress);
+
+        VkPipelineLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount = 1;
+        layoutInfo.pSetLayouts = &descriptorSetLayoutCull;
+        if (useInstanceAddress)
+        {
+            layoutInfo.pushConstantRangeCount = 1;
+            layoutInfo.pPushConstantRanges = &pushConstantRange;
+        }
+
+        if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &pipelineLayoutCull) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create culling pipeline layout!");
+        }
+    }
+
+    // Depth pyramid pipeline layout; its set has the shape of the recursive blur one (sampled input,
+    // storage output)
+    {
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(HiZBuildPushConstants);
+
+        VkPipelineLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount = 1;
+        layoutInfo.pSetLayouts = &descriptorSetLayoutIirBlur;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges = &pushConstantRange;
+
+        if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &pipelineLayoutHiZ) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create depth pyramid pipeline layout!");
+        }
+    }
+
+    // Temporal blur reuse pipeline layout (shared by the reprojection and tile blur passes)
+    {
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(TemporalBlurPushConstants);
+
+        VkPipelineLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount = 1;
+        layoutInfo.pSetLayouts = &descriptorSetLayoutTemporal;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges = &pushConstantRange;
+
+        if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &pipelineLayoutTemporal) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create temporal blur pipeline layout!");
+        }
+    }
+
+    // Frame interpolation pipeline layout (shared by its three compute passes)
+    {
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(FrameInterpolationPushConstants);
+
+        VkPipelineLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount = 1;
+        layoutInfo.pSetLayouts = &descriptorSetLayoutInterpolation;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges = &pushConstantRange;
+
+        if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &pipelineLayoutInterpolation) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create frame interpolation pipeline layout!");
+        }
+    }
+
+    // Pyramid blur pipeline layout (shared by the downsample and upsample passes)
     {
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(KawaseBlurParams);
+
         VkPipelineLayoutCreateInfo layoutInfo{};
         layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
         layoutInfo.setLayoutCount = 1;
-        layoutInfo.pSetLayouts = &descriptorSetLayoutPostProcess;
+        layoutInfo.pSetLayouts = &descriptorSetLayoutPyramid;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges = &pushConstantRange;
 
-        if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &pipelineLayoutMotionApply) != VK_SUCCESS)
+        if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &pipelineLayoutPyramid) != VK_SUCCESS)
         {
-            throw std::runtime_error("Failed to create motion apply pipeline layout!");
+            throw std::runtime_error("Failed to create pyramid blur pipeline layout!");
         }
     }
 
-    // Blur pipeline layout
+    // Post-process pipeline layout (shared by motion apply and both blur passes)
     {
+        VkDescriptorSetLayout setLayout = useBindless ? bindlessTable.GetLayout() : descriptorSetLayoutPostProcess;
+
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+        pushConstantRange.offset = 0;
+        // Parameters, bindless handles (bindless mode) and the camera parameters of motion apply, which
+        // its shaders declare in every mode. 128 bytes, the guaranteed push constant limit.
+        pushConstantRange.size = CAMERA_PARAMS_OFFSET + sizeof(MotionBlurCameraParams);
+
         VkPipelineLayoutCreateInfo layoutInfo{};
         layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
         layoutInfo.setLayoutCount = 1;
-        layoutInfo.pSetLayouts = &descriptorSetLayoutPostProcess;
+        layoutInfo.pSetLayouts = &setLayout;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges = &pushConstantRange;
 
-        if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &pipelineLayoutBlur) != VK_SUCCESS)
+        if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &pipelineLayoutPostProcess) != VK_SUCCESS)
         {
-            throw std::runtime_error("Failed to create blur pipeline layout!");
+            throw std::runtime_error("Failed to create post-process pipeline layout!");
         }
     }
 
-    // Final pipeline layout
+    // Final pipeline layout (bindless mode reuses the post-process layout)
+    if (!useBindless)
     {
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(MotionBlurPostProcessParams);
+
         VkPipelineLayoutCreateInfo layoutInfo{};
         layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
         layoutInfo.setLayoutCount = 1;
         layoutInfo.pSetLayouts = &descriptorSetLayoutFinal;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges = &pushConstantRange;
 
         if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &pipelineLayoutFinal) != VK_SUCCESS)
         {
@@ -523,7 +1511,10 @@ void MotionBlurExample::CreatePipelines()
 {
     // G-Buffer pipeline
     {
-        auto vertShaderCode = utils::ReadFile("shaders/gbuffer.vert.spv");
+        const char* vertShaderPath = useVertexPulling     ? "shaders/gbuffer_pulling.vert.spv"
+                                     : useInstanceAddress ? "shaders/gbuffer_address.vert.spv"
+                                                          : "shaders/gbuffer.vert.spv";
+        auto vertShaderCode = utils::ReadFile(vertShaderPath);
         auto fragShaderCode = utils::ReadFile("shaders/gbuffer.frag.spv");
 
         VkShaderModule vertShaderModule = ctx.CreateShaderModule(vertShaderCode);
@@ -541,43 +1532,55 @@ void MotionBlurExample::CreatePipelines()
         fragShaderStageInfo.module = fragShaderModule;
         fragShaderStageInfo.pName = "main";
 
+        // Static geometry (the static pipeline below) and G-buffer layout (shaders/include/gbuffer.glsl)
+        struct GBufferSpecializationData
+        {
+            VkBool32 staticGeometry;
+            int32_t layout;
+        } gbufferSpecializationData = {VK_FALSE, static_cast<int32_t>(gbufferLayout)};
+        std::array<VkSpecializationMapEntry, 2> gbufferSpecializationEntries = {
+            VkSpecializationMapEntry{0, offsetof(GBufferSpecializationData, staticGeometry), sizeof(VkBool32)},
+            VkSpecializationMapEntry{1, offsetof(GBufferSpecializationData, layout), sizeof(int32_t)},
+        };
+        VkSpecializationInfo fragSpecialization{};
+        fragSpecialization.mapEntryCount = static_cast<uint32_t>(gbufferSpecializationEntries.size());
+        fragSpecialization.pMapEntries = gbufferSpecializationEntries.data();
+        fragSpecialization.dataSize = sizeof(gbufferSpecializationData);
+        fragSpecialization.pData = &gbufferSpecializationData;
+        fragShaderStageInfo.pSpecializationInfo = &fragSpecialization;
+
         VkPipelineShaderStageCreateInfo shaderStages[] = {vertShaderStageInfo, fragShaderStageInfo};
 
         auto bindingDescription = TriangleVertex::GetBindingDescription();
         auto attributeDescriptions = TriangleVertex::GetAttributeDescriptions();
 
+        // Vertex pulling reads the vertices in the shader, with no vertex input state at all
         VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
         vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-        vertexInputInfo.vertexBindingDescriptionCount = 1;
-        vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
-        vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
-        vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
+        if (!useVertexPulling)
+        {
+            vertexInputInfo.vertexBindingDescriptionCount = 1;
+            vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
+            vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
+            vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
+        }
 
         VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
         inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
         inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
         inputAssembly.primitiveRestartEnable = VK_FALSE;
 
-        VkExtent2D extent = ctx.GetSwapChainExtent();
-
-        VkViewport viewport{};
-        viewport.x = 0.0f;
-        viewport.y = 0.0f;
-        viewport.width = static_cast<float>(extent.width);
-        viewport.height = static_cast<float>(extent.height);
-        viewport.minDepth = 0.0f;
-        viewport.maxDepth = 1.0f;
-
-        VkRect2D scissor{};
-        scissor.offset = {0, 0};
-        scissor.extent = extent;
-
         VkPipelineViewportStateCreateInfo viewportState{};
         viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
         viewportState.viewportCount = 1;
-        viewportState.pViewports = &viewport;
         viewportState.scissorCount = 1;
-        viewportState.pScissors = &scissor;
+
+        std::array<VkDynamicState, 2> dynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+
+        VkPipelineDynamicStateCreateInfo dynamicState{};
+        dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+        dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+        dynamicState.pDynamicStates = dynamicStates.data();
 
         VkPipelineRasterizationStateCreateInfo rasterizer{};
         rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
@@ -613,7 +1616,7 @@ void MotionBlurExample::CreatePipelines()
         VkPipelineColorBlendStateCreateInfo colorBlending{};
         colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
         colorBlending.logicOpEnable = VK_FALSE;
-        colorBlending.attachmentCount = static_cast<uint32_t>(colorBlendAttachments.size());
+        colorBlending.attachmentCount = velocityFormat != VK_FORMAT_UNDEFINED ? 2 : 1;
         colorBlending.pAttachments = colorBlendAttachments.data();
 
         VkGraphicsPipelineCreateInfo pipelineInfo{};
@@ -627,6 +1630,7 @@ void MotionBlurExample::CreatePipelines()
         pipelineInfo.pMultisampleState = &multisampling;
         pipelineInfo.pDepthStencilState = &depthStencil;
         pipelineInfo.pColorBlendState = &colorBlending;
+        pipelineInfo.pDynamicState = &dynamicState;
         pipelineInfo.layout = pipelineLayoutGBuffer;
         pipelineInfo.renderPass = renderPassGBuffer;
         pipelineInfo.subpass = 0;
@@ -637,53 +1641,181 @@ void MotionBlurExample::CreatePipelines()
             throw std::runtime_error("Failed to create G-Buffer pipeline!");
         }
 
+        // Camera velocity mode draws the static instances without writing velocity at all; the static mark
+        // in scene color sends motion apply to their depth instead
+        if (settings.cameraVelocity)
+        {
+            gbufferSpecializationData.staticGeometry = VK_TRUE;
+            colorBlendAttachments[1].colorWriteMask = 0;
+            if (vkCreateGraphicsPipelines(ctx.GetDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr,
+                                          &pipelineGBufferStatic) != VK_SUCCESS)
+            {
+                throw std::runtime_error("Failed to create static G-Buffer pipeline!");
+            }
+        }
+
         vkDestroyShaderModule(ctx.GetDevice(), fragShaderModule, nullptr);
         vkDestroyShaderModule(ctx.GetDevice(), vertShaderModule, nullptr);
     }
 
     // Post-process pipelines
     PipelineConfig configMotion{};
-    configMotion.vertShaderPath = "shaders/motion_apply.vert.spv";
-    configMotion.fragShaderPath = "shaders/motion_apply.frag.spv";
+    configMotion.vertShaderPath = "shaders/fullscreen.vert.spv";
+    configMotion.fragShaderPath = GetPostShaderPath(useBindless ? "motion_apply_bindless" : "motion_apply");
     configMotion.renderPass = renderPassMotionApply;
-    configMotion.pipelineLayout = pipelineLayoutMotionApply;
+    configMotion.pipelineLayout = pipelineLayoutPostProcess;
     configMotion.colorAttachmentCount = 1;
     configMotion.hasDepthAttachment = false;
-    configMotion.isFullscreenQuad = true;
+
+    // Camera velocity mode, G-buffer layout (shaders/include/gbuffer.glsl) and tap cap
+    // (shaders/include/motion_taps.glsl)
+    uint32_t maxMotionTaps = ClampMotionTapCap(settings.motionTapCap);
+
+    struct MotionSpecializationData
+    {
+        VkBool32 cameraVelocity;
+        int32_t gbufferLayout;
+        int32_t maxMotionTaps;
+    } motionSpecializationData = {settings.cameraVelocity ? VK_TRUE : VK_FALSE, static_cast<int32_t>(gbufferLayout),
+                                  static_cast<int32_t>(maxMotionTaps)};
+    std::array<VkSpecializationMapEntry, 3> motionEntries = {
+        VkSpecializationMapEntry{0, offsetof(MotionSpecializationData, cameraVelocity), sizeof(VkBool32)},
+        VkSpecializationMapEntry{1, offsetof(MotionSpecializationData, gbufferLayout), sizeof(int32_t)},
+        VkSpecializationMapEntry{2, offsetof(MotionSpecializationData, maxMotionTaps), sizeof(int32_t)}};
+    VkSpecializationInfo motionSpecialization{};
+    motionSpecialization.mapEntryCount = static_cast<uint32_t>(motionEntries.size());
+    motionSpecialization.pMapEntries = motionEntries.data();
+    motionSpecialization.dataSize = sizeof(motionSpecializationData);
+    motionSpecialization.pData = &motionSpecializationData;
+    configMotion.fragSpecialization = &motionSpecialization;
     pipelineMotionApply = utils::CreatePipeline(ctx, configMotion);
 
     PipelineConfig configBlurV{};
-    configBlurV.vertShaderPath = "shaders/blur_vertical.vert.spv";
-    configBlurV.fragShaderPath = "shaders/blur_vertical.frag.spv";
+    configBlurV.vertShaderPath = "shaders/fullscreen.vert.spv";
+    configBlurV.fragShaderPath = GetPostShaderPath(useBindless ? "blur_vertical_bindless" : "blur_vertical");
     configBlurV.renderPass = renderPassBlurVertical;
-    configBlurV.pipelineLayout = pipelineLayoutBlur;
+    configBlurV.pipelineLayout = pipelineLayoutPostProcess;
     configBlurV.colorAttachmentCount = 1;
     configBlurV.hasDepthAttachment = false;
-    configBlurV.isFullscreenQuad = true;
     pipelineBlurVertical = utils::CreatePipeline(ctx, configBlurV);
 
     PipelineConfig configBlurH{};
-    configBlurH.vertShaderPath = "shaders/blur_horizontal.vert.spv";
-    configBlurH.fragShaderPath = "shaders/blur_horizontal.frag.spv";
+    configBlurH.vertShaderPath = "shaders/fullscreen.vert.spv";
+    configBlurH.fragShaderPath = GetPostShaderPath(useBindless ? "blur_horizontal_bindless" : "blur_horizontal");
     configBlurH.renderPass = renderPassBlurHorizontal;
-    configBlurH.pipelineLayout = pipelineLayoutBlur;
+    configBlurH.pipelineLayout = pipelineLayoutPostProcess;
     configBlurH.colorAttachmentCount = 1;
     configBlurH.hasDepthAttachment = false;
-    configBlurH.isFullscreenQuad = true;
     pipelineBlurHorizontal = utils::CreatePipeline(ctx, configBlurH);
 
     PipelineConfig configFinal{};
-    configFinal.vertShaderPath = "shaders/final_apply.vert.spv";
-    configFinal.fragShaderPath = "shaders/final_apply.frag.spv";
+    configFinal.vertShaderPath = "shaders/fullscreen.vert.spv";
+    configFinal.fragShaderPath = GetPostShaderPath(useBindless ? "final_apply_bindless" : "final_apply");
     configFinal.renderPass = renderPassFinal;
-    configFinal.pipelineLayout = pipelineLayoutFinal;
+    configFinal.pipelineLayout = useBindless ? pipelineLayoutPostProcess : pipelineLayoutFinal;
     configFinal.colorAttachmentCount = 1;
     configFinal.hasDepthAttachment = false;
-    configFinal.isFullscreenQuad = true;
     pipelineFinal = utils::CreatePipeline(ctx, configFinal);
+
+    // Final pass variant that runs the last pyramid upsample itself
+    VkBool32 pyramidBlur = VK_TRUE;
+    VkSpecializationMapEntry pyramidBlurEntry{0, 0, sizeof(VkBool32)};
+    VkSpecializationInfo finalSpecialization{};
+    finalSpecialization.mapEntryCount = 1;
+    finalSpecialization.pMapEntries = &pyramidBlurEntry;
+    finalSpecialization.dataSize = sizeof(VkBool32);
+    finalSpecialization.pData = &pyramidBlur;
+    configFinal.fragSpecialization = &finalSpecialization;
+    pipelineFinalPyramid = utils::CreatePipeline(ctx, configFinal);
+
+    PipelineConfig configPyramid{};
+    configPyramid.vertShaderPath = "shaders/fullscreen.vert.spv";
+    configPyramid.renderPass = renderPassPyramid;
+    configPyramid.pipelineLayout = pipelineLayoutPyramid;
+    configPyramid.colorAttachmentCount = 1;
+    configPyramid.hasDepthAttachment = false;
+    configPyramid.fragShaderPath = GetPostShaderPath("kawase_down");
+    pipelinePyramidDown = utils::CreatePipeline(ctx, configPyramid);
+    configPyramid.fragShaderPath = GetPostShaderPath("kawase_up");
+    pipelinePyramidUp = utils::CreatePipeline(ctx, configPyramid);
+
+    // Recursive blur: IIR_SEGMENT_COUNT invocations per line, as many lines per workgroup as the blur tile
+    // is wide (and the invocation and shared memory limits allow)
+    const VkPhysicalDeviceLimits& limits = ctx.GetPhysicalDeviceProperties().limits;
+    iirLinesPerWorkgroup = std::min(
+        {std::max(1u, blurWorkgroupSize.width), limits.maxComputeWorkGroupSize[0],
+         std::max(1u, limits.maxComputeWorkGroupInvocations / IIR_SEGMENT_COUNT),
+         std::max(1u, limits.maxComputeSharedMemorySize / (IIR_SEGMENT_COUNT * IIR_HISTORY_BYTES))});
+
+    std::array<uint32_t, 2> iirWorkgroupSize = {iirLinesPerWorkgroup, IIR_SEGMENT_COUNT};
+    std::array<VkSpecializationMapEntry, 2> workgroupSizeEntries = {
+        VkSpecializationMapEntry{0, 0, sizeof(uint32_t)},
+        VkSpecializationMapEntry{1, sizeof(uint32_t), sizeof(uint32_t)},
+    };
+    VkSpecializationInfo specialization{};
+    specialization.mapEntryCount = static_cast<uint32_t>(workgroupSizeEntries.size());
+    specialization.pMapEntries = workgroupSizeEntries.data();
+    specialization.dataSize = sizeof(iirWorkgroupSize);
+    specialization.pData = iirWorkgroupSize.data();
+    // The recursion stays fp32 (it feeds back its own output); packed targets need their own storage format
+    const char* iirShaderPath = blurFormat == VK_FORMAT_B10G11R11_UFLOAT_PACK32 ? "shaders/iir_blur_packed.comp.spv"
+                                                                                : "shaders/iir_blur.comp.spv";
+    pipelineIirBlur = utils::CreateComputePipeline(ctx, iirShaderPath, pipelineLayoutIirBlur, &specialization);
+
+    // Temporal blur reuse decodes velocity like motion apply (and ignores its tap cap); both passes write
+    // rtBlurFinal
+    if (useTemporalBlur)
+    {
+        bool packed = blurFormat == VK_FORMAT_B10G11R11_UFLOAT_PACK32;
+        pipelineTemporalReproject = utils::CreateComputePipeline(
+            ctx, packed ? "shaders/temporal_reproject_packed.comp.spv" : "shaders/temporal_reproject.comp.spv",
+            pipelineLayoutTemporal, &motionSpecialization);
+        pipelineTemporalBlur = utils::CreateComputePipeline(
+            ctx, packed ? "shaders/temporal_blur_packed.comp.spv" : "shaders/temporal_blur.comp.spv",
+            pipelineLayoutTemporal);
+    }
+
+    // Frame interpolation keeps velocity as motion apply decodes it (and ignores its tap cap). The copy to
+    // the swapchain takes one sampler, like a pyramid pass, and ignores its push constants.
+    if (useFrameInterpolation)
+    {
+        pipelineInterpolationMotion = utils::CreateComputePipeline(ctx, "shaders/interpolation_motion.comp.spv",
+                                                                   pipelineLayoutInterpolation, &motionSpecialization);
+        pipelineInterpolationWarp =
+            utils::CreateComputePipeline(ctx, "shaders/interpolation_warp.comp.spv", pipelineLayoutInterpolation);
+        pipelineInterpolationFill =
+            utils::CreateComputePipeline(ctx, "shaders/interpolation_fill.comp.spv", pipelineLayoutInterpolation);
+
+        PipelineConfig configDisplayCopy{};
+        configDisplayCopy.vertShaderPath = "shaders/fullscreen.vert.spv";
+        configDisplayCopy.fragShaderPath = "shaders/display_copy.frag.spv";
+        configDisplayCopy.renderPass = renderPassFinal;
+        configDisplayCopy.pipelineLayout = pipelineLayoutPyramid;
+        configDisplayCopy.colorAttachmentCount = 1;
+        configDisplayCopy.hasDepthAttachment = false;
+        pipelineDisplayCopy = utils::CreatePipeline(ctx, configDisplayCopy);
+    }
+
+    if (useGpuCulling)
+    {
+        const char* cullShaderPath = useInstanceAddress ? "shaders/cull_address.comp.spv" : "shaders/cull.comp.spv";
+        pipelineCull = utils::CreateComputePipeline(ctx, cullShaderPath, pipelineLayoutCull);
+
+        // Second pass: the instances the first found occluded, against this frame's depth pyramid
+        VkBool32 occlusionRetest = VK_TRUE;
+        VkSpecializationMapEntry retestEntry{0, 0, sizeof(VkBool32)};
+        VkSpecializationInfo retestSpecialization{};
+        retestSpecialization.mapEntryCount = 1;
+        retestSpecialization.pMapEntries = &retestEntry;
+        retestSpecialization.dataSize = sizeof(occlusionRetest);
+        retestSpecialization.pData = &occlusionRetest;
+        pipelineCullRetest =
+            utils::CreateComputePipeline(ctx, cullShaderPath, pipelineLayoutCull, &retestSpecialization);
+        pipelineHiZBuild = utils::CreateComputePipeline(ctx, "shaders/hiz_build.comp.spv", pipelineLayoutHiZ);
+    }
 }
 
-void MotionBlurExample::CreateFramebuffers()
+void MotionBlurExample::CreateSwapChainFramebuffers()
 {
     VkDevice device = ctx.GetDevice();
     VkExtent2D extent = ctx.GetSwapChainExtent();
@@ -709,10 +1841,21 @@ void MotionBlurExample::CreateFramebuffers()
             throw std::runtime_error("Failed to create swapchain framebuffer!");
         }
     }
+}
+
+void MotionBlurExample::CreateRenderTargetFramebuffers()
+{
+    VkDevice device = ctx.GetDevice();
+    VkExtent2D extent = renderTargetExtent;
 
     // G-Buffer framebuffer
     {
-        std::array<VkImageView, 3> attachments = {rtSceneColor.view, rtVelocity.view, rtDepth.view};
+        std::vector<VkImageView> attachments = {rtSceneColor.view};
+        if (rtVelocity.view != VK_NULL_HANDLE)
+        {
+            attachments.push_back(rtVelocity.view);
+        }
+        attachments.push_back(rtDepth.view);
 
         VkFramebufferCreateInfo framebufferInfo{};
         framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
@@ -785,6 +1928,46 @@ void MotionBlurExample::CreateFramebuffers()
             throw std::runtime_error("Failed to create blur horizontal framebuffer!");
         }
     }
+
+    // Pyramid framebuffers, one per mip
+    for (uint32_t level = 0; level < pyramidMipLevels; level++)
+    {
+        VkExtent2D levelSize = GetPyramidLevelSize(level);
+
+        VkFramebufferCreateInfo framebufferInfo{};
+        framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        framebufferInfo.renderPass = renderPassPyramid;
+        framebufferInfo.attachmentCount = 1;
+        framebufferInfo.pAttachments = &pyramidViews[level];
+        framebufferInfo.width = levelSize.width;
+        framebufferInfo.height = levelSize.height;
+        framebufferInfo.layers = 1;
+
+        VkFramebuffer framebuffer;
+        if (vkCreateFramebuffer(device, &framebufferInfo, nullptr, &framebuffer) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create pyramid blur framebuffer!");
+        }
+        fbPyramid.push_back(framebuffer);
+    }
+
+    // Display framebuffers (frame interpolation only)
+    for (uint32_t i = 0; i < 2 && useFrameInterpolation; i++)
+    {
+        VkFramebufferCreateInfo framebufferInfo{};
+        framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        framebufferInfo.renderPass = renderPassDisplay;
+        framebufferInfo.attachmentCount = 1;
+        framebufferInfo.pAttachments = &rtDisplay[i].view;
+        framebufferInfo.width = extent.width;
+        framebufferInfo.height = extent.height;
+        framebufferInfo.layers = 1;
+
+        if (vkCreateFramebuffer(device, &framebufferInfo, nullptr, &fbDisplay[i]) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create display framebuffer!");
+        }
+    }
 }
 
 void MotionBlurExample::CleanupFramebuffers()
@@ -817,491 +2000,1715 @@ void MotionBlurExample::CleanupFramebuffers()
         vkDestroyFramebuffer(device, fbBlurHorizontal, nullptr);
         fbBlurHorizontal = VK_NULL_HANDLE;
     }
+    for (auto framebuffer : fbPyramid)
+    {
+        vkDestroyFramebuffer(device, framebuffer, nullptr);
+    }
+    fbPyramid.clear();
+    for (VkFramebuffer& framebuffer : fbDisplay)
+    {
+        if (framebuffer != VK_NULL_HANDLE)
+        {
+            vkDestroyFramebuffer(device, framebuffer, nullptr);
+            framebuffer = VK_NULL_HANDLE;
+        }
+    }
 }
 
-void MotionBlurExample::CreateTriangleVertexBuffer()
+void MotionBlurExample::CreateMeshBuffers()
 {
-    VkDeviceSize bufferSize = sizeof(triangleVertices[0]) * triangleVertices.size();
-
-    VkBuffer stagingBuffer;
-    VkDeviceMemory stagingBufferMemory;
-    ctx.CreateBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer,
-                     stagingBufferMemory);
-
-    void* data;
-    vkMapMemory(ctx.GetDevice(), stagingBufferMemory, 0, bufferSize, 0, &data);
-    memcpy(data, triangleVertices.data(), static_cast<size_t>(bufferSize));
-    vkUnmapMemory(ctx.GetDevice(), stagingBufferMemory);
+    if (!settings.meshPath.empty())
+    {
+        LoadMeshFile(settings.meshPath);
+        return;
+    }
 
-    ctx.CreateBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, triangleVertexBuffer, triangleVertexBufferMemory);
+    std::vector<TriangleVertex> vertices = triangleVertices;
+    vertices.insert(vertices.end(), cubeVertices.begin(), cubeVertices.end());
+    std::vector<uint32_t> indices = triangleIndices;
+    indices.insert(indices.end(), cubeIndices.begin(), cubeIndices.end());
 
-    ctx.CopyBuffer(stagingBuffer, triangleVertexBuffer, bufferSize);
+    auto setBounds = [](MeshRange& mesh, const std::vector<TriangleVertex>& meshVertices)
+    {
+        glm::vec3 boundsMin(INFINITY);
+        glm::vec3 boundsMax(-INFINITY);
+        for (const TriangleVertex& vertex : meshVertices)
+        {
+            boundsMin = glm::min(boundsMin, vertex.position);
+            boundsMax = glm::max(boundsMax, vertex.position);
+        }
+        mesh.boundsCenter = 0.5f * (boundsMin + boundsMax);
+        mesh.boundsExtent = 0.5f * (boundsMax - boundsMin);
+    };
 
-    vkDestroyBuffer(ctx.GetDevice(), stagingBuffer, nullptr);
-    vkFreeMemory(ctx.GetDevice(), stagingBufferMemory, nullptr);
+    MeshRange triangle;
+    triangle.indexCount = static_cast<uint32_t>(triangleIndices.size());
+    triangle.vertexCount = static_cast<uint32_t>(triangleVertices.size());
+    triangle.boundingRadius = TRIANGLE_BOUNDING_RADIUS;
+    setBounds(triangle, triangleVertices);
+
+    MeshRange cube;
+    cube.firstIndex = static_cast<uint32_t>(triangleIndices.size());
+    cube.indexCount = static_cast<uint32_t>(cubeIndices.size());
+    cube.vertexOffset = static_cast<int32_t>(triangleVertices.size());
+    cube.vertexCount = static_cast<uint32_t>(cubeVertices.size());
+    cube.boundingRadius = CUBE_BOUNDING_RADIUS;
+    setBounds(cube, cubeVertices);
+
+    sceneMesh = settings.instanceCount > 0 ? cube : triangle;
+
+    // With vertex pulling the float vertices are only read once, by the packing pass
+    VkBufferUsageFlags vertexUsage =
+        useVertexPulling ? VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT : VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+    VkDeviceSize vertexSize = sizeof(vertices[0]) * vertices.size();
+    VkDeviceSize indexSize = sizeof(indices[0]) * indices.size();
+    ctx.CreateBuffer(vertexSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | vertexUsage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                     meshVertexBuffer, meshVertexBufferMemory);
+    ctx.CreateBuffer(indexSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, meshIndexBuffer, meshIndexBufferMemory);
+
+    StagingRing staging;
+    staging.Initialize(ctx, vertexSize + indexSize, 1);
+    staging.Upload(meshVertexBuffer, 0, vertices.data(), vertexSize);
+    staging.Upload(meshIndexBuffer, 0, indices.data(), indexSize);
+    staging.Cleanup();
+
+    if (useVertexPulling)
+    {
+        PackMeshVertices({triangle, cube}, vertices.size());
+    }
 }
 
-void MotionBlurExample::CreateUniformBuffers()
+void MotionBlurExample::LoadMeshFile(const std::string& path)
 {
-    VkDeviceSize mvpBufferSize = sizeof(MotionBlurMVPUBO);
-    VkDeviceSize postProcessBufferSize = sizeof(MotionBlurPostProcessParams);
-
-    mvpUniformBuffers.resize(VulkanContext::MAX_FRAMES_IN_FLIGHT);
-    mvpUniformBuffersMemory.resize(VulkanContext::MAX_FRAMES_IN_FLIGHT);
-    mvpUniformBuffersMapped.resize(VulkanContext::MAX_FRAMES_IN_FLIGHT);
-    postProcessUniformBuffers.resize(VulkanContext::MAX_FRAMES_IN_FLIGHT);
-    postProcessUniformBuffersMemory.resize(VulkanContext::MAX_FRAMES_IN_FLIGHT);
-    postProcessUniformBuffersMapped.resize(VulkanContext::MAX_FRAMES_IN_FLIGHT);
+    auto start = std::chrono::steady_clock::now();
 
-    for (size_t i = 0; i < VulkanContext::MAX_FRAMES_IN_FLIGHT; i++)
+    MeshFile file;
+    file.Open(path);
+    if (file.GetMeshCount() == 0 || file.GetMesh(0).indexCount == 0)
     {
-        ctx.CreateBuffer(mvpBufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                         mvpUniformBuffers[i], mvpUniformBuffersMemory[i]);
-        vkMapMemory(ctx.GetDevice(), mvpUniformBuffersMemory[i], 0, mvpBufferSize, 0, &mvpUniformBuffersMapped[i]);
+        throw std::runtime_error("Mesh file has no drawable mesh: " + path);
+    }
 
-        ctx.CreateBuffer(postProcessBufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                         postProcessUniformBuffers[i], postProcessUniformBuffersMemory[i]);
-        vkMapMemory(ctx.GetDevice(), postProcessUniformBuffersMemory[i], 0, postProcessBufferSize, 0,
-                    &postProcessUniformBuffersMapped[i]);
+    std::vector<MeshRange> meshes(file.GetMeshCount());
+    for (uint32_t i = 0; i < file.GetMeshCount(); i++)
+    {
+        const MeshFileMesh& mesh = file.GetMesh(i);
+        glm::vec3 boundsMin(mesh.boundsMin[0], mesh.boundsMin[1], mesh.boundsMin[2]);
+        glm::vec3 boundsMax(mesh.boundsMax[0], mesh.boundsMax[1], mesh.boundsMax[2]);
+        meshes[i].firstIndex = mesh.firstIndex;
+        meshes[i].indexCount = mesh.indexCount;
+        meshes[i].vertexOffset = mesh.vertexOffset;
+        meshes[i].vertexCount = mesh.vertexCount;
+        meshes[i].boundingRadius = mesh.boundingRadius;
+        meshes[i].boundsCenter = 0.5f * (boundsMin + boundsMax);
+        meshes[i].boundsExtent = 0.5f * (boundsMax - boundsMin);
     }
-}
+    sceneMesh = meshes[0];
+
+    VkBufferUsageFlags vertexUsage =
+        useVertexPulling ? VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT : VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+    VkDeviceSize vertexSize = file.GetVertexDataSize();
+    VkDeviceSize indexSize = file.GetIndexDataSize();
+    ctx.CreateBuffer(vertexSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | vertexUsage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                     meshVertexBuffer, meshVertexBufferMemory);
+    ctx.CreateBuffer(indexSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, meshIndexBuffer, meshIndexBufferMemory);
+
+    // Each blob goes from the mapping to the GPU without an intermediate copy in process memory: imported
+    // as host memory and copied by the GPU when VK_EXT_external_memory_host accepts the pages, otherwise
+    // memcpy'd chunk by chunk into the staging ring. Blobs are page aligned and padded in the file, so the
+    // import can round the size up without leaving the mapping.
+    StagingRing staging;
+    staging.Initialize(ctx);
+    bool allImported = true;
+
+    auto uploadBlob = [&](const void* data, VkDeviceSize size, VkBuffer dstBuffer)
+    {
+        VkDeviceSize alignment = ctx.GetMinImportedHostPointerAlignment();
+        if (ctx.IsExternalMemoryHostSupported() && alignment > 0)
+        {
+            VkDeviceSize importSize = (size + alignment - 1) / alignment * alignment;
+            size_t offset = static_cast<size_t>(static_cast<const uint8_t*>(data) - file.GetData());
 
-void MotionBlurExample::CreateDescriptorPool()
-{
-    std::array<VkDescriptorPoolSize, 2> poolSizes{};
-    poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    poolSizes[0].descriptorCount = static_cast<uint32_t>(VulkanContext::MAX_FRAMES_IN_FLIGHT * 5);
-    poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    poolSizes[1].descriptorCount = static_cast<uint32_t>(VulkanContext::MAX_FRAMES_IN_FLIGHT * 15);
+            VkBuffer hostBuffer;
+            VkDeviceMemory hostMemory;
+            if (offset + importSize <= file.GetSize() &&
+                ctx.ImportHostBuffer(data, importSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, hostBuffer, hostMemory))
+            {
+                ctx.CopyBuffer(hostBuffer, dstBuffer, size);
+                vkDestroyBuffer(ctx.GetDevice(), hostBuffer, nullptr);
+                vkFreeMemory(ctx.GetDevice(), hostMemory, nullptr);
+                return;
+            }
+        }
 
-    VkDescriptorPoolCreateInfo poolInfo{};
-    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
-    poolInfo.pPoolSizes = poolSizes.data();
-    poolInfo.maxSets = static_cast<uint32_t>(VulkanContext::MAX_FRAMES_IN_FLIGHT * 5);
-    poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+        allImported = false;
+        staging.Upload(dstBuffer, 0, data, size);
+    };
 
-    if (vkCreateDescriptorPool(ctx.GetDevice(), &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS)
+    uploadBlob(file.GetVertexData(), vertexSize, meshVertexBuffer);
+    uploadBlob(file.GetIndexData(), indexSize, meshIndexBuffer);
+    staging.Cleanup();
+
+    if (useVertexPulling)
     {
-        throw std::runtime_error("Failed to create descriptor pool!");
+        PackMeshVertices(meshes, file.GetHeader().vertexCount);
     }
+
+    double milliseconds =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Loaded " << path << ": " << file.GetHeader().vertexCount << " vertices, "
+              << file.GetHeader().indexCount / 3 << " triangles ("
+              << (allImported ? "host memory import" : "staging ring") << ", " << milliseconds << " ms)"
+              << std::endl;
 }
 
-void MotionBlurExample::CreateDescriptorSets()
+void MotionBlurExample::PackMeshVertices(const std::vector<MeshRange>& meshes, VkDeviceSize vertexCount)
 {
     VkDevice device = ctx.GetDevice();
 
-    // G-Buffer descriptor sets
-    {
-        std::vector<VkDescriptorSetLayout> layouts(VulkanContext::MAX_FRAMES_IN_FLIGHT, descriptorSetLayoutGBuffer);
-        VkDescriptorSetAllocateInfo allocInfo{};
-        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        allocInfo.descriptorPool = descriptorPool;
-        allocInfo.descriptorSetCount = static_cast<uint32_t>(VulkanContext::MAX_FRAMES_IN_FLIGHT);
-        allocInfo.pSetLayouts = layouts.data();
+    // Two 32-bit words per vertex (shaders/include/packed_vertex.glsl)
+    VkBuffer packedBuffer;
+    VkDeviceMemory packedMemory;
+    ctx.CreateBuffer(vertexCount * 2 * sizeof(uint32_t), VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, packedBuffer, packedMemory);
 
-        descriptorSetsGBuffer.resize(VulkanContext::MAX_FRAMES_IN_FLIGHT);
-        if (vkAllocateDescriptorSets(device, &allocInfo, descriptorSetsGBuffer.data()) != VK_SUCCESS)
-        {
-            throw std::runtime_error("Failed to allocate G-Buffer descriptor sets!");
-        }
+    VkPushConstantRange pushConstantRange{};
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    pushConstantRange.offset = 0;
+    pushConstantRange.size = sizeof(VertexPackParams);
 
-        for (size_t i = 0; i < VulkanContext::MAX_FRAMES_IN_FLIGHT; i++)
-        {
-            VkDescriptorBufferInfo bufferInfo{};
-            bufferInfo.buffer = mvpUniformBuffers[i];
-            bufferInfo.offset = 0;
-            bufferInfo.range = sizeof(MotionBlurMVPUBO);
-
-            VkWriteDescriptorSet descriptorWrite{};
-            descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            descriptorWrite.dstSet = descriptorSetsGBuffer[i];
-            descriptorWrite.dstBinding = 0;
-            descriptorWrite.dstArrayElement = 0;
-            descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-            descriptorWrite.descriptorCount = 1;
-            descriptorWrite.pBufferInfo = &bufferInfo;
+    VkPipelineLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layoutInfo.pushConstantRangeCount = 1;
+    layoutInfo.pPushConstantRanges = &pushConstantRange;
 
-            vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
-        }
+    VkPipelineLayout packLayout;
+    if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &packLayout) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create vertex packing pipeline layout!");
     }
+    VkPipeline packPipeline = utils::CreateComputePipeline(ctx, "shaders/vertex_pack.comp.spv", packLayout);
 
-    // Motion Apply descriptor sets
-    {
-        std::vector<VkDescriptorSetLayout> layouts(VulkanContext::MAX_FRAMES_IN_FLIGHT, descriptorSetLayoutPostProcess);
-        VkDescriptorSetAllocateInfo allocInfo{};
-        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        allocInfo.descriptorPool = descriptorPool;
-        allocInfo.descriptorSetCount = static_cast<uint32_t>(VulkanContext::MAX_FRAMES_IN_FLIGHT);
-        allocInfo.pSetLayouts = layouts.data();
+    VertexPackParams params{};
+    params.source = ctx.GetBufferDeviceAddress(meshVertexBuffer);
+    params.destination = ctx.GetBufferDeviceAddress(packedBuffer);
+
+    uint32_t maxGroups = std::min(ctx.GetPhysicalDeviceProperties().limits.maxComputeWorkGroupCount[0], 65535u);
+    uint32_t maxBatch = maxGroups * VERTEX_PACK_WORKGROUP_SIZE;
 
-        descriptorSetsMotionApply.resize(VulkanContext::MAX_FRAMES_IN_FLIGHT);
-        if (vkAllocateDescriptorSets(device, &allocInfo, descriptorSetsMotionApply.data()) != VK_SUCCESS)
+    VkCommandBuffer cmd = ctx.BeginSingleTimeCommands();
+
+    // The uploads were submitted to this queue before
+    utils::GlobalBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, packPipeline);
+
+    for (const MeshRange& mesh : meshes)
+    {
+        params.center = glm::vec4(mesh.boundsCenter, 0.0f);
+        for (int axis = 0; axis < 3; axis++)
         {
-            throw std::runtime_error("Failed to allocate motion apply descriptor sets!");
+            params.inverseExtent[axis] = mesh.boundsExtent[axis] > 0.0f ? 1.0f / mesh.boundsExtent[axis] : 0.0f;
         }
 
-        for (size_t i = 0; i < VulkanContext::MAX_FRAMES_IN_FLIGHT; i++)
+        for (uint32_t done = 0; done < mesh.vertexCount; done += maxBatch)
         {
-            std::array<VkDescriptorImageInfo, 3> imageInfos{};
-            imageInfos[0].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            imageInfos[0].imageView = rtSceneColor.view;
-            imageInfos[0].sampler = samplerLinear;
+            params.firstVertex = static_cast<uint32_t>(mesh.vertexOffset) + done;
+            params.vertexCount = std::min(maxBatch, mesh.vertexCount - done);
+            vkCmdPushConstants(cmd, packLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(params), &params);
+            vkCmdDispatch(cmd, (params.vertexCount + VERTEX_PACK_WORKGROUP_SIZE - 1) / VERTEX_PACK_WORKGROUP_SIZE,
+                          1, 1);
+        }
+    }
+
+    utils::GlobalBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+                         VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    ctx.EndSingleTimeCommands(cmd);
 
-            imageInfos[1].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            imageInfos[1].imageView = rtVelocity.view;
-            imageInfos[1].sampler = samplerLinear;
+    vkDestroyPipeline(device, packPipeline, nullptr);
+    vkDestroyPipelineLayout(device, packLayout, nullptr);
 
-            imageInfos[2].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            imageInfos[2].imageView = rtDepth.view;
-            imageInfos[2].sampler = samplerNearest;
+    // The float vertices are not needed once packed
+    vkDestroyBuffer(device, meshVertexBuffer, nullptr);
+    vkFreeMemory(device, meshVertexBufferMemory, nullptr);
+    meshVertexBuffer = packedBuffer;
+    meshVertexBufferMemory = packedMemory;
+    meshVertexAddress = params.destination;
+}
 
-            VkDescriptorBufferInfo bufferInfo{};
-            bufferInfo.buffer = postProcessUniformBuffers[i];
-            bufferInfo.offset = 0;
-            bufferInfo.range = sizeof(MotionBlurPostProcessParams);
+void MotionBlurExample::CreateInstanceBuffer()
+{
+    const VkPhysicalDeviceLimits& limits = ctx.GetPhysicalDeviceProperties().limits;
 
-            std::array<VkWriteDescriptorSet, 4> descriptorWrites{};
-            for (int j = 0; j < 3; j++)
+    if (settings.instanceCount > 0)
+    {
+        // Without addresses one frame's slice is bound as a single storage buffer range
+        uint32_t maxInstances = useInstanceAddress
+                                    ? InstanceScene::MAX_INSTANCES
+                                    : static_cast<uint32_t>(limits.maxStorageBufferRange / sizeof(cpu::InstanceMvp));
+        instanceScene.Initialize(std::min(settings.instanceCount, maxInstances));
+        if (instanceScene.GetInstanceCount() < settings.instanceCount)
+        {
+            std::cout << "Instance count limited to " << instanceScene.GetInstanceCount();
+            if (!useInstanceAddress)
             {
-                descriptorWrites[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-                descriptorWrites[j].dstSet = descriptorSetsMotionApply[i];
-                descriptorWrites[j].dstBinding = j;
-                descriptorWrites[j].dstArrayElement = 0;
-                descriptorWrites[j].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-                descriptorWrites[j].descriptorCount = 1;
-                descriptorWrites[j].pImageInfo = &imageInfos[j];
+                std::cout << " by maxStorageBufferRange (buffer device addresses are unsupported)";
             }
+            std::cout << std::endl;
+        }
+        std::cout << "Stress scene: " << instanceScene.GetInstanceCount() << " instances ("
+                  << instanceScene.GetStaticInstanceCount() << " static)" << std::endl;
+    }
+    else
+    {
+        instanceScene.InitializeSingle(glm::radians(TRIANGLE_SPIN_RATE));
+    }
+    instanceCount = instanceScene.GetInstanceCount();
+    staticInstanceCount = instanceScene.GetStaticInstanceCount();
+    std::cout << "Instance transforms: " << cpu::GetSimdLevelName(instanceScene.GetSimdLevel()) << std::endl;
+
+    // Slices start on 16-byte boundaries at least, as the kernels' streaming stores require
+    VkDeviceSize alignment = std::max<VkDeviceSize>(limits.minStorageBufferOffsetAlignment, 16);
+    instanceSliceSize = (sizeof(cpu::InstanceMvp) * instanceCount + alignment - 1) & ~(alignment - 1);
+
+    VkDeviceSize totalSize = instanceSliceSize * VulkanContext::MAX_FRAMES_IN_FLIGHT;
+    VkBufferUsageFlags usage =
+        useInstanceAddress ? VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT : VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    ctx.CreateBuffer(totalSize, usage, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                     instanceBuffer, instanceBufferMemory);
+    if (useInstanceAddress)
+    {
+        instanceBufferAddress = ctx.GetBufferDeviceAddress(instanceBuffer);
+    }
 
-            descriptorWrites[3].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            descriptorWrites[3].dstSet = descriptorSetsMotionApply[i];
-            descriptorWrites[3].dstBinding = 3;
-            descriptorWrites[3].dstArrayElement = 0;
-            descriptorWrites[3].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-            descriptorWrites[3].descriptorCount = 1;
-            descriptorWrites[3].pBufferInfo = &bufferInfo;
+    void* data;
+    vkMapMemory(ctx.GetDevice(), instanceBufferMemory, 0, totalSize, 0, &data);
+    instanceBufferMapped = static_cast<uint8_t*>(data);
+}
 
-            vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0,
-                                   nullptr);
-        }
+void MotionBlurExample::CreateCullingBuffers()
+{
+    // Commands and counts of both culling passes
+    ctx.CreateBuffer(2 * sizeof(VkDrawIndexedIndirectCommand) * instanceCount,
+                     VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, drawCommandBuffer, drawCommandBufferMemory);
+    ctx.CreateBuffer(4 * sizeof(uint32_t),
+                     VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                         VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, drawCountBuffer, drawCountBufferMemory);
+    // Indirect dispatch header and instance indices
+    ctx.CreateBuffer(sizeof(VkDispatchIndirectCommand) + sizeof(uint32_t) * (1 + instanceCount),
+                     VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                         VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, occlusionRetestBuffer, occlusionRetestBufferMemory);
+}
+
+void MotionBlurExample::WriteInstanceTransforms(uint32_t frameIndex)
+{
+    auto* instances = reinterpret_cast<cpu::InstanceMvp*>(instanceBufferMapped + instanceSliceSize * frameIndex);
+    instanceScene.WriteTransforms(ctx.GetJobSystem(), instances, currViewProjection, prevViewProjection, totalTime,
+                                  previousTime, sceneMesh.boundingRadius);
+}
+
+void MotionBlurExample::CreateUniformAllocator()
+{
+    uniformAllocator.Initialize(ctx, UNIFORM_BYTES_PER_FRAME);
+}
+
+void MotionBlurExample::CreateDescriptorPool()
+{
+    // Pyramid sets: rtMotion, one per mip and the final pass variant (two samplers)
+    const uint32_t pyramidSets = 2 + MAX_PYRAMID_LEVELS;
+    // Culling sets: the culling pass and one depth pyramid build per mip (a sampler and a storage image,
+    // in the recursive blur layout, which has a second one)
+    const uint32_t cullSets = 1 + MAX_HIZ_LEVELS;
+    // Temporal blur reuse sets, one per output pair: six samplers, two storage images and the tile list;
+    // and the final pass set reading rtBlurAlternate
+    const uint32_t temporalSets = 2;
+    // Frame interpolation sets: eight samplers and three storage images per display target, and the
+    // swapchain copies (one sampler)
+    const uint32_t interpolationSets = 2;
+    const uint32_t displayCopySets = 3;
+
+    std::array<VkDescriptorPoolSize, 5> poolSizes{};
+    poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    poolSizes[0].descriptorCount = 1;
+    poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    poolSizes[1].descriptorCount =
+        13 + pyramidSets + 1 + cullSets + 6 * temporalSets + 2 + 8 * interpolationSets + displayCopySets;
+    poolSizes[2].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    poolSizes[2].descriptorCount = 2 * (2 + MAX_HIZ_LEVELS) + 2 * temporalSets + 3 * interpolationSets;
+    poolSizes[3].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+    poolSizes[3].descriptorCount = 2;
+    poolSizes[4].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    poolSizes[4].descriptorCount = 3 + temporalSets;
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    poolInfo.pPoolSizes = poolSizes.data();
+    poolInfo.maxSets = 7 + pyramidSets + cullSets + temporalSets + 1 + interpolationSets + displayCopySets;
+    poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+
+    if (vkCreateDescriptorPool(ctx.GetDevice(), &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create descriptor pool!");
     }
+}
 
-    // Blur Vertical descriptor sets
+void MotionBlurExample::CreateDescriptorSets()
+{
+    VkDevice device = ctx.GetDevice();
+
+    auto allocateSet = [&](VkDescriptorSetLayout layout, VkDescriptorSet& set, const char* errorMessage)
     {
-        std::vector<VkDescriptorSetLayout> layouts(VulkanContext::MAX_FRAMES_IN_FLIGHT, descriptorSetLayoutPostProcess);
         VkDescriptorSetAllocateInfo allocInfo{};
         allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
         allocInfo.descriptorPool = descriptorPool;
-        allocInfo.descriptorSetCount = static_cast<uint32_t>(VulkanContext::MAX_FRAMES_IN_FLIGHT);
-        allocInfo.pSetLayouts = layouts.data();
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &layout;
 
-        descriptorSetsBlurVertical.resize(VulkanContext::MAX_FRAMES_IN_FLIGHT);
-        if (vkAllocateDescriptorSets(device, &allocInfo, descriptorSetsBlurVertical.data()) != VK_SUCCESS)
+        if (vkAllocateDescriptorSets(device, &allocInfo, &set) != VK_SUCCESS)
         {
-            throw std::runtime_error("Failed to allocate blur vertical descriptor sets!");
+            throw std::runtime_error(errorMessage);
         }
+    };
+
+    // G-Buffer descriptor set, unless the instances are read by address
+    if (!useInstanceAddress)
+    {
+        allocateSet(descriptorSetLayoutGBuffer, descriptorSetGBuffer, "Failed to allocate G-Buffer descriptor set!");
+
+        // One frame's slice; the dynamic offset selects the frame
+        VkDescriptorBufferInfo instanceInfo{};
+        instanceInfo.buffer = instanceBuffer;
+        instanceInfo.offset = 0;
+        instanceInfo.range = sizeof(cpu::InstanceMvp) * instanceCount;
+
+        VkWriteDescriptorSet descriptorWrite{};
+        descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrite.dstSet = descriptorSetGBuffer;
+        descriptorWrite.dstBinding = 0;
+        descriptorWrite.dstArrayElement = 0;
+        descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+        descriptorWrite.descriptorCount = 1;
+        descriptorWrite.pBufferInfo = &instanceInfo;
+
+        vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
+    }
 
-        for (size_t i = 0; i < VulkanContext::MAX_FRAMES_IN_FLIGHT; i++)
+    // Recursive blur descriptor sets: the vertical scan reads the motion result, the horizontal scan
+    // reads the vertical result. Outputs and the causal scratch are written in the GENERAL layout; the
+    // depth pyramid sets share the layout but have no scratch.
+    auto writeIirBlurSet = [&](VkDescriptorSet set, VkImageView inputView, VkImageView outputView,
+                               VkImageLayout inputLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                               VkImageView scratchView = VK_NULL_HANDLE)
+    {
+        std::array<VkDescriptorImageInfo, 3> imageInfos{};
+        imageInfos[0].imageLayout = inputLayout;
+        imageInfos[0].imageView = inputView;
+        imageInfos[0].sampler = samplerNearest;
+
+        imageInfos[1].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+        imageInfos[1].imageView = outputView;
+
+        imageInfos[2].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+        imageInfos[2].imageView = scratchView;
+
+        uint32_t writeCount = scratchView != VK_NULL_HANDLE ? 3 : 2;
+        std::array<VkWriteDescriptorSet, 3> descriptorWrites{};
+        for (uint32_t j = 0; j < writeCount; j++)
         {
-            std::array<VkDescriptorImageInfo, 3> imageInfos{};
-            imageInfos[0].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            imageInfos[0].imageView = rtMotion.view;
-            imageInfos[0].sampler = samplerLinear;
+            descriptorWrites[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            descriptorWrites[j].dstSet = set;
+            descriptorWrites[j].dstBinding = j;
+            descriptorWrites[j].dstArrayElement = 0;
+            descriptorWrites[j].descriptorCount = 1;
+            descriptorWrites[j].pImageInfo = &imageInfos[j];
+        }
+        descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        descriptorWrites[2].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
 
-            imageInfos[1].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            imageInfos[1].imageView = rtVelocity.view;
-            imageInfos[1].sampler = samplerLinear;
+        vkUpdateDescriptorSets(device, writeCount, descriptorWrites.data(), 0, nullptr);
+    };
 
-            imageInfos[2].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            imageInfos[2].imageView = rtDepth.view;
-            imageInfos[2].sampler = samplerNearest;
+    allocateSet(descriptorSetLayoutIirBlur, descriptorSetIirBlurVertical,
+                "Failed to allocate recursive blur vertical descriptor set!");
+    writeIirBlurSet(descriptorSetIirBlurVertical, rtMotion.view, rtBlurIntermediate.view,
+                    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, rtIirCausal.view);
 
-            VkDescriptorBufferInfo bufferInfo{};
-            bufferInfo.buffer = postProcessUniformBuffers[i];
-            bufferInfo.offset = 0;
-            bufferInfo.range = sizeof(MotionBlurPostProcessParams);
+    allocateSet(descriptorSetLayoutIirBlur, descriptorSetIirBlurHorizontal,
+                "Failed to allocate recursive blur horizontal descriptor set!");
+    writeIirBlurSet(descriptorSetIirBlurHorizontal, rtBlurIntermediate.view, rtBlurFinal.view,
+                    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, rtIirCausal.view);
 
-            std::array<VkWriteDescriptorSet, 4> descriptorWrites{};
-            for (int j = 0; j < 3; j++)
+    // Pyramid blur descriptor sets: the first downsample reads rtMotion, every other pass one mip
+    auto writePyramidSet = [&](VkDescriptorSet set, VkImageView sourceView)
+    {
+        VkDescriptorImageInfo imageInfo{};
+        imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        imageInfo.imageView = sourceView;
+        imageInfo.sampler = samplerLinear;
+
+        VkWriteDescriptorSet descriptorWrite{};
+        descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrite.dstSet = set;
+        descriptorWrite.dstBinding = 0;
+        descriptorWrite.dstArrayElement = 0;
+        descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        descriptorWrite.descriptorCount = 1;
+        descriptorWrite.pImageInfo = &imageInfo;
+
+        vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
+    };
+
+    allocateSet(descriptorSetLayoutPyramid, descriptorSetPyramidMotion, "Failed to allocate pyramid descriptor set!");
+    writePyramidSet(descriptorSetPyramidMotion, rtMotion.view);
+
+    descriptorSetsPyramid.resize(pyramidMipLevels);
+    for (uint32_t level = 0; level < pyramidMipLevels; level++)
+    {
+        allocateSet(descriptorSetLayoutPyramid, descriptorSetsPyramid[level],
+                    "Failed to allocate pyramid descriptor set!");
+        writePyramidSet(descriptorSetsPyramid[level], pyramidViews[level]);
+    }
+
+    // Frame interpolation descriptor sets, in both modes. Set i serves the frame displayed from rtDisplay[i]:
+    // it writes that frame's motion and reads the other display target and motion as the previous frame.
+    // Displayed colors are filtered, everything else fetched; the compute-written targets stay GENERAL.
+    if (useFrameInterpolation)
+    {
+        for (uint32_t i = 0; i < 2; i++)
+        {
+            allocateSet(descriptorSetLayoutInterpolation, descriptorSetsInterpolation[i],
+                        "Failed to allocate frame interpolation descriptor set!");
+
+            const std::array<VkImageView, 11> views = {rtSceneColor.view,
+                                                       GetVelocityView(),
+                                                       rtDepth.view,
+                                                       rtDisplay[1 - i].view,
+                                                       rtDisplay[i].view,
+                                                       rtInterpolationMotion[1 - i].view,
+                                                       rtInterpolationMotion[i].view,
+                                                       rtInterpolationMotion[i].view,
+                                                       rtInterpolationWarp.view,
+                                                       rtInterpolationWarp.view,
+                                                       rtInterpolated.view};
+            std::array<VkDescriptorImageInfo, 11> imageInfos{};
+            std::array<VkWriteDescriptorSet, 11> descriptorWrites{};
+            for (uint32_t j = 0; j < descriptorWrites.size(); j++)
             {
+                bool storage = j == 7 || j == 9 || j == 10;
+                bool display = j == 3 || j == 4;
+                imageInfos[j].imageView = views[j];
+                imageInfos[j].imageLayout = j < 5 ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_GENERAL;
+                imageInfos[j].sampler = storage ? VK_NULL_HANDLE : display ? samplerLinear : samplerNearest;
+
                 descriptorWrites[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-                descriptorWrites[j].dstSet = descriptorSetsBlurVertical[i];
+                descriptorWrites[j].dstSet = descriptorSetsInterpolation[i];
                 descriptorWrites[j].dstBinding = j;
                 descriptorWrites[j].dstArrayElement = 0;
-                descriptorWrites[j].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                descriptorWrites[j].descriptorType =
+                    storage ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
                 descriptorWrites[j].descriptorCount = 1;
                 descriptorWrites[j].pImageInfo = &imageInfos[j];
             }
 
-            descriptorWrites[3].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            descriptorWrites[3].dstSet = descriptorSetsBlurVertical[i];
-            descriptorWrites[3].dstBinding = 3;
-            descriptorWrites[3].dstArrayElement = 0;
-            descriptorWrites[3].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-            descriptorWrites[3].descriptorCount = 1;
-            descriptorWrites[3].pBufferInfo = &bufferInfo;
+            vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(),
+                                   0, nullptr);
+        }
 
-            vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0,
-                                   nullptr);
+        const std::array<VkImageView, 3> copySources = {rtDisplay[0].view, rtDisplay[1].view, rtInterpolated.view};
+        for (uint32_t i = 0; i < copySources.size(); i++)
+        {
+            allocateSet(descriptorSetLayoutPyramid, descriptorSetsDisplayCopy[i],
+                        "Failed to allocate display copy descriptor set!");
+            writePyramidSet(descriptorSetsDisplayCopy[i], copySources[i]);
         }
     }
 
-    // Blur Horizontal descriptor sets
+    if (useBindless)
+        return;
+
+    // Post-process descriptor sets (input texture, velocity, depth)
+    auto writePostProcessSet = [&](VkDescriptorSet set, VkImageView inputView)
     {
-        std::vector<VkDescriptorSetLayout> layouts(VulkanContext::MAX_FRAMES_IN_FLIGHT, descriptorSetLayoutPostProcess);
-        VkDescriptorSetAllocateInfo allocInfo{};
-        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        allocInfo.descriptorPool = descriptorPool;
-        allocInfo.descriptorSetCount = static_cast<uint32_t>(VulkanContext::MAX_FRAMES_IN_FLIGHT);
-        allocInfo.pSetLayouts = layouts.data();
+        std::array<VkDescriptorImageInfo, 3> imageInfos{};
+        imageInfos[0].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        imageInfos[0].imageView = inputView;
+        imageInfos[0].sampler = samplerLinear;
+
+        imageInfos[1].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        imageInfos[1].imageView = GetVelocityView();
+        imageInfos[1].sampler = samplerLinear;
+
+        imageInfos[2].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        imageInfos[2].imageView = rtDepth.view;
+        imageInfos[2].sampler = samplerNearest;
 
-        descriptorSetsBlurHorizontal.resize(VulkanContext::MAX_FRAMES_IN_FLIGHT);
-        if (vkAllocateDescriptorSets(device, &allocInfo, descriptorSetsBlurHorizontal.data()) != VK_SUCCESS)
+        std::array<VkWriteDescriptorSet, 3> descriptorWrites{};
+        for (int j = 0; j < 3; j++)
         {
-            throw std::runtime_error("Failed to allocate blur horizontal descriptor sets!");
+            descriptorWrites[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            descriptorWrites[j].dstSet = set;
+            descriptorWrites[j].dstBinding = j;
+            descriptorWrites[j].dstArrayElement = 0;
+            descriptorWrites[j].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            descriptorWrites[j].descriptorCount = 1;
+            descriptorWrites[j].pImageInfo = &imageInfos[j];
         }
 
-        for (size_t i = 0; i < VulkanContext::MAX_FRAMES_IN_FLIGHT; i++)
-        {
-            std::array<VkDescriptorImageInfo, 3> imageInfos{};
-            imageInfos[0].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            imageInfos[0].imageView = rtBlurIntermediate.view;
-            imageInfos[0].sampler = samplerLinear;
+        vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0,
+                               nullptr);
+    };
 
-            imageInfos[1].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            imageInfos[1].imageView = rtVelocity.view;
-            imageInfos[1].sampler = samplerLinear;
+    allocateSet(descriptorSetLayoutPostProcess, descriptorSetMotionApply,
+                "Failed to allocate motion apply descriptor set!");
+    writePostProcessSet(descriptorSetMotionApply, rtSceneColor.view);
 
-            imageInfos[2].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            imageInfos[2].imageView = rtDepth.view;
-            imageInfos[2].sampler = samplerNearest;
+    allocateSet(descriptorSetLayoutPostProcess, descriptorSetBlurVertical,
+                "Failed to allocate blur vertical descriptor set!");
+    writePostProcessSet(descriptorSetBlurVertical, rtMotion.view);
 
-            VkDescriptorBufferInfo bufferInfo{};
-            bufferInfo.buffer = postProcessUniformBuffers[i];
-            bufferInfo.offset = 0;
-            bufferInfo.range = sizeof(MotionBlurPostProcessParams);
+    allocateSet(descriptorSetLayoutPostProcess, descriptorSetBlurHorizontal,
+                "Failed to allocate blur horizontal descriptor set!");
+    writePostProcessSet(descriptorSetBlurHorizontal, rtBlurIntermediate.view);
 
-            std::array<VkWriteDescriptorSet, 4> descriptorWrites{};
-            for (int j = 0; j < 3; j++)
-            {
-                descriptorWrites[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-                descriptorWrites[j].dstSet = descriptorSetsBlurHorizontal[i];
-                descriptorWrites[j].dstBinding = j;
-                descriptorWrites[j].dstArrayElement = 0;
-                descriptorWrites[j].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-                descriptorWrites[j].descriptorCount = 1;
-                descriptorWrites[j].pImageInfo = &imageInfos[j];
-            }
+    // Final pass descriptor sets (motion result and blur result; the pyramid variant reads mip 0)
+    auto writeFinalSet = [&](VkDescriptorSet set, VkImageView blurView)
+    {
+        std::array<VkDescriptorImageInfo, 2> imageInfos{};
+        imageInfos[0].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        imageInfos[0].imageView = rtMotion.view;
+        imageInfos[0].sampler = samplerLinear;
 
-            descriptorWrites[3].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            descriptorWrites[3].dstSet = descriptorSetsBlurHorizontal[i];
-            descriptorWrites[3].dstBinding = 3;
-            descriptorWrites[3].dstArrayElement = 0;
-            descriptorWrites[3].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-            descriptorWrites[3].descriptorCount = 1;
-            descriptorWrites[3].pBufferInfo = &bufferInfo;
+        imageInfos[1].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        imageInfos[1].imageView = blurView;
+        imageInfos[1].sampler = samplerLinear;
 
-            vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0,
-                                   nullptr);
+        std::array<VkWriteDescriptorSet, 2> descriptorWrites{};
+        for (int j = 0; j < 2; j++)
+        {
+            descriptorWrites[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            descriptorWrites[j].dstSet = set;
+            descriptorWrites[j].dstBinding = j;
+            descriptorWrites[j].dstArrayElement = 0;
+            descriptorWrites[j].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            descriptorWrites[j].descriptorCount = 1;
+            descriptorWrites[j].pImageInfo = &imageInfos[j];
         }
-    }
 
-    // Final pass descriptor sets
+        vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0,
+                               nullptr);
+    };
+
+    allocateSet(descriptorSetLayoutFinal, descriptorSetFinal, "Failed to allocate final descriptor set!");
+    writeFinalSet(descriptorSetFinal, rtBlurFinal.view);
+
+    allocateSet(descriptorSetLayoutFinal, descriptorSetFinalPyramid, "Failed to allocate final descriptor set!");
+    writeFinalSet(descriptorSetFinalPyramid, pyramidViews[0]);
+
+    if (useTemporalBlur)
     {
-        std::vector<VkDescriptorSetLayout> layouts(VulkanContext::MAX_FRAMES_IN_FLIGHT, descriptorSetLayoutFinal);
-        VkDescriptorSetAllocateInfo allocInfo{};
-        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        allocInfo.descriptorPool = descriptorPool;
-        allocInfo.descriptorSetCount = static_cast<uint32_t>(VulkanContext::MAX_FRAMES_IN_FLIGHT);
-        allocInfo.pSetLayouts = layouts.data();
+        allocateSet(descriptorSetLayoutFinal, descriptorSetFinalAlternate, "Failed to allocate final descriptor set!");
+        writeFinalSet(descriptorSetFinalAlternate, rtBlurAlternate.view);
+    }
 
-        descriptorSetsFinal.resize(VulkanContext::MAX_FRAMES_IN_FLIGHT);
-        if (vkAllocateDescriptorSets(device, &allocInfo, descriptorSetsFinal.data()) != VK_SUCCESS)
+    // Temporal blur reuse descriptor sets; G-buffer texels are fetched unfiltered, the motion result and
+    // blur history filtered, and both outputs stay in the GENERAL layout. Set i writes pair i and reads
+    // the other one as its history.
+    const std::array<VkImageView, 2> temporalBlurViews = {rtBlurFinal.view, rtBlurAlternate.view};
+    for (uint32_t i = 0; useTemporalBlur && i < descriptorSetsTemporal.size(); i++)
+    {
+        allocateSet(descriptorSetLayoutTemporal, descriptorSetsTemporal[i],
+                    "Failed to allocate temporal blur descriptor set!");
+
+        std::array<VkDescriptorImageInfo, 8> imageInfos{};
+        const std::array<VkImageView, 8> views = {rtSceneColor.view,
+                                                  GetVelocityView(),
+                                                  rtDepth.view,
+                                                  rtMotion.view,
+                                                  temporalBlurViews[1 - i],
+                                                  rtTemporalDepth[1 - i].view,
+                                                  temporalBlurViews[i],
+                                                  rtTemporalDepth[i].view};
+        const std::array<VkSampler, 6> samplers = {samplerNearest, samplerNearest, samplerNearest,
+                                                   samplerLinear,  samplerLinear,  samplerNearest};
+        for (uint32_t j = 0; j < imageInfos.size(); j++)
         {
-            throw std::runtime_error("Failed to allocate final descriptor sets!");
+            imageInfos[j].imageView = views[j];
+            imageInfos[j].imageLayout = j < samplers.size() ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+                                                            : VK_IMAGE_LAYOUT_GENERAL;
+            imageInfos[j].sampler = j < samplers.size() ? samplers[j] : VK_NULL_HANDLE;
         }
+        VkDescriptorBufferInfo tileInfo = {temporalTileBuffer, 0, VK_WHOLE_SIZE};
 
-        for (size_t i = 0; i < VulkanContext::MAX_FRAMES_IN_FLIGHT; i++)
+        std::array<VkWriteDescriptorSet, 9> descriptorWrites{};
+        for (uint32_t j = 0; j < descriptorWrites.size(); j++)
         {
-            std::array<VkDescriptorImageInfo, 2> imageInfos{};
-            imageInfos[0].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            imageInfos[0].imageView = rtMotion.view;
-            imageInfos[0].sampler = samplerLinear;
+            descriptorWrites[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            descriptorWrites[j].dstSet = descriptorSetsTemporal[i];
+            descriptorWrites[j].dstBinding = j;
+            descriptorWrites[j].dstArrayElement = 0;
+            descriptorWrites[j].descriptorCount = 1;
+            if (j < imageInfos.size())
+            {
+                descriptorWrites[j].descriptorType = j < samplers.size() ? VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER
+                                                                         : VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+                descriptorWrites[j].pImageInfo = &imageInfos[j];
+            }
+        }
+        descriptorWrites[8].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        descriptorWrites[8].pBufferInfo = &tileInfo;
 
-            imageInfos[1].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            imageInfos[1].imageView = rtBlurFinal.view;
-            imageInfos[1].sampler = samplerLinear;
+        vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0,
+                               nullptr);
+    }
+
+    if (!useGpuCulling)
+        return;
 
-            std::array<VkWriteDescriptorSet, 2> descriptorWrites{};
-            for (int j = 0; j < 2; j++)
+    // Culling descriptor set; the depth pyramid stays in the GENERAL layout
+    {
+        allocateSet(descriptorSetLayoutCull, descriptorSetCull, "Failed to allocate culling descriptor set!");
+
+        std::array<VkDescriptorBufferInfo, 4> bufferInfos{};
+        bufferInfos[0] = {uniformAllocator.GetBuffer(), 0, sizeof(CullUniforms)};
+        bufferInfos[1] = {instanceBuffer, 0, sizeof(cpu::InstanceMvp) * instanceCount};
+        bufferInfos[2] = {drawCommandBuffer, 0, VK_WHOLE_SIZE};
+        bufferInfos[3] = {drawCountBuffer, 0, VK_WHOLE_SIZE};
+        VkDescriptorBufferInfo retestInfo = {occlusionRetestBuffer, 0, VK_WHOLE_SIZE};
+
+        VkDescriptorImageInfo hizInfo{};
+        hizInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+        hizInfo.imageView = rtHiZ.view;
+        hizInfo.sampler = samplerNearest;
+
+        const std::array<VkDescriptorType, 4> bufferTypes = {
+            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER};
+
+        std::vector<VkWriteDescriptorSet> descriptorWrites(6);
+        for (uint32_t j = 0; j < descriptorWrites.size(); j++)
+        {
+            descriptorWrites[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            descriptorWrites[j].dstSet = descriptorSetCull;
+            descriptorWrites[j].dstBinding = j;
+            descriptorWrites[j].dstArrayElement = 0;
+            descriptorWrites[j].descriptorCount = 1;
+            if (j < bufferInfos.size())
             {
-                descriptorWrites[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-                descriptorWrites[j].dstSet = descriptorSetsFinal[i];
-                descriptorWrites[j].dstBinding = j;
-                descriptorWrites[j].dstArrayElement = 0;
-                descriptorWrites[j].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-                descriptorWrites[j].descriptorCount = 1;
-                descriptorWrites[j].pImageInfo = &imageInfos[j];
+                descriptorWrites[j].descriptorType = bufferTypes[j];
+                descriptorWrites[j].pBufferInfo = &bufferInfos[j];
             }
+        }
+        descriptorWrites[4].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        descriptorWrites[4].pImageInfo = &hizInfo;
+        descriptorWrites[5].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        descriptorWrites[5].pBufferInfo = &retestInfo;
+        // The layout has no instance binding when they are read by address
+        if (useInstanceAddress)
+        {
+            descriptorWrites.erase(descriptorWrites.begin() + 1);
+        }
 
-            vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0,
-                                   nullptr);
+        vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0,
+                               nullptr);
+    }
+
+    // Depth pyramid build sets: level 0 reduces rtDepth, every other level the one below it
+    descriptorSetsHiZ.resize(hizMipLevels);
+    for (uint32_t level = 0; level < hizMipLevels; level++)
+    {
+        allocateSet(descriptorSetLayoutIirBlur, descriptorSetsHiZ[level],
+                    "Failed to allocate depth pyramid descriptor set!");
+        if (level == 0)
+        {
+            writeIirBlurSet(descriptorSetsHiZ[level], rtDepth.view, hizLevelViews[level]);
+        }
+        else
+        {
+            writeIirBlurSet(descriptorSetsHiZ[level], hizLevelViews[level - 1], hizLevelViews[level],
+                            VK_IMAGE_LAYOUT_GENERAL);
         }
     }
 }
 
 void MotionBlurExample::Update(float deltaTime)
 {
+    previousTime = totalTime;
     totalTime += deltaTime;
 
-    uint32_t currentFrame = ctx.GetCurrentFrame();
     VkExtent2D extent = ctx.GetSwapChainExtent();
+    float aspect = extent.width / static_cast<float>(extent.height);
 
-    glm::mat4 model = glm::rotate(glm::mat4(1.0f), totalTime * glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f));
-    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 2.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
-    glm::mat4 proj =
-        glm::perspective(glm::radians(45.0f), extent.width / static_cast<float>(extent.height), 0.1f, 10.0f);
+    // Every pass up to the final one renders renderExtent, which the final pass upscales. A new extent
+    // leaves the temporal history in the old one.
+    VkExtent2D scaledExtent = extent;
+    if (useDynamicResolution)
+    {
+        auto scaleAxis = [this](uint32_t size)
+        {
+            uint32_t steps = static_cast<uint32_t>(std::lround(size * renderScale / RENDER_EXTENT_GRANULARITY));
+            return std::min(size, std::max(steps, 1u) * RENDER_EXTENT_GRANULARITY);
+        };
+        scaledExtent = {scaleAxis(extent.width), scaleAxis(extent.height)};
+    }
+    if (scaledExtent.width != renderExtent.width || scaledExtent.height != renderExtent.height)
+    {
+        temporalHistoryValid = false;
+    }
+    renderExtent = scaledExtent;
+
+    // The stress scene is framed from outside its bounding sphere, orbiting it slowly
+    glm::vec3 eye(0.0f, 0.0f, 2.0f);
+    float farPlane = 10.0f;
+    if (settings.instanceCount > 0)
+    {
+        float radius = instanceScene.GetBoundingRadius();
+        float distance = 2.5f * radius + 2.0f;
+        float angle = totalTime * CAMERA_ORBIT_RATE;
+        eye = glm::vec3(distance * std::sin(angle), 0.3f * distance, distance * std::cos(angle));
+        farPlane = distance * 1.3f + radius;
+    }
+
+    glm::mat4 view = glm::lookAt(eye, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 proj = glm::perspective(glm::radians(45.0f), aspect, 0.1f, farPlane);
     proj[1][1] *= -1;
 
-    glm::mat4 currentMVP = proj * view * model;
+    glm::mat4 viewProjection = proj * view;
 
-    MotionBlurMVPUBO ubo{};
-    ubo.currMVP = currentMVP;
-    ubo.prevMVP = previousMVP;
+    // Uniform data and instance MVPs are only staged here; they are written into the frame's slices
+    // in RecordCommands, once the GPU is known to be done with them.
+    currViewProjection = viewProjection;
+    prevViewProjection = previousViewProjection;
 
-    memcpy(mvpUniformBuffersMapped[currentFrame], &ubo, sizeof(ubo));
+    // Frustum planes (Gribb-Hartmann) for the culling pass: row 3 plus or minus rows 0-2 of the matrix
+    if (useGpuCulling)
+    {
+        for (int i = 0; i < 6; i++)
+        {
+            glm::vec4 plane;
+            for (int column = 0; column < 4; column++)
+            {
+                float row = viewProjection[column][i / 2];
+                plane[column] = viewProjection[column][3] + (i % 2 == 0 ? row : -row);
+            }
+            cullUniforms.frustumPlanes[i] = plane / glm::length(glm::vec3(plane));
+        }
+        cullUniforms.instanceCount = instanceCount;
+        cullUniforms.staticInstanceCount = staticInstanceCount;
+        cullUniforms.indexCount = sceneMesh.indexCount;
+        cullUniforms.firstIndex = sceneMesh.firstIndex;
+        cullUniforms.vertexOffset = sceneMesh.vertexOffset;
+    }
 
-    previousMVP = currentMVP;
+    // Static geometry moves only with the camera
+    cameraParams.reprojection = previousViewProjection * glm::inverse(viewProjection);
+    previousViewProjection = viewProjection;
 
-    MotionBlurPostProcessParams params{};
-    params.blurStrength = 1.0f;
-    params.motionScale = 1.0f;
-    params.texelSize = glm::vec2(1.0f / extent.width, 1.0f / extent.height);
+    // The blur radius is in render texels, so it shrinks with the render extent to keep its reach on screen
+    float blurRadius = settings.blurRadius * renderExtent.width / extent.width;
+    postProcessParams.blurStrength = blurRadius / BLUR_KERNEL_RADIUS;
+    postProcessParams.motionScale = 1.0f;
+    postProcessParams.texelSize = glm::vec2(1.0f / renderTargetExtent.width, 1.0f / renderTargetExtent.height);
+    postProcessParams.uvScale = glm::vec2(static_cast<float>(renderExtent.width) / renderTargetExtent.width,
+                                          static_cast<float>(renderExtent.height) / renderTargetExtent.height);
+    postProcessParams.kernelRadius = BLUR_KERNEL_RADIUS;
+
+    activeBlurMode = ResolveBlurMode();
+
+    // Each pyramid level doubles the reach of the chain, so the level count grows with log2 of the radius
+    if (activeBlurMode == GpuBlurMode::Pyramid)
+    {
+        uint32_t levels = settings.pyramidLevels;
+        if (levels == 0)
+        {
+            levels = static_cast<uint32_t>(std::max(1.0f, std::round(std::log2(blurRadius)) - 1.0f));
+        }
+        pyramidLevelCount = std::min(levels, pyramidMipLevels);
+    }
 
-    memcpy(postProcessUniformBuffersMapped[currentFrame], &params, sizeof(params));
+    // The recursive blur matches the sigma of the stretched 9-tap kernel
+    if (activeBlurMode == GpuBlurMode::Iir || measuringCrossover)
+    {
+        cpu::CpuPostProcessParams kernelParams;
+        kernelParams.blurStrength = postProcessParams.blurStrength;
+        kernelParams.kernelRadius = postProcessParams.kernelRadius;
+        iirCoefficients =
+            cpu::ComputeIirGaussianCoefficients(cpu::GetBlurKernelSigma(cpu::BuildBlurKernel(kernelParams)));
+    }
 }
 
-void MotionBlurExample::RecordCommands(VkCommandBuffer cmd, uint32_t imageIndex)
+void MotionBlurExample::RecordCulling(VkCommandBuffer cmd, uint32_t cullOffset, uint32_t instanceOffset)
 {
-    uint32_t currentFrame = ctx.GetCurrentFrame();
-    VkExtent2D extent = ctx.GetSwapChainExtent();
+    // The previous frame's indirect draws and second pass have consumed the commands, the counts and the
+    // re-test list before they are rewritten; the list starts as a dispatch of zero workgroups
+    const uint32_t emptyRetestList[] = {0, 1, 1, 0};
+    utils::GlobalBarrier(cmd, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0);
+    vkCmdFillBuffer(cmd, drawCountBuffer, 0, 4 * sizeof(uint32_t), 0);
+    vkCmdUpdateBuffer(cmd, occlusionRetestBuffer, 0, sizeof(emptyRetestList), emptyRetestList);
+    utils::GlobalBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+    // A new depth pyramid is moved to GENERAL once, before anything has been built into it
+    if (!hizInitialized)
+    {
+        utils::ImageBarrier(cmd, rtHiZ.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+                            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                            VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT, VK_IMAGE_ASPECT_COLOR_BIT,
+                            hizMipLevels);
+        hizInitialized = true;
+    }
 
-    VkClearValue clearColor = {{{0.0f, 0.0f, 0.0f, 1.0f}}};
-    VkClearValue clearVelocity = {{{0.0f, 0.0f, 0.0f, 0.0f}}};
+    // Instances read by address are pushed instead of offset
+    std::array<uint32_t, 2> dynamicOffsets = {cullOffset, instanceOffset};
+    uint32_t dynamicOffsetCount = useInstanceAddress ? 1 : 2;
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineCull);
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayoutCull, 0, 1, &descriptorSetCull,
+                            dynamicOffsetCount, dynamicOffsets.data());
+    if (useInstanceAddress)
+    {
+        VkDeviceAddress instances = instanceBufferAddress + instanceOffset;
+        vkCmdPushConstants(cmd, pipelineLayoutCull, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(instances), &instances);
+    }
+    vkCmdDispatch(cmd, (instanceCount + CULL_WORKGROUP_SIZE - 1) / CULL_WORKGROUP_SIZE, 1, 1);
+
+    // Read by the draws, and the re-test list by the second pass
+    utils::GlobalBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+                         VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT);
+}
+
+void MotionBlurExample::RecordOcclusionRetest(VkCommandBuffer cmd, uint32_t cullOffset, uint32_t instanceOffset)
+{
+    std::array<uint32_t, 2> dynamicOffsets = {cullOffset, instanceOffset};
+    uint32_t dynamicOffsetCount = useInstanceAddress ? 1 : 2;
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineCullRetest);
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayoutCull, 0, 1, &descriptorSetCull,
+                            dynamicOffsetCount, dynamicOffsets.data());
+    if (useInstanceAddress)
+    {
+        VkDeviceAddress instances = instanceBufferAddress + instanceOffset;
+        vkCmdPushConstants(cmd, pipelineLayoutCull, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(instances), &instances);
+    }
+    vkCmdDispatchIndirect(cmd, occlusionRetestBuffer, 0);
+
+    utils::GlobalBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+                         VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT);
+}
+
+void MotionBlurExample::RecordGBufferPass(VkCommandBuffer cmd, VkExtent2D extent, uint32_t instanceOffset,
+                                          bool occlusionRetest)
+{
+    // The clear values mark the background as static (shaders/include/gbuffer.glsl): scene color alpha
+    // 0 for camera velocity mode in the separate layout and velocity code 0 in the folded one, velocity
+    // -1 in the packed one. The draws of the second culling pass load the targets instead.
+    bool staticAlpha = settings.cameraVelocity || gbufferLayout == GBufferLayout::Folded;
+    VkClearValue clearSceneColor = {{{0.0f, 0.0f, 0.0f, staticAlpha ? 0.0f : 1.0f}}};
+    float velocityClear = gbufferLayout == GBufferLayout::Packed ? -1.0f : 0.0f;
+    VkClearValue clearVelocity = {{{velocityClear, velocityClear, 0.0f, 0.0f}}};
     VkClearValue clearDepth = {{{1.0f, 0}}};
 
-    // Pass 0: G-Buffer (Triangle)
+    std::vector<VkClearValue> clearValues = {clearSceneColor};
+    if (velocityFormat != VK_FORMAT_UNDEFINED)
+    {
+        clearValues.push_back(clearVelocity);
+    }
+    clearValues.push_back(clearDepth);
+
+    VkRenderPassBeginInfo renderPassInfo{};
+    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    renderPassInfo.renderPass = occlusionRetest ? renderPassGBufferRetest : renderPassGBuffer;
+    renderPassInfo.framebuffer = fbGBuffer;
+    renderPassInfo.renderArea.offset = {0, 0};
+    renderPassInfo.renderArea.extent = extent;
+    if (!occlusionRetest)
+    {
+        renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
+        renderPassInfo.pClearValues = clearValues.data();
+    }
+
+    vkCmdBeginRenderPass(cmd, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+    utils::SetViewportAndScissor(cmd, extent);
+
+    if (useInstanceAddress)
+    {
+        GBufferParams gbufferParams{};
+        gbufferParams.instances = instanceBufferAddress + instanceOffset;
+        if (useVertexPulling)
+        {
+            gbufferParams.packedVertices = meshVertexAddress;
+            gbufferParams.positionCenter = glm::vec4(sceneMesh.boundsCenter, 0.0f);
+            gbufferParams.positionExtent = glm::vec4(sceneMesh.boundsExtent, 0.0f);
+        }
+        vkCmdPushConstants(cmd, pipelineLayoutGBuffer, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(gbufferParams),
+                           &gbufferParams);
+    }
+    else
+    {
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayoutGBuffer, 0, 1,
+                                &descriptorSetGBuffer, 1, &instanceOffset);
+    }
+    if (!useVertexPulling)
+    {
+        VkBuffer vertexBuffers[] = {meshVertexBuffer};
+        VkDeviceSize offsets[] = {0};
+        vkCmdBindVertexBuffers(cmd, 0, 1, vertexBuffers, offsets);
+    }
+    vkCmdBindIndexBuffer(cmd, meshIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
+
+    // Static instances, then the rest; only camera velocity mode draws them differently. The second
+    // culling pass has its own commands and counts after the first's.
+    uint32_t firstCommand = occlusionRetest ? instanceCount : 0;
+    uint32_t firstCount = occlusionRetest ? 2 : 0;
+    auto drawInstances = [&](uint32_t firstInstance, uint32_t count, uint32_t countIndex)
     {
-        std::array<VkClearValue, 3> clearValues = {clearColor, clearVelocity, clearDepth};
+        if (count == 0)
+        {
+            return;
+        }
+        if (useGpuCulling)
+        {
+            vkCmdDrawIndexedIndirectCount(
+                cmd, drawCommandBuffer, sizeof(VkDrawIndexedIndirectCommand) * (firstCommand + firstInstance),
+                drawCountBuffer, sizeof(uint32_t) * (firstCount + countIndex), count,
+                sizeof(VkDrawIndexedIndirectCommand));
+        }
+        else
+        {
+            vkCmdDrawIndexed(cmd, sceneMesh.indexCount, count, sceneMesh.firstIndex, sceneMesh.vertexOffset,
+                             firstInstance);
+        }
+    };
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                      settings.cameraVelocity ? pipelineGBufferStatic : pipelineGBuffer);
+    drawInstances(0, staticInstanceCount, 0);
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineGBuffer);
+    drawInstances(staticInstanceCount, instanceCount - staticInstanceCount, 1);
+    vkCmdEndRenderPass(cmd);
+}
+
+void MotionBlurExample::RecordHiZBuild(VkCommandBuffer cmd, VkExtent2D extent)
+{
+    // rtDepth stays in SHADER_READ_ONLY_OPTIMAL after the G-buffer pass; the pyramid levels were last read
+    // by this frame's first culling pass
+    VkImageAspectFlags depthAspect = VK_IMAGE_ASPECT_DEPTH_BIT;
+    if (rtDepth.format != VK_FORMAT_D32_SFLOAT)
+    {
+        depthAspect |= VK_IMAGE_ASPECT_STENCIL_BIT;
+    }
+    utils::ImageBarrier(cmd, rtDepth.image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                        VK_ACCESS_SHADER_READ_BIT, depthAspect);
+    utils::GlobalBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0);
+
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineHiZBuild);
 
+    for (uint32_t level = 0; level < hizMipLevels; level++)
+    {
+        HiZBuildPushConstants pushConstants{};
+        VkExtent2D sourceExtent = level == 0 ? extent : GetHiZLevelSize(extent, level - 1);
+        VkExtent2D levelExtent = GetHiZLevelSize(extent, level);
+        pushConstants.sourceExtent = glm::ivec2(sourceExtent.width, sourceExtent.height);
+        pushConstants.levelExtent = glm::ivec2(levelExtent.width, levelExtent.height);
+
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayoutHiZ, 0, 1,
+                                &descriptorSetsHiZ[level], 0, nullptr);
+        vkCmdPushConstants(cmd, pipelineLayoutHiZ, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants),
+                           &pushConstants);
+        vkCmdDispatch(cmd, (levelExtent.width + HIZ_WORKGROUP_SIZE - 1) / HIZ_WORKGROUP_SIZE,
+                      (levelExtent.height + HIZ_WORKGROUP_SIZE - 1) / HIZ_WORKGROUP_SIZE, 1);
+
+        // Read by the next level, and by both culling passes after the last one
+        utils::GlobalBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    }
+
+    hizValid = true;
+    hizSourceExtent = extent;
+    hizViewProjection = currViewProjection;
+}
+
+void MotionBlurExample::RecordFragmentBlur(VkCommandBuffer cmd, VkExtent2D extent)
+{
+    VkClearValue clearColor = {{{0.0f, 0.0f, 0.0f, 1.0f}}};
+
+    // Pass 2: Blur Vertical
+    {
         VkRenderPassBeginInfo renderPassInfo{};
         renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        renderPassInfo.renderPass = renderPassGBuffer;
-        renderPassInfo.framebuffer = fbGBuffer;
+        renderPassInfo.renderPass = renderPassBlurVertical;
+        renderPassInfo.framebuffer = fbBlurVertical;
         renderPassInfo.renderArea.offset = {0, 0};
         renderPassInfo.renderArea.extent = extent;
-        renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
-        renderPassInfo.pClearValues = clearValues.data();
+        renderPassInfo.clearValueCount = 1;
+        renderPassInfo.pClearValues = &clearColor;
 
         vkCmdBeginRenderPass(cmd, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
-        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineGBuffer);
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineBlurVertical);
+        utils::SetViewportAndScissor(cmd, extent);
 
-        VkBuffer vertexBuffers[] = {triangleVertexBuffer};
-        VkDeviceSize offsets[] = {0};
-        vkCmdBindVertexBuffers(cmd, 0, 1, vertexBuffers, offsets);
-        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayoutGBuffer, 0, 1,
-                                &descriptorSetsGBuffer[currentFrame], 0, nullptr);
-        vkCmdDraw(cmd, static_cast<uint32_t>(triangleVertices.size()), 1, 0, 0);
+        BindPostProcessResources(cmd, descriptorSetBlurVertical, MakeBindlessHandles(bindlessMotion));
+        utils::DrawFullscreenTriangle(cmd);
         vkCmdEndRenderPass(cmd);
     }
 
-    // Pass 1: Motion Apply
+    // Pass 3: Blur Horizontal
     {
         VkRenderPassBeginInfo renderPassInfo{};
         renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        renderPassInfo.renderPass = renderPassMotionApply;
-        renderPassInfo.framebuffer = fbMotionApply;
+        renderPassInfo.renderPass = renderPassBlurHorizontal;
+        renderPassInfo.framebuffer = fbBlurHorizontal;
         renderPassInfo.renderArea.offset = {0, 0};
         renderPassInfo.renderArea.extent = extent;
         renderPassInfo.clearValueCount = 1;
         renderPassInfo.pClearValues = &clearColor;
 
         vkCmdBeginRenderPass(cmd, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
-        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineMotionApply);
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineBlurHorizontal);
+        utils::SetViewportAndScissor(cmd, extent);
 
-        fullscreenQuad.Bind(cmd);
-        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayoutMotionApply, 0, 1,
-                                &descriptorSetsMotionApply[currentFrame], 0, nullptr);
-        fullscreenQuad.Draw(cmd);
+        BindPostProcessResources(cmd, descriptorSetBlurHorizontal, MakeBindlessHandles(bindlessBlurIntermediate));
+        utils::DrawFullscreenTriangle(cmd);
         vkCmdEndRenderPass(cmd);
     }
+}
 
-    // Pass 2: Blur Vertical
+void MotionBlurExample::RecordIirBlur(VkCommandBuffer cmd, VkExtent2D extent)
+{
+    // Motion apply wrote rtMotion as a color attachment and left it in SHADER_READ_ONLY_OPTIMAL; the
+    // previous contents of both outputs are discarded
+    utils::ImageBarrier(cmd, rtMotion.image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                        VK_ACCESS_SHADER_READ_BIT);
+    utils::ImageBarrier(cmd, rtBlurIntermediate.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+                        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                        VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+    utils::ImageBarrier(cmd, rtIirCausal.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+                        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                        VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineIirBlur);
+
+    IirBlurPushConstants pushConstants{};
+    pushConstants.coefficients = glm::vec4(iirCoefficients.b, iirCoefficients.a1, iirCoefficients.a2,
+                                           iirCoefficients.a3);
+    pushConstants.extent = glm::ivec2(extent.width, extent.height);
+
+    // Vertical scans, a block of adjacent columns per workgroup
+    pushConstants.vertical = 1;
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayoutIirBlur, 0, 1,
+                            &descriptorSetIirBlurVertical, 0, nullptr);
+    vkCmdPushConstants(cmd, pipelineLayoutIirBlur, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants),
+                       &pushConstants);
+    vkCmdDispatch(cmd, (extent.width + iirLinesPerWorkgroup - 1) / iirLinesPerWorkgroup, 1, 1);
+
+    utils::ImageBarrier(cmd, rtBlurIntermediate.image, VK_IMAGE_LAYOUT_GENERAL,
+                        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                        VK_ACCESS_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    utils::ImageBarrier(cmd, rtBlurFinal.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+                        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                        VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+    // The horizontal scans overwrite the causal scratch the vertical ones read last
+    utils::ImageBarrier(cmd, rtIirCausal.image, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL,
+                        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+                        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+    // Horizontal scans, a block of adjacent rows per workgroup
+    pushConstants.vertical = 0;
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayoutIirBlur, 0, 1,
+                            &descriptorSetIirBlurHorizontal, 0, nullptr);
+    vkCmdPushConstants(cmd, pipelineLayoutIirBlur, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants),
+                       &pushConstants);
+    vkCmdDispatch(cmd, (extent.height + iirLinesPerWorkgroup - 1) / iirLinesPerWorkgroup, 1, 1);
+
+    // The final pass samples rtBlurFinal from the fragment shader
+    utils::ImageBarrier(cmd, rtBlurFinal.image, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+                        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+}
+
+void MotionBlurExample::RecordCrossoverMeasurement(VkCommandBuffer cmd, VkExtent2D extent)
+{
+    // Accumulate the frame that last used this slot, once past the warm-up
+    crossoverTimer.BeginFrame(cmd, ctx.GetCurrentFrame());
+    if (crossoverTimer.GetResultCount() == CROSSOVER_TIMESTAMP_COUNT && ++crossoverFrames > CROSSOVER_WARMUP_FRAMES)
+    {
+        for (uint32_t i = 0; i < CROSSOVER_RADII.size(); i++)
+        {
+            firMilliseconds[i] += crossoverTimer.GetMilliseconds(i, i + 1);
+        }
+        uint32_t iirStart = CROSSOVER_TIMESTAMP_COUNT - 2;
+        iirMilliseconds += crossoverTimer.GetMilliseconds(iirStart, iirStart + 1);
+        if (crossoverFrames == CROSSOVER_WARMUP_FRAMES + CROSSOVER_SAMPLE_FRAMES)
+        {
+            FinishCrossoverMeasurement();
+            return;
+        }
+    }
+
+    // Each blur runs alone between its timestamps, and none overlaps the frame's own blur
+    auto serialize = [cmd]()
+    {
+        utils::GlobalBarrier(cmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_ACCESS_MEMORY_WRITE_BIT,
+                             VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                             VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT);
+    };
+
+    serialize();
+    crossoverTimer.Timestamp(cmd);
+    float blurStrength = postProcessParams.blurStrength;
+    for (float radius : CROSSOVER_RADII)
+    {
+        postProcessParams.blurStrength = radius / BLUR_KERNEL_RADIUS;
+        RecordFragmentBlur(cmd, extent);
+        serialize();
+        crossoverTimer.Timestamp(cmd);
+    }
+    postProcessParams.blurStrength = blurStrength;
+
+    RecordIirBlur(cmd, extent);
+    serialize();
+    crossoverTimer.Timestamp(cmd);
+}
+
+void MotionBlurExample::FinishCrossoverMeasurement()
+{
+    measuringCrossover = false;
+
+    // The recursive blur costs the same at any radius; the fragment blur gets slower as its stretched taps
+    // spread over more cache lines. Auto switches where it reaches the recursive blur, interpolated
+    // between the measured radii, or never if it stays faster.
+    double iir = iirMilliseconds / CROSSOVER_SAMPLE_FRAMES;
+    iirCrossoverRadius = std::numeric_limits<float>::infinity();
+    for (uint32_t i = 0; i < CROSSOVER_RADII.size(); i++)
+    {
+        double fir = firMilliseconds[i] / CROSSOVER_SAMPLE_FRAMES;
+        if (fir < iir)
+            continue;
+
+        iirCrossoverRadius = CROSSOVER_RADII[i];
+        if (i > 0)
+        {
+            double previous = firMilliseconds[i - 1] / CROSSOVER_SAMPLE_FRAMES;
+            float t = static_cast<float>((iir - previous) / (fir - previous));
+            iirCrossoverRadius = CROSSOVER_RADII[i - 1] + t * (CROSSOVER_RADII[i] - CROSSOVER_RADII[i - 1]);
+        }
+        break;
+    }
+
+    std::cout << "Blur crossover: fragment blur";
+    for (uint32_t i = 0; i < CROSSOVER_RADII.size(); i++)
+    {
+        std::cout << (i == 0 ? " " : ", ") << firMilliseconds[i] / CROSSOVER_SAMPLE_FRAMES << " ms at radius "
+                  << CROSSOVER_RADII[i];
+    }
+    std::cout << "; recursive blur " << iir << " ms. Auto switches ";
+    if (std::isinf(iirCrossoverRadius))
+        std::cout << "never" << std::endl;
+    else
+        std::cout << "at radius " << iirCrossoverRadius << std::endl;
+}
+
+void MotionBlurExample::RecordPyramidBlur(VkCommandBuffer cmd, VkExtent2D extent)
+{
+    // Rendered sub-rect of a mip, rounded up so that it covers the whole rendered area
+    auto levelExtent = [&](uint32_t level)
     {
+        uint32_t shift = level + 1;
+        return VkExtent2D{std::max(1u, (extent.width + (1u << shift) - 1) >> shift),
+                          std::max(1u, (extent.height + (1u << shift) - 1) >> shift)};
+    };
+
+    auto sourceParams = [&](uint32_t level)
+    {
+        VkExtent2D size = GetPyramidLevelSize(level);
+        VkExtent2D rendered = levelExtent(level);
+
+        KawaseBlurParams params{};
+        params.sourceTexelSize = glm::vec2(1.0f / size.width, 1.0f / size.height);
+        params.sourceUvScale = glm::vec2(static_cast<float>(rendered.width) / size.width,
+                                         static_cast<float>(rendered.height) / size.height);
+        params.offset = KAWASE_OFFSET;
+        return params;
+    };
+
+    auto drawLevel = [&](VkPipeline pipeline, uint32_t targetLevel, VkDescriptorSet sourceSet,
+                         const KawaseBlurParams& params)
+    {
+        VkClearValue clearColor = {{{0.0f, 0.0f, 0.0f, 1.0f}}};
+        VkExtent2D targetExtent = levelExtent(targetLevel);
+
         VkRenderPassBeginInfo renderPassInfo{};
         renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        renderPassInfo.renderPass = renderPassBlurVertical;
-        renderPassInfo.framebuffer = fbBlurVertical;
+        renderPassInfo.renderPass = renderPassPyramid;
+        renderPassInfo.framebuffer = fbPyramid[targetLevel];
         renderPassInfo.renderArea.offset = {0, 0};
-        renderPassInfo.renderArea.extent = extent;
+        renderPassInfo.renderArea.extent = targetExtent;
         renderPassInfo.clearValueCount = 1;
         renderPassInfo.pClearValues = &clearColor;
 
         vkCmdBeginRenderPass(cmd, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
-        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineBlurVertical);
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+        utils::SetViewportAndScissor(cmd, targetExtent);
 
-        fullscreenQuad.Bind(cmd);
-        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayoutBlur, 0, 1,
-                                &descriptorSetsBlurVertical[currentFrame], 0, nullptr);
-        fullscreenQuad.Draw(cmd);
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayoutPyramid, 0, 1, &sourceSet, 0,
+                                nullptr);
+        vkCmdPushConstants(cmd, pipelineLayoutPyramid, VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(params), &params);
+        utils::DrawFullscreenTriangle(cmd);
         vkCmdEndRenderPass(cmd);
+    };
+
+    // Down: rtMotion -> mip 0 -> ... -> mip N-1
+    KawaseBlurParams motionParams{};
+    motionParams.sourceTexelSize = postProcessParams.texelSize;
+    motionParams.sourceUvScale = postProcessParams.uvScale;
+    motionParams.offset = KAWASE_OFFSET;
+    drawLevel(pipelinePyramidDown, 0, descriptorSetPyramidMotion, motionParams);
+    for (uint32_t level = 1; level < pyramidLevelCount; level++)
+    {
+        drawLevel(pipelinePyramidDown, level, descriptorSetsPyramid[level - 1], sourceParams(level - 1));
     }
 
-    // Pass 3: Blur Horizontal
+    // Up: mip N-1 -> ... -> mip 0, overwriting the downsampled levels once they have been read
+    for (uint32_t level = pyramidLevelCount - 1; level > 0; level--)
+    {
+        drawLevel(pipelinePyramidUp, level - 1, descriptorSetsPyramid[level], sourceParams(level));
+    }
+}
+
+void MotionBlurExample::RecordTemporalBlur(VkCommandBuffer cmd, VkExtent2D extent)
+{
+    // The G-buffer and motion apply outputs are read by compute; they stay in SHADER_READ_ONLY_OPTIMAL
+    utils::GlobalBarrier(cmd,
+                         VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                         VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+
+    // This frame writes the other pair; last frame's outputs are the history
+    temporalIndex = 1 - temporalIndex;
+    const std::array<RenderTarget*, 2> blurTargets = {&rtBlurFinal, &rtBlurAlternate};
+    RenderTarget& blurOutput = *blurTargets[temporalIndex];
+    RenderTarget& depthOutput = rtTemporalDepth[temporalIndex];
+
+    // Invalid history is moved out of UNDEFINED; the reprojection pass does not read it then
+    if (!temporalHistoryValid)
+    {
+        for (RenderTarget* target : {blurTargets[1 - temporalIndex], &rtTemporalDepth[1 - temporalIndex]})
+        {
+            utils::ImageBarrier(cmd, target->image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+                                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+        }
+    }
+
+    // Both outputs are rewritten in full; the frame before last read them in the final pass and as the
+    // history of the last one
+    utils::ImageBarrier(cmd, blurOutput.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+                        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+                        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+    utils::ImageBarrier(cmd, depthOutput.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+                        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                        VK_ACCESS_SHADER_WRITE_BIT);
+
+    // Empty tile list: an indirect dispatch of zero workgroups, after the previous frame's dispatch and
+    // tile blur have read it
+    const VkDispatchIndirectCommand emptyDispatch = {0, 1, 1};
+    utils::GlobalBarrier(cmd, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT, 0);
+    vkCmdUpdateBuffer(cmd, temporalTileBuffer, 0, sizeof(emptyDispatch), &emptyDispatch);
+    utils::GlobalBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+    TemporalBlurPushConstants pushConstants{};
+    pushConstants.reprojection = cameraParams.reprojection;
+    pushConstants.texelSize = postProcessParams.texelSize;
+    pushConstants.uvScale = postProcessParams.uvScale;
+    pushConstants.extent = glm::ivec2(extent.width, extent.height);
+    pushConstants.blurStrength = postProcessParams.blurStrength;
+    pushConstants.kernelRadius = postProcessParams.kernelRadius;
+    pushConstants.apron = static_cast<int32_t>(temporalApron);
+    pushConstants.historyValid = temporalHistoryValid ? 1 : 0;
+
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayoutTemporal, 0, 1,
+                            &descriptorSetsTemporal[temporalIndex], 0, nullptr);
+    vkCmdPushConstants(cmd, pipelineLayoutTemporal, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants),
+                       &pushConstants);
+
+    // Reprojection, one workgroup per tile; rejected tiles are appended to the list
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineTemporalReproject);
+    vkCmdDispatch(cmd, (extent.width + TEMPORAL_TILE_SIZE - 1) / TEMPORAL_TILE_SIZE,
+                  (extent.height + TEMPORAL_TILE_SIZE - 1) / TEMPORAL_TILE_SIZE, 1);
+
+    // The tile blur overwrites whole rejected tiles, including texels the reprojection pass stored
+    utils::GlobalBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+                         VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+    // Tile blur, one workgroup per listed tile
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineTemporalBlur);
+    vkCmdDispatchIndirect(cmd, temporalTileBuffer, 0);
+
+    // The final pass samples the blur result; the next frame's reprojection samples both as its history
+    utils::ImageBarrier(cmd, blurOutput.image, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+                        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                        VK_ACCESS_SHADER_READ_BIT);
+    utils::ImageBarrier(cmd, depthOutput.image, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+                        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+
+    temporalHistoryValid = true;
+}
+
+FrameInterpolationPushConstants MotionBlurExample::MakeInterpolationPushConstants(VkExtent2D extent) const
+{
+    // The display targets are sampled over the displayed extent, not the rendered one
+    FrameInterpolationPushConstants pushConstants{};
+    pushConstants.reprojection = cameraParams.reprojection;
+    pushConstants.texelSize = postProcessParams.texelSize;
+    pushConstants.uvScale = glm::vec2(static_cast<float>(extent.width) / renderTargetExtent.width,
+                                      static_cast<float>(extent.height) / renderTargetExtent.height);
+    pushConstants.extent = glm::ivec2(extent.width, extent.height);
+    pushConstants.renderExtent = glm::ivec2(renderExtent.width, renderExtent.height);
+    return pushConstants;
+}
+
+void MotionBlurExample::RecordInterpolationMotion(VkCommandBuffer cmd, VkExtent2D extent)
+{
+    // The G-buffer is read by compute and the display target just rendered by the swapchain copy; both
+    // stay in SHADER_READ_ONLY_OPTIMAL
+    utils::GlobalBarrier(cmd,
+                         VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                         VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_ACCESS_SHADER_READ_BIT);
+
+    // Rewritten in full; the previous interpolated frame read it as the motion of its earlier frame
+    utils::ImageBarrier(cmd, rtInterpolationMotion[displayIndex].image, VK_IMAGE_LAYOUT_UNDEFINED,
+                        VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+                        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+
+    FrameInterpolationPushConstants pushConstants = MakeInterpolationPushConstants(extent);
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayoutInterpolation, 0, 1,
+                            &descriptorSetsInterpolation[displayIndex], 0, nullptr);
+    vkCmdPushConstants(cmd, pipelineLayoutInterpolation, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants),
+                       &pushConstants);
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineInterpolationMotion);
+    vkCmdDispatch(cmd, (extent.width + INTERPOLATION_WORKGROUP_SIZE - 1) / INTERPOLATION_WORKGROUP_SIZE,
+                  (extent.height + INTERPOLATION_WORKGROUP_SIZE - 1) / INTERPOLATION_WORKGROUP_SIZE, 1);
+}
+
+void MotionBlurExample::RecordDisplayCopy(VkCommandBuffer cmd, uint32_t imageIndex, VkDescriptorSet sourceSet)
+{
+    VkExtent2D extent = ctx.GetSwapChainExtent();
+    VkClearValue clearColor = {{{0.0f, 0.0f, 0.0f, 1.0f}}};
+
+    VkRenderPassBeginInfo renderPassInfo{};
+    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    renderPassInfo.renderPass = renderPassFinal;
+    renderPassInfo.framebuffer = swapChainFramebuffers[imageIndex];
+    renderPassInfo.renderArea.offset = {0, 0};
+    renderPassInfo.renderArea.extent = extent;
+    renderPassInfo.clearValueCount = 1;
+    renderPassInfo.pClearValues = &clearColor;
+
+    vkCmdBeginRenderPass(cmd, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineDisplayCopy);
+    utils::SetViewportAndScissor(cmd, extent);
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayoutPyramid, 0, 1, &sourceSet, 0,
+                            nullptr);
+    utils::DrawFullscreenTriangle(cmd);
+    vkCmdEndRenderPass(cmd);
+}
+
+void MotionBlurExample::RecordInterpolatedFrame(VkCommandBuffer cmd, uint32_t imageIndex)
+{
+    // Until two frames have been rendered at the current size there is nothing to interpolate between,
+    // and the rendered frame is shown twice
+    if (interpolationFrames < 2)
+    {
+        RecordDisplayCopy(cmd, imageIndex, descriptorSetsDisplayCopy[displayIndex]);
+        return;
+    }
+
+    VkExtent2D extent = ctx.GetSwapChainExtent();
+    uint32_t groupsX = (extent.width + INTERPOLATION_WORKGROUP_SIZE - 1) / INTERPOLATION_WORKGROUP_SIZE;
+    uint32_t groupsY = (extent.height + INTERPOLATION_WORKGROUP_SIZE - 1) / INTERPOLATION_WORKGROUP_SIZE;
+
+    // After this frame's motion pass, whose barrier also made the display targets visible to compute
+    utils::GlobalBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+
+    // Both outputs are rewritten in full; the previous interpolated frame last read them in the fill pass
+    // and the swapchain copy
+    utils::ImageBarrier(cmd, rtInterpolationWarp.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+                        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                        VK_ACCESS_SHADER_WRITE_BIT);
+    utils::ImageBarrier(cmd, rtInterpolated.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+                        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                        VK_ACCESS_SHADER_WRITE_BIT);
+
+    FrameInterpolationPushConstants pushConstants = MakeInterpolationPushConstants(extent);
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayoutInterpolation, 0, 1,
+                            &descriptorSetsInterpolation[displayIndex], 0, nullptr);
+    vkCmdPushConstants(cmd, pipelineLayoutInterpolation, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants),
+                       &pushConstants);
+
+    // Warp both rendered frames to the midpoint, then fill the holes from their surroundings
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineInterpolationWarp);
+    vkCmdDispatch(cmd, groupsX, groupsY, 1);
+
+    utils::ImageBarrier(cmd, rtInterpolationWarp.image, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL,
+                        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+                        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineInterpolationFill);
+    vkCmdDispatch(cmd, groupsX, groupsY, 1);
+
+    utils::ImageBarrier(cmd, rtInterpolated.image, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+                        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+
+    RecordDisplayCopy(cmd, imageIndex, descriptorSetsDisplayCopy[2]);
+}
+
+void MotionBlurExample::RecordCommands(VkCommandBuffer cmd, uint32_t imageIndex)
+{
+    // Every pass renders into the top-left renderExtent sub-rect of the (larger) render targets, which is
+    // the swapchain extent unless dynamic resolution scales it; the final pass upscales it to the swapchain
+    VkExtent2D displayExtent = ctx.GetSwapChainExtent();
+    VkExtent2D extent = renderExtent;
+
+    // The timestamps of the frame that last used this slot steer the render scale of the next one
+    bool timed = gpuTimer.IsSupported();
+    if (timed)
+    {
+        gpuTimer.BeginFrame(cmd, ctx.GetCurrentFrame());
+        ReadFrameTimings();
+        gpuTimer.Timestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+    }
+
+    // Frame interpolation alternates display targets, keeping the previous frame for the interpolated one
+    if (useFrameInterpolation)
+    {
+        displayIndex = 1 - displayIndex;
+    }
+
+    uniformAllocator.BeginFrame(ctx.GetCurrentFrame());
+    uint32_t instanceOffset = static_cast<uint32_t>(instanceSliceSize * ctx.GetCurrentFrame());
+    WriteInstanceTransforms(ctx.GetCurrentFrame());
+
+    // Culling pre-pass: the occlusion test uses the depth pyramid of the last frame that built one
+    bool useOcclusionCulling = useGpuCulling && settings.occlusionCulling;
+    if (useGpuCulling)
+    {
+        cullUniforms.occlusionViewProjection = hizViewProjection;
+        cullUniforms.hizExtent = glm::vec2(hizSourceExtent.width, hizSourceExtent.height) * 0.5f;
+        cullUniforms.hizLevelCount = useOcclusionCulling && hizValid ? hizMipLevels : 0;
+        RecordCulling(cmd, uniformAllocator.Push(cullUniforms), instanceOffset);
+    }
+    if (timed)
+    {
+        gpuTimer.Timestamp(cmd);
+    }
+
+    VkClearValue clearColor = {{{0.0f, 0.0f, 0.0f, 1.0f}}};
+
+    // Pass 0: G-Buffer (the triangle or the stress scene, instanced)
+    RecordGBufferPass(cmd, extent, instanceOffset, false);
+    if (timed)
+    {
+        gpuTimer.Timestamp(cmd);
+    }
+
+    // Depth pyramid of the first draws, then the draws of whatever the second culling pass finds visible in it
+    if (useOcclusionCulling)
+    {
+        RecordHiZBuild(cmd, extent);
+
+        CullUniforms retestUniforms = cullUniforms;
+        retestUniforms.occlusionViewProjection = hizViewProjection;
+        retestUniforms.hizExtent = glm::vec2(hizSourceExtent.width, hizSourceExtent.height) * 0.5f;
+        retestUniforms.hizLevelCount = hizMipLevels;
+        RecordOcclusionRetest(cmd, uniformAllocator.Push(retestUniforms), instanceOffset);
+        RecordGBufferPass(cmd, extent, instanceOffset, true);
+    }
+    if (timed)
+    {
+        gpuTimer.Timestamp(cmd);
+    }
+
+    // Pass 1: Motion Apply
     {
         VkRenderPassBeginInfo renderPassInfo{};
         renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        renderPassInfo.renderPass = renderPassBlurHorizontal;
-        renderPassInfo.framebuffer = fbBlurHorizontal;
+        renderPassInfo.renderPass = renderPassMotionApply;
+        renderPassInfo.framebuffer = fbMotionApply;
         renderPassInfo.renderArea.offset = {0, 0};
         renderPassInfo.renderArea.extent = extent;
         renderPassInfo.clearValueCount = 1;
         renderPassInfo.pClearValues = &clearColor;
 
         vkCmdBeginRenderPass(cmd, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
-        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineBlurHorizontal);
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineMotionApply);
+        utils::SetViewportAndScissor(cmd, extent);
 
-        fullscreenQuad.Bind(cmd);
-        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayoutBlur, 0, 1,
-                                &descriptorSetsBlurHorizontal[currentFrame], 0, nullptr);
-        fullscreenQuad.Draw(cmd);
+        BindPostProcessResources(cmd, descriptorSetMotionApply, MakeBindlessHandles(bindlessSceneColor));
+        if (settings.cameraVelocity)
+        {
+            vkCmdPushConstants(cmd, pipelineLayoutPostProcess, VK_SHADER_STAGE_FRAGMENT_BIT, CAMERA_PARAMS_OFFSET,
+                               sizeof(MotionBlurCameraParams), &cameraParams);
+        }
+        utils::DrawFullscreenTriangle(cmd);
         vkCmdEndRenderPass(cmd);
     }
+    if (timed)
+    {
+        gpuTimer.Timestamp(cmd);
+    }
+
+    // Auto crossover measurement, ahead of the frame's own blur
+    if (measuringCrossover)
+    {
+        RecordCrossoverMeasurement(cmd, extent);
+    }
+
+    // Passes 2 and 3 (recursive): both blur directions as compute scans
+    if (activeBlurMode == GpuBlurMode::Iir)
+    {
+        RecordIirBlur(cmd, extent);
+    }
+
+    // Passes 2 and 3 (pyramid): downsample and upsample chain, the last upsample runs in pass 4
+    if (activeBlurMode == GpuBlurMode::Pyramid)
+    {
+        RecordPyramidBlur(cmd, extent);
+    }
+
+    // Passes 2 and 3 (temporal): last frame's blur where it still holds, the fragment blur kernel in compute
+    // for every other tile
+    if (useTemporalBlur)
+    {
+        RecordTemporalBlur(cmd, extent);
+    }
+
+    // Passes 2 and 3: the fragment blur
+    if (activeBlurMode == GpuBlurMode::Fir && !useTemporalBlur)
+    {
+        RecordFragmentBlur(cmd, extent);
+    }
+    if (timed)
+    {
+        gpuTimer.Timestamp(cmd);
+    }
 
-    // Pass 4: Final to Swapchain
+    // Pass 4: Final to Swapchain, or to a display target with frame interpolation. The interpolated frame
+    // before this one read that target as its previous frame. It covers the whole display, upscaling the
+    // rendered sub-rect through uvScale.
+    if (useFrameInterpolation)
+    {
+        utils::GlobalBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+                             VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0);
+    }
     {
         VkRenderPassBeginInfo renderPassInfo{};
         renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        renderPassInfo.renderPass = renderPassFinal;
-        renderPassInfo.framebuffer = swapChainFramebuffers[imageIndex];
+        renderPassInfo.renderPass = useFrameInterpolation ? renderPassDisplay : renderPassFinal;
+        renderPassInfo.framebuffer =
+            useFrameInterpolation ? fbDisplay[displayIndex] : swapChainFramebuffers[imageIndex];
         renderPassInfo.renderArea.offset = {0, 0};
-        renderPassInfo.renderArea.extent = extent;
+        renderPassInfo.renderArea.extent = displayExtent;
         renderPassInfo.clearValueCount = 1;
         renderPassInfo.pClearValues = &clearColor;
 
         vkCmdBeginRenderPass(cmd, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
-        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineFinal);
+        bool pyramid = activeBlurMode == GpuBlurMode::Pyramid;
+        // Temporal reuse alternates its blur result between rtBlurFinal and rtBlurAlternate
+        bool alternate = useTemporalBlur && temporalIndex == 1;
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pyramid ? pipelineFinalPyramid : pipelineFinal);
+        utils::SetViewportAndScissor(cmd, displayExtent);
 
-        fullscreenQuad.Bind(cmd);
-        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayoutFinal, 0, 1,
-                                &descriptorSetsFinal[currentFrame], 0, nullptr);
-        fullscreenQuad.Draw(cmd);
+        if (useBindless)
+        {
+            uint32_t blurTexture = pyramid     ? bindlessBlurPyramid
+                                   : alternate ? bindlessBlurAlternate
+                                               : bindlessBlurFinal;
+            BindPostProcessResources(cmd, VK_NULL_HANDLE, MakeBindlessHandles(bindlessMotion, blurTexture));
+        }
+        else
+        {
+            VkDescriptorSet finalSet = pyramid     ? descriptorSetFinalPyramid
+                                       : alternate ? descriptorSetFinalAlternate
+                                                   : descriptorSetFinal;
+            vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayoutFinal, 0, 1, &finalSet, 0,
+                                    nullptr);
+            vkCmdPushConstants(cmd, pipelineLayoutFinal, VK_SHADER_STAGE_FRAGMENT_BIT, 0,
+                               sizeof(MotionBlurPostProcessParams), &postProcessParams);
+        }
+        utils::DrawFullscreenTriangle(cmd);
         vkCmdEndRenderPass(cmd);
     }
+
+    // Pass 5 (frame interpolation): keep this frame's motion, then copy the display target to the swapchain
+    if (useFrameInterpolation)
+    {
+        RecordInterpolationMotion(cmd, displayExtent);
+        RecordDisplayCopy(cmd, imageIndex, descriptorSetsDisplayCopy[displayIndex]);
+        interpolationFrames = std::min(interpolationFrames + 1, 2u);
+    }
+    if (timed)
+    {
+        gpuTimer.Timestamp(cmd);
+    }
+}
+
+void MotionBlurExample::ReadFrameTimings()
+{
+    // The blur crossover measurement inflates the frames it runs in
+    if (gpuTimer.GetResultCount() < TIMESTAMP_COUNT || measuringCrossover)
+        return;
+
+    float frameMilliseconds = static_cast<float>(gpuTimer.GetMilliseconds(TIMESTAMP_FRAME_START, TIMESTAMP_FINAL));
+    if (useDynamicResolution)
+    {
+        renderScale = resolutionGovernor.Update(frameMilliseconds);
+    }
+
+    if (++timedFrames % GPU_TIMING_REPORT_FRAMES != 0)
+        return;
+
+    // The G-buffer and motion apply bandwidth are estimates, not measurements: the upper bounds of their bytes
+    // per pixel (SelectGBufferLayout) over the rendered pixels
+    double gbufferMilliseconds = gpuTimer.GetMilliseconds(TIMESTAMP_CULLING, TIMESTAMP_GBUFFER);
+    double motionApplyMilliseconds = gpuTimer.GetMilliseconds(TIMESTAMP_HIZ, TIMESTAMP_MOTION_APPLY);
+    double pixels = static_cast<double>(renderExtent.width) * renderExtent.height;
+    auto gigabytesPerSecond = [pixels](uint32_t bytesPerPixel, double milliseconds)
+    { return milliseconds > 0.0 ? pixels * bytesPerPixel / (milliseconds * 1.0e6) : 0.0; };
+
+    std::cout << "GPU " << frameMilliseconds << " ms";
+    if (useDynamicResolution)
+    {
+        std::cout << " at render scale " << renderScale;
+    }
+    std::cout << " (" << renderExtent.width << "x" << renderExtent.height
+              << "): culling " << gpuTimer.GetMilliseconds(TIMESTAMP_FRAME_START, TIMESTAMP_CULLING)
+              << ", G-buffer " << gbufferMilliseconds << " (up to " << gbufferWriteBytes << " B/px written, "
+              << gigabytesPerSecond(gbufferWriteBytes, gbufferMilliseconds) << " GB/s)"
+              << ", depth pyramid and occlusion re-test " << gpuTimer.GetMilliseconds(TIMESTAMP_GBUFFER, TIMESTAMP_HIZ)
+              << ", motion apply " << motionApplyMilliseconds << " (up to " << motionApplyReadBytes << " B/px read, "
+              << gigabytesPerSecond(motionApplyReadBytes, motionApplyMilliseconds) << " GB/s)"
+              << ", blur " << gpuTimer.GetMilliseconds(TIMESTAMP_MOTION_APPLY, TIMESTAMP_BLUR)
+              << ", final " << gpuTimer.GetMilliseconds(TIMESTAMP_BLUR, TIMESTAMP_FINAL) << std::endl;
 }
 
 }  // namespace vkdemo
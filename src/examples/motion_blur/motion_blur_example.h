@@ -1,25 +1,224 @@
 #pragma once
 
+#include "../../core/bindless_table.h"
+#include "../../core/compute_tuning.h"
+#include "../../core/gpu_timer.h"
+#include "../../core/linear_uniform_allocator.h"
+#include "../../core/resolution_governor.h"
 #include "../../core/vulkan_utils.h"
+#include "../../cpu/iir_blur.h"
 #include "../example_base.h"
+#include "instance_scene.h"
 
 #include <array>
 #include <glm/glm.hpp>
+#include <string>
 
 namespace vkdemo
 {
 
-struct MotionBlurMVPUBO
+// Post-process parameters, delivered as push constants. Per-pass values (such as the
+// blur kernel radius) live here too so that descriptor sets stay frame-invariant.
+// uvScale maps screen UVs into the rendered sub-rect of the over-allocated render targets.
+struct MotionBlurPostProcessParams
 {
-    alignas(16) glm::mat4 currMVP;
-    alignas(16) glm::mat4 prevMVP;
+    alignas(4) float blurStrength;
+    alignas(4) float motionScale;
+    alignas(8) glm::vec2 texelSize;
+    alignas(8) glm::vec2 uvScale;
+    alignas(4) int32_t kernelRadius;
 };
 
-struct MotionBlurPostProcessParams
+// Resource handles for the bindless post-process passes, pushed directly after
+// MotionBlurPostProcessParams in the same push constant range
+struct MotionBlurBindlessHandles
 {
+    uint32_t inputTexture;
+    uint32_t velocityTexture;
+    uint32_t depthTexture;
+    uint32_t blurTexture;
+    uint32_t linearSampler;
+    uint32_t nearestSampler;
+};
+
+// Push constants of the recursive blur compute pass (shaders/iir_blur.comp)
+struct IirBlurPushConstants
+{
+    alignas(16) glm::vec4 coefficients;
+    alignas(8) glm::ivec2 extent;
+    alignas(4) int32_t vertical;
+};
+
+// Camera velocity reconstruction for motion apply, pushed at CAMERA_PARAMS_OFFSET of the post-process
+// push constant range
+struct MotionBlurCameraParams
+{
+    alignas(16) glm::mat4 reprojection;
+};
+
+// Push constants of the pyramid blur passes (shaders/kawase_*.frag)
+struct KawaseBlurParams
+{
+    alignas(8) glm::vec2 sourceTexelSize;
+    alignas(8) glm::vec2 sourceUvScale;
+    alignas(4) float offset;
+};
+
+// Per-frame inputs of the culling pass (shaders/cull.comp), bound as a dynamic uniform
+struct CullUniforms
+{
+    alignas(16) glm::vec4 frustumPlanes[6];
+    alignas(16) glm::mat4 occlusionViewProjection;
+    alignas(8) glm::vec2 hizExtent;
+    alignas(4) uint32_t instanceCount;
+    alignas(4) uint32_t hizLevelCount;
+    alignas(4) uint32_t indexCount;
+    alignas(4) uint32_t firstIndex;
+    alignas(4) int32_t vertexOffset;
+    alignas(4) uint32_t staticInstanceCount;
+};
+
+// Push constants of the depth pyramid build (shaders/hiz_build.comp)
+struct HiZBuildPushConstants
+{
+    alignas(8) glm::ivec2 sourceExtent;
+    alignas(8) glm::ivec2 levelExtent;
+};
+
+// Push constants of the G-buffer shader reading the instances by address (gbuffer.vert with
+// INSTANCE_ADDRESS or VERTEX_PULLING); packedVertices and the bounds are only read by vertex pulling
+struct GBufferParams
+{
+    alignas(8) VkDeviceAddress packedVertices;
+    alignas(8) VkDeviceAddress instances;
+    alignas(16) glm::vec4 positionCenter;
+    alignas(16) glm::vec4 positionExtent;
+};
+
+// Push constants of the load-time vertex quantization (shaders/vertex_pack.comp)
+struct VertexPackParams
+{
+    alignas(8) VkDeviceAddress source;
+    alignas(8) VkDeviceAddress destination;
+    alignas(16) glm::vec4 center;
+    alignas(16) glm::vec4 inverseExtent;
+    alignas(4) uint32_t firstVertex;
+    alignas(4) uint32_t vertexCount;
+};
+
+// Push constants of the temporal blur reuse passes (shaders/include/temporal_blur.glsl)
+struct TemporalBlurPushConstants
+{
+    alignas(16) glm::mat4 reprojection;
+    alignas(8) glm::vec2 texelSize;
+    alignas(8) glm::vec2 uvScale;
+    alignas(8) glm::ivec2 extent;
     alignas(4) float blurStrength;
-    alignas(4) float motionScale;
+    alignas(4) int32_t kernelRadius;
+    alignas(4) int32_t apron;
+    alignas(4) int32_t historyValid;
+};
+
+// Push constants of the frame interpolation passes (shaders/include/frame_interpolation.glsl)
+struct FrameInterpolationPushConstants
+{
+    alignas(16) glm::mat4 reprojection;
     alignas(8) glm::vec2 texelSize;
+    alignas(8) glm::vec2 uvScale;
+    alignas(8) glm::ivec2 extent;
+    alignas(8) glm::ivec2 renderExtent;
+};
+
+// Attachments of the G-buffer pass, decoded by shaders/include/gbuffer.glsl
+enum class GBufferLayout
+{
+    Separate, // RGBA16F color + RG16F velocity
+    Packed,   // B10G11R11 color + RG16 snorm velocity scaled to a fixed range
+    Folded    // RGBA16 unorm color with a log-polar velocity code in alpha, no velocity target
+};
+
+// How the blur input of the final pass is produced
+enum class GpuBlurMode
+{
+    Fir,     // 9-tap separable fragment blur at full resolution
+    Iir,     // Recursive Gaussian compute scans (iir_blur.comp)
+    Pyramid, // Dual Kawase downsample/upsample chain over mips of rtMotion
+    Auto     // Fir or Iir, from iirCrossoverRadius
+};
+
+// Runtime options, parsed from the command line
+struct MotionBlurSettings
+{
+    // Address post-process resources through one descriptor-indexing table
+    // (ignored when the device lacks descriptor indexing support)
+    bool bindless = false;
+
+    // Blur radius in texels; the fragment blur stretches its 9 taps to cover it
+    float blurRadius = 4.0f;
+
+    // Auto switches from the fragment blur to the recursive one at iirCrossoverRadius. 0 measures it
+    // over the first frames with timestamp queries: the crossover is the radius where the fragment blur
+    // gets slower than the recursive one. Until then, and without timestamps, Auto switches at radius 8.
+    GpuBlurMode blurMode = GpuBlurMode::Auto;
+    float iirCrossoverRadius = 0.0f;
+
+    // Pyramid levels (0 derives them from blurRadius, each level doubles the reach)
+    uint32_t pyramidLevels = 0;
+
+    // Reuse last frame's blur result, reprojected along velocity, wherever it passes a depth and a color
+    // neighborhood test, and blur only the 16x16 tiles where it fails. Needs the fragment blur (Fir, or
+    // Auto below the crossover) with a radius below 16 texels; ignored otherwise.
+    bool temporalBlur = false;
+
+    // Reduced precision, each used only where the device supports it: B10G11R11 color intermediates
+    // (rtMotion, the blur targets and the pyramid) and fp16 arithmetic in the post-process shaders
+    bool packedFormats = true;
+    bool fp16Shaders = true;
+
+    // Motion apply taps: 0 takes a fixed 4 along the velocity of every pixel, otherwise one per texel of
+    // velocity up to this cap (at least 4), jittered by interleaved gradient noise
+    uint32_t motionTapCap = 0;
+
+    // G-buffer attachment layout; the packed ones fall back to Separate where the device cannot render
+    // to their formats
+    GBufferLayout gbufferLayout = GBufferLayout::Separate;
+
+    // Write velocity only for dynamic geometry; motion apply reconstructs the camera-only velocity of
+    // everything else from depth and the current and previous view-projection
+    bool cameraVelocity = false;
+
+    // Instanced stress scene: 0 draws the single spinning triangle, otherwise this many cubes
+    // (up to InstanceScene::MAX_INSTANCES) on a grid, seen from a slowly orbiting camera. Without
+    // bufferDeviceAddress the instances are bound as one storage buffer range, which caps them at
+    // maxStorageBufferRange / sizeof(cpu::InstanceMvp) (932067 at the 128 MiB minimum).
+    uint32_t instanceCount = 0;
+
+    // Binary mesh file (.vkmesh, written by MeshConverter) whose first mesh replaces the triangle or
+    // the cube. The stress grid is spaced for meshes within [-0.5, 0.5]^3 (MeshConverter --normalize).
+    std::string meshPath;
+
+    // GPU-driven stress scene: a compute pass culls the instances against the frustum and, with
+    // occlusionCulling, against a depth pyramid of the previous frame, then compacts the survivors into
+    // indirect draws. The occluded ones are tested again against a pyramid of those draws and drawn in a
+    // second G-buffer pass if visible. Needs drawIndirectCount; the stress scene is drawn unculled without it.
+    bool gpuCulling = true;
+    bool occlusionCulling = true;
+
+    // Draw the G-buffer pass by vertex pulling: meshes are quantized to 8-byte vertices at load and
+    // read through a buffer device address instead of fixed-function vertex input. Needs
+    // bufferDeviceAddress; the float vertex buffer is bound as before without it.
+    bool vertexPulling = true;
+
+    // Dynamic resolution: every pass up to the final one renders a scaled sub-rect of the render targets,
+    // which the final pass upscales to the swapchain. A PID governor sets the scale each frame from GPU
+    // timestamps, steering the frame towards targetFrameMs (0 disables), down to minRenderScale per axis.
+    // Needs timestamp queries; renders at full resolution without them.
+    float targetFrameMs = 0.0f;
+    float minRenderScale = 0.5f;
+
+    // Reports the GPU time of each pass every few seconds, with the bytes per pixel the G-buffer layout writes
+    // and motion apply reads and the bandwidth they come to. Needs timestamp queries.
+    bool gpuProfile = false;
 };
 
 struct TriangleVertex
@@ -34,7 +233,7 @@ struct TriangleVertex
 class MotionBlurExample : public ExampleBase
 {
 public:
-    explicit MotionBlurExample(VulkanContext& context);
+    explicit MotionBlurExample(VulkanContext& context, const MotionBlurSettings& settings = MotionBlurSettings());
     ~MotionBlurExample() override = default;
 
     std::string GetName() const override { return "Motion Blur Demo"; }
@@ -44,94 +243,338 @@ public:
     void OnSwapChainRecreated() override;
     void OnSwapChainCleanup() override;
     void RecordCommands(VkCommandBuffer cmd, uint32_t imageIndex) override;
+    bool SupportsFrameInterpolation() const override { return useFrameInterpolation; }
+    void RecordInterpolatedFrame(VkCommandBuffer cmd, uint32_t imageIndex) override;
     void Update(float deltaTime) override;
 
 private:
+    // Index and vertex range of one mesh in the scene mesh buffers
+    struct MeshRange
+    {
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+        int32_t vertexOffset = 0;
+        uint32_t vertexCount = 0;
+        // Bounding sphere radius around the model origin
+        float boundingRadius = 0.0f;
+        // Centre and half size of the model-space bounds, which packed positions are relative to
+        glm::vec3 boundsCenter = glm::vec3(0.0f);
+        glm::vec3 boundsExtent = glm::vec3(0.0f);
+    };
+
     void CreateRenderTargets();
     void CreateRenderPasses();
     void CreateDescriptorSetLayouts();
     void CreatePipelineLayouts();
     void CreatePipelines();
-    void CreateFramebuffers();
-    void CreateTriangleVertexBuffer();
-    void CreateUniformBuffers();
+    void CreateRenderTargetFramebuffers();
+    void CreateSwapChainFramebuffers();
+    void CreateMeshBuffers();
+    void LoadMeshFile(const std::string& path);
+    void PackMeshVertices(const std::vector<MeshRange>& meshes, VkDeviceSize vertexCount);
+    void CreateInstanceBuffer();
+    void WriteInstanceTransforms(uint32_t frameIndex);
+    void CreateCullingBuffers();
+    void RecordCulling(VkCommandBuffer cmd, uint32_t cullOffset, uint32_t instanceOffset);
+    void RecordOcclusionRetest(VkCommandBuffer cmd, uint32_t cullOffset, uint32_t instanceOffset);
+    void RecordGBufferPass(VkCommandBuffer cmd, VkExtent2D extent, uint32_t instanceOffset, bool occlusionRetest);
+    void RecordHiZBuild(VkCommandBuffer cmd, VkExtent2D extent);
+    VkExtent2D GetHiZLevelSize(VkExtent2D extent, uint32_t level) const;
+    void CreateUniformAllocator();
     void CreateDescriptorPool();
     void CreateDescriptorSets();
     void CreateSamplers();
+    void CreateBindlessTable();
+    void RegisterBindlessRenderTargets();
+    void RecordFragmentBlur(VkCommandBuffer cmd, VkExtent2D extent);
+    void RecordIirBlur(VkCommandBuffer cmd, VkExtent2D extent);
+    void RecordCrossoverMeasurement(VkCommandBuffer cmd, VkExtent2D extent);
+    void FinishCrossoverMeasurement();
+    void RecordPyramidBlur(VkCommandBuffer cmd, VkExtent2D extent);
+    void RecordTemporalBlur(VkCommandBuffer cmd, VkExtent2D extent);
+    void RecordInterpolationMotion(VkCommandBuffer cmd, VkExtent2D extent);
+    void RecordDisplayCopy(VkCommandBuffer cmd, uint32_t imageIndex, VkDescriptorSet sourceSet);
+    FrameInterpolationPushConstants MakeInterpolationPushConstants(VkExtent2D extent) const;
+    void ReadFrameTimings();
+    GpuBlurMode ResolveBlurMode() const;
+    VkExtent2D GetPyramidLevelSize(uint32_t level) const;
+    void SelectPrecision();
+    std::string GetPostShaderPath(const char* name) const;
+    void SelectGBufferLayout();
+    VkImageView GetVelocityView() const;
 
-    void CleanupRenderTargets();
+    MotionBlurBindlessHandles MakeBindlessHandles(uint32_t inputTexture,
+                                                  uint32_t blurTexture = BindlessTable::INVALID_HANDLE) const;
+    void BindPostProcessResources(VkCommandBuffer cmd, VkDescriptorSet descriptorSet,
+                                  const MotionBlurBindlessHandles& handles);
+
+    bool RenderTargetsFit(VkExtent2D extent) const;
+    void RetireRenderTargets();
+    void RetireSwapChainFramebuffers();
+    void RetireDescriptorPool();
     void CleanupFramebuffers();
 
-    // Render targets
+    MotionBlurSettings settings;
+    bool useBindless = false;
+
+    // Precision policy (see SelectPrecision); the blur targets also need storage image support
+    VkFormat motionFormat = VK_FORMAT_R16G16B16A16_SFLOAT;
+    VkFormat blurFormat = VK_FORMAT_R16G16B16A16_SFLOAT;
+    // G-buffer layout in use; velocityFormat is VK_FORMAT_UNDEFINED when the layout has no velocity target
+    GBufferLayout gbufferLayout = GBufferLayout::Separate;
+    VkFormat sceneColorFormat = VK_FORMAT_R16G16B16A16_SFLOAT;
+    VkFormat velocityFormat = VK_FORMAT_R16G16_SFLOAT;
+    bool useFp16Shaders = false;
+    bool useGpuCulling = false;
+    bool useVertexPulling = false;
+    bool useInstanceAddress = false;
+    bool useTemporalBlur = false;
+    bool useFrameInterpolation = false;
+    bool useDynamicResolution = false;
+
+    // Render targets (over-allocated to RENDER_TARGET_BUCKET multiples, rendered into a sub-rect)
+    static constexpr uint32_t RENDER_TARGET_BUCKET = 256;
+    VkExtent2D renderTargetExtent{};
     RenderTarget rtSceneColor;
     RenderTarget rtVelocity;
     RenderTarget rtDepth;
     RenderTarget rtMotion;
     RenderTarget rtBlurIntermediate;
     RenderTarget rtBlurFinal;
+    // Causal result of the recursive blur, between its two directions (only when the blur mode allows it)
+    RenderTarget rtIirCausal;
+
+    // Blur pyramid: mip k holds rtMotion at 1/2^(k+1) resolution, with one view and framebuffer per mip
+    static constexpr uint32_t MAX_PYRAMID_LEVELS = 8;
+    RenderTarget rtBlurPyramid;
+    uint32_t pyramidMipLevels = 0;
+    std::vector<VkImageView> pyramidViews;
+    std::vector<VkFramebuffer> fbPyramid;
+
+    // Hierarchical-Z: farthest depth of rtDepth at half resolution and below, one storage view per mip
+    // and a view of the whole chain for the culling pass. Built after the draws of the first culling
+    // pass and tested by the second, then by the next frame's first, with the camera it was rendered
+    // with.
+    static constexpr uint32_t MAX_HIZ_LEVELS = 16;
+    RenderTarget rtHiZ;
+    uint32_t hizMipLevels = 0;
+    std::vector<VkImageView> hizLevelViews;
+    bool hizValid = false;
+    bool hizInitialized = false;
+    VkExtent2D hizSourceExtent{};
+    glm::mat4 hizViewProjection = glm::mat4(1.0f);
+
+    // Temporal blur reuse: each frame writes its blur result into rtBlurFinal or rtBlurAlternate and its
+    // depth (R32F) into rtTemporalDepth[temporalIndex], alternating each frame, and reprojects the other
+    // pair, last frame's, as its history. The list of tiles to blur again is also the indirect dispatch of
+    // the tile blur. temporalApron is the blur reach in texels.
+    RenderTarget rtBlurAlternate;
+    std::array<RenderTarget, 2> rtTemporalDepth;
+    uint32_t temporalIndex = 0;
+    bool temporalHistoryValid = false;
+    uint32_t temporalApron = 0;
+    VkBuffer temporalTileBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory temporalTileBufferMemory = VK_NULL_HANDLE;
+
+    // Frame interpolation: the final pass renders into rtDisplay[displayIndex], alternating each frame, and
+    // is copied to the swapchain from there. rtInterpolationMotion[i] holds velocity and nearness of the
+    // frame displayed from rtDisplay[i]; the warp and the filled interpolated frame are rebuilt every time.
+    // interpolationFrames counts rendered frames since the last resize, up to the two interpolation needs.
+    std::array<RenderTarget, 2> rtDisplay;
+    std::array<RenderTarget, 2> rtInterpolationMotion;
+    RenderTarget rtInterpolationWarp;
+    RenderTarget rtInterpolated;
+    uint32_t displayIndex = 0;
+    uint32_t interpolationFrames = 0;
+
+    // Dynamic resolution: renderExtent is the sub-rect rendered before the final pass, renderScale times the
+    // swapchain extent per axis. The timestamps of each frame feed the governor and the GPU profile once they
+    // are read back, MAX_FRAMES_IN_FLIGHT frames later, setting the scale of the next Update.
+    GpuTimer gpuTimer;
+    ResolutionGovernor resolutionGovernor;
+    float renderScale = 1.0f;
+    VkExtent2D renderExtent{};
+    uint64_t timedFrames = 0;
+    // Upper bounds of the G-buffer and motion apply bytes per pixel of the selected layout, tap cap and
+    // velocity mode, for the bandwidth estimates in the GPU profile
+    uint32_t gbufferWriteBytes = 0;
+    uint32_t motionApplyReadBytes = 0;
 
     // Framebuffers
     VkFramebuffer fbGBuffer = VK_NULL_HANDLE;
     VkFramebuffer fbMotionApply = VK_NULL_HANDLE;
     VkFramebuffer fbBlurVertical = VK_NULL_HANDLE;
     VkFramebuffer fbBlurHorizontal = VK_NULL_HANDLE;
+    std::array<VkFramebuffer, 2> fbDisplay = {VK_NULL_HANDLE, VK_NULL_HANDLE};
     std::vector<VkFramebuffer> swapChainFramebuffers;
 
     // Render passes
     VkRenderPass renderPassGBuffer = VK_NULL_HANDLE;
+    // Loads the G-buffer for the draws of the second culling pass; compatible with fbGBuffer
+    VkRenderPass renderPassGBufferRetest = VK_NULL_HANDLE;
     VkRenderPass renderPassMotionApply = VK_NULL_HANDLE;
     VkRenderPass renderPassBlurVertical = VK_NULL_HANDLE;
     VkRenderPass renderPassBlurHorizontal = VK_NULL_HANDLE;
     VkRenderPass renderPassFinal = VK_NULL_HANDLE;
+    VkRenderPass renderPassPyramid = VK_NULL_HANDLE;
+    VkRenderPass renderPassDisplay = VK_NULL_HANDLE;
 
     // Descriptor set layouts
     VkDescriptorSetLayout descriptorSetLayoutGBuffer = VK_NULL_HANDLE;
     VkDescriptorSetLayout descriptorSetLayoutPostProcess = VK_NULL_HANDLE;
     VkDescriptorSetLayout descriptorSetLayoutFinal = VK_NULL_HANDLE;
+    VkDescriptorSetLayout descriptorSetLayoutIirBlur = VK_NULL_HANDLE;
+    VkDescriptorSetLayout descriptorSetLayoutPyramid = VK_NULL_HANDLE;
+    VkDescriptorSetLayout descriptorSetLayoutCull = VK_NULL_HANDLE;
+    VkDescriptorSetLayout descriptorSetLayoutTemporal = VK_NULL_HANDLE;
+    VkDescriptorSetLayout descriptorSetLayoutInterpolation = VK_NULL_HANDLE;
 
     // Pipeline layouts
     VkPipelineLayout pipelineLayoutGBuffer = VK_NULL_HANDLE;
-    VkPipelineLayout pipelineLayoutMotionApply = VK_NULL_HANDLE;
-    VkPipelineLayout pipelineLayoutBlur = VK_NULL_HANDLE;
+    VkPipelineLayout pipelineLayoutPostProcess = VK_NULL_HANDLE;
     VkPipelineLayout pipelineLayoutFinal = VK_NULL_HANDLE;
+    VkPipelineLayout pipelineLayoutIirBlur = VK_NULL_HANDLE;
+    VkPipelineLayout pipelineLayoutPyramid = VK_NULL_HANDLE;
+    VkPipelineLayout pipelineLayoutCull = VK_NULL_HANDLE;
+    VkPipelineLayout pipelineLayoutHiZ = VK_NULL_HANDLE;
+    VkPipelineLayout pipelineLayoutTemporal = VK_NULL_HANDLE;
+    VkPipelineLayout pipelineLayoutInterpolation = VK_NULL_HANDLE;
 
     // Pipelines
     VkPipeline pipelineGBuffer = VK_NULL_HANDLE;
+    // Camera velocity mode only: static instances, velocity target masked (shaders/gbuffer.frag)
+    VkPipeline pipelineGBufferStatic = VK_NULL_HANDLE;
     VkPipeline pipelineMotionApply = VK_NULL_HANDLE;
     VkPipeline pipelineBlurVertical = VK_NULL_HANDLE;
     VkPipeline pipelineBlurHorizontal = VK_NULL_HANDLE;
     VkPipeline pipelineFinal = VK_NULL_HANDLE;
+    VkPipeline pipelineIirBlur = VK_NULL_HANDLE;
+    VkPipeline pipelinePyramidDown = VK_NULL_HANDLE;
+    VkPipeline pipelinePyramidUp = VK_NULL_HANDLE;
+    VkPipeline pipelineFinalPyramid = VK_NULL_HANDLE;
+    VkPipeline pipelineCull = VK_NULL_HANDLE;
+    VkPipeline pipelineCullRetest = VK_NULL_HANDLE;
+    VkPipeline pipelineHiZBuild = VK_NULL_HANDLE;
+    VkPipeline pipelineTemporalReproject = VK_NULL_HANDLE;
+    VkPipeline pipelineTemporalBlur = VK_NULL_HANDLE;
+    VkPipeline pipelineInterpolationMotion = VK_NULL_HANDLE;
+    VkPipeline pipelineInterpolationWarp = VK_NULL_HANDLE;
+    VkPipeline pipelineInterpolationFill = VK_NULL_HANDLE;
+    VkPipeline pipelineDisplayCopy = VK_NULL_HANDLE;
+
+    // Scene meshes in one vertex and one index buffer (32-bit indices): the built-in triangle and
+    // stress-scene cube, or the blobs of settings.meshPath. Every instance draws sceneMesh. With vertex
+    // pulling the vertex buffer holds packed vertices (shaders/include/packed_vertex.glsl).
+    VkBuffer meshVertexBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory meshVertexBufferMemory = VK_NULL_HANDLE;
+    VkDeviceAddress meshVertexAddress = 0;
+    VkBuffer meshIndexBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory meshIndexBufferMemory = VK_NULL_HANDLE;
+    MeshRange sceneMesh;
+
+    // Per-instance MVPs (per-frame slices of one persistently mapped storage buffer, bound with a
+    // dynamic offset like the uniforms, or read by address), written by the SIMD transform kernels on
+    // the job system
+    InstanceScene instanceScene;
+    uint32_t instanceCount = 1;
+    // Instances [0, staticInstanceCount) are static; drawn and culled apart from the rest
+    uint32_t staticInstanceCount = 0;
+    VkBuffer instanceBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory instanceBufferMemory = VK_NULL_HANDLE;
+    VkDeviceAddress instanceBufferAddress = 0;
+    uint8_t* instanceBufferMapped = nullptr;
+    VkDeviceSize instanceSliceSize = 0;
+
+    // Indirect draws compacted by the culling passes (one per visible instance) and their counts: static
+    // instances from command 0 (count 0) and the rest from command staticInstanceCount (count 1), the
+    // second pass the same from command instanceCount (counts 2 and 3). Only the GPU touches them,
+    // ordered across frames by the barriers around the passes.
+    VkBuffer drawCommandBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory drawCommandBufferMemory = VK_NULL_HANDLE;
+    VkBuffer drawCountBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory drawCountBufferMemory = VK_NULL_HANDLE;
+    // Instances the first culling pass found occluded, behind the indirect dispatch of the second
+    // (shaders/cull.comp)
+    VkBuffer occlusionRetestBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory occlusionRetestBufferMemory = VK_NULL_HANDLE;
 
-    // Triangle mesh
-    VkBuffer triangleVertexBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory triangleVertexBufferMemory = VK_NULL_HANDLE;
+    // Uniform data (per-frame slices of one persistently mapped buffer) and push constants
+    static constexpr VkDeviceSize UNIFORM_BYTES_PER_FRAME = 64 * 1024;
+    static constexpr int32_t BLUR_KERNEL_RADIUS = 4;
+    static constexpr uint32_t CAMERA_PARAMS_OFFSET = 64;
+    LinearUniformAllocator uniformAllocator;
+    // Cameras of the frame being recorded and of the frame before it, staged by Update for the MVPs
+    glm::mat4 currViewProjection = glm::mat4(1.0f);
+    glm::mat4 prevViewProjection = glm::mat4(1.0f);
+    MotionBlurPostProcessParams postProcessParams{};
+    MotionBlurCameraParams cameraParams{};
+    CullUniforms cullUniforms{};
 
-    // Uniform buffers
-    std::vector<VkBuffer> mvpUniformBuffers;
-    std::vector<VkDeviceMemory> mvpUniformBuffersMemory;
-    std::vector<void*> mvpUniformBuffersMapped;
-    std::vector<VkBuffer> postProcessUniformBuffers;
-    std::vector<VkDeviceMemory> postProcessUniformBuffersMemory;
-    std::vector<void*> postProcessUniformBuffersMapped;
+    // Workgroup size for compute blur dispatches, from the tile profile (or the device-limit heuristic)
+    cpu::TileSize blurWorkgroupSize{};
 
-    // Descriptors
+    // Blur state for the current frame (see MotionBlurSettings::blurMode); activeBlurMode is never Auto
+    GpuBlurMode activeBlurMode = GpuBlurMode::Fir;
+    uint32_t pyramidLevelCount = 1;
+    uint32_t iirLinesPerWorkgroup = 1;
+    cpu::IirGaussianCoefficients iirCoefficients{};
+
+    // Auto blur crossover (see MotionBlurSettings::iirCrossoverRadius). While it is measured, every frame
+    // also times the fragment blur at a few radii and the recursive blur; the frame's own blur overwrites
+    // their results.
+    float iirCrossoverRadius = 0.0f;
+    bool measuringCrossover = false;
+    GpuTimer crossoverTimer;
+    uint32_t crossoverFrames = 0;
+    std::vector<double> firMilliseconds;
+    double iirMilliseconds = 0.0;
+
+    // Descriptors (frame-invariant, uniforms are bound with dynamic offsets)
     VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
-    std::vector<VkDescriptorSet> descriptorSetsGBuffer;
-    std::vector<VkDescriptorSet> descriptorSetsMotionApply;
-    std::vector<VkDescriptorSet> descriptorSetsBlurVertical;
-    std::vector<VkDescriptorSet> descriptorSetsBlurHorizontal;
-    std::vector<VkDescriptorSet> descriptorSetsFinal;
+    VkDescriptorSet descriptorSetGBuffer = VK_NULL_HANDLE;
+    VkDescriptorSet descriptorSetMotionApply = VK_NULL_HANDLE;
+    VkDescriptorSet descriptorSetBlurVertical = VK_NULL_HANDLE;
+    VkDescriptorSet descriptorSetBlurHorizontal = VK_NULL_HANDLE;
+    VkDescriptorSet descriptorSetFinal = VK_NULL_HANDLE;
+    VkDescriptorSet descriptorSetIirBlurVertical = VK_NULL_HANDLE;
+    VkDescriptorSet descriptorSetIirBlurHorizontal = VK_NULL_HANDLE;
+    VkDescriptorSet descriptorSetFinalPyramid = VK_NULL_HANDLE;
+    // Pyramid pass inputs: rtMotion, then one set per mip
+    VkDescriptorSet descriptorSetPyramidMotion = VK_NULL_HANDLE;
+    std::vector<VkDescriptorSet> descriptorSetsPyramid;
+    VkDescriptorSet descriptorSetCull = VK_NULL_HANDLE;
+    // Depth pyramid build inputs: rtDepth, then one set per mip reading the level below
+    std::vector<VkDescriptorSet> descriptorSetsHiZ;
+    // Temporal blur reuse inputs and outputs, shared by both of its passes; set i writes the pair at
+    // temporalIndex i. The final pass reads rtBlurAlternate through its own set.
+    std::array<VkDescriptorSet, 2> descriptorSetsTemporal = {VK_NULL_HANDLE, VK_NULL_HANDLE};
+    VkDescriptorSet descriptorSetFinalAlternate = VK_NULL_HANDLE;
+    // Frame interpolation inputs and outputs, one set per display target written this frame, and the
+    // swapchain copies of rtDisplay[0], rtDisplay[1] and rtInterpolated
+    std::array<VkDescriptorSet, 2> descriptorSetsInterpolation = {VK_NULL_HANDLE, VK_NULL_HANDLE};
+    std::array<VkDescriptorSet, 3> descriptorSetsDisplayCopy = {VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE};
+
+    // Bindless resource table and handles (bindless mode only)
+    BindlessTable bindlessTable;
+    uint32_t bindlessSceneColor = BindlessTable::INVALID_HANDLE;
+    uint32_t bindlessVelocity = BindlessTable::INVALID_HANDLE;
+    uint32_t bindlessDepth = BindlessTable::INVALID_HANDLE;
+    uint32_t bindlessMotion = BindlessTable::INVALID_HANDLE;
+    uint32_t bindlessBlurIntermediate = BindlessTable::INVALID_HANDLE;
+    uint32_t bindlessBlurFinal = BindlessTable::INVALID_HANDLE;
+    uint32_t bindlessBlurAlternate = BindlessTable::INVALID_HANDLE;
+    uint32_t bindlessBlurPyramid = BindlessTable::INVALID_HANDLE;
+    uint32_t bindlessSamplerLinear = BindlessTable::INVALID_HANDLE;
+    uint32_t bindlessSamplerNearest = BindlessTable::INVALID_HANDLE;
 
     // Samplers
     VkSampler samplerLinear = VK_NULL_HANDLE;
     VkSampler samplerNearest = VK_NULL_HANDLE;
 
-    // Fullscreen quad
-    FullscreenQuad fullscreenQuad;
-
-    // Animation state
+    // Animation state; instance transforms are a function of these two times alone
     float totalTime = 0.0f;
-    glm::mat4 previousMVP = glm::mat4(1.0f);
+    float previousTime = 0.0f;
+    glm::mat4 previousViewProjection = glm::mat4(1.0f);
 };
 
 }  // namespace vkdemo
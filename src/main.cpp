@@ -2,28 +2,165 @@
 #include "examples/example_base.h"
 #include "examples/motion_blur/motion_blur_example.h"
 
+#include <cstdint>
 #include <cstdlib>
 #include <iostream>
 #include <memory>
 #include <stdexcept>
+#include <string>
 
 namespace
 {
 
-std::unique_ptr<vkdemo::ExampleBase> CreateExample(vkdemo::VulkanContext& ctx)
+struct AppSettings
 {
-    return std::make_unique<vkdemo::MotionBlurExample>(ctx);
+    vkdemo::JobSystemConfig jobs;
+    vkdemo::FrameLoopConfig frameLoop;
+    vkdemo::MotionBlurSettings motionBlur;
+};
+
+AppSettings ParseSettings(int argc, char** argv)
+{
+    AppSettings settings;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--bindless")
+        {
+            settings.motionBlur.bindless = true;
+        }
+        else if (arg == "--blur" && i + 1 < argc)
+        {
+            std::string mode = argv[++i];
+            if (mode == "fir")
+                settings.motionBlur.blurMode = vkdemo::GpuBlurMode::Fir;
+            else if (mode == "iir")
+                settings.motionBlur.blurMode = vkdemo::GpuBlurMode::Iir;
+            else if (mode == "pyramid")
+                settings.motionBlur.blurMode = vkdemo::GpuBlurMode::Pyramid;
+            else if (mode == "auto")
+                settings.motionBlur.blurMode = vkdemo::GpuBlurMode::Auto;
+            else
+                std::cerr << "Ignoring unknown blur mode: " << mode << std::endl;
+        }
+        else if (arg == "--blur-radius" && i + 1 < argc)
+        {
+            settings.motionBlur.blurRadius = static_cast<float>(std::atof(argv[++i]));
+        }
+        else if (arg == "--pyramid-levels" && i + 1 < argc)
+        {
+            settings.motionBlur.pyramidLevels = static_cast<uint32_t>(std::atoi(argv[++i]));
+        }
+        else if (arg == "--iir-crossover" && i + 1 < argc)
+        {
+            settings.motionBlur.iirCrossoverRadius = static_cast<float>(std::atof(argv[++i]));
+        }
+        else if (arg == "--temporal-blur")
+        {
+            settings.motionBlur.temporalBlur = true;
+        }
+        else if (arg == "--full-precision")
+        {
+            settings.motionBlur.packedFormats = false;
+            settings.motionBlur.fp16Shaders = false;
+        }
+        else if (arg == "--gbuffer" && i + 1 < argc)
+        {
+            std::string layout = argv[++i];
+            if (layout == "separate")
+                settings.motionBlur.gbufferLayout = vkdemo::GBufferLayout::Separate;
+            else if (layout == "packed")
+                settings.motionBlur.gbufferLayout = vkdemo::GBufferLayout::Packed;
+            else if (layout == "folded")
+                settings.motionBlur.gbufferLayout = vkdemo::GBufferLayout::Folded;
+            else
+                std::cerr << "Ignoring unknown G-buffer layout: " << layout << std::endl;
+        }
+        else if (arg == "--motion-taps" && i + 1 < argc)
+        {
+            settings.motionBlur.motionTapCap = static_cast<uint32_t>(std::atoi(argv[++i]));
+        }
+        else if (arg == "--camera-velocity")
+        {
+            settings.motionBlur.cameraVelocity = true;
+        }
+        else if (arg == "--instances" && i + 1 < argc)
+        {
+            // Digits only: atoi would turn "-1" into four billion instances and "many" into the triangle
+            std::string count = argv[++i];
+            bool digits =
+                !count.empty() && count.size() <= 10 && count.find_first_not_of("0123456789") == std::string::npos;
+            unsigned long long value = digits ? std::strtoull(count.c_str(), nullptr, 10) : 0;
+            if (digits && value <= UINT32_MAX)
+                settings.motionBlur.instanceCount = static_cast<uint32_t>(value);
+            else
+                std::cerr << "Ignoring invalid instance count: " << count << std::endl;
+        }
+        else if (arg == "--mesh" && i + 1 < argc)
+        {
+            settings.motionBlur.meshPath = argv[++i];
+        }
+        else if (arg == "--no-culling")
+        {
+            settings.motionBlur.gpuCulling = false;
+        }
+        else if (arg == "--no-occlusion-culling")
+        {
+            settings.motionBlur.occlusionCulling = false;
+        }
+        else if (arg == "--no-vertex-pulling")
+        {
+            settings.motionBlur.vertexPulling = false;
+        }
+        else if (arg == "--target-frame-ms" && i + 1 < argc)
+        {
+            settings.motionBlur.targetFrameMs = static_cast<float>(std::atof(argv[++i]));
+        }
+        else if (arg == "--min-render-scale" && i + 1 < argc)
+        {
+            settings.motionBlur.minRenderScale = static_cast<float>(std::atof(argv[++i]));
+        }
+        else if (arg == "--gpu-profile")
+        {
+            settings.motionBlur.gpuProfile = true;
+        }
+        else if (arg == "--interpolate-frames")
+        {
+            settings.frameLoop.frameInterpolation = true;
+        }
+        else if (arg == "--worker-threads" && i + 1 < argc)
+        {
+            settings.jobs.workerCount = static_cast<uint32_t>(std::atoi(argv[++i]));
+        }
+        else if (arg == "--pin-threads")
+        {
+            settings.jobs.pinThreads = true;
+        }
+        else
+        {
+            std::cerr << "Ignoring unknown option: " << arg << std::endl;
+        }
+    }
+    return settings;
+}
+
+std::unique_ptr<vkdemo::ExampleBase> CreateExample(vkdemo::VulkanContext& ctx,
+                                                   const vkdemo::MotionBlurSettings& settings)
+{
+    return std::make_unique<vkdemo::MotionBlurExample>(ctx, settings);
 }
 
 }  // namespace
 
-int main()
+int main(int argc, char** argv)
 {
     try
     {
-        vkdemo::VulkanContext context(1280, 720, "Cache Blocking Demo");
+        AppSettings settings = ParseSettings(argc, argv);
+
+        vkdemo::VulkanContext context(1280, 720, "Cache Blocking Demo", settings.jobs, settings.frameLoop);
 
-        auto example = CreateExample(context);
+        auto example = CreateExample(context, settings.motionBlur);
 
         std::cout << "Running: " << example->GetName() << std::endl;
 
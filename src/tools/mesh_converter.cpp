@@ -0,0 +1,324 @@
+// Offline converter from Wavefront OBJ to the binary .vkmesh format read by the motion blur example
+// (--mesh). All parsing happens here, so loading at run time is a memory mapping plus one copy per blob.
+//
+// Usage: MeshConverter input.obj output.vkmesh [--normalize]
+//
+// Every "o" or "g" statement starts a new mesh. Polygons are triangulated as fans and corners sharing a
+// position and normal are merged. Vertex colors come from "v x y z r g b" when present, else from the
+// normal, else from the position within the mesh bounds. --normalize centres each mesh on its bounds
+// and scales it into [-0.5, 0.5]^3, the extent of the built-in cube the stress scene instances.
+
+#include "core/mesh_file.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace vkdemo;
+
+namespace
+{
+
+struct ObjData
+{
+    std::vector<float> positions;  // xyz per entry
+    std::vector<float> colors;     // rgb per entry, empty when the file has no vertex colors
+    std::vector<float> normals;    // xyz per entry
+};
+
+struct MeshBuilder
+{
+    std::string name;
+    std::vector<MeshFileVertex> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<uint8_t> colorFromBounds;
+    std::unordered_map<uint64_t, uint32_t> corners;
+};
+
+// OBJ indices are 1-based, or negative relative to the end of the list so far
+int64_t ResolveIndex(long index, size_t count)
+{
+    if (index > 0)
+        return index - 1;
+    if (index < 0)
+        return static_cast<int64_t>(count) + index;
+    return -1;
+}
+
+uint32_t AddCorner(MeshBuilder& mesh, const ObjData& obj, const char* token)
+{
+    char* end = nullptr;
+    long positionIndex = std::strtol(token, &end, 10);
+    long normalIndex = 0;
+    if (*end == '/')
+    {
+        std::strtol(end + 1, &end, 10);  // Texture coordinates are not used
+        if (*end == '/')
+            normalIndex = std::strtol(end + 1, &end, 10);
+    }
+
+    size_t positionCount = obj.positions.size() / 3;
+    size_t normalCount = obj.normals.size() / 3;
+    int64_t position = ResolveIndex(positionIndex, positionCount);
+    int64_t normal = ResolveIndex(normalIndex, normalCount);
+    if (position < 0 || position >= static_cast<int64_t>(positionCount))
+    {
+        throw std::runtime_error(std::string("Face references a missing vertex: ") + token);
+    }
+    if (normal >= static_cast<int64_t>(normalCount))
+        normal = -1;
+
+    uint64_t key = (static_cast<uint64_t>(position) << 32) | static_cast<uint32_t>(normal + 1);
+    auto found = mesh.corners.find(key);
+    if (found != mesh.corners.end())
+        return found->second;
+
+    MeshFileVertex vertex{};
+    const float* p = &obj.positions[position * 3];
+    std::copy(p, p + 3, vertex.position);
+
+    bool fromBounds = false;
+    if (!obj.colors.empty())
+    {
+        const float* c = &obj.colors[position * 3];
+        std::copy(c, c + 3, vertex.color);
+    }
+    else if (normal >= 0)
+    {
+        const float* n = &obj.normals[normal * 3];
+        for (int i = 0; i < 3; i++)
+            vertex.color[i] = n[i] * 0.5f + 0.5f;
+    }
+    else
+    {
+        fromBounds = true;
+    }
+
+    uint32_t index = static_cast<uint32_t>(mesh.vertices.size());
+    mesh.vertices.push_back(vertex);
+    mesh.colorFromBounds.push_back(fromBounds ? 1 : 0);
+    mesh.corners.emplace(key, index);
+    return index;
+}
+
+void ParseObj(const std::string& path, std::vector<MeshBuilder>& meshes)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        throw std::runtime_error("Failed to open " + path);
+    }
+
+    ObjData obj;
+    meshes.emplace_back();
+
+    std::string line;
+    std::vector<uint32_t> polygon;
+    while (std::getline(file, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        const char* cursor = line.c_str();
+        while (*cursor == ' ' || *cursor == '\t')
+            cursor++;
+
+        if (cursor[0] == 'v' && (cursor[1] == ' ' || cursor[1] == '\t'))
+        {
+            char* end = nullptr;
+            float values[6];
+            int count = 0;
+            for (const char* p = cursor + 2; count < 6; count++, p = end)
+            {
+                values[count] = std::strtof(p, &end);
+                if (end == p)
+                    break;
+            }
+            if (count < 3)
+            {
+                throw std::runtime_error("Malformed vertex: " + line);
+            }
+
+            obj.positions.insert(obj.positions.end(), values, values + 3);
+            if (count == 6)
+            {
+                // Colors must cover every vertex or none
+                obj.colors.resize(obj.positions.size() - 3, 1.0f);
+                obj.colors.insert(obj.colors.end(), values + 3, values + 6);
+            }
+            else if (!obj.colors.empty())
+            {
+                obj.colors.insert(obj.colors.end(), {1.0f, 1.0f, 1.0f});
+            }
+        }
+        else if (cursor[0] == 'v' && cursor[1] == 'n')
+        {
+            char* end = nullptr;
+            const char* p = cursor + 2;
+            for (int i = 0; i < 3; i++, p = end)
+                obj.normals.push_back(std::strtof(p, &end));
+        }
+        else if (cursor[0] == 'f' && (cursor[1] == ' ' || cursor[1] == '\t'))
+        {
+            MeshBuilder& mesh = meshes.back();
+            polygon.clear();
+
+            const char* p = cursor + 1;
+            while (*p)
+            {
+                while (*p == ' ' || *p == '\t')
+                    p++;
+                if (!*p)
+                    break;
+                polygon.push_back(AddCorner(mesh, obj, p));
+                while (*p && *p != ' ' && *p != '\t')
+                    p++;
+            }
+
+            for (size_t i = 2; i < polygon.size(); i++)
+            {
+                mesh.indices.insert(mesh.indices.end(), {polygon[0], polygon[i - 1], polygon[i]});
+            }
+        }
+        else if ((cursor[0] == 'o' || cursor[0] == 'g') && (cursor[1] == ' ' || cursor[1] == '\t'))
+        {
+            if (!meshes.back().indices.empty())
+                meshes.emplace_back();
+            meshes.back().name = cursor + 2;
+        }
+    }
+
+    meshes.erase(std::remove_if(meshes.begin(), meshes.end(),
+                                [](const MeshBuilder& mesh) { return mesh.indices.empty(); }),
+                 meshes.end());
+    if (meshes.empty())
+    {
+        throw std::runtime_error("No faces in " + path);
+    }
+}
+
+MeshFileMesh FinishMesh(MeshBuilder& mesh, bool normalize)
+{
+    MeshFileMesh info{};
+    for (int i = 0; i < 3; i++)
+    {
+        info.boundsMin[i] = INFINITY;
+        info.boundsMax[i] = -INFINITY;
+    }
+    for (const MeshFileVertex& vertex : mesh.vertices)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            info.boundsMin[i] = std::min(info.boundsMin[i], vertex.position[i]);
+            info.boundsMax[i] = std::max(info.boundsMax[i], vertex.position[i]);
+        }
+    }
+
+    if (normalize)
+    {
+        float center[3];
+        float extent = 0.0f;
+        for (int i = 0; i < 3; i++)
+        {
+            center[i] = 0.5f * (info.boundsMin[i] + info.boundsMax[i]);
+            extent = std::max(extent, info.boundsMax[i] - info.boundsMin[i]);
+        }
+        float scale = extent > 0.0f ? 1.0f / extent : 1.0f;
+        for (MeshFileVertex& vertex : mesh.vertices)
+        {
+            for (int i = 0; i < 3; i++)
+                vertex.position[i] = (vertex.position[i] - center[i]) * scale;
+        }
+        for (int i = 0; i < 3; i++)
+        {
+            info.boundsMin[i] = (info.boundsMin[i] - center[i]) * scale;
+            info.boundsMax[i] = (info.boundsMax[i] - center[i]) * scale;
+        }
+    }
+
+    float radiusSquared = 0.0f;
+    for (size_t v = 0; v < mesh.vertices.size(); v++)
+    {
+        MeshFileVertex& vertex = mesh.vertices[v];
+        const float* p = vertex.position;
+        radiusSquared = std::max(radiusSquared, p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+
+        if (mesh.colorFromBounds[v])
+        {
+            for (int i = 0; i < 3; i++)
+            {
+                float size = info.boundsMax[i] - info.boundsMin[i];
+                vertex.color[i] = size > 0.0f ? (p[i] - info.boundsMin[i]) / size : 0.5f;
+            }
+        }
+    }
+    info.boundingRadius = std::sqrt(radiusSquared);
+    info.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+    info.indexCount = static_cast<uint32_t>(mesh.indices.size());
+    return info;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::fprintf(stderr, "Usage: MeshConverter input.obj output.vkmesh [--normalize]\n");
+        return 1;
+    }
+    bool normalize = argc > 3 && std::strcmp(argv[3], "--normalize") == 0;
+
+    try
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        std::vector<MeshBuilder> builders;
+        ParseObj(argv[1], builders);
+
+        std::vector<MeshFileMesh> meshes;
+        std::vector<MeshFileVertex> vertices;
+        std::vector<uint32_t> indices;
+        for (MeshBuilder& builder : builders)
+        {
+            MeshFileMesh mesh = FinishMesh(builder, normalize);
+            // MeshFile::Open rejects files with an index outside its mesh; never write one
+            for (uint32_t index : builder.indices)
+            {
+                if (index >= mesh.vertexCount)
+                {
+                    throw std::runtime_error("Index " + std::to_string(index) + " is outside its mesh of " +
+                                             std::to_string(mesh.vertexCount) + " vertices");
+                }
+            }
+            mesh.firstIndex = static_cast<uint32_t>(indices.size());
+            mesh.vertexOffset = static_cast<int32_t>(vertices.size());
+            vertices.insert(vertices.end(), builder.vertices.begin(), builder.vertices.end());
+            indices.insert(indices.end(), builder.indices.begin(), builder.indices.end());
+            meshes.push_back(mesh);
+
+            std::printf("  %-24s %9u vertices %9u triangles  radius %.3f\n",
+                        builder.name.empty() ? "(unnamed)" : builder.name.c_str(), mesh.vertexCount,
+                        mesh.indexCount / 3, mesh.boundingRadius);
+        }
+
+        WriteMeshFile(argv[2], meshes, vertices, indices);
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("Wrote %s: %zu meshes, %zu vertices, %zu triangles in %.2f s\n", argv[2], meshes.size(),
+                    vertices.size(), indices.size() / 3, seconds);
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "Error: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}